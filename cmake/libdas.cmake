@@ -8,24 +8,39 @@ set(LIBDAS_STATIC_TARGET das-static)
 set(LIBDAS_SOURCES
     src/Algorithm.cpp
     src/Base64Decoder.cpp
+    src/BoundingVolumes.cpp
+    src/BufferDeduplicator.cpp
     src/BufferImageTypeResolver.cpp
+    src/BvhBuilder.cpp
+    src/DasArena.cpp
+    src/DasBlobStore.cpp
     src/DasParser.cpp
+    src/DasPatcher.cpp
     src/DasReaderCore.cpp
+    src/DasSceneGraph.cpp
     src/DasStructures.cpp
+    src/DasTranscoder.cpp
     src/DasValidator.cpp
     src/DasWriterCore.cpp
     src/ErrorHandlers.cpp
+    src/FileWriter.cpp
     src/GLTFCompiler.cpp
     src/GLTFParser.cpp
     src/Hash.cpp
     src/JSONParser.cpp
 	src/LodGenerator.cpp
+    src/MappedFile.cpp
+    src/MeshletBuilder.cpp
+    src/MeshOptimizer.cpp
 	src/MultiAttributeLodGenerator.cpp
+    src/OutputSink.cpp
+    src/RandomAccessFile.cpp
     src/STLCompiler.cpp
     src/STLParser.cpp
     src/STLStructures.cpp
     src/TextureReader.cpp
     src/URIResolver.cpp
+    src/VertexQuantization.cpp
     src/WavefrontObjCompiler.cpp
     src/WavefrontObjParser.cpp
     src/WavefrontObjStructures.cpp
@@ -35,23 +50,38 @@ set(LIBDAS_HEADERS
     include/das/Algorithm.h
     include/das/Api.h
     include/das/Base64Decoder.h
+    include/das/BoundingVolumes.h
+    include/das/BufferDeduplicator.h
     include/das/BufferImageTypeResolver.h
+    include/das/BvhBuilder.h
+    include/das/DasArena.h
+    include/das/DasBlobStore.h
     include/das/DasParser.h
+    include/das/DasPatcher.h
     include/das/DasReaderCore.h
+    include/das/DasSceneGraph.h
     include/das/DasStructures.h
+    include/das/DasTranscoder.h
     include/das/DasValidator.h
     include/das/DasWriterCore.h
     include/das/Debug.h
     include/das/ErrorHandlers.h
+    include/das/FileWriter.h
     include/das/GLTFCompiler.h
     include/das/GLTFParser.h
     include/das/GLTFStructures.h
     include/das/Hash.h
     include/das/HuffmanCompression.h
     include/das/JSONParser.h
+    include/das/KeywordMatcher.h
     include/das/LibdasAssert.h
     include/das/Libdas.h
 	include/das/LodGenerator.h
+    include/das/MappedFile.h
+    include/das/MeshletBuilder.h
+    include/das/MeshOptimizer.h
+    include/das/OutputSink.h
+    include/das/RandomAccessFile.h
 	include/das/MultiAttributeLodGenerator.h
     include/das/stb_image.h
     include/das/STLCompiler.h
@@ -60,6 +90,7 @@ set(LIBDAS_HEADERS
     include/das/TextureReader.h
     include/das/URIResolver.h
 	include/das/Version.h
+    include/das/VertexQuantization.h
     include/das/WavefrontObjCompiler.h
     include/das/WavefrontObjParser.h
     include/das/WavefrontObjStructures.h
@@ -69,6 +100,9 @@ if(CMAKE_BUILD_TYPE MATCHES Debug)
     list(APPEND LIBDAS_SOURCES src/Debug.cpp)
 endif()
 
+# Parallel parsing uses std::thread
+find_package(Threads REQUIRED)
+
 # Static library configuration
 if(LIBDAS_BUILD_STATIC_LIB)
 	add_library(${LIBDAS_STATIC_TARGET} STATIC 
@@ -82,7 +116,7 @@ if(LIBDAS_BUILD_STATIC_LIB)
             PUBLIC ${CMAKE_CURRENT_SOURCE_DIR}/deps/mar/include
             PUBLIC ${CMAKE_CURRENT_SOURCE_DIR}/deps/trs/include)
     endif()
-    target_link_libraries(${LIBDAS_STATIC_TARGET} PUBLIC mar)
+    target_link_libraries(${LIBDAS_STATIC_TARGET} PUBLIC mar Threads::Threads)
 	target_compile_definitions(${LIBDAS_STATIC_TARGET} PUBLIC LIBDAS_STATIC)
 endif()
 
@@ -101,6 +135,6 @@ if(LIBDAS_BUILD_SHARED_LIB)
             PUBLIC ${CMAKE_CURRENT_SOURCE_DIR}/deps/trs/include)
     endif()
 	
-	target_link_libraries(${LIBDAS_SHARED_TARGET} PUBLIC mar)
+	target_link_libraries(${LIBDAS_SHARED_TARGET} PUBLIC mar Threads::Threads)
 	target_compile_definitions(${LIBDAS_SHARED_TARGET} PRIVATE LIBDAS_EXPORT_LIBRARY)
 endif()
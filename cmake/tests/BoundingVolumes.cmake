@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: BoundingVolumes.cmake - bounding volume calculation functions test build configuration
+# author: Karl-Mihkel Ott
+
+set(BOUNDING_VOLUMES_TARGET BoundingVolumesTest)
+set(BOUNDING_VOLUMES_SOURCES tests/BoundingVolumesTest.cpp)
+
+add_executable(${BOUNDING_VOLUMES_TARGET} ${BOUNDING_VOLUMES_SOURCES})
+target_link_libraries(${BOUNDING_VOLUMES_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${BOUNDING_VOLUMES_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: BufferDeduplicator.cmake - BufferDeduplicator class and HashFunc64 function test build configuration
+# author: Karl-Mihkel Ott
+
+set(BUFFER_DEDUPLICATOR_TARGET BufferDeduplicatorTest)
+set(BUFFER_DEDUPLICATOR_SOURCES tests/BufferDeduplicatorTest.cpp)
+
+add_executable(${BUFFER_DEDUPLICATOR_TARGET} ${BUFFER_DEDUPLICATOR_SOURCES})
+target_link_libraries(${BUFFER_DEDUPLICATOR_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${BUFFER_DEDUPLICATOR_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: BvhBuilder.cmake - BvhBuilder class test build configuration
+# author: Karl-Mihkel Ott
+
+set(BVH_BUILDER_TARGET BvhBuilderTest)
+set(BVH_BUILDER_SOURCES tests/BvhBuilderTest.cpp)
+
+add_executable(${BVH_BUILDER_TARGET} ${BVH_BUILDER_SOURCES})
+target_link_libraries(${BVH_BUILDER_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${BVH_BUILDER_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: DasBlobStore.cmake - DasBlobStore class test build configuration
+# author: Karl-Mihkel Ott
+
+set(DAS_BLOB_STORE_TARGET DasBlobStoreTest)
+set(DAS_BLOB_STORE_SOURCES tests/DasBlobStoreTest.cpp)
+
+add_executable(${DAS_BLOB_STORE_TARGET} ${DAS_BLOB_STORE_SOURCES})
+target_link_libraries(${DAS_BLOB_STORE_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${DAS_BLOB_STORE_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
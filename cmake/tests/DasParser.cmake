@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: DasParser.cmake - DasParser table of contents and arena parsing test build configuration
+# author: Karl-Mihkel Ott
+
+set(DAS_PARSER_TARGET DasParserTest)
+set(DAS_PARSER_SOURCES tests/DasParserTest.cpp)
+
+add_executable(${DAS_PARSER_TARGET} ${DAS_PARSER_SOURCES})
+target_link_libraries(${DAS_PARSER_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${DAS_PARSER_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: DasParserAsync.cmake - DasParser streaming parse test build configuration
+# author: Karl-Mihkel Ott
+
+set(DAS_PARSER_ASYNC_TARGET DasParserAsyncTest)
+set(DAS_PARSER_ASYNC_SOURCES tests/DasParserAsyncTest.cpp)
+
+add_executable(${DAS_PARSER_ASYNC_TARGET} ${DAS_PARSER_ASYNC_SOURCES})
+target_link_libraries(${DAS_PARSER_ASYNC_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${DAS_PARSER_ASYNC_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
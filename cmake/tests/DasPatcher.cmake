@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: DasPatcher.cmake - DasPatcher and DasTranscoder patch and compaction test build configuration
+# author: Karl-Mihkel Ott
+
+set(DAS_PATCHER_TARGET DasPatcherTest)
+set(DAS_PATCHER_SOURCES tests/DasPatcherTest.cpp)
+
+add_executable(${DAS_PATCHER_TARGET} ${DAS_PATCHER_SOURCES})
+target_link_libraries(${DAS_PATCHER_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${DAS_PATCHER_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
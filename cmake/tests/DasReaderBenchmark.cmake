@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: DasReaderBenchmark.cmake - DAS scope decoding benchmark build configuration
+# author: Karl-Mihkel Ott
+
+set(DAS_READER_BENCHMARK_TARGET DasReaderBenchmark)
+set(DAS_READER_BENCHMARK_SOURCES tests/DasReaderBenchmark.cpp)
+
+add_executable(${DAS_READER_BENCHMARK_TARGET} ${DAS_READER_BENCHMARK_SOURCES})
+target_link_libraries(${DAS_READER_BENCHMARK_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${DAS_READER_BENCHMARK_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
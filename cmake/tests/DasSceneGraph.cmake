@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: DasSceneGraph.cmake - DasSceneGraph class test build configuration
+# author: Karl-Mihkel Ott
+
+set(DAS_SCENE_GRAPH_TARGET DasSceneGraphTest)
+set(DAS_SCENE_GRAPH_SOURCES tests/DasSceneGraphTest.cpp)
+
+add_executable(${DAS_SCENE_GRAPH_TARGET} ${DAS_SCENE_GRAPH_SOURCES})
+target_link_libraries(${DAS_SCENE_GRAPH_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${DAS_SCENE_GRAPH_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
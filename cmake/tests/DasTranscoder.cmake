@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: DasTranscoder.cmake - DasTranscoder class test build configuration
+# author: Karl-Mihkel Ott
+
+set(DAS_TRANSCODER_TARGET DasTranscoderTest)
+set(DAS_TRANSCODER_SOURCES tests/DasTranscoderTest.cpp)
+
+add_executable(${DAS_TRANSCODER_TARGET} ${DAS_TRANSCODER_SOURCES})
+target_link_libraries(${DAS_TRANSCODER_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${DAS_TRANSCODER_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: DasWriterBenchmark.cmake - DAS writer output throughput benchmark build configuration
+# author: Karl-Mihkel Ott
+
+set(DAS_WRITER_BENCHMARK_TARGET DasWriterBenchmark)
+set(DAS_WRITER_BENCHMARK_SOURCES tests/DasWriterBenchmark.cpp)
+
+add_executable(${DAS_WRITER_BENCHMARK_TARGET} ${DAS_WRITER_BENCHMARK_SOURCES})
+target_link_libraries(${DAS_WRITER_BENCHMARK_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${DAS_WRITER_BENCHMARK_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
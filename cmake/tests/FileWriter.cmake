@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: FileWriter.cmake - FileWriter class crash safety test build configuration
+# author: Karl-Mihkel Ott
+
+set(FILE_WRITER_TARGET FileWriterTest)
+set(FILE_WRITER_SOURCES tests/FileWriterTest.cpp)
+
+add_executable(${FILE_WRITER_TARGET} ${FILE_WRITER_SOURCES})
+target_link_libraries(${FILE_WRITER_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${FILE_WRITER_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: MeshOptimizer.cmake - MeshOptimizer class test build configuration
+# author: Karl-Mihkel Ott
+
+set(MESH_OPTIMIZER_TARGET MeshOptimizerTest)
+set(MESH_OPTIMIZER_SOURCES tests/MeshOptimizerTest.cpp)
+
+add_executable(${MESH_OPTIMIZER_TARGET} ${MESH_OPTIMIZER_SOURCES})
+target_link_libraries(${MESH_OPTIMIZER_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${MESH_OPTIMIZER_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
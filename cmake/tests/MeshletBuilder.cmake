@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: MeshletBuilder.cmake - MeshletBuilder class test build configuration
+# author: Karl-Mihkel Ott
+
+set(MESHLET_BUILDER_TARGET MeshletBuilderTest)
+set(MESHLET_BUILDER_SOURCES tests/MeshletBuilderTest.cpp)
+
+add_executable(${MESHLET_BUILDER_TARGET} ${MESHLET_BUILDER_SOURCES})
+target_link_libraries(${MESHLET_BUILDER_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${MESHLET_BUILDER_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: OutputSink.cmake - MemorySink and CallbackSink class test build configuration
+# author: Karl-Mihkel Ott
+
+set(OUTPUT_SINK_TARGET OutputSinkTest)
+set(OUTPUT_SINK_SOURCES tests/OutputSinkTest.cpp)
+
+add_executable(${OUTPUT_SINK_TARGET} ${OUTPUT_SINK_SOURCES})
+target_link_libraries(${OUTPUT_SINK_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${OUTPUT_SINK_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
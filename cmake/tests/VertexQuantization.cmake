@@ -0,0 +1,11 @@
+# libdas: DENG asset management library
+# licence: Apache, see LICENCE file
+# file: VertexQuantization.cmake - vertex attribute quantization functions test build configuration
+# author: Karl-Mihkel Ott
+
+set(VERTEX_QUANTIZATION_TARGET VertexQuantizationTest)
+set(VERTEX_QUANTIZATION_SOURCES tests/VertexQuantizationTest.cpp)
+
+add_executable(${VERTEX_QUANTIZATION_TARGET} ${VERTEX_QUANTIZATION_SOURCES})
+target_link_libraries(${VERTEX_QUANTIZATION_TARGET} PRIVATE ${LIBDAS_SHARED_TARGET})
+add_dependencies(${VERTEX_QUANTIZATION_TARGET} ${LIBDAS_SHARED_TARGET} ${LIBDAS_STATIC_TARGET})
@@ -9,6 +9,7 @@
 #ifdef DAS_TOOL_CPP
     #include <any>
     #include <array>
+    #include <algorithm>
     #include <variant>
     #include <map>
     #include <cfloat>
@@ -44,10 +45,20 @@
     #include "das/ErrorHandlers.h"
     #include "das/Hash.h"
     #include "das/DasStructures.h"
+    #include "das/BoundingVolumes.h"
+    #include "das/VertexQuantization.h"
+    #include "das/MeshOptimizer.h"
+    #include "das/MeshletBuilder.h"
+    #include "das/BvhBuilder.h"
+    #include "das/BufferDeduplicator.h"
     #include "das/TextureReader.h"
+    #include "das/OutputSink.h"
+    #include "das/FileWriter.h"
     #include "das/DasWriterCore.h"
+    #include "das/DasBlobStore.h"
     #include "das/DasReaderCore.h"
     #include "das/DasParser.h"
+    #include "das/DasTranscoder.h"
     #include "das/STLStructures.h"
     #include "das/STLParser.h"
     #include "das/STLCompiler.h"
@@ -78,13 +89,19 @@ typedef uint16_t FlagType;
 #define USAGE_FLAG_OUT_FILE         0x0020
 #define USAGE_FLAG_HELP             0x0040
 #define USAGE_FLAG_VERBOSE          0x0080
+#define USAGE_FLAG_QUANTIZE         0x0100
+#define USAGE_FLAG_OPTIMIZE         0x0200
+#define USAGE_FLAG_MESHLETS         0x0400
+#define USAGE_FLAG_BVH              0x0800
+#define USAGE_FLAG_DEDUPLICATE      0x1000
+#define USAGE_FLAG_BLOB_STORE       0x2000
 
 
 class DASTool {
     private:
         const std::string m_help_text =
             "DASTool version " + std::to_string(LIBDAS_VERSION_MAJOR) + "." + std::to_string(LIBDAS_VERSION_MINOR) + "." + std::to_string(LIBDAS_VERSION_REVISION) + "\n"\
-            "Usage: dastool convert|list|validate <input file> [output options]\n"\
+            "Usage: dastool convert|list|validate|compact <input file> [output options]\n"\
             "Valid conversion options:\n"\
             "--author \"<Author>\" - specify model author's name\n"\
             "--copyright \"<Message>\" - specify copyright message as an argument string\n"\
@@ -92,10 +109,19 @@ class DASTool {
             "--model \"<ModelName>\" - specify model name\n"\
             "-L / --lod <N%> - specify level of detail in percentage\n"\
             "-o / --output \"<OutFile>\" - specify output file name\n"\
+            "-q / --quantize - quantize vertex attributes of GLTF meshes\n"\
+            "-O / --optimize - reorder mesh triangles and vertices for GPU vertex cache efficiency\n"\
+            "-M / --meshlets - split mesh primitives into meshlets with bounding spheres and normal cones\n"\
+            "-B / --bvh - build bounding volume hierarchies over scene nodes of GLTF files\n"\
+            "-D / --deduplicate - store identical vertex attribute, index and meshlet data of GLTF and OBJ files once\n"\
+            "--blob-store \"<Directory>\" - keep large buffers in a content addressed blob store shared between files\n"\
             "-h / --help - display help text\n"\
             "Valid listing options:\n"\
             "-v / --verbose - output verbose message about the object\n"\
-            "-h / --help - display help text\n";
+            "--blob-store \"<Directory>\" - resolve buffers, that are kept in a blob store\n"\
+            "-h / --help - display help text\n"\
+            "Valid compaction options:\n"\
+            "-o / --output \"<OutFile>\" - specify output file name, the input file is replaced by default\n";
 
         FlagType m_flags = 0;
         uint32_t m_lod = 90;
@@ -106,12 +132,15 @@ class DASTool {
         std::vector<uint32_t> m_removed_textures;
         std::string m_model;
         std::string m_out_file;
+        std::string m_blob_store_path;
 
     private:
         ////////////////////////////////////
         // ***** Conversion methods ***** //
         ////////////////////////////////////
         
+        // LOD generation reads buffer regions, that may span several payload fragments
+        std::vector<char> _ReadBufferRegion(Libdas::DasBuffer &_buffer, uint32_t _offset, size_t _size);
         void _ConvertDAS(const std::string &_input_file);
         void _ConvertSTL(const std::string &_input_file);
         void _ConvertWavefrontObj(const std::string &_input_file);
@@ -130,7 +159,9 @@ class DASTool {
         void _ListGLB(const std::string &_input_file);
         void _ListDasProperties(const Libdas::DasProperties &_props);
         void _ListDasBuffers(Libdas::DasParser &_parser);
+        void _ListDasBoundingVolume(const Libdas::DasBoundingVolume &_bounds, const std::string &_prefix);
         void _ListDasMeshes(Libdas::DasParser &_parser);
+        void _ListDasVertexCacheStatistics(Libdas::DasParser &_parser, const Libdas::DasMeshPrimitive &_prim); // called from _ListDasMeshPrimitive()
         void _ListDasMeshPrimitive(Libdas::DasParser &_parser, uint32_t _rel_id, uint32_t _id); // called from _ListDasMeshes()
         void _ListDasMorphTarget(Libdas::DasParser &_parser, uint32_t _rel_id, uint32_t _id);   // called from _ListDasMeshPrimitive()
         void _ListDasSkeletons(Libdas::DasParser &_parser);
@@ -139,6 +170,7 @@ class DASTool {
         void _ListDasNodes(Libdas::DasParser &_parser);
         void _ListDasAnimationChannels(Libdas::DasParser &_parser);
         void _ListDasAnimations(Libdas::DasParser &_parser);
+        void _ListDasBvhs(Libdas::DasParser &_parser);
         void _ListDas(const std::string &_input_file);
 
         
@@ -147,6 +179,7 @@ class DASTool {
         void _MakeProps();
         void _ParseFlags(const std::vector<std::string> &_opts);
         void _ExcludeFlags(bool _is_convert);
+        std::shared_ptr<Libdas::DasBlobStore> _MakeBlobStore();
 
     public:
         /**
@@ -166,6 +199,12 @@ class DASTool {
          * @param _input_file specifies the input file used for reading
          */
         void Validate(const std::string &_input_file);
+        /**
+         * Rewrite a patched DAS file without replaced scopes
+         * @param _input_file specifies the input file used for reading
+         * @param _opts specifies output options
+         */
+        void Compact(const std::string &_input_file, const std::vector<std::string> &_opts);
         /**
          * Get DASTool help text
          */
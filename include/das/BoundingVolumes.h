@@ -0,0 +1,111 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: BoundingVolumes.h - bounding volume calculation functions header
+// author: Karl-Mihkel Ott
+
+#ifndef BOUNDING_VOLUMES_H
+#define BOUNDING_VOLUMES_H
+
+#ifdef BOUNDING_VOLUMES_CPP
+    #include <cstring>
+    #include <cfloat>
+    #include <cmath>
+    #include <string>
+    #include <vector>
+    #include <algorithm>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define LIBDAS_BOUNDS_SSE
+    #include <xmmintrin.h>
+#endif
+
+    #include "trs/Points.h"
+    #include "trs/Vector.h"
+    #include "trs/Matrix.h"
+    #include "trs/Quaternion.h"
+
+    #include "das/Api.h"
+    #include "das/LibdasAssert.h"
+    #include "das/RandomAccessFile.h"
+    #include "das/DasStructures.h"
+#endif
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace Libdas {
+
+    /**
+     * Functions for calculating axis aligned bounding boxes and bounding spheres of DAS mesh primitives, meshes and
+     * scenes. Position streams are scanned with SSE instructions when they are available.
+     */
+    namespace Bounds {
+
+        /**
+         * Create a bounding volume from known axis aligned bounding box extents without reading any positions, the
+         * bounding sphere encloses the whole box
+         * @param _min specifies the minimum corner of the bounding box
+         * @param _max specifies the maximum corner of the bounding box
+         * @return DasBoundingVolume object
+         */
+        LIBDAS_API DasBoundingVolume FromMinMax(const TRS::Point3D<float> &_min, const TRS::Point3D<float> &_max);
+        /**
+         * Calculate the bounding volume of a position stream, the bounding sphere is centered at the bounding box center
+         * @param _positions specifies the first position, each position consists of three floats
+         * @param _stride specifies the size of a single stream element in bytes, at least 12
+         * @param _count specifies the amount of positions in the stream
+         * @return DasBoundingVolume object, empty if the stream has no positions
+         */
+        LIBDAS_API DasBoundingVolume FindPositionBounds(const char *_positions, size_t _stride, uint32_t _count);
+        /**
+         * Calculate the bounding volume of positions, that are referenced by an index array
+         * @param _positions specifies the position array, that indices point to
+         * @param _vertex_count specifies the amount of positions in the array
+         * @param _indices specifies the index array
+         * @param _index_count specifies the amount of indices
+         * @return DasBoundingVolume object, empty if there are no indices
+         */
+        LIBDAS_API DasBoundingVolume FindIndexedPositionBounds(const TRS::Point3D<float> *_positions, uint32_t _vertex_count, const uint32_t *_indices, uint32_t _index_count);
+
+        /**
+         * Extend a bounding volume to enclose another bounding volume
+         * @param _dst specifies a reference to DasBoundingVolume object, that is extended
+         * @param _src specifies a reference to DasBoundingVolume object, that is enclosed
+         */
+        LIBDAS_API void Merge(DasBoundingVolume &_dst, const DasBoundingVolume &_src);
+        /**
+         * Transform a bounding volume, the resulting bounding box encloses the transformed box
+         * @param _bounds specifies a reference to DasBoundingVolume object in local space
+         * @param _transform specifies a row major transformation matrix, where translation is stored in the fourth column
+         * @return transformed DasBoundingVolume object
+         */
+        LIBDAS_API DasBoundingVolume Transform(const DasBoundingVolume &_bounds, const TRS::Matrix4<float> &_transform);
+
+        /**
+         * Find the union of all mesh primitive bounding volumes of a mesh
+         * @param _mesh specifies a reference to DasMesh object
+         * @param _primitives specifies all mesh primitives of the model
+         * @return DasBoundingVolume object in model space
+         */
+        LIBDAS_API DasBoundingVolume FindMeshBounds(const DasMesh &_mesh, const std::vector<DasMeshPrimitive> &_primitives);
+        /**
+         * Find world space bounding volumes of the meshes of all scene nodes, node transforms are propagated from scene
+         * roots down the hierarchy
+         * @param _scene specifies a reference to DasScene object
+         * @param _nodes specifies all nodes of the model
+         * @param _meshes specifies all meshes of the model, whose bounding volumes are already calculated
+         * @return std::vector instance indexed by node ids, nodes without meshes and nodes outside the scene have empty bounds
+         */
+        LIBDAS_API std::vector<DasBoundingVolume> FindNodeBounds(const DasScene &_scene, const std::vector<DasNode> &_nodes, const std::vector<DasMesh> &_meshes);
+        /**
+         * Find the union of all node bounding volumes of a scene in world space
+         * @param _scene specifies a reference to DasScene object
+         * @param _nodes specifies all nodes of the model
+         * @param _meshes specifies all meshes of the model, whose bounding volumes are already calculated
+         * @return DasBoundingVolume object in world space
+         */
+        LIBDAS_API DasBoundingVolume FindSceneBounds(const DasScene &_scene, const std::vector<DasNode> &_nodes, const std::vector<DasMesh> &_meshes);
+    }
+}
+
+#endif
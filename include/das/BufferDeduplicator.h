@@ -0,0 +1,87 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: BufferDeduplicator.h - content based buffer region deduplication class header
+// author: Karl-Mihkel Ott
+
+#ifndef BUFFER_DEDUPLICATOR_H
+#define BUFFER_DEDUPLICATOR_H
+
+#ifdef BUFFER_DEDUPLICATOR_CPP
+    #include <cstring>
+    #include <string>
+    #include <vector>
+    #include <memory>
+    #include <algorithm>
+    #include <unordered_map>
+
+    #include "trs/Points.h"
+    #include "trs/Vector.h"
+    #include "trs/Matrix.h"
+    #include "trs/Quaternion.h"
+
+    #include "das/Api.h"
+    #include "das/Hash.h"
+    #include "das/LibdasAssert.h"
+    #include "das/RandomAccessFile.h"
+    #include "das/DasStructures.h"
+#endif
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+
+namespace Libdas {
+
+    /**
+     * Find data regions with identical content, so that each unique region is stored once and referenced by offset
+     * from everywhere it is used. Regions are looked up by their 64 bit content hash and compared byte by byte
+     * before they are considered equal, thus hash collisions never merge different data.
+     */
+    class LIBDAS_API BufferDeduplicator {
+        private:
+            // region that is kept in the output, data must outlive the deduplicator
+            struct Region {
+                const char *data;
+                size_t len;
+                uint32_t offset;
+            };
+
+            std::unordered_map<uint64_t, std::vector<Region>> m_regions;
+            // original and deduplicated fragment offsets in ascending original offset order
+            std::vector<std::pair<uint32_t, uint32_t>> m_offsets;
+            size_t m_removed_size = 0;
+
+        public:
+            BufferDeduplicator() = default;
+
+            /**
+             * Find a previously inserted region with identical content, the region is inserted if none exists
+             * @param _data specifies the region data, that must stay valid for the lifetime of the deduplicator
+             * @param _len specifies the region length in bytes, empty regions are never deduplicated
+             * @param _offset specifies the offset, where the region is stored if it is unique
+             * @return offset of the identical region, _offset if the region was inserted
+             */
+            uint32_t FindOrInsert(const char *_data, size_t _len, uint32_t _offset);
+            /**
+             * Remove all buffer fragments, whose content is identical to some preceding fragment, remaining fragments
+             * are moved towards the beginning of the buffer. A single deduplicator instance handles a single buffer.
+             * @param _buffer specifies a reference to DasBuffer object, whose fragments are all kept in memory
+             */
+            void Deduplicate(DasBuffer &_buffer);
+            /**
+             * Find the offset of data in the buffer, that was passed to Deduplicate()
+             * @param _offset specifies the byte offset before deduplication
+             * @return byte offset of the same data after deduplication
+             */
+            uint32_t RemapOffset(uint32_t _offset) const;
+
+            ////////////////////////////////
+            // ***** Getter methods ***** //
+            ////////////////////////////////
+            inline size_t GetRemovedSize() const {
+                return m_removed_size;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,143 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: BvhBuilder.h - bounding volume hierarchy construction class header
+// author: Karl-Mihkel Ott
+
+#ifndef BVH_BUILDER_H
+#define BVH_BUILDER_H
+
+#ifdef BVH_BUILDER_CPP
+    #include <cstring>
+    #include <cfloat>
+    #include <cmath>
+    #include <string>
+    #include <vector>
+    #include <algorithm>
+    #include <atomic>
+    #include <thread>
+
+    #include "trs/Points.h"
+    #include "trs/Vector.h"
+    #include "trs/Matrix.h"
+    #include "trs/Quaternion.h"
+
+    #include "das/Api.h"
+    #include "das/LibdasAssert.h"
+    #include "das/RandomAccessFile.h"
+    #include "das/DasStructures.h"
+#endif
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// amount of bins that are used for evaluating the surface area heuristic along a single axis
+#define LIBDAS_BVH_BIN_COUNT            16
+// maximum amount of items that are stored in a single leaf node
+#define LIBDAS_BVH_MAX_LEAF_ITEMS       4
+// subtrees with at most this many items are built by a single task
+#define LIBDAS_BVH_TASK_ITEMS           4096
+
+namespace Libdas {
+
+    /**
+     * Build bounding volume hierarchies over axis aligned bounding boxes using the binned surface area heuristic.
+     * Upper levels of the hierarchy are split sequentially until subtrees are small enough, after which the subtrees
+     * are built in parallel. Every subtree works on its own item range, thus the output does not depend on the
+     * thread count.
+     */
+    class LIBDAS_API BvhBuilder {
+        private:
+            // item bounding box with precalculated centroid
+            struct ItemBox {
+                float min[3];
+                float max[3];
+                float centroid[3];
+            };
+
+            std::vector<ItemBox> m_boxes;
+            const uint32_t m_max_leaf_items;
+
+            std::vector<uint32_t> m_items;
+            std::vector<DasBvhNode> m_nodes;
+
+            // hierarchy node during construction, child indices are local to the partition
+            struct BuildNode {
+                float min[3];
+                float max[3];
+                uint32_t first = 0;
+                uint32_t count = 0;
+                uint32_t left = UINT32_MAX;
+                uint32_t right = UINT32_MAX;
+                // partition that builds the subtree of this node, UINT32_MAX if the subtree is built in place
+                uint32_t task = UINT32_MAX;
+            };
+
+            // subtree that is built by a single task, the first node is the subtree root
+            struct Partition {
+                uint32_t first = 0;
+                uint32_t count = 0;
+                std::vector<BuildNode> nodes;
+            };
+
+        private:
+            /**
+             * Calculate bounding box of item bounding boxes and the bounding box of item centroids in given range
+             * @param _node specifies a reference to BuildNode object, whose item range is used and bounds are written
+             * @param _cmin specifies the minimum corner of centroid bounds
+             * @param _cmax specifies the maximum corner of centroid bounds
+             */
+            void _CalculateBounds(BuildNode &_node, float *_cmin, float *_cmax) const;
+            /**
+             * Split an item range into two with binned surface area heuristic, items are reordered in place
+             * @param _node specifies a reference to BuildNode object, whose bounds are already calculated
+             * @param _cmin specifies the minimum corner of centroid bounds
+             * @param _cmax specifies the maximum corner of centroid bounds
+             * @return amount of items in the first half, zero if the node should stay a leaf
+             */
+            uint32_t _SplitItems(const BuildNode &_node, const float *_cmin, const float *_cmax);
+            /**
+             * Build a subtree over items in given range
+             * @param _partition specifies a reference to Partition object, whose item range is used and nodes are written
+             * @param _tasks specifies a pointer to std::vector, where new task partitions are pushed, nullptr to build
+             * the whole subtree in place
+             */
+            void _BuildPartition(Partition &_partition, std::vector<Partition> *_tasks);
+            /**
+             * Write all partition nodes in depth first order into the final node array
+             * @param _partitions specifies all partitions, where the first partition contains the hierarchy root
+             */
+            void _Flatten(const std::vector<Partition> &_partitions);
+
+        public:
+            /**
+             * @param _item_bounds specifies bounding volumes of all items, items with empty bounding volumes are skipped
+             * @param _max_leaf_items specifies the maximum amount of items per leaf node
+             */
+            BvhBuilder(const std::vector<DasBoundingVolume> &_item_bounds, uint32_t _max_leaf_items = LIBDAS_BVH_MAX_LEAF_ITEMS);
+
+            /**
+             * Build the bounding volume hierarchy
+             * @param _thread_count specifies the amount of threads to use, 0 to use all hardware threads
+             */
+            void Build(uint32_t _thread_count = 1);
+            /**
+             * Create a BVH scope from the built hierarchy
+             * @param _scene specifies the scene index, whose node bounding volumes were used as items
+             * @return DasBvh object, where leaf items are indices into the item bounding volume array
+             */
+            DasBvh CreateBvh(uint32_t _scene) const;
+
+            ////////////////////////////////
+            // ***** Getter methods ***** //
+            ////////////////////////////////
+            inline const std::vector<DasBvhNode> &GetNodes() const {
+                return m_nodes;
+            }
+
+            inline const std::vector<uint32_t> &GetItems() const {
+                return m_items;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,96 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasArena.h - monotonic memory arena class header
+// author: Karl-Mihkel Ott
+
+#ifndef DAS_ARENA_H
+#define DAS_ARENA_H
+
+#ifdef DAS_ARENA_CPP
+    #include <cstdlib>
+    #include <string>
+    #include <vector>
+    #include <iostream>
+    #include <algorithm>
+
+    #include "das/Api.h"
+    #include "das/ErrorHandlers.h"
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#define LIBDAS_ARENA_DEFAULT_BLOCK_SIZE     (64 * 1024)
+#define LIBDAS_ARENA_MAX_BLOCK_SIZE         (16 * 1024 * 1024)
+
+namespace Libdas {
+
+    /**
+     * Monotonic memory arena, that carves small arrays out of few large heap blocks. Single allocations are never
+     * freed, instead all memory is released at once when the arena is destroyed. Allocation is thread safe.
+     */
+    class LIBDAS_API DasArena {
+        private:
+            std::mutex m_mutex;
+            std::vector<char*> m_blocks;
+            char *m_ptr = nullptr;
+            char *m_end = nullptr;
+            size_t m_block_size;
+            size_t m_used = 0;
+
+        private:
+            /**
+             * Allocate a new block that is large enough to contain at least specified amount of bytes
+             * @param _len specifies the minimum amount of usable bytes in the block
+             */
+            void _NewBlock(size_t _len);
+            /**
+             * Carve an aligned memory area out of the current block
+             * @param _len specifies the memory area size in bytes
+             * @param _alignment specifies the memory area alignment, must be a power of two
+             * @return pointer to the memory area
+             */
+            char *_Allocate(size_t _len, size_t _alignment);
+
+        public:
+            /**
+             * @param _block_size specifies the size of the first block, every following block is twice as large
+             * until LIBDAS_ARENA_MAX_BLOCK_SIZE is reached
+             */
+            DasArena(size_t _block_size = LIBDAS_ARENA_DEFAULT_BLOCK_SIZE);
+            DasArena(const DasArena &_arena) = delete;
+            ~DasArena();
+
+            void operator=(const DasArena &_arena) = delete;
+
+            /**
+             * Allocate an uninitialised array from the arena
+             * @param _count specifies the element count of the array
+             * @return pointer to the array, nullptr if the element count is zero
+             */
+            template<typename T>
+            inline T *Allocate(size_t _count) {
+                if(!_count) return nullptr;
+                return reinterpret_cast<T*>(_Allocate(sizeof(T) * _count, alignof(T)));
+            }
+            /**
+             * Make sure that the following allocations of specified total size fit into a single block
+             * @param _len specifies the total size of following allocations in bytes
+             */
+            void Reserve(size_t _len);
+
+            ////////////////////////////////
+            // ***** Getter methods ***** //
+            ////////////////////////////////
+            inline size_t GetUsedSize() const {
+                return m_used;
+            }
+
+            inline size_t GetBlockCount() const {
+                return m_blocks.size();
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,129 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasBlobStore.h - content addressed external buffer data store class header
+// author: Karl-Mihkel Ott
+
+#ifndef DAS_BLOB_STORE_H
+#define DAS_BLOB_STORE_H
+
+#ifdef DAS_BLOB_STORE_CPP
+    #include <cstring>
+    #include <cstdio>
+    #include <string>
+    #include <vector>
+    #include <iostream>
+    #include <atomic>
+    #include <chrono>
+    #include <thread>
+    #include <filesystem>
+    #include <system_error>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <cerrno>
+    #include <unistd.h>
+#endif
+
+    #include "trs/Points.h"
+    #include "trs/Vector.h"
+    #include "trs/Matrix.h"
+    #include "trs/Quaternion.h"
+
+    #include "das/Api.h"
+    #include "das/ErrorHandlers.h"
+    #include "das/Hash.h"
+    #include "das/OutputSink.h"
+    #include "das/FileWriter.h"
+    #include "das/MappedFile.h"
+    #include "das/RandomAccessFile.h"
+    #include "das/DasStructures.h"
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/// Smallest buffer payload size in bytes, that is moved into the blob store by default
+#define LIBDAS_BLOB_STORE_MIN_SIZE      4096
+
+namespace Libdas {
+
+    class MappedFile;
+    struct DasBuffer;
+
+    /**
+     * Content addressed store for buffer payloads, that are shared between multiple DAS files. Every payload is kept
+     * once in its own blob file named after the 64 bit hash of its content, thus assets that embed identical textures
+     * or meshes reference the same blob instead of each carrying a copy. Blob files are memory mapped on demand and
+     * all buffers referencing the same blob share a single reference counted mapping, which is unmapped once the last
+     * buffer referencing it is released. Blob data must be treated as read-only, since it is shared between buffers.
+     * Storing and acquiring blobs is thread safe.
+     */
+    class LIBDAS_API DasBlobStore {
+        private:
+            std::string m_root_path;
+            std::mutex m_mutex;
+            // mappings are cached only while some buffer still references them
+            std::unordered_map<uint64_t, std::weak_ptr<MappedFile>> m_cache;
+
+        private:
+            /**
+             * Find the file name of a blob, blobs are spread into subdirectories by the first byte of their hash
+             * @param _hash specifies the content hash of the blob
+             * @return blob file name
+             */
+            std::string _GetBlobPath(uint64_t _hash) const;
+            /**
+             * Move a staged blob file into the store without replacing an already existing blob
+             * @param _src specifies the staged blob file name
+             * @param _dst specifies the blob file name in the store
+             * @param _exists is set to true if publishing failed because the blob already exists
+             * @return true if the blob was published, false otherwise
+             */
+            bool _Publish(const std::string &_src, const std::string &_dst, bool &_exists);
+
+        public:
+            /**
+             * @param _root_path specifies the root directory of the store, which is created once the first blob is stored
+             */
+            DasBlobStore(const std::string &_root_path);
+            DasBlobStore(const DasBlobStore &_store) = delete;
+
+            void operator=(const DasBlobStore &_store) = delete;
+
+            /**
+             * Store data as a blob, if no blob with identical content exists yet. Existing blobs are compared byte by
+             * byte, thus a hash collision never makes a reference point to different data.
+             * @param _data specifies a pointer to the data
+             * @param _len specifies the length of the data in bytes
+             * @return nonzero blob hash if the data is available from the store, 0 if the data could not be stored and
+             * must be embedded instead
+             */
+            uint64_t Store(const char *_data, size_t _len);
+            /**
+             * Map a blob into memory, blobs that are already mapped are shared
+             * @param _hash specifies the content hash of the blob
+             * @param _len specifies the expected blob length in bytes
+             * @return shared pointer to the blob mapping, nullptr if the blob does not exist or its length differs
+             */
+            std::shared_ptr<MappedFile> Acquire(uint64_t _hash, size_t _len);
+            /**
+             * Point buffer data to the blob it references, buffers with embedded data are left as they are
+             * @param _buffer specifies a reference to DasBuffer object, whose blob hash and data length are used
+             * @return true if buffer data is available, false if the referenced blob could not be acquired
+             */
+            bool Resolve(DasBuffer &_buffer);
+
+            ////////////////////////////////
+            // ***** Getter methods ***** //
+            ////////////////////////////////
+            inline const std::string &GetRootPath() const {
+                return m_root_path;
+            }
+    };
+}
+
+#endif
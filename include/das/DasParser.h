@@ -8,12 +8,16 @@
 
 #ifdef DAS_PARSER_CPP
     #include <any>
+    #include <atomic>
+    #include <thread>
+    #include <algorithm>
     #include <fstream>
     #include <vector>
     #include <string>
     #include <cstring>
     #include <cmath>
     #include <iostream>
+    #include <memory>
     #include <unordered_map>
 
     #include "trs/Vector.h"
@@ -28,22 +32,144 @@
     #include "das/LibdasAssert.h"
     #include "das/ErrorHandlers.h"
     #include "das/DasStructures.h"
+    #include "das/DasArena.h"
+    #include "das/DasBlobStore.h"
+    #include "das/MappedFile.h"
+    #include "das/RandomAccessFile.h"
     #include "das/DasReaderCore.h"
 #endif
+#include <functional>
+#include <future>
+
+/// Scope type masks for selecting which scopes should be parsed
+typedef uint32_t DasScopeMask;
+#define LIBDAS_DAS_SCOPE_MASK(type)     (static_cast<DasScopeMask>(1) << (type))
+#define LIBDAS_DAS_SCOPE_MASK_ALL       UINT32_MAX
 
 namespace Libdas {
 
+    class DasBlobStore;
+
+    /**
+     * Callbacks that are invoked on the parsing thread as soon as a scope is decoded. Scope references are valid only 
+     * during the callback, but all scopes are stored in the model as well. Every callback is optional.
+     */
+    struct DasParseCallbacks {
+        std::function<void(const DasBuffer&, uint32_t)> on_buffer;
+        std::function<void(const DasMeshPrimitive&, uint32_t)> on_mesh_primitive;
+        std::function<void(const DasMesh&, uint32_t)> on_mesh;
+        std::function<void(const DasNode&, uint32_t)> on_node;
+        // bytes processed so far and the total amount of bytes to process, reported only for memory mapped files,
+        // files with a table of contents count only the scopes that are selected by the scope mask
+        std::function<void(uint64_t, uint64_t)> on_progress;
+    };
+
+
     class LIBDAS_API DasParser : private DasReaderCore {
         private:
             DasModel m_model;
+            uint32_t m_thread_count = 1;
+            // store, where buffers referencing external blobs are resolved from
+            std::shared_ptr<DasBlobStore> m_blob_store;
+
+            // streaming parse state
+            DasParseCallbacks m_callbacks;
+            bool m_use_callbacks = false;
+            uint64_t m_bytes_read = 0;
+            uint64_t m_progress_total = 0;
+
+            // scope override that applies to the next sequentially read scope of patched files
+            DasScopeOverride m_override;
+
+            // contiguous range of same typed scopes, that is decoded by a single thread at once
+            struct ScopeRange {
+                DasScopeType type;
+                uint32_t beg;
+                uint32_t end;
+                size_t model_offset;
+            };
 
         private:
             /**
-             * Cast scope stored in std::any object into real scope value
-             * @param _any_scope is any reference object that will be casted into correct data type
-             * @param _type is specified scope type 
+             * Read scope values directly into a new element of given scope vector. Scopes that are preceded by an 
+             * override scope replace the overridden element instead.
+             * @param _scopes specifies a reference to the model's scope vector
+             * @param _type specifies the scope type
+             * @param _discard specifies if the read scope should be thrown away instead
+             */
+            template<typename T>
+            inline void _ReadScopeInto(std::vector<T> &_scopes, DasScopeType _type, bool _discard) {
+                if(_discard) {
+                    T scope;
+                    ReadScope(scope);
+                } else if(m_override.type == _type && m_override.index < _scopes.size()) {
+                    _scopes[m_override.index] = T();
+                    ReadScope(_scopes[m_override.index]);
+                } else {
+                    ReadScope(_scopes.emplace_back());
+                }
+            }
+            /**
+             * Pass the most recently decoded scope of given scope vector to a callback
+             * @param _callback specifies the callback, that is invoked if set
+             * @param _scopes specifies a reference to the model's scope vector
+             * @param _type specifies the scope type
              */
-            void _DataCast(std::any &_any_scope, DasScopeType _type);
+            template<typename T>
+            inline void _EmitScopeFrom(const std::function<void(const T&, uint32_t)> &_callback, const std::vector<T> &_scopes, DasScopeType _type) {
+                if(!_callback)
+                    return;
+
+                const size_t index = m_override.type == _type && m_override.index < _scopes.size() ? m_override.index : _scopes.size() - 1;
+                _callback(_scopes[index], static_cast<uint32_t>(index));
+            }
+            /**
+             * Read current scope into the model with statically dispatched decoding
+             * @param _type specifies the scope type, whose declaration was just parsed
+             * @param _discard specifies if the read scope should be thrown away instead of storing it in the model
+             */
+            void _ReadScope(DasScopeType _type, bool _discard);
+            /**
+             * Pass the most recently decoded scope to its callback
+             * @param _type specifies the decoded scope type
+             */
+            void _EmitScope(DasScopeType _type);
+            /**
+             * Report parsing progress, if a progress callback is set and the file is memory mapped
+             * @param _bytes_read specifies the amount of bytes processed so far
+             */
+            void _ReportProgress(uint64_t _bytes_read);
+            /**
+             * Find the size of every scope listed in the table of contents, scopes extend up to the following scope
+             * @param _toc specifies a reference to DasTableOfContents object
+             * @return scope sizes in bytes in the same order as the table of contents scope offsets
+             */
+            std::vector<uint64_t> _FindScopeSizes(const DasTableOfContents &_toc);
+            /**
+             * Read current scope into an existing element of given model's scope vector
+             * @param _model specifies a reference to the model, where the scope is stored
+             * @param _type specifies the scope type, whose declaration was just parsed
+             * @param _index specifies the element index in model's scope vector
+             */
+            void _ReadScopeAt(DasModel &_model, DasScopeType _type, size_t _index);
+            /**
+             * Decode all masked scopes on multiple threads using the table of contents. Model scope vectors are
+             * resized beforehand, thus every thread decodes directly into its own elements in file order.
+             * @param _toc specifies a reference to DasTableOfContents object
+             * @param _mask specifies which scope types should be parsed into the model
+             */
+            void _ParseParallel(const DasTableOfContents &_toc, DasScopeMask _mask);
+            /**
+             * Reserve memory for all model scopes according to the table of contents
+             * @param _toc specifies a reference to DasTableOfContents object
+             */
+            void _ReserveScopes(const DasTableOfContents &_toc);
+            /**
+             * Point buffer data to the blob it references, buffers that are already resolved or contain embedded
+             * data are left as they are
+             * @param _buffer specifies a reference to DasBuffer object
+             */
+            void _ResolveBlob(DasBuffer &_buffer);
 
             /**
              * Find root nodes from given scene
@@ -52,22 +178,62 @@ namespace Libdas {
             void _FindSceneNodeRoots(DasScene &_scene);
 
         public:
-            DasParser(const std::string &_file_name = "");
+            /**
+             * @param _file_name specifies the DAS file to parse
+             * @param _use_mapping specifies whether the file should be memory mapped, in which case buffer data is never
+             * copied and all DasBuffer data pointers point directly into the mapping. The mapping is kept alive by the
+             * parsed model, until its buffers are deleted.
+             * @param _lazy_buffers specifies whether buffer payloads should be left unread, in which case payloads are
+             * read from the file on first DasBuffer::GetData() call. The file mapping is then used only while parsing.
+             */
+            DasParser(const std::string &_file_name = "", bool _use_mapping = false, bool _lazy_buffers = false);
+            /**
+             * @param _image specifies an in-memory DAS image to parse, see DasReaderCore::NewImage()
+             */
+            DasParser(std::vector<char> &&_image);
             DasParser(DasParser &&_parser) noexcept;
 
             /**
              * Parse contents from provided DAS file into scene array.
              * If the file contains no scenes, a default scene will be created that should be considered as a
              * object library.
+             * DAS v2 files that are memory mapped are parsed using their table of contents, which allows to seek 
+             * directly to requested scopes and skip everything else. Such files are decoded on multiple threads if
+             * the thread count is set to be larger than one.
              * @param _clean_read is an optional argument when set to true, closes the file stream currently used
              * @param _file_name is an optional argument that specifies new file to use
+             * @param _mask is an optional argument that specifies which scope types should be parsed into the model
+             */
+            void Parse(bool _clean_read = false, const std::string &_file_name = "", DasScopeMask _mask = LIBDAS_DAS_SCOPE_MASK_ALL);
+            /**
+             * Parse contents from provided DAS file on a background thread, while emitting decoded scopes through
+             * callbacks. Scopes of files without a table of contents are emitted in file order, scopes of files with a
+             * table of contents are emitted grouped by scope type in table of contents order. The model must not be 
+             * accessed before the returned future is ready.
+             * @param _callbacks specifies callbacks, that are invoked on the parsing thread
+             * @param _file_name is an optional argument that specifies new file to use
+             * @param _mask is an optional argument that specifies which scope types should be parsed into the model
+             * @return std::future instance, that becomes ready once the whole file is parsed
              */
-            void Parse(bool _clean_read = false, const std::string &_file_name = "");
+            std::future<void> ParseAsync(const DasParseCallbacks &_callbacks, const std::string &_file_name = "", 
+                                         DasScopeMask _mask = LIBDAS_DAS_SCOPE_MASK_ALL);
             /**
              * Delete all heap allocated buffer data. Call this when all mesh primitives are copied into video memory.
              */
             void DeleteBuffers();
 
+            /**
+             * Set the amount of threads used for parsing files with a table of contents
+             * @param _thread_count specifies the thread count, zero uses all available hardware threads
+             */
+            void SetThreadCount(uint32_t _thread_count);
+            /**
+             * Set the blob store, where buffer payloads that are kept outside of the file are resolved from. Resolved
+             * buffers share read-only mappings of their blobs. Without a blob store such buffers are left without data.
+             * @param _store specifies the blob store to use
+             */
+            void SetBlobStore(const std::shared_ptr<DasBlobStore> &_store);
+
             ////////////////////////////////
             // ***** Getter methods ***** //
             ////////////////////////////////
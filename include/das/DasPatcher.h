@@ -0,0 +1,158 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasPatcher.h - incremental DAS file patching class header
+// author: Karl-Mihkel Ott
+
+#ifndef DAS_PATCHER_H
+#define DAS_PATCHER_H
+
+#ifdef DAS_PATCHER_CPP
+    #include <any>
+    #include <cstring>
+    #include <string>
+    #include <vector>
+    #include <fstream>
+    #include <iostream>
+    #include <memory>
+    #include <unordered_map>
+
+    #include "trs/Iterators.h"
+    #include "trs/Vector.h"
+    #include "trs/Matrix.h"
+    #include "trs/Points.h"
+    #include "trs/Quaternion.h"
+
+    #include "mar/AsciiStreamReader.h"
+    #include "mar/AsciiLineReader.h"
+
+    #include "das/Api.h"
+    #include "das/LibdasAssert.h"
+    #include "das/ErrorHandlers.h"
+    #include "das/DasStructures.h"
+    #include "das/DasArena.h"
+    #include "das/MappedFile.h"
+    #include "das/RandomAccessFile.h"
+    #include "das/OutputSink.h"
+    #include "das/FileWriter.h"
+    #include "das/TextureReader.h"
+    #include "das/DasWriterCore.h"
+    #include "das/DasReaderCore.h"
+#endif
+
+namespace Libdas {
+
+    /**
+     * Incremental updater for existing DAS v2 files. Replacement and new scopes are appended to the end of the file
+     * together with a new table of contents, thus the cost of a patch is proportional to the size of written scopes
+     * and the table of contents instead of the whole file. Replaced scopes are left in the file as dead data until
+     * the file is compacted with DasTranscoder. A failed patch is discarded and leaves the file unchanged.
+     */
+    class LIBDAS_API DasPatcher : private DasWriterCore {
+        private:
+            DasTableOfContents m_toc;
+
+        public:
+            /**
+             * Open an existing DAS v2 file with a table of contents for patching
+             * @param _file_name specifies the DAS file to patch
+             */
+            DasPatcher(const std::string &_file_name);
+
+            /**
+             * Replace an existing buffer
+             * @param _index specifies the index of the replaced buffer
+             * @param _buffer specifies a reference to the new DasBuffer object
+             * @param _alignment specifies the payload alignment, see DasWriterCore::WriteBuffer()
+             */
+            void ReplaceBuffer(uint32_t _index, const DasBuffer &_buffer, uint32_t _alignment = 0);
+            /**
+             * Replace an existing mesh primitive
+             * @param _index specifies the index of the replaced mesh primitive
+             * @param _primitive specifies a reference to the new DasMeshPrimitive object
+             */
+            void ReplaceMeshPrimitive(uint32_t _index, const DasMeshPrimitive &_primitive);
+            /**
+             * Replace an existing morph target
+             * @param _index specifies the index of the replaced morph target
+             * @param _morph_target specifies a reference to the new DasMorphTarget object
+             */
+            void ReplaceMorphTarget(uint32_t _index, const DasMorphTarget &_morph_target);
+            /**
+             * Replace an existing mesh
+             * @param _index specifies the index of the replaced mesh
+             * @param _mesh specifies a reference to the new DasMesh object
+             */
+            void ReplaceMesh(uint32_t _index, const DasMesh &_mesh);
+            /**
+             * Replace an existing node
+             * @param _index specifies the index of the replaced node
+             * @param _node specifies a reference to the new DasNode object
+             */
+            void ReplaceNode(uint32_t _index, const DasNode &_node);
+            /**
+             * Replace an existing scene
+             * @param _index specifies the index of the replaced scene
+             * @param _scene specifies a reference to the new DasScene object
+             */
+            void ReplaceScene(uint32_t _index, const DasScene &_scene);
+            /**
+             * Replace an existing skeleton
+             * @param _index specifies the index of the replaced skeleton
+             * @param _skeleton specifies a reference to the new DasSkeleton object
+             */
+            void ReplaceSkeleton(uint32_t _index, const DasSkeleton &_skeleton);
+            /**
+             * Replace an existing skeleton joint
+             * @param _index specifies the index of the replaced skeleton joint
+             * @param _joint specifies a reference to the new DasSkeletonJoint object
+             */
+            void ReplaceSkeletonJoint(uint32_t _index, const DasSkeletonJoint &_joint);
+            /**
+             * Replace an existing animation channel
+             * @param _index specifies the index of the replaced animation channel
+             * @param _channel specifies a reference to the new DasAnimationChannel object
+             */
+            void ReplaceAnimationChannel(uint32_t _index, const DasAnimationChannel &_channel);
+            /**
+             * Replace an existing animation
+             * @param _index specifies the index of the replaced animation
+             * @param _animation specifies a reference to the new DasAnimation object
+             */
+            void ReplaceAnimation(uint32_t _index, const DasAnimation &_animation);
+            /**
+             * Replace an existing bounding volume hierarchy
+             * @param _index specifies the index of the replaced bounding volume hierarchy
+             * @param _bvh specifies a reference to the new DasBvh object
+             */
+            void ReplaceBvh(uint32_t _index, const DasBvh &_bvh);
+
+            // new scopes are appended after all existing scopes of the same type
+            using DasWriterCore::WriteBuffer;
+            using DasWriterCore::WriteMeshPrimitive;
+            using DasWriterCore::WriteMorphTarget;
+            using DasWriterCore::WriteMesh;
+            using DasWriterCore::WriteNode;
+            using DasWriterCore::WriteScene;
+            using DasWriterCore::WriteSkeleton;
+            using DasWriterCore::WriteSkeletonJoint;
+            using DasWriterCore::WriteAnimationChannel;
+            using DasWriterCore::WriteAnimation;
+            using DasWriterCore::WriteBvh;
+
+            /**
+             * Write the new table of contents and commit the patch. This is done automatically on destruction.
+             */
+            inline void Close() {
+                CloseStream();
+            }
+
+            ////////////////////////////////
+            // ***** Getter methods ***** //
+            ////////////////////////////////
+            inline const DasTableOfContents &GetTableOfContents() const {
+                return m_toc;
+            }
+    };
+}
+
+#endif
@@ -13,11 +13,14 @@
     #include <climits>
     #include <cmath>
     #include <string>
+    #include <string_view>
+    #include <array>
     #include <fstream>
 #ifdef __DEBUG
     #include <iostream>
 #endif
     #include <vector>
+    #include <memory>
     #include <unordered_map>
     
     #include "trs/Iterators.h"
@@ -33,31 +36,16 @@
     #include "das/DasStructures.h"
     #include "das/LibdasAssert.h"
     #include "das/ErrorHandlers.h"
+    #include "das/MappedFile.h"
+    #include "das/RandomAccessFile.h"
+    #include "das/KeywordMatcher.h"
 #endif
+// scope arrays are allocated from the arena in an inline template
+#include "das/DasArena.h"
 
 
 namespace Libdas {
 
-    /**
-     * Enumeral values to specify all possible das scopes
-     */
-    enum DasScopeType {
-        LIBDAS_DAS_SCOPE_PROPERTIES,
-        LIBDAS_DAS_SCOPE_BUFFER,
-        LIBDAS_DAS_SCOPE_MESH_PRIMITIVE,
-        LIBDAS_DAS_SCOPE_MORPH_TARGET,
-        LIBDAS_DAS_SCOPE_MESH,
-        LIBDAS_DAS_SCOPE_NODE,
-        LIBDAS_DAS_SCOPE_SCENE,
-        LIBDAS_DAS_SCOPE_SKELETON_JOINT,
-        LIBDAS_DAS_SCOPE_SKELETON,
-        LIBDAS_DAS_SCOPE_ANIMATION,
-        LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL,
-        LIBDAS_DAS_SCOPE_UNDEFINED,
-        LIBDAS_DAS_SCOPE_END
-    };
-
-
     /**
      * Enumeral values to specify all unique value declaration types
      */
@@ -72,7 +60,9 @@ namespace Libdas {
         // BUFFER
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_BUFFER_TYPE,
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_DATA_LEN,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_DATA_PADDING,
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_DATA,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_BLOB_HASH,
 
         // MESH
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_PRIMITIVE_COUNT,
@@ -93,6 +83,14 @@ namespace Libdas {
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_MORPH_TARGET_COUNT,
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_MORPH_TARGETS,
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_MORPH_WEIGHTS,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_QUANTIZATION,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_POSITION_OFFSET,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_POSITION_SCALE,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_UV_OFFSET,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_UV_SCALE,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_MESHLET_BUFFER_ID,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_MESHLET_BUFFER_OFFSET,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_MESHLET_COUNT,
 
         // NODE
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_MESH,
@@ -128,6 +126,22 @@ namespace Libdas {
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_TANGENTS,
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_TARGET_VALUES,
 
+        // BVH
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCENE,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_BVH_NODE_COUNT,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_BVH_NODES,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_ITEM_COUNT,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_ITEMS,
+
+        // TOC
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_TYPE_COUNT,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_COUNTS,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_OFFSETS,
+
+        // OVERRIDE
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_TYPE,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_INDEX,
+
         // Not so unique value types, since these values can be present in multiple scopes
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_NAME,
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_TRANSFORM,
@@ -143,6 +157,7 @@ namespace Libdas {
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_VERTEX_TANGENT_BUFFER_OFFSET,
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHILDREN_COUNT,
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHILDREN,
+        LIBDAS_DAS_UNIQUE_VALUE_TYPE_BOUNDS,
 
         // reserved value
         LIBDAS_DAS_UNIQUE_VALUE_TYPE_UNKNOWN
@@ -157,26 +172,78 @@ namespace Libdas {
         private:
             BinaryFormatErrorHandler m_error;
 
-            // scope parsing maps
-            std::unordered_map<std::string, DasScopeType> m_scope_name_map;
-            std::unordered_map<std::string, DasUniqueValueType> m_unique_val_map;
             std::vector<char*> m_buffer_blobs;
+            DasHeader m_header;
+            DasTableOfContents m_toc;
+
+            // lazy buffer loading mode, where only payload offsets are recorded
+            bool m_lazy_buffers = false;
+            std::shared_ptr<RandomAccessFile> m_lazy_source;
+
+            // memory mapped reading mode, where buffer data is never copied
+            bool m_use_mapping = false;
+            std::shared_ptr<MappedFile> m_mapped_file;
+            char *m_map_ptr = nullptr;
+            char *m_map_end = nullptr;
+
+            // arena where scope arrays are allocated from, if set
+            std::shared_ptr<DasArena> m_arena;
 
         private:
             /**
-             * Create scope name value hashmap for efficient type lookup
+             * Get the unique value type from specified value string
+             * @param _value is a string value specifying the value declaration 
+             * @return DasUniqueValueType enumeral, that defines the unique value type
              */
-            void _CreateScopeNameMap();
+            DasUniqueValueType _FindUniqueValueType(std::string_view _value);
             /**
-             * Create scope value non-buffer types sizes' map
+             * Check if there is any unread data left in the current buffer chunk or mapping
+             * @return true if the read pointer has not reached the end of readable data, false otherwise
              */
-            void _CreateScopeValueTypeMap();
+            inline bool _IsReadable() {
+                if(m_mapped_file)
+                    return m_map_ptr < m_map_end;
+                return _GetReadPtr() < m_buffer + m_buffer_size;
+            }
             /**
-             * Get the unique value type from specified value string
-             * @param _value is a string value specifying the value declaration 
-             * @return DasUniqueValueType enumeral, that defines the unique value type
+             * Read the next whitespace separated declaration word
+             * @return std::string_view instance pointing to the declaration in read buffer, empty if no more data is available
              */
-            DasUniqueValueType _FindUniqueValueType(const std::string &_value);
+            std::string_view _ReadDeclaration();
+            /**
+             * Skip specified amount of bytes from the current read position
+             * @param _len specifies the amount of bytes to skip
+             * @return true if skipping was successful, false otherwise
+             */
+            bool _SkipBytes(size_t _len);
+            /**
+             * Read a quoted string value
+             * @return std::string instance containing the string value without quotes
+             */
+            std::string _ReadString();
+            /**
+             * Read a binary blob with specified length. In mapped reading mode the returned pointer points directly
+             * into the file mapping, otherwise a new heap allocated copy is created.
+             * @param _len specifies the length of the blob in bytes
+             * @return pointer to the blob data, nullptr if the blob could not be read
+             */
+            char *_ReadBlob(size_t _len);
+            /**
+             * Allocate a scope array either from the arena or from the heap. Arena allocated arrays clear the scope's
+             * _free_bit, thus all arrays of a single scope must be allocated the same way.
+             * @param _count specifies the array element count
+             * @param _free_bit specifies a reference to the scope's _free_bit
+             * @return pointer to the allocated array
+             */
+            template<typename T>
+            inline T *_AllocateArray(uint32_t _count, bool &_free_bit) {
+                if(m_arena) {
+                    _free_bit = false;
+                    return m_arena->Allocate<T>(_count);
+                }
+
+                return new T[_count];
+            }
 
             ////////////////////////////////////////////////
             // ***** Property value reading methods ***** //
@@ -188,6 +255,14 @@ namespace Libdas {
              */
             template<typename T>
             void _ReadSingleValue(T &_dst) {
+                if(m_mapped_file) {
+                    if(static_cast<size_t>(m_map_end - m_map_ptr) < sizeof(T))
+                        m_error.Error(LIBDAS_ERROR_INVALID_DATA_LENGTH);
+                    std::memcpy(&_dst, m_map_ptr, sizeof(T));
+                    m_map_ptr += sizeof(T);
+                    return;
+                }
+
                 uint64_t sbck = _VerifyRead(sizeof(T));
                 if(!sbck) {
                     _dst = *reinterpret_cast<T*>(_GetReadPtr());
@@ -201,14 +276,26 @@ namespace Libdas {
             }
 
             /**
-             * General template function for reading array values from a blob
+             * General template function for reading array values from a blob. The whole array is copied as a single
+             * contiguous span, thus chunk boundaries are handled only once per array.
              * @param _dst specifies the destination array pointer
              * @param _size specifies the array element count to read 
              */
             template<typename T>
             void _ReadArrayValues(T *_dst, uint32_t _size) {
-                for(uint32_t i = 0; i < _size; i++)
-                    _ReadSingleValue(_dst[i]);
+                const size_t len = static_cast<size_t>(_size) * sizeof(T);
+                if(!len) return;
+
+                if(m_mapped_file) {
+                    if(static_cast<size_t>(m_map_end - m_map_ptr) < len)
+                        m_error.Error(LIBDAS_ERROR_INVALID_DATA_LENGTH);
+                    std::memcpy(reinterpret_cast<char*>(_dst), m_map_ptr, len);
+                    m_map_ptr += len;
+                    return;
+                }
+
+                if(!_ExtractBlob(len, reinterpret_cast<char*>(_dst)))
+                    m_error.Error(LIBDAS_ERROR_INVALID_DATA_LENGTH);
             }
 
             /**
@@ -278,19 +365,46 @@ namespace Libdas {
              */
             void _ReadAnimationChannelValue(DasAnimationChannel *_channel, DasUniqueValueType _type);
             /**
-             * Call correct scope value data reader method according to the type specified
-             * @param _scope specifies any _scope value that is read
-             * @param _type specifies that scope type
-             * @param _value_type specifies the scope value type
-             * @param _val_str specifies the value string that was read
+             * Read bounding volume hierarchy scope value according to the specified value type
+             * @param _bvh is a valid pointer to DasBvh instance
+             * @param _type is a type value specifying the current value type
              */
-            void _ReadScopeValueDataCaller(std::any &_scope, DasScopeType _type, DasUniqueValueType _value_type);
+            void _ReadBvhValue(DasBvh *_bvh, DasUniqueValueType _type);
             /**
-             * Retrieve correct initialised scope structure in std::any format
-             * @param _type specifies the scope type
-             * @return std::any instance specifying the structure value
+             * Read table of contents scope value according to the specified value type
+             * @param _toc is a valid pointer to DasTableOfContents instance
+             * @param _type is a type value specifying the current value type
              */
-            inline std::any _GetAnyScopeStructure(DasScopeType _type);
+            void _ReadTableOfContentsValue(DasTableOfContents *_toc, DasUniqueValueType _type);
+            /**
+             * Discard table of contents with invalid scope counts. Mapped reading skips the rest of the file, since
+             * the extent of the table of contents is unknown, while streamed reading is aborted with an error.
+             * @param _toc is a valid pointer to DasTableOfContents instance, that is cleared
+             * @param _value specifies the name of the invalid value
+             */
+            void _RejectTableOfContents(DasTableOfContents *_toc, const std::string &_value);
+            /**
+             * Read scope override value according to the specified value type
+             * @param _override is a valid pointer to DasScopeOverride instance
+             * @param _type is a type value specifying the current value type
+             */
+            void _ReadScopeOverrideValue(DasScopeOverride *_override, DasUniqueValueType _type);
+
+            // scope value reader overloads for static dispatch in ReadScope()
+            inline void _ReadScopeValue(DasProperties &_props, DasUniqueValueType _type) { _ReadPropertiesValue(&_props, _type); }
+            inline void _ReadScopeValue(DasBuffer &_buffer, DasUniqueValueType _type) { _ReadBufferValue(&_buffer, _type); }
+            inline void _ReadScopeValue(DasMeshPrimitive &_primitive, DasUniqueValueType _type) { _ReadMeshPrimitiveValue(&_primitive, _type); }
+            inline void _ReadScopeValue(DasMorphTarget &_morph_target, DasUniqueValueType _type) { _ReadMorphTargetValue(&_morph_target, _type); }
+            inline void _ReadScopeValue(DasMesh &_mesh, DasUniqueValueType _type) { _ReadMeshValue(&_mesh, _type); }
+            inline void _ReadScopeValue(DasNode &_node, DasUniqueValueType _type) { _ReadNodeValue(&_node, _type); }
+            inline void _ReadScopeValue(DasScene &_scene, DasUniqueValueType _type) { _ReadSceneValue(&_scene, _type); }
+            inline void _ReadScopeValue(DasSkeletonJoint &_joint, DasUniqueValueType _type) { _ReadSkeletonJointValue(&_joint, _type); }
+            inline void _ReadScopeValue(DasSkeleton &_skeleton, DasUniqueValueType _type) { _ReadSkeletonValue(&_skeleton, _type); }
+            inline void _ReadScopeValue(DasAnimation &_animation, DasUniqueValueType _type) { _ReadAnimationValue(&_animation, _type); }
+            inline void _ReadScopeValue(DasAnimationChannel &_channel, DasUniqueValueType _type) { _ReadAnimationChannelValue(&_channel, _type); }
+            inline void _ReadScopeValue(DasBvh &_bvh, DasUniqueValueType _type) { _ReadBvhValue(&_bvh, _type); }
+            inline void _ReadScopeValue(DasTableOfContents &_toc, DasUniqueValueType _type) { _ReadTableOfContentsValue(&_toc, _type); }
+            inline void _ReadScopeValue(DasScopeOverride &_override, DasUniqueValueType _type) { _ReadScopeOverrideValue(&_override, _type); }
 
         protected:
             /**
@@ -299,30 +413,136 @@ namespace Libdas {
             inline void _ClearBlobs() {
                 m_buffer_blobs.clear();
             }
+            /**
+             * Open a new file for reading, either as a stream or as a memory mapping depending on the reader mode
+             * @param _file_name specifies the file name to open
+             */
+            void _OpenFile(const std::string &_file_name);
+            /**
+             * Get the memory mapping that is currently used for reading
+             * @return shared pointer to MappedFile instance, nullptr if mapped reading mode is not used
+             */
+            inline std::shared_ptr<MappedFile> _GetMappedFile() {
+                return m_mapped_file;
+            }
+            /**
+             * Get the current read position in the memory mapped file
+             * @return absolute file offset in bytes, zero if mapped reading mode is not used
+             */
+            uint64_t _GetReadOffset();
+            /**
+             * Check if buffer payloads are loaded lazily
+             * @return true if lazy buffer loading is used, false otherwise
+             */
+            inline bool _IsLazyBufferLoading() {
+                return m_lazy_buffers;
+            }
+            /**
+             * Share the file mapping, header and table of contents of another mapped reader, so that scopes can be
+             * read concurrently using separate read positions
+             * @param _reader specifies a reference to the reader whose file should be shared
+             */
+            void _ShareFile(const DasReaderCore &_reader);
+            /**
+             * Set the arena where all following scope arrays are allocated from
+             * @param _arena specifies a shared pointer to the DasArena instance, nullptr to allocate arrays from the heap
+             */
+            inline void _SetArena(const std::shared_ptr<DasArena> &_arena) {
+                m_arena = _arena;
+            }
 
         public:
-            DasReaderCore(const std::string &_file_name = "");
+            /**
+             * @param _file_name specifies the DAS file to read
+             * @param _use_mapping specifies whether the file should be memory mapped instead of read into chunks,
+             * in which case all buffer data pointers will point directly into the mapping
+             * @param _lazy_buffers specifies whether buffer payloads should be skipped and only their file offsets
+             * recorded, so that the payloads are read on demand with DasBuffer::GetData(). Implies memory mapped reading.
+             */
+            DasReaderCore(const std::string &_file_name = "", bool _use_mapping = false, bool _lazy_buffers = false);
             DasReaderCore(DasReaderCore &&_drc) noexcept;
             ~DasReaderCore();
             /**
-             * Read and verify file signature
+             * Read a DAS image from memory instead of a file, for instance one written with MemorySink. The image is 
+             * read the same way as a memory mapped file, thus buffer data pointers point directly into the image.
+             * @param _image specifies the image data, that is moved into the reader
+             */
+            void NewImage(std::vector<char> &&_image);
+            /**
+             * Read and verify file signature. DAS v2 files store their header in place of signature padding bytes.
              */
             void ReadSignature();
             /**
-             * Read scope values and return its instance
+             * Read the table of contents scope from DAS v2 file, without changing the current read position.
+             * Random access is only possible when the file is memory mapped.
+             * @return true if the table of contents was successfully read, false if there is none or its scope counts
+             * or offsets do not fit into the file
+             */
+            bool ReadTableOfContents();
+            /**
+             * Move the read position to the beginning of specified scope's data using the table of contents, 
+             * meaning that the scope declaration is already consumed. ReadTableOfContents() must have been called before.
+             * @param _type specifies the scope type
+             * @param _index specifies the index of the scope among the scopes of the same type
+             * @return true if the read position was moved, false if no such scope exists
+             */
+            bool SeekScope(DasScopeType _type, uint32_t _index);
+            /**
+             * Read all scope values directly into the given scope structure until the scope ends.
+             * The scope declaration must be parsed beforehand with ParseScopeDeclaration().
+             * @param _scope specifies a reference to the scope structure, where all values are read into
+             */
+            template<typename T>
+            void ReadScope(T &_scope) {
+                do {
+                    std::string_view val_decl = _ReadDeclaration();
+
+                    // no more data available
+                    if(val_decl.empty())
+                        m_error.Error(LIBDAS_ERROR_INCOMPLETE_SCOPE);
+
+                    // only non-value statement in scope can be "ENDSCOPE"
+                    if(val_decl.back() != ':') {
+                        if(val_decl == "ENDSCOPE")
+                            break;
+                        m_error.Error(LIBDAS_ERROR_INVALID_DATA_LENGTH);
+                    }
+
+                    // the declaration view points into the current chunk, which skipping can reload
+                    const DasUniqueValueType type = _FindUniqueValueType(val_decl.substr(0, val_decl.size() - 1));
+
+                    // skip the whitespace following the declaration
+                    _SkipBytes(1);
+                    _ReadScopeValue(_scope, type);
+                } while(_IsReadable());
+            }
+            /**
+             * Read scope values and return its instance. Prefer ReadScope() when the scope type is known at compile time.
              * @param _type specifies the current scope type
-             * @return DasProperties value defining the properties for given file
+             * @return std::any instance containing the scope structure
              */
             std::any ReadScopeData(DasScopeType _type);
             /**
              * Read new scope declaration and return its enumeral value
+             * @param _scope_str is an optional argument specifying already read scope declaration
              * @return DasScopeType value that specifies currently parsed scope
              */
-            DasScopeType ParseScopeDeclaration(const std::string &_scope_str = "");
+            DasScopeType ParseScopeDeclaration(std::string_view _scope_str = std::string_view());
             /**
-             * Close the file stream and delete heap allocated maps
+             * Close the file stream or release the file mapping
              */
             void Clear();
+
+            ////////////////////////////////
+            // ***** Getter methods ***** //
+            ////////////////////////////////
+            inline const DasHeader &GetHeader() const {
+                return m_header;
+            }
+
+            inline const DasTableOfContents &GetTableOfContents() const {
+                return m_toc;
+            }
     };
 }
 
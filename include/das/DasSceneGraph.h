@@ -0,0 +1,168 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasSceneGraph.h - structure of arrays scene graph view class header
+// author: Karl-Mihkel Ott
+
+#ifndef DAS_SCENE_GRAPH_H
+#define DAS_SCENE_GRAPH_H
+
+#ifdef DAS_SCENE_GRAPH_CPP
+    #include <cstdint>
+    #include <cstring>
+    #include <cmath>
+    #include <string>
+    #include <vector>
+    #include <unordered_map>
+    #include <memory>
+
+    #include "trs/Points.h"
+    #include "trs/Vector.h"
+    #include "trs/Matrix.h"
+    #include "trs/Quaternion.h"
+
+    #include "das/Api.h"
+    #include "das/LibdasAssert.h"
+    #include "das/DasStructures.h"
+#endif
+
+namespace Libdas {
+
+    /**
+     * Cache friendly structure of arrays view of a single DasScene hierarchy. Nodes are stored in breadth first order,
+     * thus every parent precedes its children and world transforms can be computed with a single linear sweep.
+     * The view is derived data, it must be rebuilt when the model's node hierarchy changes.
+     */
+    class LIBDAS_API DasSceneGraph {
+        private:
+            // model node index of every graph node
+            std::vector<uint32_t> m_node_ids;
+            // graph node index of every model node, UINT32_MAX if the node is not part of the scene
+            std::vector<uint32_t> m_graph_ids;
+
+            // hierarchy as graph node indices, UINT32_MAX marks a missing relation
+            std::vector<uint32_t> m_parents;
+            std::vector<uint32_t> m_first_children;
+            std::vector<uint32_t> m_next_siblings;
+            // graph node indices where each hierarchy level begins, with the node count as the last element
+            std::vector<uint32_t> m_level_offsets;
+
+            std::vector<uint32_t> m_meshes;
+            std::vector<uint32_t> m_skeletons;
+
+            std::vector<TRS::Matrix4<float>> m_local_transforms;
+            std::vector<TRS::Matrix4<float>> m_world_transforms;
+
+            // interned node names, nodes with equal names share the same name id
+            std::vector<uint32_t> m_name_ids;
+            std::vector<std::string> m_names;
+
+        private:
+            /**
+             * Find all nodes in given scene, that are not children of any other scene node
+             * @param _model specifies a reference to the DasModel object
+             * @param _scene specifies a reference to the DasScene object
+             * @return std::vector instance containing root node ids
+             */
+            std::vector<uint32_t> _FindRoots(const DasModel &_model, const DasScene &_scene);
+            /**
+             * Append a new model node into the graph
+             * @param _model specifies a reference to the DasModel object
+             * @param _node_id specifies the model node index
+             * @param _parent specifies the parent graph node index, UINT32_MAX for root nodes
+             * @param _names specifies a reference to the name interning table
+             */
+            void _AppendNode(const DasModel &_model, uint32_t _node_id, uint32_t _parent, std::unordered_map<std::string, uint32_t> &_names);
+
+        public:
+            DasSceneGraph() = default;
+            /**
+             * Build a scene graph view from specified model scene
+             * @param _model specifies a reference to the DasModel object
+             * @param _scene_id specifies the scene index in model's scene array
+             */
+            DasSceneGraph(const DasModel &_model, uint32_t _scene_id);
+            /**
+             * Rebuild the scene graph view from specified model scene
+             * @param _model specifies a reference to the DasModel object
+             * @param _scene_id specifies the scene index in model's scene array
+             */
+            void Build(const DasModel &_model, uint32_t _scene_id);
+            /**
+             * Propagate local transforms down the hierarchy into world transforms
+             */
+            void UpdateWorldTransforms();
+            /**
+             * Update the local transform of a single graph node, world transforms are updated with UpdateWorldTransforms()
+             * @param _graph_id specifies the graph node index
+             * @param _transform specifies a new local transformation matrix
+             */
+            inline void SetLocalTransform(uint32_t _graph_id, const TRS::Matrix4<float> &_transform) {
+                m_local_transforms[_graph_id] = _transform;
+            }
+            /**
+             * Get the graph node index of a model node
+             * @param _node_id specifies the model node index
+             * @return graph node index, UINT32_MAX if the node is not a part of the scene
+             */
+            inline uint32_t FindGraphNode(uint32_t _node_id) const {
+                return _node_id < m_graph_ids.size() ? m_graph_ids[_node_id] : UINT32_MAX;
+            }
+
+            ////////////////////////////////
+            // ***** Getter methods ***** //
+            ////////////////////////////////
+            inline size_t GetNodeCount() const {
+                return m_node_ids.size();
+            }
+
+            inline const std::vector<uint32_t> &GetNodeIds() const {
+                return m_node_ids;
+            }
+
+            inline const std::vector<uint32_t> &GetParents() const {
+                return m_parents;
+            }
+
+            inline const std::vector<uint32_t> &GetFirstChildren() const {
+                return m_first_children;
+            }
+
+            inline const std::vector<uint32_t> &GetNextSiblings() const {
+                return m_next_siblings;
+            }
+
+            inline const std::vector<uint32_t> &GetLevelOffsets() const {
+                return m_level_offsets;
+            }
+
+            inline const std::vector<uint32_t> &GetMeshes() const {
+                return m_meshes;
+            }
+
+            inline const std::vector<uint32_t> &GetSkeletons() const {
+                return m_skeletons;
+            }
+
+            inline const std::vector<TRS::Matrix4<float>> &GetLocalTransforms() const {
+                return m_local_transforms;
+            }
+
+            inline const std::vector<TRS::Matrix4<float>> &GetWorldTransforms() const {
+                return m_world_transforms;
+            }
+
+            inline const std::vector<uint32_t> &GetNameIds() const {
+                return m_name_ids;
+            }
+
+            inline const std::string &GetName(uint32_t _graph_id) const {
+                return m_names[m_name_ids[_graph_id]];
+            }
+
+            inline const std::vector<std::string> &GetNames() const {
+                return m_names;
+            }
+    };
+}
+
+#endif
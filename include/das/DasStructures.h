@@ -8,6 +8,7 @@
 
 #ifdef DAS_STRUCTURES_CPP
     #include <cstdint>
+    #include <cstdlib>
     #include <cstring>
     #include <cmath>
 #ifdef __DEBUG
@@ -20,12 +21,20 @@
     #include "trs/Vector.h"
     #include "trs/Matrix.h"
     #include "trs/Quaternion.h"
+
+    #include "das/Api.h"
+    #include "das/RandomAccessFile.h"
 #endif
+#include <memory>
 
 // file constant definitions
 #define LIBDAS_DAS_MAGIC                0x00534144
 #define LIBDAS_DAS_DEFAULT_AUTHOR       "DENG project v 1.0"
 
+/// DAS format versions, version 1 files have only padding bytes in their signature
+#define LIBDAS_DAS_VERSION_1            1
+#define LIBDAS_DAS_VERSION_2            2
+
 /// Buffer type definitions
 typedef uint16_t BufferType;
 #define LIBDAS_BUFFER_TYPE_UNKNOWN                  ((BufferType) 0x0000)
@@ -43,12 +52,40 @@ typedef uint16_t BufferType;
 #define LIBDAS_BUFFER_TYPE_TEXTURE_BMP              ((BufferType) 0x0800)
 #define LIBDAS_BUFFER_TYPE_TEXTURE_PPM              ((BufferType) 0x1000)
 #define LIBDAS_BUFFER_TYPE_TEXTURE_RAW              ((BufferType) 0x2000)
+#define LIBDAS_BUFFER_TYPE_QUANTIZED                ((BufferType) 0x4000)
+#define LIBDAS_BUFFER_TYPE_MESHLET                  ((BufferType) 0x8000)
 
 #define LIBDAS_BUFFER_TYPE_TEXTURE                  (LIBDAS_BUFFER_TYPE_TEXTURE_JPEG | LIBDAS_BUFFER_TYPE_TEXTURE_PNG |\
                                                      LIBDAS_BUFFER_TYPE_TEXTURE_TGA | LIBDAS_BUFFER_TYPE_TEXTURE_BMP |\
                                                      LIBDAS_BUFFER_TYPE_TEXTURE_PPM | LIBDAS_BUFFER_TYPE_TEXTURE_RAW)
 
 
+/// Vertex attribute quantization definitions, see DasMeshPrimitive::quantization
+typedef uint8_t VertexQuantization;
+#define LIBDAS_QUANTIZATION_NONE                    ((VertexQuantization) 0x00)
+// unorm16 x4 positions relative to the primitive bounding box, fourth component is padding
+#define LIBDAS_QUANTIZATION_POSITION                ((VertexQuantization) 0x01)
+// snorm16 x2 octahedral normals
+#define LIBDAS_QUANTIZATION_NORMAL                  ((VertexQuantization) 0x02)
+// snorm16 x4 tangents, where first two components are octahedral direction and third is the bitangent sign
+#define LIBDAS_QUANTIZATION_TANGENT                 ((VertexQuantization) 0x04)
+// unorm16 x2 texture coordinates relative to the coordinate range of all primitive uv sets
+#define LIBDAS_QUANTIZATION_UV                      ((VertexQuantization) 0x08)
+// unorm8 x4 joint weights, that always sum up to 255
+#define LIBDAS_QUANTIZATION_JOINT_WEIGHTS           ((VertexQuantization) 0x10)
+
+#define LIBDAS_QUANTIZATION_ALL                     (LIBDAS_QUANTIZATION_POSITION | LIBDAS_QUANTIZATION_NORMAL |\
+                                                     LIBDAS_QUANTIZATION_TANGENT | LIBDAS_QUANTIZATION_UV |\
+                                                     LIBDAS_QUANTIZATION_JOINT_WEIGHTS)
+
+/// Sizes of single quantized vertex attribute values in bytes
+#define LIBDAS_QUANTIZED_POSITION_SIZE              8
+#define LIBDAS_QUANTIZED_NORMAL_SIZE                4
+#define LIBDAS_QUANTIZED_TANGENT_SIZE               8
+#define LIBDAS_QUANTIZED_UV_SIZE                    4
+#define LIBDAS_QUANTIZED_JOINT_WEIGHTS_SIZE         4
+
+
 /// Animation interpolation technique definitions 
 typedef uint8_t InterpolationType;
 #define LIBDAS_INTERPOLATION_VALUE_LINEAR       0
@@ -67,11 +104,108 @@ typedef uint8_t AnimationTarget;
 #ifndef LIBDAS_DEFS_ONLY
 namespace Libdas {
 
+    class DasArena;
+    class MappedFile;
+    class RandomAccessFile;
+
+    /**
+     * Enumeral values to specify all possible das scopes
+     */
+    enum DasScopeType {
+        LIBDAS_DAS_SCOPE_PROPERTIES,
+        LIBDAS_DAS_SCOPE_BUFFER,
+        LIBDAS_DAS_SCOPE_MESH_PRIMITIVE,
+        LIBDAS_DAS_SCOPE_MORPH_TARGET,
+        LIBDAS_DAS_SCOPE_MESH,
+        LIBDAS_DAS_SCOPE_NODE,
+        LIBDAS_DAS_SCOPE_SCENE,
+        LIBDAS_DAS_SCOPE_SKELETON_JOINT,
+        LIBDAS_DAS_SCOPE_SKELETON,
+        LIBDAS_DAS_SCOPE_ANIMATION,
+        LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL,
+        LIBDAS_DAS_SCOPE_BVH,
+        LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS,
+        LIBDAS_DAS_SCOPE_OVERRIDE,
+        LIBDAS_DAS_SCOPE_UNDEFINED,
+        LIBDAS_DAS_SCOPE_END
+    };
+
+
     struct DasSignature {
         uint32_t magic = LIBDAS_DAS_MAGIC;
         char padding[12] = {};
     };
 
+
+    /**
+     * DAS v2 file header, that is stored in place of signature padding bytes
+     */
+    struct DasHeader {
+        uint32_t magic = LIBDAS_DAS_MAGIC;
+        uint32_t version = LIBDAS_DAS_VERSION_2;
+        // absolute file offset of the TOC scope, zero if the file does not have a table of contents
+        uint64_t toc_offset = 0;
+    };
+
+    static_assert(sizeof(DasHeader) == sizeof(DasSignature), "DasHeader must occupy exactly the DasSignature bytes");
+
+
+    /**
+     * DAS v2 scope structure that defines the table of contents for all scopes in a file.
+     * Scope offsets are absolute file offsets of scope declarations, ordered by scope type and then by scope index.
+     */
+    struct DasTableOfContents {
+        std::vector<uint32_t> scope_counts;
+        std::vector<uint64_t> scope_offsets;
+
+        /**
+         * Get the absolute file offset of specified scope
+         * @param _type specifies the scope type
+         * @param _index specifies the index of the scope among scopes with the same type
+         * @return file offset of the scope declaration, UINT64_MAX if no such scope exists
+         */
+        inline uint64_t GetScopeOffset(DasScopeType _type, uint32_t _index) const {
+            if(static_cast<size_t>(_type) >= scope_counts.size() || _index >= scope_counts[_type])
+                return UINT64_MAX;
+
+            size_t beg = 0;
+            for(size_t i = 0; i < static_cast<size_t>(_type); i++)
+                beg += scope_counts[i];
+            return beg + _index < scope_offsets.size() ? scope_offsets[beg + _index] : UINT64_MAX;
+        }
+
+        /**
+         * Get the total count of scopes with specified type
+         * @param _type specifies the scope type
+         * @return scope count
+         */
+        inline uint32_t GetScopeCount(DasScopeType _type) const {
+            return static_cast<size_t>(_type) < scope_counts.size() ? scope_counts[_type] : 0;
+        }
+
+        enum ValueType {
+            LIBDAS_TABLE_OF_CONTENTS_SCOPE_TYPE_COUNT,
+            LIBDAS_TABLE_OF_CONTENTS_SCOPE_COUNTS,
+            LIBDAS_TABLE_OF_CONTENTS_SCOPE_OFFSETS
+        };
+    };
+
+
+    /**
+     * DAS v2 scope structure that marks the following scope as a replacement for an earlier scope of the same type.
+     * Override scopes are appended to existing files by DasPatcher and are never listed in the table of contents,
+     * thus they only matter to readers that read the file sequentially.
+     */
+    struct DasScopeOverride {
+        DasScopeType type = LIBDAS_DAS_SCOPE_UNDEFINED;
+        uint32_t index = UINT32_MAX;
+
+        enum ValueType {
+            LIBDAS_SCOPE_OVERRIDE_SCOPE_TYPE,
+            LIBDAS_SCOPE_OVERRIDE_SCOPE_INDEX
+        };
+    };
+
     
     /**
      * DAS scope structure that defines all file properties
@@ -79,7 +213,7 @@ namespace Libdas {
     struct DasProperties {
         DasProperties() = default;
         DasProperties(const DasProperties &_props);
-        DasProperties(DasProperties &&_props);
+        DasProperties(DasProperties &&_props) noexcept;
 
         void operator=(const DasProperties &_props);
         void operator=(DasProperties &&_props);
@@ -106,7 +240,7 @@ namespace Libdas {
     struct DasBuffer {
         DasBuffer() = default;
         DasBuffer(const DasBuffer &_buf);
-        DasBuffer(DasBuffer &&_buf);
+        DasBuffer(DasBuffer &&_buf) noexcept;
 
         void operator=(const DasBuffer &_buf);
         void operator=(DasBuffer &&_buf);
@@ -114,26 +248,70 @@ namespace Libdas {
         std::vector<std::pair<char*, size_t>> data_ptrs;
         uint32_t data_len = 0;
         BufferType type = 0;
+        // amount of zero bytes preceding the payload in the file, that align the payload start
+        uint32_t data_padding = 0;
+
+        // lazily loaded buffers keep file offsets of their payloads instead of the data itself
+        std::vector<uint64_t> data_offsets;
+        std::shared_ptr<RandomAccessFile> source;
+
+        // payloads of buffers with nonzero blob hash are kept in an external blob store instead of the file,
+        // resolved payloads point into the blob mapping, which is shared by all buffers referencing the blob
+        uint64_t blob_hash = 0;
+        std::shared_ptr<MappedFile> blob;
 
         // should the memory be freed under data_ptrs
         bool _free_bit = true;
+        // payloads allocated by GetData(), these stay owned by the buffer even if data_ptrs entries are replaced later
+        std::vector<char*> _loaded_payloads;
+
+        /**
+         * Get buffer payload data. Lazily loaded payloads are read from the source file on first access.
+         * @param _index specifies the payload index in data_ptrs
+         * @return pointer to the payload data, nullptr if the payload does not exist or could not be read
+         */
+        char *GetData(size_t _index = 0);
+        /**
+         * Read all lazily loaded payloads into memory
+         * @return true if all payloads are available in memory, false otherwise
+         */
+        bool Load();
 
 
         enum ValueType {
             LIBDAS_BUFFER_BUFFER_TYPE,
             LIBDAS_BUFFER_DATA_LEN,
-            LIBDAS_BUFFER_DATA
+            LIBDAS_BUFFER_DATA_PADDING,
+            LIBDAS_BUFFER_DATA,
+            LIBDAS_BUFFER_BLOB_HASH
         };
     };
 
 
+    /**
+     * Axis aligned bounding box and bounding sphere, that enclose vertex positions of a mesh primitive, a mesh or a
+     * scene. Bounding volumes are stored as a single BOUNDS value, empty volumes have a negative radius and are not
+     * written into files.
+     */
+    struct DasBoundingVolume {
+        TRS::Point3D<float> min = {0.0f, 0.0f, 0.0f};
+        TRS::Point3D<float> max = {0.0f, 0.0f, 0.0f};
+        TRS::Point3D<float> center = {0.0f, 0.0f, 0.0f};
+        float radius = -1.0f;
+
+        inline bool IsEmpty() const {
+            return radius < 0.0f;
+        }
+    };
+
+
     /**
      * DAS scope structure that defines mesh related information
      */
     struct DasMesh {
         DasMesh() = default;
         DasMesh(const DasMesh &_mesh);
-        DasMesh(DasMesh &&_mesh);
+        DasMesh(DasMesh &&_mesh) noexcept;
         ~DasMesh();
 
         void operator=(const DasMesh &_mesh);
@@ -142,22 +320,51 @@ namespace Libdas {
         std::string name = "";
         uint32_t primitive_count = 0;
         uint32_t *primitives = nullptr;
+        // union of all primitive bounding volumes
+        DasBoundingVolume bounds;
+
+        // should the memory be freed under array pointers, false if arrays are carved out of DasModel::arena
+        bool _free_bit = true;
 
         enum ValueType {
             LIBDAS_MESH_NAME,
             LIBDAS_MESH_PRIMITIVE_COUNT,
-            LIBDAS_MESH_PRIMITIVES
+            LIBDAS_MESH_PRIMITIVES,
+            LIBDAS_MESH_BOUNDS
         };
     };
 
 
+    /**
+     * Meshlet descriptor as it is stored in LIBDAS_BUFFER_TYPE_MESHLET buffers. Descriptors of a mesh primitive are
+     * followed by uint32_t meshlet vertex indices, that point into mesh primitive vertex attributes, and by uint8_t
+     * triangle indices, that point into meshlet vertex indices.
+     */
+    struct DasMeshlet {
+        // byte offsets relative to DasMeshPrimitive::meshlet_buffer_offset
+        uint32_t vertex_offset = 0;
+        uint32_t triangle_offset = 0;
+        uint32_t vertex_count = 0;
+        uint32_t triangle_count = 0;
+
+        // bounding sphere
+        TRS::Point3D<float> center = {0.0f, 0.0f, 0.0f};
+        float radius = 0.0f;
+
+        // meshlet is backfacing if dot(normalize(cone_apex - camera_position), cone_axis) >= cone_cutoff
+        TRS::Point3D<float> cone_apex = {0.0f, 0.0f, 0.0f};
+        TRS::Point3D<float> cone_axis = {0.0f, 0.0f, 0.0f};
+        float cone_cutoff = 1.0f;
+    };
+
+
     /**
      * DAS scope structure that defines mesh primitive related information
      */
     struct DasMeshPrimitive {
         DasMeshPrimitive() = default;
         DasMeshPrimitive(const DasMeshPrimitive &_prim);
-        DasMeshPrimitive(DasMeshPrimitive &&_prim);
+        DasMeshPrimitive(DasMeshPrimitive &&_prim) noexcept;
         ~DasMeshPrimitive();
 
         void operator=(const DasMeshPrimitive &_prim);
@@ -196,6 +403,26 @@ namespace Libdas {
         uint32_t *morph_targets = nullptr;
         float *morph_weights = nullptr;
 
+        // quantized vertex attributes, quantized buffers are flagged with LIBDAS_BUFFER_TYPE_QUANTIZED
+        VertexQuantization quantization = LIBDAS_QUANTIZATION_NONE;
+        // position = position_offset + position_scale * unorm16 value
+        TRS::Point3D<float> position_offset = {0.0f, 0.0f, 0.0f};
+        TRS::Point3D<float> position_scale = {1.0f, 1.0f, 1.0f};
+        // uv = uv_offset + uv_scale * unorm16 value
+        TRS::Point2D<float> uv_offset = {0.0f, 0.0f};
+        TRS::Point2D<float> uv_scale = {1.0f, 1.0f};
+
+        // meshlet descriptors, see DasMeshlet
+        uint32_t meshlet_buffer_id = UINT32_MAX;
+        uint32_t meshlet_buffer_offset = 0;
+        uint32_t meshlet_count = 0;
+
+        // bounding volume of base mesh positions in model space, morph target displacements are not included
+        DasBoundingVolume bounds;
+
+        // should the memory be freed under array pointers, false if arrays are carved out of DasModel::arena
+        bool _free_bit = true;
+
         enum ValueType {
             LIBDAS_MESH_PRIMITIVE_INDEX_BUFFER_ID,
             LIBDAS_MESH_PRIMITIVE_INDEX_BUFFER_OFFSET,
@@ -224,7 +451,19 @@ namespace Libdas {
 
             LIBDAS_MESH_PRIMITIVE_MORPH_TARGET_COUNT,
             LIBDAS_MESH_PRIMITIVE_MORPH_TARGETS,
-            LIBDAS_MESH_PRIMITIVE_MORPH_WEIGHTS
+            LIBDAS_MESH_PRIMITIVE_MORPH_WEIGHTS,
+
+            LIBDAS_MESH_PRIMITIVE_QUANTIZATION,
+            LIBDAS_MESH_PRIMITIVE_POSITION_OFFSET,
+            LIBDAS_MESH_PRIMITIVE_POSITION_SCALE,
+            LIBDAS_MESH_PRIMITIVE_UV_OFFSET,
+            LIBDAS_MESH_PRIMITIVE_UV_SCALE,
+
+            LIBDAS_MESH_PRIMITIVE_MESHLET_BUFFER_ID,
+            LIBDAS_MESH_PRIMITIVE_MESHLET_BUFFER_OFFSET,
+            LIBDAS_MESH_PRIMITIVE_MESHLET_COUNT,
+
+            LIBDAS_MESH_PRIMITIVE_BOUNDS
         };
     };
 
@@ -235,7 +474,7 @@ namespace Libdas {
     struct DasMorphTarget {
         DasMorphTarget() = default;
         DasMorphTarget(const DasMorphTarget &_morph);
-        DasMorphTarget(DasMorphTarget &&_morph);
+        DasMorphTarget(DasMorphTarget &&_morph) noexcept;
         ~DasMorphTarget();
 
         void operator=(const DasMorphTarget &_morph);
@@ -257,6 +496,9 @@ namespace Libdas {
         uint32_t *color_mul_buffer_ids = nullptr;
         uint32_t *color_mul_buffer_offsets = nullptr;
 
+        // should the memory be freed under array pointers, false if arrays are carved out of DasModel::arena
+        bool _free_bit = true;
+
         enum ValueType {
             LIBDAS_MORPH_TARGET_VERTEX_BUFFER_ID,
             LIBDAS_MORPH_TARGET_VERTEX_BUFFER_OFFSET,
@@ -286,7 +528,7 @@ namespace Libdas {
         // default constructor
         DasNode() = default;
         DasNode(const DasNode &_node);
-        DasNode(DasNode &&_node);
+        DasNode(DasNode &&_node) noexcept;
         ~DasNode();
 
         void operator=(const DasNode &_node);
@@ -299,6 +541,9 @@ namespace Libdas {
         uint32_t skeleton = UINT32_MAX;
         TRS::Matrix4<float> transform;
 
+        // should the memory be freed under array pointers, false if arrays are carved out of DasModel::arena
+        bool _free_bit = true;
+
         // value types
         enum ValueType {
             LIBDAS_NODE_NAME,
@@ -317,7 +562,7 @@ namespace Libdas {
     struct DasScene {
         DasScene() = default;
         DasScene(const DasScene &_scene);
-        DasScene(DasScene &&_scene);
+        DasScene(DasScene &&_scene) noexcept;
         ~DasScene();
 
         void operator=(const DasScene &_scene);
@@ -326,16 +571,73 @@ namespace Libdas {
         std::string name = "";
         uint32_t node_count = 0;
         uint32_t *nodes = nullptr;
+        // union of all mesh bounding volumes in world space
+        DasBoundingVolume bounds;
 
         // custom members not included in the file specification
         uint32_t root_count = 0;
         uint32_t *roots = nullptr;
 
+        // should the memory be freed under array pointers, false if arrays are carved out of DasModel::arena
+        bool _free_bit = true;
+
         // value types
         enum ValueType {
             LIBDAS_SCENE_NAME,
             LIBDAS_SCENE_NODE_COUNT,
-            LIBDAS_SCENE_NODES
+            LIBDAS_SCENE_NODES,
+            LIBDAS_SCENE_BOUNDS
+        };
+    };
+
+
+    /**
+     * Bounding volume hierarchy node as it is stored in BVH scopes. Nodes are stored in depth first order, thus the
+     * first child of an inner node always follows its parent and only the index of the second child is stored.
+     */
+    struct DasBvhNode {
+        TRS::Point3D<float> min = {0.0f, 0.0f, 0.0f};
+        // index of the second child for inner nodes, index of the first item for leaf nodes
+        uint32_t offset = 0;
+        TRS::Point3D<float> max = {0.0f, 0.0f, 0.0f};
+        // amount of items in a leaf node, zero for inner nodes
+        uint32_t item_count = 0;
+
+        inline bool IsLeaf() const {
+            return item_count != 0;
+        }
+    };
+
+
+    /**
+     * DAS scope structure that defines a bounding volume hierarchy over world space bounding volumes of scene nodes
+     */
+    struct DasBvh {
+        DasBvh() = default;
+        DasBvh(const DasBvh &_bvh);
+        DasBvh(DasBvh &&_bvh) noexcept;
+        ~DasBvh();
+
+        void operator=(const DasBvh &_bvh);
+        void operator=(DasBvh &&_bvh);
+
+        uint32_t scene = UINT32_MAX;
+        uint32_t node_count = 0;
+        DasBvhNode *nodes = nullptr;
+        // scene node ids, that leaf nodes reference as contiguous ranges
+        uint32_t item_count = 0;
+        uint32_t *items = nullptr;
+
+        // should the memory be freed under array pointers, false if arrays are carved out of DasModel::arena
+        bool _free_bit = true;
+
+        // value types
+        enum ValueType {
+            LIBDAS_BVH_SCENE,
+            LIBDAS_BVH_NODE_COUNT,
+            LIBDAS_BVH_NODES,
+            LIBDAS_BVH_ITEM_COUNT,
+            LIBDAS_BVH_ITEMS
         };
     };
 
@@ -351,7 +653,7 @@ namespace Libdas {
     struct DasSkeleton {
         DasSkeleton() = default;
         DasSkeleton(const DasSkeleton &_skel);
-        DasSkeleton(DasSkeleton &&_skel);
+        DasSkeleton(DasSkeleton &&_skel) noexcept;
         ~DasSkeleton();
 
         void operator=(const DasSkeleton &_skel);
@@ -362,6 +664,9 @@ namespace Libdas {
         uint32_t joint_count = 0;
         uint32_t *joints = nullptr;
 
+        // should the memory be freed under array pointers, false if arrays are carved out of DasModel::arena
+        bool _free_bit = true;
+
         enum ValueType {
             LIBDAS_SKELETON_NAME,
             LIBDAS_SKELETON_PARENT,
@@ -377,7 +682,7 @@ namespace Libdas {
     struct DasSkeletonJoint {
         DasSkeletonJoint() = default;
         DasSkeletonJoint(const DasSkeletonJoint &_joint);
-        DasSkeletonJoint(DasSkeletonJoint &&_joint);
+        DasSkeletonJoint(DasSkeletonJoint &&_joint) noexcept;
         ~DasSkeletonJoint();
 
         void operator=(const DasSkeletonJoint &_joint);
@@ -391,6 +696,9 @@ namespace Libdas {
         TRS::Quaternion rotation;
         TRS::Point3D<float> translation;
 
+        // should the memory be freed under array pointers, false if arrays are carved out of DasModel::arena
+        bool _free_bit = true;
+
         enum ValueType {
             LIBDAS_SKELETON_JOINT_INVERSE_BIND_POS,
             LIBDAS_SKELETON_JOINT_NAME,
@@ -409,7 +717,7 @@ namespace Libdas {
     struct DasAnimation {
         DasAnimation() = default;
         DasAnimation(const DasAnimation &_ani);
-        DasAnimation(DasAnimation &&_ani);
+        DasAnimation(DasAnimation &&_ani) noexcept;
         ~DasAnimation();
 
         void operator=(const DasAnimation &_ani);
@@ -419,6 +727,9 @@ namespace Libdas {
         uint32_t channel_count = 0;
         uint32_t *channels = nullptr;
 
+        // should the memory be freed under array pointers, false if arrays are carved out of DasModel::arena
+        bool _free_bit = true;
+
         enum ValueType {
             LIBDAS_ANIMATION_NAME,
             LIBDAS_ANIMATION_CHANNEL_COUNT,
@@ -430,7 +741,7 @@ namespace Libdas {
     struct DasAnimationChannel {
         DasAnimationChannel() = default;
         DasAnimationChannel(const DasAnimationChannel &_ch);
-        DasAnimationChannel(DasAnimationChannel &&_ch);
+        DasAnimationChannel(DasAnimationChannel &&_ch) noexcept;
         ~DasAnimationChannel();
 
         void operator=(const DasAnimationChannel &_ch);
@@ -446,6 +757,9 @@ namespace Libdas {
         char *tangents = nullptr;
         char *target_values = nullptr;
 
+        // should the memory be freed under array pointers, false if arrays are carved out of DasModel::arena
+        bool _free_bit = true;
+
         enum ValueType {
             LIBDAS_ANIMATION_CHANNEL_NODE_ID,
             LIBDAS_ANIMATION_CHANNEL_JOINT_ID,
@@ -478,6 +792,12 @@ namespace Libdas {
         std::vector<DasSkeleton> skeletons;
         std::vector<DasAnimationChannel> channels;
         std::vector<DasAnimation> animations;
+        std::vector<DasBvh> bvhs;
+
+        // memory mapping that owns buffer data when the model was loaded without copying
+        std::shared_ptr<MappedFile> mapped_file;
+        // arena that owns all scope arrays with cleared _free_bit, released once the model and its copies are destroyed
+        std::shared_ptr<DasArena> arena;
     };
 }
 
@@ -0,0 +1,184 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasTranscoder.h - streaming DAS to DAS transcoder class header
+// author: Karl-Mihkel Ott
+
+#ifndef DAS_TRANSCODER_H
+#define DAS_TRANSCODER_H
+
+#ifdef DAS_TRANSCODER_CPP
+    #include <any>
+    #include <algorithm>
+    #include <fstream>
+    #include <vector>
+    #include <string>
+    #include <cstring>
+    #include <cstdlib>
+    #include <cmath>
+    #include <iostream>
+    #include <memory>
+    #include <unordered_map>
+
+    #include "trs/Iterators.h"
+    #include "trs/Vector.h"
+    #include "trs/Matrix.h"
+    #include "trs/Points.h"
+    #include "trs/Quaternion.h"
+
+    #include "mar/AsciiStreamReader.h"
+    #include "mar/AsciiLineReader.h"
+
+    #include "das/Api.h"
+    #include "das/LibdasAssert.h"
+    #include "das/ErrorHandlers.h"
+    #include "das/DasStructures.h"
+    #include "das/DasArena.h"
+    #include "das/MappedFile.h"
+    #include "das/RandomAccessFile.h"
+    #include "das/OutputSink.h"
+    #include "das/FileWriter.h"
+    #include "das/TextureReader.h"
+    #include "das/DasWriterCore.h"
+    #include "das/DasReaderCore.h"
+    #include "das/DasParser.h"
+    #include "das/DasBlobStore.h"
+#endif
+#include <functional>
+#include <memory>
+
+/// Buffer alignment, that keeps the payload alignment of every input buffer
+#define LIBDAS_DAS_TRANSCODER_INPUT_ALIGNMENT       UINT32_MAX
+
+namespace Libdas {
+
+    class DasBlobStore;
+
+    /**
+     * Callbacks that are invoked for every transcoded scope right before it is written to the output. Callbacks may
+     * modify the scope in place. Memory that a modified scope references must stay valid until the callback returns
+     * next time. Buffer callbacks, that replace payload pointers instead of appending new payloads, must clear
+     * DasBuffer::data_offsets as well. Buffers with modified payloads are embedded into the output, even if they
+     * referenced a blob in the input. Every callback is optional, scopes without a callback are copied as they are.
+     */
+    struct DasTranscodeCallbacks {
+        std::function<void(DasProperties&)> on_properties;
+        std::function<void(DasBuffer&, uint32_t)> on_buffer;
+        std::function<void(DasMeshPrimitive&, uint32_t)> on_mesh_primitive;
+        std::function<void(DasMorphTarget&, uint32_t)> on_morph_target;
+        std::function<void(DasMesh&, uint32_t)> on_mesh;
+        std::function<void(DasNode&, uint32_t)> on_node;
+        std::function<void(DasScene&, uint32_t)> on_scene;
+        std::function<void(DasSkeletonJoint&, uint32_t)> on_skeleton_joint;
+        std::function<void(DasSkeleton&, uint32_t)> on_skeleton;
+        std::function<void(DasAnimation&, uint32_t)> on_animation;
+        std::function<void(DasAnimationChannel&, uint32_t)> on_animation_channel;
+        std::function<void(DasBvh&, uint32_t)> on_bvh;
+    };
+
+
+    /**
+     * Streaming DAS to DAS transcoder, that reads one scope at a time and writes it to the output immediately,
+     * without materializing the whole model. Buffer payloads are loaded lazily, thus payloads that are never accessed
+     * with DasBuffer::GetData() are copied from the input file without passing through userspace memory. Peak memory
+     * usage is bounded by the largest buffer that is accessed in a callback.
+     */
+    class LIBDAS_API DasTranscoder : private DasReaderCore {
+        private:
+            DasWriterCore m_writer;
+            DasTranscodeCallbacks m_callbacks;
+            std::shared_ptr<DasBlobStore> m_blob_store;
+            uint32_t m_buffer_alignment = LIBDAS_DAS_TRANSCODER_INPUT_ALIGNMENT;
+            bool m_is_initialised = false;
+
+        private:
+            /**
+             * Write the output file header and properties scope, unless they were already written
+             * @param _props specifies a reference to properties, that are written to the output
+             */
+            void _InitialiseOutput(const DasProperties &_props);
+            /**
+             * Find the payload alignment of an input buffer, that is at least as strict as the alignment it was written with
+             * @param _buffer specifies a reference to the lazily loaded input buffer
+             * @return payload alignment in bytes, 0 if the payload is not padded
+             */
+            static uint32_t _FindInputAlignment(const DasBuffer &_buffer);
+            /**
+             * Read current scope, pass it to its callback and write it to the output
+             * @param _callback specifies the callback that is invoked for the scope
+             * @param _WriteScope specifies the DasWriterCore method that writes the scope
+             * @param _index specifies the index of the scope among the scopes of the same type
+             * @param _discard specifies if the read scope should be thrown away instead of writing it
+             */
+            template<typename T>
+            inline void _TranscodeScope(const std::function<void(T&, uint32_t)> &_callback, void (DasWriterCore::*_WriteScope)(const T&),
+                                        uint32_t _index, bool _discard) {
+                T scope;
+                ReadScope(scope);
+                if(_discard)
+                    return;
+
+                if(_callback)
+                    _callback(scope, _index);
+                _InitialiseOutput(DasProperties());
+                (m_writer.*_WriteScope)(scope);
+            }
+            /**
+             * Read current buffer scope, pass it to its callback and write it to the output. Payloads that were loaded
+             * during the callback are freed right after the buffer is written.
+             * @param _index specifies the index of the buffer scope
+             * @param _discard specifies if the read buffer should be thrown away instead of writing it
+             */
+            void _TranscodeBuffer(uint32_t _index, bool _discard);
+            /**
+             * Transcode current scope with statically dispatched decoding
+             * @param _type specifies the scope type, whose declaration was just parsed
+             * @param _index specifies the index of the scope among the scopes of the same type
+             * @param _discard specifies if the read scope should be thrown away instead of writing it
+             */
+            void _Transcode(DasScopeType _type, uint32_t _index, bool _discard);
+
+        public:
+            /**
+             * @param _in_file specifies the DAS file to read scopes from
+             * @param _out_file specifies the DAS file to write transcoded scopes to
+             */
+            DasTranscoder(const std::string &_in_file, const std::string &_out_file);
+            /**
+             * @param _in_file specifies the DAS file to read scopes from
+             * @param _sink specifies the output sink where transcoded scopes are written to
+             */
+            DasTranscoder(const std::string &_in_file, const std::shared_ptr<OutputSink> &_sink);
+
+            /**
+             * Transcode all scopes from the input file into the output. DAS v2 input files are transcoded using their
+             * table of contents, thus scopes of the same type are visited together in the order of DasScopeType
+             * values and buffers are always visited before mesh primitives. The output is committed once all scopes
+             * are written.
+             * @param _callbacks specifies callbacks, that are invoked before each scope is written
+             * @param _mask is an optional argument that specifies which scope types are written to the output. Scope
+             * indices are not remapped, thus dropping scopes that are referenced by other scopes is the caller's
+             * responsibility. Properties are always written.
+             */
+            void Transcode(const DasTranscodeCallbacks &_callbacks = DasTranscodeCallbacks(), DasScopeMask _mask = LIBDAS_DAS_SCOPE_MASK_ALL);
+
+            /**
+             * Set the alignment of all written buffer payloads, see DasWriterCore::WriteBuffer(). By default each 
+             * padded input payload keeps its alignment, while payloads without padding are written unaligned.
+             * @param _alignment specifies the payload alignment in bytes, zero to disable padding or 
+             * LIBDAS_DAS_TRANSCODER_INPUT_ALIGNMENT to keep the input alignment
+             */
+            inline void SetBufferAlignment(uint32_t _alignment) {
+                m_buffer_alignment = _alignment;
+            }
+            /**
+             * Set the blob store, where buffers referencing external blobs are resolved from before they are passed to
+             * the buffer callback. Without a blob store such buffers are passed to the callback without payloads.
+             * @param _store specifies the blob store to use
+             */
+            inline void SetBlobStore(const std::shared_ptr<DasBlobStore> &_store) {
+                m_blob_store = _store;
+            }
+    };
+}
+
+#endif
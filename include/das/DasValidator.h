@@ -57,6 +57,9 @@ namespace Libdas {
      *     5.1 Check if skeleton joint ids are correct (error stack, critical_bit)
      *     5.2 Check if there are matching skeleton joint ids in the joint array (warning stack)
      *     5.2 Check if all joints are consumed by skeletons (warning stack)
+     *   6. Check bounding volume hierarchies
+     *     6.1 Check if BVH scene ids and item node ids are correct (error stack, critical_bit)
+     *     6.2 Check if BVH child node indices and leaf item ranges are correct (error stack, critical_bit)
      */
     class LIBDAS_API DasValidator {
         private:
@@ -68,8 +71,27 @@ namespace Libdas {
 
         private:
             // templated checking methods
+            /**
+             * Find the size of a single vertex attribute value, that might be quantized in mesh primitives
+             * @param _prim specifies a reference to the mesh primitive or morph target
+             * @param _attr specifies the quantization flag of the attribute
+             * @param _quantized_size specifies the size of a quantized attribute value in bytes
+             * @param _size specifies the size of a full precision attribute value in bytes
+             * @return attribute value size in bytes
+             */
+            template<typename T>
+            uint32_t _FindAttributeSize(const T &_prim, VertexQuantization _attr, uint32_t _quantized_size, uint32_t _size) {
+                if constexpr(std::is_same_v<T, DasMeshPrimitive>) {
+                    if(_prim.quantization & _attr)
+                        return _quantized_size;
+                }
+
+                return _size;
+            }
+
             template<typename T>
             void _CheckPositionVertices(const T &_prim, uint32_t _cur_index, uint32_t _max_index) {
+                const uint32_t attr_size = _FindAttributeSize(_prim, LIBDAS_QUANTIZATION_POSITION, LIBDAS_QUANTIZED_POSITION_SIZE, static_cast<uint32_t>(sizeof(TRS::Vector3<float>)));
                 if(_prim.vertex_buffer_id >= (uint32_t)m_model.buffers.size()) {
                     std::string errme;
                     if constexpr(std::is_same_v<T, DasMeshPrimitive>) {
@@ -78,17 +100,17 @@ namespace Libdas {
                         errme = "DAS validation error: Invalid position vertex buffer id " + std::to_string(_prim.vertex_buffer_id) + " for morph target " + std::to_string(_cur_index);
                     }
                     m_error_stack.push(errme);
-                } else if(m_model.buffers[_prim.vertex_buffer_id].data_len < _prim.vertex_buffer_offset + _max_index * sizeof(TRS::Vector3<float>)) {
+                } else if(m_model.buffers[_prim.vertex_buffer_id].data_len < _prim.vertex_buffer_offset + _max_index * attr_size) {
                     std::string errme;
                     if constexpr(std::is_same_v<T, DasMeshPrimitive>) {
                         errme = "DAS validation error: Invalid position vertex buffer(" + std::to_string(_prim.vertex_buffer_id) + 
                                 ") region with offset " + std::to_string(_prim.vertex_buffer_offset) + " and size " + 
-                                std::to_string(_max_index * static_cast<uint32_t>(sizeof(TRS::Vector3<float>))) +
+                                std::to_string(_max_index * attr_size) +
                                 " for mesh primitive " + std::to_string(_cur_index); 
                     } else {
                         errme = "DAS validation error: Invalid position vertex buffer(" + std::to_string(_prim.vertex_buffer_id) + 
                                 ") region with offset " + std::to_string(_prim.vertex_buffer_offset) + " and size " + 
-                                std::to_string(_max_index * static_cast<uint32_t>(sizeof(TRS::Vector3<float>))) +
+                                std::to_string(_max_index * attr_size) +
                                 " for morph target" + std::to_string(_cur_index); 
                     }
                     m_error_stack.push(errme);
@@ -97,6 +119,7 @@ namespace Libdas {
 
             template<typename T>
             void _CheckVertexNormal(const T &_prim, uint32_t _cur_index, uint32_t _max_index) {
+                const uint32_t attr_size = _FindAttributeSize(_prim, LIBDAS_QUANTIZATION_NORMAL, LIBDAS_QUANTIZED_NORMAL_SIZE, static_cast<uint32_t>(sizeof(TRS::Vector3<float>)));
                 if(_prim.vertex_normal_buffer_id != UINT32_MAX && _prim.vertex_normal_buffer_id >= (uint32_t)m_model.buffers.size()) {
                     std::string errme;
                     if constexpr(std::is_same_v<T, DasMeshPrimitive>) {
@@ -105,17 +128,17 @@ namespace Libdas {
                         errme = "DAS validation error: Invalid vertex normal buffer id " + std::to_string(_prim.vertex_normal_buffer_id) + " for morph target " + std::to_string(_cur_index);
                     }
                     m_error_stack.push(errme);
-                } else if(_prim.vertex_normal_buffer_id != UINT32_MAX && m_model.buffers[_prim.vertex_normal_buffer_id].data_len < _prim.vertex_normal_buffer_offset + _max_index * sizeof(TRS::Vector3<float>)) {
+                } else if(_prim.vertex_normal_buffer_id != UINT32_MAX && m_model.buffers[_prim.vertex_normal_buffer_id].data_len < _prim.vertex_normal_buffer_offset + _max_index * attr_size) {
                     std::string errme;
                     if constexpr(std::is_same_v<T, DasMeshPrimitive>) {
                         errme = "DAS validation error: Invalid vertex normal buffer(" + std::to_string(_prim.vertex_normal_buffer_id) + 
                                 ") region with offset " + std::to_string(_prim.vertex_normal_buffer_offset) + " and size " + 
-                                std::to_string(_max_index * static_cast<uint32_t>(sizeof(TRS::Vector3<float>))) +
+                                std::to_string(_max_index * attr_size) +
                                 " for mesh primitive " + std::to_string(_cur_index); 
                     } else {
                         errme = "DAS validation error: Invalid vertex normal buffer(" + std::to_string(_prim.vertex_normal_buffer_id) + 
                                 ") region with offset " + std::to_string(_prim.vertex_normal_buffer_offset) + " and size " + 
-                                std::to_string(_max_index * static_cast<uint32_t>(sizeof(TRS::Vector3<float>))) +
+                                std::to_string(_max_index * attr_size) +
                                 " for morph target" + std::to_string(_cur_index); 
                     }
                     m_error_stack.push(errme);
@@ -124,6 +147,7 @@ namespace Libdas {
 
             template<typename T>
             void _CheckVertexTangent(const T &_prim, uint32_t _cur_index, uint32_t _max_index) {
+                const uint32_t attr_size = _FindAttributeSize(_prim, LIBDAS_QUANTIZATION_TANGENT, LIBDAS_QUANTIZED_TANGENT_SIZE, static_cast<uint32_t>(sizeof(TRS::Vector4<float>)));
                 if (_prim.vertex_tangent_buffer_id != UINT32_MAX && _prim.vertex_tangent_buffer_id >= (uint32_t)m_model.buffers.size()) {
                     std::string errme;
                     if constexpr(std::is_same_v<T, DasMeshPrimitive>) {
@@ -132,17 +156,17 @@ namespace Libdas {
                         errme = "DAS validation error: Invalid vertex tangent buffer id " + std::to_string(_prim.vertex_tangent_buffer_id) + " for morph target " + std::to_string(_cur_index);
                     }
                     m_error_stack.push(errme);
-                } else if(_prim.vertex_tangent_buffer_id != UINT32_MAX && m_model.buffers[_prim.vertex_tangent_buffer_id].data_len < _prim.vertex_tangent_buffer_offset + _max_index * sizeof(TRS::Vector4<float>)) {
+                } else if(_prim.vertex_tangent_buffer_id != UINT32_MAX && m_model.buffers[_prim.vertex_tangent_buffer_id].data_len < _prim.vertex_tangent_buffer_offset + _max_index * attr_size) {
                     std::string errme;
                     if constexpr(std::is_same_v<T, DasMeshPrimitive>) {
                         errme = "DAS validation error: Invalid vertex tangent buffer(" + std::to_string(_prim.vertex_tangent_buffer_id) + 
                                 ") region with offset " + std::to_string(_prim.vertex_tangent_buffer_offset) + " and size " + 
-                                std::to_string(_max_index * static_cast<uint32_t>(sizeof(TRS::Vector4<float>))) +
+                                std::to_string(_max_index * attr_size) +
                                 " for mesh primitive " + std::to_string(_cur_index); 
                     } else {
                         errme = "DAS validation error: Invalid vertex tangent buffer(" + std::to_string(_prim.vertex_tangent_buffer_id) + 
                                 ") region with offset " + std::to_string(_prim.vertex_tangent_buffer_offset) + " and size " + 
-                                std::to_string(_max_index * static_cast<uint32_t>(sizeof(TRS::Vector4<float>))) +
+                                std::to_string(_max_index * attr_size) +
                                 " for morph target" + std::to_string(_cur_index); 
                     }
                     m_error_stack.push(errme);
@@ -151,6 +175,7 @@ namespace Libdas {
 
             template<typename T>
             void _CheckTextureProperties(const T &_prim, uint32_t _cur_index, uint32_t _max_index) {
+                const uint32_t attr_size = _FindAttributeSize(_prim, LIBDAS_QUANTIZATION_UV, LIBDAS_QUANTIZED_UV_SIZE, static_cast<uint32_t>(sizeof(TRS::Vector2<float>)));
                 if(_prim.texture_count) {
                     // for each texture check it's buffer regions
                     for(uint32_t i = 0; i < _prim.texture_count; i++) {
@@ -162,17 +187,17 @@ namespace Libdas {
                                 errme = "DAS validation error: Invalid uv buffer id " + std::to_string(_prim.uv_buffer_ids[i]) + " for morph target " + std::to_string(_cur_index);
                             }
                             m_error_stack.push(errme);
-                        } else if(m_model.buffers[_prim.uv_buffer_ids[i]].data_len < _prim.uv_buffer_offsets[i] + _max_index * sizeof(TRS::Vector2<float>)) {
+                        } else if(m_model.buffers[_prim.uv_buffer_ids[i]].data_len < _prim.uv_buffer_offsets[i] + _max_index * attr_size) {
                             std::string errme;
                             if constexpr(std::is_same_v<T, DasMeshPrimitive>) {
                                 errme = "DAS validation error: Invalid uv vertex buffer(" + std::to_string(_prim.uv_buffer_ids[i]) +
                                         ") region with offset " + std::to_string(_prim.uv_buffer_offsets[i]) + " and size " +
-                                        std::to_string(_max_index * static_cast<uint32_t>(sizeof(TRS::Vector2<float>))) +
+                                        std::to_string(_max_index * attr_size) +
                                         " for mesh primitive " + std::to_string(_cur_index);
                             } else {
                                 errme = "DAS validation error: Invalid uv vertex buffer(" + std::to_string(_prim.uv_buffer_ids[i]) +
                                         ") region with offset " + std::to_string(_prim.uv_buffer_offsets[i]) + " and size " +
-                                        std::to_string(_max_index * static_cast<uint32_t>(sizeof(TRS::Vector2<float>))) +
+                                        std::to_string(_max_index * attr_size) +
                                         " for morph target " + std::to_string(_cur_index);
                             }
                             m_error_stack.push(errme);
@@ -215,12 +240,14 @@ namespace Libdas {
             void _CheckJointProperties(const DasMeshPrimitive &_prim, uint32_t _cur_index, uint32_t _max_index);
             void _CheckMorphTargetIndices(const DasMeshPrimitive &_prim, uint32_t _cur_index);
             void _CheckMeshPrimitiveIndicesContinuity(const DasMeshPrimitive &_prim, uint32_t _cur_index);
+            void _CheckMeshlets(const DasMeshPrimitive &_prim, uint32_t _cur_index);
 
             void _VerifyProperties();
             void _VerifyMeshes();
             void _VerifyMorphTargets();
             void _VerifyScenes();
             void _VerifySkeletons();
+            void _VerifyBvhs();
 
         public:
             DasValidator(DasModel &_model, bool _validate = true);
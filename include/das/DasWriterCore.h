@@ -10,12 +10,16 @@
 #ifdef DAS_WRITER_CORE_CPP
     #include <string>
     #include <cstring>
-    #include <fstream>
+    #include <cstddef>
+    #include <memory>
     #include <type_traits>
     #include <vector>
     #include <iostream>
     #include <chrono>
     #include <cmath>
+    #include <atomic>
+    #include <thread>
+    #include <algorithm>
 
     #include "trs/Iterators.h"
     #include "trs/Vector.h"
@@ -27,8 +31,21 @@
     #include "das/LibdasAssert.h"
     #include "das/ErrorHandlers.h"
     #include "das/DasStructures.h"
+    #include "das/RandomAccessFile.h"
+    #include "das/OutputSink.h"
+    #include "das/FileWriter.h"
     #include "das/TextureReader.h"
 #endif
+// blob store is needed for the default minimum blob size
+#include "das/DasBlobStore.h"
+
+/// Output staging buffer size and the size from which data is written to the file directly instead
+#define LIBDAS_DAS_WRITER_STAGING_SIZE              (1024 * 1024)
+#define LIBDAS_DAS_WRITER_DIRECT_WRITE_THRESHOLD    (64 * 1024)
+/// Minimum amount of same typed scopes that are serialized on multiple threads
+#define LIBDAS_DAS_WRITER_PARALLEL_THRESHOLD        256
+/// Largest supported buffer payload alignment, which matches the page size of most systems
+#define LIBDAS_DAS_WRITER_MAX_BUFFER_ALIGNMENT      4096
 
 
 namespace Libdas {
@@ -36,12 +53,47 @@ namespace Libdas {
     class LIBDAS_API DasWriterCore {
         private:
             std::vector<TextureReader> m_texture_readers;
-            std::ofstream m_out_stream;
+            std::shared_ptr<OutputSink> m_out_file;
             RawImageDataHeader m_raw_img_header;
 
+            // all small values are gathered into the staging buffer and written out in large blocks
+            std::vector<char> m_staging;
+            uint64_t m_flushed_size = 0;
+
+            // scope offsets per scope type for the table of contents
+            std::vector<std::vector<uint64_t>> m_scope_offsets;
+            bool m_is_toc_pending = false;
+
+            // detached writers serialize scopes only into their staging buffer and never flush it
+            bool m_is_detached = false;
+            uint32_t m_thread_count = 1;
+
+            // existing scope, that the next written scope of the same type replaces
+            DasScopeOverride m_override;
+
+            // large buffer payloads are moved into the blob store and only referenced from the file
+            std::shared_ptr<DasBlobStore> m_blob_store;
+            uint32_t m_blob_min_size = 0;
+
         protected:
             std::string m_file_name;
 
+            /**
+             * Continue writing at the end of an existing DAS file. Scopes that are already in the file are kept in the 
+             * table of contents, which is rewritten at the end of the file once the stream is closed.
+             * @param _sink specifies the output sink, that appends to the existing file
+             * @param _size specifies the current size of the existing file in bytes
+             * @param _toc specifies a reference to the table of contents of the existing file
+             */
+            void _AppendTo(const std::shared_ptr<OutputSink> &_sink, uint64_t _size, const DasTableOfContents &_toc);
+            /**
+             * Make the next written scope of given type replace an existing scope. The replacement takes over the 
+             * table of contents entry of the replaced scope and is preceded by an override scope for sequential readers.
+             * @param _type specifies the scope type
+             * @param _index specifies the index of the replaced scope among the scopes of the same type
+             */
+            void _OverrideNextScope(DasScopeType _type, uint32_t _index);
+
         private:
             /**
              * Check if the current m_out_file string contains extension .das
@@ -52,6 +104,84 @@ namespace Libdas {
              * Open a output file stream with m_out_file as a used file name
              */
             void _OpenFileStream();
+            /**
+             * Write all staged data into the file
+             */
+            void _Flush();
+            /**
+             * Write data that does not fit into the staging buffer. Large data is written directly together with
+             * already staged data, without copying it into the staging buffer.
+             * @param _data specifies a pointer to the data
+             * @param _len specifies the length of the data in bytes
+             */
+            void _WriteLarge(const char *_data, size_t _len);
+            /**
+             * Write data to the output, small writes are only copied into the staging buffer
+             * @param _data specifies a pointer to the data
+             * @param _len specifies the length of the data in bytes
+             */
+            inline void _Write(const char *_data, size_t _len) {
+                if(_len < LIBDAS_DAS_WRITER_DIRECT_WRITE_THRESHOLD && m_staging.size() + _len <= m_staging.capacity()) {
+                    m_staging.insert(m_staging.end(), _data, _data + _len);
+                    return;
+                }
+
+                _WriteLarge(_data, _len);
+            }
+            /**
+             * Write multiple memory areas to the output. Large fragments are passed to the file with a single 
+             * vectored write, while small fragments are staged.
+             * @param _fragments specifies a reference to std::vector containing all memory areas and their lengths
+             */
+            void _WriteFragments(const std::vector<std::pair<const char*, size_t>> &_fragments);
+            /**
+             * Write data from another file to the output. Large areas are copied between files inside the kernel, 
+             * small areas are read into the staging buffer.
+             * @param _src specifies a reference to the source file
+             * @param _offset specifies the absolute source file offset in bytes
+             * @param _len specifies the length of the data in bytes
+             */
+            void _WriteFileData(const RandomAccessFile &_src, uint64_t _offset, size_t _len);
+            /**
+             * Get the current absolute output offset, including staged data
+             * @return output offset in bytes
+             */
+            inline uint64_t _GetOffset() const {
+                return m_flushed_size + static_cast<uint64_t>(m_staging.size());
+            }
+            /**
+             * Reserve disk space for the output, so that the following data is written contiguously
+             * @param _len specifies the amount of bytes, that are about to be written after the current offset
+             */
+            inline void _Preallocate(uint64_t _len) {
+                if(m_out_file && !m_is_detached)
+                    m_out_file->Preallocate(_GetOffset() + _len);
+            }
+            /**
+             * Calculate the serialized size of a buffer scope
+             * @param _buffer specifies a reference to DasBuffer object
+             * @param _alignment specifies the payload alignment, for which the largest possible padding is assumed
+             * @return buffer scope size in bytes
+             */
+            static uint64_t _GetBufferScopeSize(const DasBuffer &_buffer, uint32_t _alignment);
+            /**
+             * Move buffer payload into the blob store, if the store is used and the payload is large enough
+             * @param _buffer specifies a reference to DasBuffer object
+             * @return blob hash of the payload, 0 if the payload must be embedded into the file
+             */
+            uint64_t _StoreBlob(const DasBuffer &_buffer);
+            /**
+             * Write buffer scope values, that reference a blob instead of containing the payload
+             * @param _type specifies the buffer type
+             * @param _data_len specifies the payload length in bytes
+             * @param _blob_hash specifies the blob hash of the payload
+             */
+            void _WriteBlobReference(BufferType _type, uint32_t _data_len, uint64_t _blob_hash);
+            /**
+             * Write zero bytes to the output
+             * @param _len specifies the amount of zero bytes to write
+             */
+            void _WritePadding(size_t _len);
             /**
              * Write a single string value to the stream
              * @param _value_name is a value name that is used
@@ -66,12 +196,12 @@ namespace Libdas {
             template <typename T>
             void _WriteNumericalValue(const std::string &_value_name, T _value) {
                 LIBDAS_ASSERT(std::is_floating_point<T>::value || std::is_integral<T>::value);
-                LIBDAS_ASSERT(m_out_stream.is_open());
+                LIBDAS_ASSERT(m_out_file || m_is_detached);
 
-                m_out_stream.write(_value_name.c_str(), _value_name.size());
-                m_out_stream.write(": ", 2);
-                m_out_stream.write(reinterpret_cast<const char*>(&_value), sizeof(T));
-                m_out_stream.write(LIBDAS_DAS_NEWLINE, strlen(LIBDAS_DAS_NEWLINE));
+                _Write(_value_name.c_str(), _value_name.size());
+                _Write(": ", 2);
+                _Write(reinterpret_cast<const char*>(&_value), sizeof(T));
+                _Write(LIBDAS_DAS_NEWLINE, sizeof(LIBDAS_DAS_NEWLINE) - 1);
             }
             /**
              * Write an array value to the stream
@@ -81,12 +211,12 @@ namespace Libdas {
              */
             template<typename T>
             void _WriteArrayValue(const std::string &_value_name, uint32_t _n, T *_values) {
-                LIBDAS_ASSERT(m_out_stream.is_open());
+                LIBDAS_ASSERT(m_out_file || m_is_detached);
 
-                m_out_stream.write(_value_name.c_str(), _value_name.size());
-                m_out_stream.write(": ", 2);
-                m_out_stream.write(reinterpret_cast<const char*>(_values), sizeof(T) * _n);
-                m_out_stream.write(LIBDAS_DAS_NEWLINE, strlen(LIBDAS_DAS_NEWLINE));
+                _Write(_value_name.c_str(), _value_name.size());
+                _Write(": ", 2);
+                _Write(reinterpret_cast<const char*>(_values), sizeof(T) * _n);
+                _Write(LIBDAS_DAS_NEWLINE, sizeof(LIBDAS_DAS_NEWLINE) - 1);
             }
             /**
              * Write a generic data value to the stream
@@ -104,40 +234,77 @@ namespace Libdas {
             template <typename T>
             void _WriteMatrixValue(const std::string &_value_name, const TRS::Matrix4<T> &_mat) {
                 LIBDAS_ASSERT(std::is_floating_point<T>::value || std::is_integral<T>::value);
-                LIBDAS_ASSERT(m_out_stream.is_open());
+                LIBDAS_ASSERT(m_out_file || m_is_detached);
 
-                m_out_stream.write(_value_name.c_str(), _value_name.size());
-                m_out_stream.write(": ", 2);
+                _Write(_value_name.c_str(), _value_name.size());
+                _Write(": ", 2);
 
-                for(auto it = _mat.BeginRowMajor(); it != _mat.EndRowMajor(); it++) {
-                    m_out_stream.write(reinterpret_cast<const char*>(it.GetData()), sizeof(T));
-                }
+                // gather all matrix elements in row major order and write them at once
+                T values[16];
+                size_t i = 0;
+                for(auto it = _mat.BeginRowMajor(); it != _mat.EndRowMajor() && i < 16; it++)
+                    values[i++] = *it.GetData();
 
-                m_out_stream.write(LIBDAS_DAS_NEWLINE, strlen(LIBDAS_DAS_NEWLINE));
+                _Write(reinterpret_cast<const char*>(values), sizeof(T) * i);
+                _Write(LIBDAS_DAS_NEWLINE, sizeof(LIBDAS_DAS_NEWLINE) - 1);
             }
             /**
-             * Start a new scope definition
+             * Start a new scope definition and record its offset for the table of contents
              * @param _scope_name is a specified scope name to use when starting a new scope
+             * @param _type specifies the scope type
              */
-            void _WriteScopeBeginning(const std::string &_scope_name);
+            void _WriteScopeBeginning(const std::string &_scope_name, DasScopeType _type);
             /**
              * Write a scope ending declaration
              */
             void _EndScope();
+            /**
+             * Write the table of contents scope to the end of the file and patch its offset into the file header
+             */
+            void _WriteTableOfContents();
+            /**
+             * Append all data and scope offsets of a detached writer to the output
+             * @param _writer specifies a reference to the detached DasWriterCore object
+             */
+            void _AppendDetached(const DasWriterCore &_writer);
+            /**
+             * Write multiple same typed scopes. If multiple threads are used, ranges of scopes are serialized into 
+             * detached writers concurrently and appended to the output in their original order.
+             * @param _scopes specifies a reference to std::vector containing all scopes to write
+             * @param _WriteScope specifies a method pointer, that writes a single scope
+             */
+            template<typename T>
+            void _WriteScopes(const std::vector<T> &_scopes, void (DasWriterCore::*_WriteScope)(const T&));
 
 
         public:
             DasWriterCore(const std::string &_file_name = "");
+            /**
+             * @param _sink specifies the output sink to write into
+             */
+            DasWriterCore(const std::shared_ptr<OutputSink> &_sink);
             ~DasWriterCore();
             /**
              * Open a new file for output
              * @param _file_name is a new file name to use when opening a stream
              */
             void NewFile(const std::string &_file_name);
+            /**
+             * Use a new output sink instead of a file, no file extension is enforced
+             * @param _sink specifies the output sink to write into
+             */
+            void NewSink(const std::shared_ptr<OutputSink> &_sink);
             /**
              * Close the stream if opened
              */
             void CloseStream();
+            /**
+             * Keep large buffer payloads in an external content addressed blob store instead of the file. Buffers that
+             * already reference a blob are always written as references.
+             * @param _store specifies the blob store to use, nullptr to embed all payloads
+             * @param _min_size specifies the smallest payload size in bytes, that is moved into the store
+             */
+            void SetBlobStore(const std::shared_ptr<DasBlobStore> &_store, uint32_t _min_size = LIBDAS_BLOB_STORE_MIN_SIZE);
             /**
              * Write a file signature with its properties section
              * @param _properties is a reference to DasProperties
@@ -146,8 +313,10 @@ namespace Libdas {
             /**
              * Write a generic buffer scope into a file
              * @param _buffer is a reference to DasBuffer object
+             * @param _alignment optionally specifies the payload start alignment in the file, which must be a power of
+             * two up to LIBDAS_DAS_WRITER_MAX_BUFFER_ALIGNMENT. Zero and one write the payload unaligned.
              */
-            void WriteBuffer(const DasBuffer &_buffer);
+            void WriteBuffer(const DasBuffer &_buffer, uint32_t _alignment = 0);
             /**
              * Write texture buffers from given texture images files
              * @param _textures is a const reference to std::vector that contains all texture file names in std::string type
@@ -198,6 +367,73 @@ namespace Libdas {
              * @param _animation is a reference to DasAnimation object
              */
             void WriteAnimation(const DasAnimation &_animation);
+            /**
+             * Write a bounding volume hierarchy to the file
+             * @param _bvh is a reference to DasBvh object
+             */
+            void WriteBvh(const DasBvh &_bvh);
+            /**
+             * Write multiple buffer scopes into the file
+             * @param _buffers specifies a reference to std::vector containing DasBuffer objects
+             * @param _alignment optionally specifies the payload start alignment in the file, see WriteBuffer()
+             */
+            void WriteBuffers(const std::vector<DasBuffer> &_buffers, uint32_t _alignment = 0);
+            /**
+             * Write multiple mesh primitive scopes into the file
+             * @param _primitives specifies a reference to std::vector containing DasMeshPrimitive objects
+             */
+            void WriteMeshPrimitives(const std::vector<DasMeshPrimitive> &_primitives);
+            /**
+             * Write multiple morph target scopes into the file
+             * @param _morph_targets specifies a reference to std::vector containing DasMorphTarget objects
+             */
+            void WriteMorphTargets(const std::vector<DasMorphTarget> &_morph_targets);
+            /**
+             * Write multiple mesh scopes into the file
+             * @param _meshes specifies a reference to std::vector containing DasMesh objects
+             */
+            void WriteMeshes(const std::vector<DasMesh> &_meshes);
+            /**
+             * Write multiple node scopes into the file
+             * @param _nodes specifies a reference to std::vector containing DasNode objects
+             */
+            void WriteNodes(const std::vector<DasNode> &_nodes);
+            /**
+             * Write multiple scene scopes into the file
+             * @param _scenes specifies a reference to std::vector containing DasScene objects
+             */
+            void WriteScenes(const std::vector<DasScene> &_scenes);
+            /**
+             * Write multiple skeleton scopes into the file
+             * @param _skeletons specifies a reference to std::vector containing DasSkeleton objects
+             */
+            void WriteSkeletons(const std::vector<DasSkeleton> &_skeletons);
+            /**
+             * Write multiple skeleton joint scopes into the file
+             * @param _joints specifies a reference to std::vector containing DasSkeletonJoint objects
+             */
+            void WriteSkeletonJoints(const std::vector<DasSkeletonJoint> &_joints);
+            /**
+             * Write multiple animation channel scopes into the file
+             * @param _channels specifies a reference to std::vector containing DasAnimationChannel objects
+             */
+            void WriteAnimationChannels(const std::vector<DasAnimationChannel> &_channels);
+            /**
+             * Write multiple animation scopes into the file
+             * @param _animations specifies a reference to std::vector containing DasAnimation objects
+             */
+            void WriteAnimations(const std::vector<DasAnimation> &_animations);
+            /**
+             * Write multiple bounding volume hierarchy scopes into the file
+             * @param _bvhs specifies a reference to std::vector containing DasBvh objects
+             */
+            void WriteBvhs(const std::vector<DasBvh> &_bvhs);
+            /**
+             * Set the amount of threads used for serializing scopes in Write*s() methods, all hardware threads are
+             * used by default. The output does not depend on the thread count.
+             * @param _thread_count specifies the thread count, zero uses all available hardware threads
+             */
+            void SetThreadCount(uint32_t _thread_count);
             /**
              * Append textures into buffers' vector
              * @param _buffers specifies the main buffers' vector to use for writing destination 
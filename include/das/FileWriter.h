@@ -0,0 +1,140 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: FileWriter.h - unbuffered file writer class header
+// author: Karl-Mihkel Ott
+
+#ifndef FILE_WRITER_H
+#define FILE_WRITER_H
+
+#ifdef FILE_WRITER_CPP
+    #include <cstdint>
+    #include <climits>
+    #include <string>
+    #include <vector>
+    #include <iostream>
+    #include <algorithm>
+    #include <atomic>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <cerrno>
+    #include <cstdio>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/uio.h>
+#ifdef __linux__
+    #include <sys/sendfile.h>
+#endif
+#endif
+
+    #include "das/Api.h"
+    #include "das/ErrorHandlers.h"
+    #include "das/RandomAccessFile.h"
+    #include "das/OutputSink.h"
+#endif
+
+namespace Libdas {
+
+    /**
+     * Write-only file handle that passes all data straight to the operating system without any userspace buffering.
+     * Callers are expected to batch small writes themselves and to use vectored writes for scattered data.
+     * All data is written into a temporary file next to the target file, which replaces the target atomically once
+     * the output is committed. Uncommitted output is discarded, thus the target file is never left partially written.
+     * Writers that append to an existing file write into the file directly and discard uncommitted output by 
+     * truncating the file back to its original size.
+     */
+    class LIBDAS_API FileWriter : public OutputSink {
+        private:
+            std::string m_file_name;
+            std::string m_tmp_file_name;
+            uint64_t m_size = 0;
+            uint64_t m_allocated_size = 0;
+            // appending writers keep the size of the existing file for discarding uncommitted output
+            bool m_is_append = false;
+            uint64_t m_base_size = 0;
+#ifdef _WIN32
+            void *m_file_handle = nullptr;
+#else
+            int m_fd = -1;
+#endif
+
+        private:
+            /**
+             * Close the file handle without committing the output
+             */
+            void _CloseHandle();
+
+        public:
+            /**
+             * Create a temporary file for writing, that replaces specified file on commit
+             * @param _file_name specifies the target file name
+             * @param _append specifies if data should be appended to the existing target file instead
+             */
+            FileWriter(const std::string &_file_name, bool _append = false);
+            FileWriter(const FileWriter &_file) = delete;
+            ~FileWriter() override;
+
+            void operator=(const FileWriter &_file) = delete;
+
+            /**
+             * Append data to the end of the file
+             * @param _data specifies a pointer to the data
+             * @param _len specifies the amount of bytes to write
+             * @return true if all bytes were written, false otherwise
+             */
+            bool Write(const char *_data, size_t _len) override;
+            /**
+             * Append multiple memory areas to the end of the file with as few system calls as possible
+             * @param _fragments specifies a pointer to an array of memory areas and their lengths
+             * @param _count specifies the amount of memory areas
+             * @return true if all bytes were written, false otherwise
+             */
+            bool WriteVectored(const std::pair<const char*, size_t> *_fragments, size_t _count) override;
+            /**
+             * Overwrite data at specified file offset without changing the append position. When appending to an
+             * existing file, all appended data is flushed to the disk before any of the existing data is overwritten.
+             * @param _offset specifies the absolute file offset in bytes
+             * @param _data specifies a pointer to the data
+             * @param _len specifies the amount of bytes to write
+             * @return true if all bytes were written, false otherwise
+             */
+            bool WriteAt(uint64_t _offset, const char *_data, size_t _len) override;
+            /**
+             * Append data from another file to the end of the file. On Linux the data is copied inside the kernel with
+             * copy_file_range() or sendfile(), other platforms use an intermediate buffer.
+             * @param _src specifies a reference to the source file
+             * @param _offset specifies the absolute source file offset in bytes
+             * @param _len specifies the amount of bytes to copy
+             * @return true if all bytes were copied, false otherwise
+             */
+            bool CopyFrom(const RandomAccessFile &_src, uint64_t _offset, size_t _len) override;
+            /**
+             * Reserve contiguous disk space for the output, the reserved space beyond written data is released on commit
+             * @param _size specifies the expected total file size in bytes
+             */
+            void Preallocate(uint64_t _size) override;
+            /**
+             * Flush all data to the disk and atomically replace the target file with the written output
+             * @return true if the target file was replaced or appended to, false otherwise
+             */
+            bool Commit() override;
+            /**
+             * Close the file handle, uncommitted output is discarded
+             */
+            void Close();
+
+            ////////////////////////////////
+            // ***** Getter methods ***** //
+            ////////////////////////////////
+            inline const std::string &GetFileName() const {
+                return m_file_name;
+            }
+
+            inline uint64_t GetSize() const {
+                return m_size;
+            }
+    };
+}
+
+#endif
@@ -38,12 +38,20 @@
     #include "das/LibdasAssert.h"
     #include "das/ErrorHandlers.h"
     #include "das/DasStructures.h"
+    #include "das/BoundingVolumes.h"
+    #include "das/VertexQuantization.h"
+    #include "das/MeshOptimizer.h"
+    #include "das/MeshletBuilder.h"
+    #include "das/BvhBuilder.h"
+    #include "das/BufferDeduplicator.h"
 #define LIBDAS_DEFS_ONLY
     #include "das/HuffmanCompression.h"
 #undef LIBDAS_DEFS_ONLY
     #include "das/Base64Decoder.h"
     #include "das/URIResolver.h"
     #include "das/TextureReader.h"
+    #include "das/OutputSink.h"
+    #include "das/FileWriter.h"
     #include "das/DasWriterCore.h"
     #include "das/TextureReader.h"
     #include "das/GLTFStructures.h"
@@ -63,12 +71,19 @@ namespace Libdas {
             size_t m_buffers_size = 0;
             size_t m_images_size = 0;
             const bool m_use_raw_textures;
+            VertexQuantization m_quantization = LIBDAS_QUANTIZATION_NONE;
+            bool m_optimize_meshes = false;
+            bool m_build_meshlets = false;
+            bool m_build_bvhs = false;
+            bool m_deduplicate_buffers = false;
             std::string m_root_path;
 
             // buffer related
             std::vector<URIResolver> m_uri_resolvers;
             std::vector<TextureReader> m_tex_readers;
             std::vector<char*> m_allocated_memory;
+            // meshlets of all mesh primitives, the buffer is appended after all other buffers
+            DasBuffer m_meshlet_buffer;
 
             const std::unordered_map<std::string, BufferType> m_attribute_type_map = {
                 std::make_pair("POSITION", LIBDAS_BUFFER_TYPE_VERTEX),
@@ -111,6 +126,16 @@ namespace Libdas {
                 uint32_t indices_accessor = UINT32_MAX;
             };
 
+            // dequantization parameters of the mesh primitive that is currently written
+            struct QuantizationParameters {
+                VertexQuantization flags = LIBDAS_QUANTIZATION_NONE;
+                VertexQuantization used = LIBDAS_QUANTIZATION_NONE;
+                TRS::Point3D<float> position_offset = {0.0f, 0.0f, 0.0f};
+                TRS::Point3D<float> position_scale = {1.0f, 1.0f, 1.0f};
+                TRS::Point2D<float> uv_offset = {0.0f, 0.0f};
+                TRS::Point2D<float> uv_scale = {1.0f, 1.0f};
+            };
+
             std::vector<DasMesh> m_meshes;
             std::vector<DasMeshPrimitive> m_mesh_primitives;
             std::vector<DasMorphTarget> m_morph_targets;
@@ -138,6 +163,8 @@ namespace Libdas {
             TRS::Vector4<uint16_t> _GetJointIndices(BufferAccessorData &_ad, uint32_t _index);
             TRS::Vector4<float> _GetJointWeights(BufferAccessorData &_ad, uint32_t _index);
             uint32_t _GetIndex(BufferAccessorData &_ad, uint32_t _index);
+            TRS::Vector3<float> _GetVector3(BufferAccessorData &_ad, uint32_t _index);
+            TRS::Vector4<float> _GetVector4(BufferAccessorData &_ad, uint32_t _index);
 
             // indexing methods
             GenericVertexAttributeAccessors _GenerateGenericVertexAttributeAccessors(GLTFMeshPrimitive::AttributesType &_attrs);
@@ -169,6 +196,54 @@ namespace Libdas {
                 m_allocated_memory.push_back(buf);
             }
             
+            /**
+             * Write quantized values of a single attribute
+             * @param _Quantize specifies a callable, that reads and quantizes a single attribute value from the accessor
+             */
+            template<typename Q, typename F>
+            void _QuantizeSingleAttributeAccessorDataToBuffer(GLTFRoot &_root,
+                                                              uint32_t _accessor,
+                                                              uint32_t &_prim_id,
+                                                              uint32_t &_prim_offset,
+                                                              DasBuffer &_buffer,
+                                                              F _Quantize)
+            {
+                BufferAccessorData acc = _FindAccessorData(_root, _accessor);
+                const size_t count = static_cast<size_t>(_root.accessors[_accessor].count);
+                const size_t len = count * sizeof(Q);
+                char *buf = new char[len]{};
+                for(size_t j = 0; j < count; j++) {
+                    reinterpret_cast<Q*>(buf)[j] = _Quantize(acc, static_cast<uint32_t>(j));
+                }
+
+                _buffer.data_ptrs.push_back(std::make_pair(buf, len));
+                _prim_id = 0;
+                _prim_offset = _buffer.data_len;
+                _buffer.data_len += static_cast<uint32_t>(len);
+                m_allocated_memory.push_back(buf);
+            }
+
+            /**
+             * Find the bounding volume of a position accessor, accessor bounds are used without reading positions when present
+             * @param _root specifies a reference to GLTFRoot object, where all GLTF data is stored
+             * @param _accessor specifies the position accessor index
+             * @return DasBoundingVolume object, empty if positions without accessor bounds are not stored as floats
+             */
+            DasBoundingVolume _FindPositionBounds(const GLTFRoot &_root, uint32_t _accessor);
+            /**
+             * Write positions as unorm16 values relative to the position accessor bounding box
+             * @param _bounds specifies a reference to the position accessor DasBoundingVolume object
+             * @param _quant specifies a reference to QuantizationParameters, where position dequantization parameters are written to
+             */
+            void _QuantizePositions(GLTFRoot &_root, uint32_t _accessor, const DasBoundingVolume &_bounds, DasBuffer &_buffer, uint32_t &_prim_id, 
+                                    uint32_t &_prim_offset, QuantizationParameters &_quant);
+            /**
+             * Write all uv sets as unorm16 values relative to the common coordinate range of all sets
+             * @param _quant specifies a reference to QuantizationParameters, where uv dequantization parameters are written to
+             */
+            void _QuantizeUVs(GLTFRoot &_root, std::vector<uint32_t> &_accessors, DasBuffer &_buffer, uint32_t *_prim_ids, uint32_t *_prim_offsets,
+                              QuantizationParameters &_quant);
+
             /**
              * Write attributes that can occur multiple times in a mesh primitive
              */
@@ -196,17 +271,55 @@ namespace Libdas {
             template<typename T>
             void _WritePrimitiveData(GLTFRoot &_root, GenericVertexAttributeAccessors &_gen_acc, DasBuffer &_buffer, T &_prim) {
                 LIBDAS_ASSERT(_gen_acc.pos_accessor != UINT32_MAX);
-                _CopyVertexAttributeAccessorDataToBuffer(_root, _gen_acc.pos_accessor, _buffer, 
-                                                         _prim.vertex_buffer_id, 
-                                                         _prim.vertex_buffer_offset);
 
-                if(_gen_acc.normal_accessor != UINT32_MAX) {
+                // morph target deltas are always kept in full precision and do not have bounding volumes
+                QuantizationParameters quant;
+                DasBoundingVolume bounds;
+                if constexpr(std::is_base_of<DasMeshPrimitive, T>::value) {
+                    quant.flags = m_quantization;
+                    bounds = _FindPositionBounds(_root, _gen_acc.pos_accessor);
+                    _prim.bounds = bounds;
+                }
+
+                if(quant.flags & LIBDAS_QUANTIZATION_POSITION) {
+                    _QuantizePositions(_root, _gen_acc.pos_accessor, bounds, _buffer,
+                                       _prim.vertex_buffer_id,
+                                       _prim.vertex_buffer_offset,
+                                       quant);
+                } else {
+                    _CopyVertexAttributeAccessorDataToBuffer(_root, _gen_acc.pos_accessor, _buffer, 
+                                                             _prim.vertex_buffer_id, 
+                                                             _prim.vertex_buffer_offset);
+                }
+
+                if(_gen_acc.normal_accessor != UINT32_MAX && (quant.flags & LIBDAS_QUANTIZATION_NORMAL)) {
+                    _QuantizeSingleAttributeAccessorDataToBuffer<TRS::Vector2<int16_t>>(_root, _gen_acc.normal_accessor,
+                        _prim.vertex_normal_buffer_id,
+                        _prim.vertex_normal_buffer_offset,
+                        _buffer,
+                        [this](BufferAccessorData &_acc, uint32_t _index) {
+                            return Quantization::EncodeOctahedral(_GetVector3(_acc, _index));
+                        });
+                    quant.used |= LIBDAS_QUANTIZATION_NORMAL;
+                } else if(_gen_acc.normal_accessor != UINT32_MAX) {
                     _CopyVertexAttributeAccessorDataToBuffer(_root, _gen_acc.normal_accessor, _buffer,
                                                              _prim.vertex_normal_buffer_id, 
                                                              _prim.vertex_normal_buffer_offset);
                 } 
 
-                if(_gen_acc.tangent_accessor != UINT32_MAX) {
+                if(_gen_acc.tangent_accessor != UINT32_MAX && (quant.flags & LIBDAS_QUANTIZATION_TANGENT)) {
+                    // bitangent sign is kept in the third component
+                    _QuantizeSingleAttributeAccessorDataToBuffer<TRS::Vector4<int16_t>>(_root, _gen_acc.tangent_accessor,
+                        _prim.vertex_tangent_buffer_id,
+                        _prim.vertex_tangent_buffer_offset,
+                        _buffer,
+                        [this](BufferAccessorData &_acc, uint32_t _index) {
+                            const TRS::Vector4<float> tangent = _GetVector4(_acc, _index);
+                            const TRS::Vector2<int16_t> oct = Quantization::EncodeOctahedral(TRS::Vector3<float>(tangent.first, tangent.second, tangent.third));
+                            return TRS::Vector4<int16_t>(oct.first, oct.second, static_cast<int16_t>(tangent.fourth < 0.0f ? -32767 : 32767), 0);
+                        });
+                    quant.used |= LIBDAS_QUANTIZATION_TANGENT;
+                } else if(_gen_acc.tangent_accessor != UINT32_MAX) {
                     _CopyVertexAttributeAccessorDataToBuffer(_root, _gen_acc.tangent_accessor, _buffer,
                                                              _prim.vertex_tangent_buffer_id, 
                                                              _prim.vertex_tangent_buffer_offset);
@@ -217,12 +330,16 @@ namespace Libdas {
                     _prim.texture_count = static_cast<uint32_t>(_gen_acc.uv_accessors.size());
                     _prim.uv_buffer_ids = new uint32_t[_gen_acc.uv_accessors.size()];
                     _prim.uv_buffer_offsets = new uint32_t[_gen_acc.uv_accessors.size()];
-                    _RewriteMultiAttributeAccessorsDataToBuffer(_root,
-                                                                _gen_acc.uv_accessors, 
-                                                                _prim.uv_buffer_ids,
-                                                                _prim.uv_buffer_offsets, 
-                                                                _buffer,
-                                                                &GLTFCompiler::_GetUV);
+                    if(quant.flags & LIBDAS_QUANTIZATION_UV) {
+                        _QuantizeUVs(_root, _gen_acc.uv_accessors, _buffer, _prim.uv_buffer_ids, _prim.uv_buffer_offsets, quant);
+                    } else {
+                        _RewriteMultiAttributeAccessorsDataToBuffer(_root,
+                                                                    _gen_acc.uv_accessors, 
+                                                                    _prim.uv_buffer_ids,
+                                                                    _prim.uv_buffer_offsets, 
+                                                                    _buffer,
+                                                                    &GLTFCompiler::_GetUV);
+                    }
                 }
 
                 // color multipliers
@@ -272,16 +389,137 @@ namespace Libdas {
                         // joint weights
                         _prim.joint_weight_buffer_ids = new uint32_t[_gen_acc.weights_accessors.size()];
                         _prim.joint_weight_buffer_offsets = new uint32_t[_gen_acc.weights_accessors.size()];
-                        _RewriteMultiAttributeAccessorsDataToBuffer(_root,
-                                                                    _gen_acc.weights_accessors,
-                                                                    _prim.joint_weight_buffer_ids,
-                                                                    _prim.joint_weight_buffer_offsets,
-                                                                    _buffer,
-                                                                    &GLTFCompiler::_GetJointWeights);
+                        if(quant.flags & LIBDAS_QUANTIZATION_JOINT_WEIGHTS) {
+                            for(size_t i = 0; i < _gen_acc.weights_accessors.size(); i++) {
+                                _QuantizeSingleAttributeAccessorDataToBuffer<TRS::Vector4<uint8_t>>(_root, _gen_acc.weights_accessors[i],
+                                    _prim.joint_weight_buffer_ids[i],
+                                    _prim.joint_weight_buffer_offsets[i],
+                                    _buffer,
+                                    [this](BufferAccessorData &_acc, uint32_t _index) {
+                                        return Quantization::EncodeJointWeights(_GetJointWeights(_acc, _index));
+                                    });
+                            }
+                            quant.used |= LIBDAS_QUANTIZATION_JOINT_WEIGHTS;
+                        } else {
+                            _RewriteMultiAttributeAccessorsDataToBuffer(_root,
+                                                                        _gen_acc.weights_accessors,
+                                                                        _prim.joint_weight_buffer_ids,
+                                                                        _prim.joint_weight_buffer_offsets,
+                                                                        _buffer,
+                                                                        &GLTFCompiler::_GetJointWeights);
+                        }
                     }
+
+                    // only attributes that are present are flagged as quantized
+                    _prim.quantization = quant.used;
+                    _prim.position_offset = quant.position_offset;
+                    _prim.position_scale = quant.position_scale;
+                    _prim.uv_offset = quant.uv_offset;
+                    _prim.uv_scale = quant.uv_scale;
+                    if(quant.used)
+                        _buffer.type |= LIBDAS_BUFFER_TYPE_QUANTIZED;
                 }
             }
 
+            /**
+             * Find the mesh buffer fragment, that starts at given buffer offset
+             * @param _first_fragment specifies the first fragment to search from
+             * @param _offset specifies the buffer offset of the fragment
+             * @return index of the fragment in DasBuffer::data_ptrs
+             */
+            size_t _FindFragment(const DasBuffer &_buffer, size_t _first_fragment, uint32_t _offset);
+            /**
+             * Replace a vertex attribute fragment of the mesh buffer with its remapped copy
+             * @param _first_fragment specifies the first fragment, that was written for the current mesh primitive
+             * @param _offset specifies the buffer offset of the attribute
+             * @param _elem_size specifies the size of a single attribute value in bytes
+             * @param _remap specifies the vertex remap table from MeshOptimizer::OptimizeVertexFetch()
+             */
+            void _RemapVertexFragment(DasBuffer &_buffer, size_t _first_fragment, uint32_t _offset, size_t _elem_size, const std::vector<uint32_t> &_remap);
+
+            /**
+             * Remap all vertex attributes of a mesh primitive or morph target
+             */
+            template<typename T>
+            void _RemapPrimitiveVertices(DasBuffer &_buffer, size_t _first_fragment, const T &_prim, const std::vector<uint32_t> &_remap) {
+                VertexQuantization quant = LIBDAS_QUANTIZATION_NONE;
+                if constexpr(std::is_base_of<DasMeshPrimitive, T>::value)
+                    quant = _prim.quantization;
+
+                _RemapVertexFragment(_buffer, _first_fragment, _prim.vertex_buffer_offset, 
+                                     quant & LIBDAS_QUANTIZATION_POSITION ? LIBDAS_QUANTIZED_POSITION_SIZE : sizeof(TRS::Vector3<float>), _remap);
+                if(_prim.vertex_normal_buffer_id != UINT32_MAX) {
+                    _RemapVertexFragment(_buffer, _first_fragment, _prim.vertex_normal_buffer_offset, 
+                                         quant & LIBDAS_QUANTIZATION_NORMAL ? LIBDAS_QUANTIZED_NORMAL_SIZE : sizeof(TRS::Vector3<float>), _remap);
+                }
+                if(_prim.vertex_tangent_buffer_id != UINT32_MAX) {
+                    _RemapVertexFragment(_buffer, _first_fragment, _prim.vertex_tangent_buffer_offset, 
+                                         quant & LIBDAS_QUANTIZATION_TANGENT ? LIBDAS_QUANTIZED_TANGENT_SIZE : sizeof(TRS::Vector4<float>), _remap);
+                }
+
+                for(uint32_t i = 0; i < _prim.texture_count; i++) {
+                    _RemapVertexFragment(_buffer, _first_fragment, _prim.uv_buffer_offsets[i], 
+                                         quant & LIBDAS_QUANTIZATION_UV ? LIBDAS_QUANTIZED_UV_SIZE : sizeof(TRS::Vector2<float>), _remap);
+                }
+                for(uint32_t i = 0; i < _prim.color_mul_count; i++)
+                    _RemapVertexFragment(_buffer, _first_fragment, _prim.color_mul_buffer_offsets[i], sizeof(TRS::Vector4<float>), _remap);
+
+                if constexpr(std::is_base_of<DasMeshPrimitive, T>::value) {
+                    for(uint32_t i = 0; i < _prim.joint_set_count; i++) {
+                        _RemapVertexFragment(_buffer, _first_fragment, _prim.joint_index_buffer_offsets[i], sizeof(TRS::Vector4<uint16_t>), _remap);
+                        _RemapVertexFragment(_buffer, _first_fragment, _prim.joint_weight_buffer_offsets[i], 
+                                             quant & LIBDAS_QUANTIZATION_JOINT_WEIGHTS ? LIBDAS_QUANTIZED_JOINT_WEIGHTS_SIZE : sizeof(TRS::Vector4<float>), _remap);
+                    }
+                }
+            }
+
+            /**
+             * Point all mesh buffer offsets of a mesh primitive or morph target to deduplicated buffer regions
+             * @param _dedup specifies a reference to BufferDeduplicator object, that deduplicated the mesh buffer
+             */
+            template<typename T>
+            void _RemapPrimitiveBufferOffsets(const BufferDeduplicator &_dedup, T &_prim) {
+                _prim.vertex_buffer_offset = _dedup.RemapOffset(_prim.vertex_buffer_offset);
+                if(_prim.vertex_normal_buffer_id != UINT32_MAX)
+                    _prim.vertex_normal_buffer_offset = _dedup.RemapOffset(_prim.vertex_normal_buffer_offset);
+                if(_prim.vertex_tangent_buffer_id != UINT32_MAX)
+                    _prim.vertex_tangent_buffer_offset = _dedup.RemapOffset(_prim.vertex_tangent_buffer_offset);
+
+                for(uint32_t i = 0; i < _prim.texture_count; i++)
+                    _prim.uv_buffer_offsets[i] = _dedup.RemapOffset(_prim.uv_buffer_offsets[i]);
+                for(uint32_t i = 0; i < _prim.color_mul_count; i++)
+                    _prim.color_mul_buffer_offsets[i] = _dedup.RemapOffset(_prim.color_mul_buffer_offsets[i]);
+
+                if constexpr(std::is_base_of<DasMeshPrimitive, T>::value) {
+                    if(_prim.index_buffer_id != UINT32_MAX)
+                        _prim.index_buffer_offset = _dedup.RemapOffset(_prim.index_buffer_offset);
+                    for(uint32_t i = 0; i < _prim.joint_set_count; i++) {
+                        _prim.joint_index_buffer_offsets[i] = _dedup.RemapOffset(_prim.joint_index_buffer_offsets[i]);
+                        _prim.joint_weight_buffer_offsets[i] = _dedup.RemapOffset(_prim.joint_weight_buffer_offsets[i]);
+                    }
+                }
+            }
+            /**
+             * Store identical mesh buffer and meshlet buffer regions once, all mesh primitives and morph targets are
+             * pointed to the remaining regions
+             * @param _buffer specifies a reference to the mesh buffer
+             */
+            void _DeduplicateMeshBuffers(DasBuffer &_buffer);
+
+            /**
+             * Optimize the last written mesh primitive for vertex cache efficiency and linear vertex fetching, morph
+             * targets of the primitive are remapped accordingly
+             * @param _first_fragment specifies the first fragment, that was written for the mesh primitive
+             * @param _vertex_count specifies the amount of vertices in the mesh primitive
+             */
+            void _OptimizeMeshPrimitive(DasBuffer &_buffer, size_t _first_fragment, uint32_t _vertex_count);
+            /**
+             * Split the last written mesh primitive into meshlets, that are appended to the meshlet buffer
+             * @param _first_fragment specifies the first fragment, that was written for the mesh primitive
+             * @param _vertex_count specifies the amount of vertices in the mesh primitive
+             */
+            void _BuildMeshlets(DasBuffer &_buffer, size_t _first_fragment, uint32_t _vertex_count);
+
             /**
              * Check if any properties are empty and if they are, supplement values from GLTFRoot::asset into it
              * @param _root specifies a reference to GLTFRoot object, where potentially supplement values are held
@@ -345,8 +583,18 @@ namespace Libdas {
             std::vector<DasAnimation> _CreateAnimations(const GLTFRoot &_root);
         public:
             GLTFCompiler(const std::string &_in_path, const std::string &_out_file = "", bool _use_raw_textures = false);
+            /**
+             * @param _in_path specifies the root path of the GLTF file
+             * @param _sink specifies the output sink, where the compiled DAS image is written to
+             * @param _use_raw_textures specifies whether textures should be written as raw pixel data
+             */
+            GLTFCompiler(const std::string &_in_path, const std::shared_ptr<OutputSink> &_sink, bool _use_raw_textures = false);
+            /**
+             * @param _quantization specifies which vertex attributes of mesh primitives are written quantized
+             */
             GLTFCompiler(const std::string &_in_path, GLTFRoot &_root, const DasProperties &_props, 
-                         const std::string &_out_file = "", const std::vector<std::string> &_embedded_textures = {}, bool _use_raw_textures = false);
+                         const std::string &_out_file = "", const std::vector<std::string> &_embedded_textures = {}, bool _use_raw_textures = false,
+                         VertexQuantization _quantization = LIBDAS_QUANTIZATION_NONE);
             ~GLTFCompiler();
             /**
              * Compile the DAS file from given GLTFRoot structure
@@ -355,6 +603,50 @@ namespace Libdas {
              * @param _out_file optinally specifes a new output file name to use
              */
             void Compile(GLTFRoot &_root, const DasProperties &_props, const std::vector<std::string> &_embedded_textures, const std::string &_out_file = "");
+
+            /**
+             * Set vertex attributes of mesh primitives, which are quantized in compiled files
+             * @param _quantization specifies a bitmask of LIBDAS_QUANTIZATION_* flags
+             */
+            inline void SetVertexQuantization(VertexQuantization _quantization) {
+                m_quantization = _quantization;
+            }
+
+            /**
+             * Enable or disable vertex cache and vertex fetch optimization of indexed triangle mesh primitives, see MeshOptimizer
+             * @param _optimize specifies if mesh primitives should be optimized, disabled by default
+             */
+            inline void SetMeshOptimization(bool _optimize) {
+                m_optimize_meshes = _optimize;
+            }
+
+            /**
+             * Enable or disable meshlet generation for indexed triangle mesh primitives, see MeshletBuilder
+             * @param _build specifies if meshlets should be generated, disabled by default
+             */
+            inline void SetMeshletGeneration(bool _build) {
+                m_build_meshlets = _build;
+            }
+
+            /**
+             * Enable or disable bounding volume hierarchy generation over world space bounding volumes of scene nodes,
+             * see BvhBuilder
+             * @param _build specifies if a BVH scope should be written for each scene, disabled by default
+             */
+            inline void SetBvhGeneration(bool _build) {
+                m_build_bvhs = _build;
+            }
+
+            /**
+             * Enable or disable storing identical vertex attribute, index and meshlet data once, see BufferDeduplicator
+             * @param _deduplicate specifies if identical buffer regions should be shared between mesh primitives, disabled by default
+             */
+            inline void SetBufferDeduplication(bool _deduplicate) {
+                m_deduplicate_buffers = _deduplicate;
+            }
+
+            using DasWriterCore::CloseStream;
+            using DasWriterCore::SetBlobStore;
     };
 }
 
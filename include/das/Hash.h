@@ -9,10 +9,16 @@
 #ifdef HASH_CPP
     #include <cstddef>
     #include <cstdint>
+    #include <cstring>
 
     #include "das/Api.h"
     #define PRIME   0x9E3779B1   
+    #define PRIME64_1   0x9E3779B185EBCA87ULL
+    #define PRIME64_2   0xC2B2AE3D27D4EB4FULL
+    #define PRIME64_3   0x165667B19E3779F9ULL
 #endif
+#include <cstddef>
+#include <cstdint>
 
 namespace Libdas {
 
@@ -22,6 +28,12 @@ namespace Libdas {
      * @param _len specifies the data length in bytes
      */
     uint32_t HashFunc(char const* _data, size_t _len);
+    /**
+     * 64 bit content hashing function for large data regions, where 32 bit hashes would collide too often
+     * @param _data specifies any arbitrary data pointer
+     * @param _len specifies the data length in bytes
+     */
+    LIBDAS_API uint64_t HashFunc64(char const* _data, size_t _len);
 
     template <class T>
     struct LIBDAS_API Hash {
@@ -0,0 +1,68 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: KeywordMatcher.h - compile time keyword lookup table header
+// author: Karl-Mihkel Ott
+
+#ifndef KEYWORD_MATCHER_H
+#define KEYWORD_MATCHER_H
+
+namespace Libdas {
+
+    template<typename T>
+    struct Keyword {
+        std::string_view name;
+        T value;
+    };
+
+
+    /**
+     * Constant lookup table for a fixed set of keywords, that is built at compile time.
+     * Keywords are bucketed by their length, thus a lookup compares the given word only against keywords of the
+     * same length without hashing or allocating anything.
+     * @tparam T specifies the value type associated with each keyword
+     * @tparam N specifies the total amount of keywords
+     * @tparam MAX_LEN specifies the maximum keyword length
+     */
+    template<typename T, size_t N, size_t MAX_LEN = 32>
+    class KeywordMatcher {
+        private:
+            std::array<Keyword<T>, N> m_keywords = {};
+            // m_offsets[len] is the index of the first keyword with length len
+            std::array<uint16_t, MAX_LEN + 2> m_offsets = {};
+            T m_unknown;
+
+        public:
+            constexpr KeywordMatcher(const Keyword<T> (&_keywords)[N], T _unknown) : m_unknown(_unknown) {
+                // count keywords per length
+                for(size_t i = 0; i < N; i++)
+                    m_offsets[_keywords[i].name.size() + 1]++;
+
+                for(size_t i = 1; i < m_offsets.size(); i++)
+                    m_offsets[i] += m_offsets[i - 1];
+
+                // place keywords into their length buckets
+                std::array<uint16_t, MAX_LEN + 2> pos = m_offsets;
+                for(size_t i = 0; i < N; i++)
+                    m_keywords[pos[_keywords[i].name.size()]++] = _keywords[i];
+            }
+
+            /**
+             * Find the value associated with given word
+             * @param _word specifies the word to look up
+             * @return value associated with the keyword or unknown value if no such keyword exists
+             */
+            constexpr T Find(std::string_view _word) const {
+                if(_word.size() > MAX_LEN)
+                    return m_unknown;
+
+                for(uint16_t i = m_offsets[_word.size()]; i < m_offsets[_word.size() + 1]; i++) {
+                    if(m_keywords[i].name == _word)
+                        return m_keywords[i].value;
+                }
+
+                return m_unknown;
+            }
+    };
+}
+
+#endif
@@ -49,6 +49,19 @@
 
 // DAS format handling related includes
 #include "das/DasStructures.h"
+#include "das/VertexQuantization.h"
+#include "das/MeshOptimizer.h"
+#include "das/MeshletBuilder.h"
+#include "das/BoundingVolumes.h"
+#include "das/BvhBuilder.h"
+#include "das/BufferDeduplicator.h"
+#include "das/DasArena.h"
+#include "das/DasBlobStore.h"
+#include "das/DasSceneGraph.h"
+#include "das/MappedFile.h"
+#include "das/RandomAccessFile.h"
+#include "das/OutputSink.h"
+#include "das/FileWriter.h"
 #include "das/DasWriterCore.h"
 
 // Wavefront OBJ format handling related includes
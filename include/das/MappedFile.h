@@ -0,0 +1,96 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: MappedFile.h - memory mapped file class header
+// author: Karl-Mihkel Ott
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#ifdef MAPPED_FILE_CPP
+    #include <cstdint>
+    #include <cstring>
+    #include <string>
+    #include <vector>
+    #include <iostream>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+    #include "das/Api.h"
+    #include "das/ErrorHandlers.h"
+#endif
+
+namespace Libdas {
+
+    /**
+     * Read-only file view mapped into the process address space. Mapped pages are private copy-on-write pages,
+     * meaning that the data can be modified in memory without it ever being written back to the file.
+     */
+    class LIBDAS_API MappedFile {
+        private:
+            std::string m_file_name;
+            char *m_data = nullptr;
+            size_t m_size = 0;
+            // in-memory images are owned by the view instead of being mapped from a file
+            std::vector<char> m_image;
+#ifdef _WIN32
+            void *m_file_handle = nullptr;
+            void *m_mapping_handle = nullptr;
+#else
+            int m_fd = -1;
+#endif
+
+        private:
+            /**
+             * Release all mapping and file handles
+             */
+            void _Unmap();
+
+        public:
+            MappedFile(const std::string &_file_name);
+            /**
+             * Use an in-memory image in place of a file mapping
+             * @param _image specifies the image data, that is moved into the view
+             * @param _name specifies an optional name for diagnostics
+             */
+            MappedFile(std::vector<char> &&_image, const std::string &_name = "");
+            MappedFile(const MappedFile &_file) = delete;
+            MappedFile(MappedFile &&_file) noexcept;
+            ~MappedFile();
+
+            void operator=(const MappedFile &_file) = delete;
+
+            /**
+             * Check if given memory area belongs to the current mapping
+             * @param _ptr specifies the beginning of the memory area
+             * @param _len specifies the length of the memory area in bytes
+             * @return true if the memory area is completely inside the mapping, false otherwise
+             */
+            inline bool Contains(const char *_ptr, size_t _len = 0) const {
+                return _ptr >= m_data && _ptr + _len <= m_data + m_size;
+            }
+
+            ////////////////////////////////
+            // ***** Getter methods ***** //
+            ////////////////////////////////
+            inline char *GetData() const {
+                return m_data;
+            }
+
+            inline size_t GetSize() const {
+                return m_size;
+            }
+
+            inline const std::string &GetFileName() const {
+                return m_file_name;
+            }
+    };
+}
+
+#endif
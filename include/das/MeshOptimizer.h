@@ -0,0 +1,110 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: MeshOptimizer.h - vertex cache and vertex fetch optimization class header
+// author: Karl-Mihkel Ott
+
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#ifdef MESH_OPTIMIZER_CPP
+    #include <cstring>
+    #include <cmath>
+    #include <algorithm>
+
+    #include "das/Api.h"
+    #include "das/LibdasAssert.h"
+#endif
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// size of the simulated post-transform vertex cache that is used for analysis
+#define LIBDAS_MESH_OPTIMIZER_CACHE_SIZE    16
+// size of the LRU cache that is used for scoring vertices during triangle reordering
+#define LIBDAS_MESH_OPTIMIZER_SCORE_CACHE_SIZE  32
+
+namespace Libdas {
+
+    /**
+     * Post-transform vertex cache efficiency of an indexed triangle list
+     */
+    struct VertexCacheStatistics {
+        // average cache miss ratio, transformed vertices per triangle, ranges from 0.5 to 3.0
+        float acmr = 0.0f;
+        // average transformed to vertex ratio, transformed vertices per referenced vertex, 1.0 is optimal
+        float atvr = 0.0f;
+        uint32_t transformed_vertex_count = 0;
+    };
+
+
+    /**
+     * Reorder indexed triangle lists for better GPU vertex processing efficiency. Triangles are reordered with Forsyth's
+     * linear speed vertex cache optimization algorithm, after which vertices can be renumbered in the order of their
+     * first use, thus vertex buffers are fetched close to linearly. The index array is modified in place, while vertex
+     * streams must be remapped by the caller with the table returned from OptimizeVertexFetch().
+     */
+    class LIBDAS_API MeshOptimizer {
+        private:
+            uint32_t *m_indices;
+            const uint32_t m_index_count;
+            const uint32_t m_vertex_count;
+
+        private:
+            /**
+             * Calculate the score of a vertex according to its position in the LRU cache and its remaining valence
+             * @param _cache_pos specifies the position of the vertex in the cache, negative if not in the cache
+             * @param _valence specifies the amount of triangles, that use the vertex and are not yet emitted
+             * @return vertex score
+             */
+            float _FindVertexScore(int32_t _cache_pos, uint32_t _valence) const;
+
+        public:
+            /**
+             * @param _indices specifies the triangle list indices, that are reordered in place
+             * @param _index_count specifies the amount of indices, trailing indices that do not form a triangle are left untouched
+             * @param _vertex_count specifies the amount of vertices, that indices can reference
+             */
+            MeshOptimizer(uint32_t *_indices, uint32_t _index_count, uint32_t _vertex_count);
+
+            /**
+             * Reorder triangles to minimize post-transform vertex cache misses. Winding order of each triangle is
+             * preserved.
+             */
+            void OptimizeVertexCache();
+            /**
+             * Renumber vertices in the order of their first use in the index array. Vertices that are not referenced
+             * are moved after all referenced vertices, keeping their relative order.
+             * @return remap table, where the value at old vertex index is the new vertex index
+             */
+            std::vector<uint32_t> OptimizeVertexFetch();
+            /**
+             * Simulate a FIFO post-transform vertex cache over the index array
+             * @param _cache_size specifies the amount of vertices that fit into the simulated cache
+             * @return VertexCacheStatistics object, containing ACMR and ATVR values
+             */
+            VertexCacheStatistics AnalyzeVertexCache(uint32_t _cache_size = LIBDAS_MESH_OPTIMIZER_CACHE_SIZE) const;
+
+            /**
+             * Reorder vertex stream elements according to the remap table from OptimizeVertexFetch()
+             * @param _dst specifies the memory area where remapped elements are written to, must not overlap with _src
+             * @param _src specifies the vertex stream that is remapped
+             * @param _stride specifies the size of a single element in bytes
+             * @param _remap specifies the remap table
+             */
+            static void RemapVertexStream(char *_dst, const char *_src, size_t _stride, const std::vector<uint32_t> &_remap);
+            /**
+             * Reorder vertex elements in place according to the remap table from OptimizeVertexFetch()
+             * @param _vertices specifies an std::vector instance that is remapped
+             * @param _remap specifies the remap table
+             */
+            template<typename T>
+            static void RemapVertices(std::vector<T> &_vertices, const std::vector<uint32_t> &_remap) {
+                std::vector<T> remapped(_vertices.size());
+                for(size_t i = 0; i < _vertices.size() && i < _remap.size(); i++)
+                    remapped[_remap[i]] = _vertices[i];
+                _vertices.swap(remapped);
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,123 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: MeshletBuilder.h - meshlet generation class header
+// author: Karl-Mihkel Ott
+
+#ifndef MESHLET_BUILDER_H
+#define MESHLET_BUILDER_H
+
+#ifdef MESHLET_BUILDER_CPP
+    #include <cstring>
+    #include <cmath>
+    #include <string>
+    #include <vector>
+    #include <algorithm>
+    #include <atomic>
+    #include <thread>
+
+    #include "trs/Points.h"
+    #include "trs/Vector.h"
+    #include "trs/Matrix.h"
+    #include "trs/Quaternion.h"
+
+    #include "das/Api.h"
+    #include "das/LibdasAssert.h"
+    #include "das/RandomAccessFile.h"
+    #include "das/DasStructures.h"
+#endif
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// default meshlet limits, that fit into mesh shader workgroup output limits of all major vendors
+#define LIBDAS_MESHLET_MAX_VERTICES         64
+#define LIBDAS_MESHLET_MAX_TRIANGLES        124
+// amount of triangles that are partitioned into meshlets by a single task
+#define LIBDAS_MESHLET_TASK_TRIANGLES       (1 << 16)
+
+namespace Libdas {
+
+    /**
+     * Split indexed triangle lists into meshlets with bounding spheres and normal cones. Triangles are grouped greedily
+     * in index order, thus meshlets are most compact when indices are vertex cache optimized beforehand. Large index
+     * arrays are split into fixed size tasks, that are processed in parallel, meaning that the output does not depend
+     * on the thread count.
+     */
+    class LIBDAS_API MeshletBuilder {
+        private:
+            const uint32_t *m_indices;
+            const uint32_t m_index_count;
+            const TRS::Point3D<float> *m_positions;
+            const uint32_t m_vertex_count;
+            const uint32_t m_max_vertices;
+            const uint32_t m_max_triangles;
+
+            std::vector<DasMeshlet> m_meshlets;
+            std::vector<uint32_t> m_meshlet_vertices;
+            std::vector<uint8_t> m_meshlet_triangles;
+
+            // meshlets of a single task, offsets are element offsets into task local vertex and triangle arrays
+            struct Partition {
+                std::vector<DasMeshlet> meshlets;
+                std::vector<uint32_t> vertices;
+                std::vector<uint8_t> triangles;
+            };
+
+        private:
+            /**
+             * Partition a range of triangles into meshlets
+             * @param _first_triangle specifies the first triangle of the range
+             * @param _triangle_count specifies the amount of triangles in the range
+             * @param _partition specifies a reference to Partition object, where meshlets are written to
+             */
+            void _PartitionTriangles(uint32_t _first_triangle, uint32_t _triangle_count, Partition &_partition) const;
+            /**
+             * Calculate the bounding sphere and normal cone of a meshlet
+             * @param _meshlet specifies a reference to DasMeshlet object, whose element offsets are used
+             * @param _partition specifies a reference to Partition object, that contains meshlet vertices and triangles
+             */
+            void _CalculateBounds(DasMeshlet &_meshlet, const Partition &_partition) const;
+
+        public:
+            /**
+             * @param _indices specifies the triangle list indices
+             * @param _index_count specifies the amount of indices
+             * @param _positions specifies vertex positions, that indices point to
+             * @param _vertex_count specifies the amount of vertex positions
+             * @param _max_vertices specifies the maximum amount of unique vertices per meshlet, at most 256
+             * @param _max_triangles specifies the maximum amount of triangles per meshlet
+             */
+            MeshletBuilder(const uint32_t *_indices, uint32_t _index_count, const TRS::Point3D<float> *_positions, uint32_t _vertex_count,
+                           uint32_t _max_vertices = LIBDAS_MESHLET_MAX_VERTICES, uint32_t _max_triangles = LIBDAS_MESHLET_MAX_TRIANGLES);
+
+            /**
+             * Build meshlets from given triangles
+             * @param _thread_count specifies the amount of threads to use, 0 to use all hardware threads
+             */
+            void Build(uint32_t _thread_count = 1);
+
+            /**
+             * Find the size of meshlet data in LIBDAS_BUFFER_TYPE_MESHLET buffer layout, the size is always a multiple of 4
+             * @return size of meshlet data in bytes
+             */
+            size_t GetSerializedSize() const;
+            /**
+             * Write meshlet descriptors, meshlet vertices and meshlet triangles in LIBDAS_BUFFER_TYPE_MESHLET buffer layout
+             * @param _dst specifies the memory area of at least GetSerializedSize() bytes
+             */
+            void Serialize(char *_dst) const;
+
+            ////////////////////////////////
+            // ***** Getter methods ***** //
+            ////////////////////////////////
+            inline uint32_t GetMeshletCount() const {
+                return static_cast<uint32_t>(m_meshlets.size());
+            }
+
+            inline const std::vector<DasMeshlet> &GetMeshlets() const {
+                return m_meshlets;
+            }
+    };
+}
+
+#endif
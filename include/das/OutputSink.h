@@ -0,0 +1,144 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: OutputSink.h - DAS writer output sink classes header
+// author: Karl-Mihkel Ott
+
+#ifndef OUTPUT_SINK_H
+#define OUTPUT_SINK_H
+
+#ifdef OUTPUT_SINK_CPP
+    #include <cstdint>
+    #include <cstring>
+    #include <string>
+    #include <vector>
+    #include <functional>
+    #include <algorithm>
+
+    #include "das/Api.h"
+    #include "das/RandomAccessFile.h"
+#endif
+
+#include <cstdint>
+#include <vector>
+#include <functional>
+
+/// Size of the intermediate buffer used when data cannot be copied between files inside the kernel
+#define LIBDAS_OUTPUT_SINK_COPY_BUFFER_SIZE     (1024 * 1024)
+
+namespace Libdas {
+
+    class RandomAccessFile;
+
+    /**
+     * Destination of DAS writer output. Data is always appended to the end of the sink, with the exception of
+     * positional writes that patch already written data.
+     */
+    class LIBDAS_API OutputSink {
+        public:
+            virtual ~OutputSink() = default;
+
+            /**
+             * Append data to the end of the sink
+             * @param _data specifies a pointer to the data
+             * @param _len specifies the amount of bytes to write
+             * @return true if all bytes were written, false otherwise
+             */
+            virtual bool Write(const char *_data, size_t _len) = 0;
+            /**
+             * Overwrite already written data at specified offset without changing the append position
+             * @param _offset specifies the absolute offset in bytes
+             * @param _data specifies a pointer to the data
+             * @param _len specifies the amount of bytes to write
+             * @return true if all bytes were written, false otherwise
+             */
+            virtual bool WriteAt(uint64_t _offset, const char *_data, size_t _len) = 0;
+            /**
+             * Append multiple memory areas to the end of the sink
+             * @param _fragments specifies a pointer to an array of memory areas and their lengths
+             * @param _count specifies the amount of memory areas
+             * @return true if all bytes were written, false otherwise
+             */
+            virtual bool WriteVectored(const std::pair<const char*, size_t> *_fragments, size_t _count);
+            /**
+             * Append data from a file to the end of the sink
+             * @param _src specifies a reference to the source file
+             * @param _offset specifies the absolute source file offset in bytes
+             * @param _len specifies the amount of bytes to copy
+             * @return true if all bytes were copied, false otherwise
+             */
+            virtual bool CopyFrom(const RandomAccessFile &_src, uint64_t _offset, size_t _len);
+            /**
+             * Hint the sink about the expected total output size
+             * @param _size specifies the expected total output size in bytes
+             */
+            virtual void Preallocate(uint64_t _size) { (void)_size; }
+            /**
+             * Finish the output, once all data is written
+             * @return true if the output was successfully finished, false otherwise
+             */
+            virtual bool Commit() { return true; }
+    };
+
+
+    /**
+     * Output sink that keeps the whole written image in memory. The image can be parsed directly with DasParser.
+     */
+    class LIBDAS_API MemorySink : public OutputSink {
+        private:
+            std::vector<char> m_image;
+
+        public:
+            /**
+             * @param _reserve specifies the amount of bytes to preallocate for the image
+             */
+            MemorySink(size_t _reserve = 0);
+
+            bool Write(const char *_data, size_t _len) override;
+            bool WriteAt(uint64_t _offset, const char *_data, size_t _len) override;
+            bool CopyFrom(const RandomAccessFile &_src, uint64_t _offset, size_t _len) override;
+            void Preallocate(uint64_t _size) override;
+
+            /**
+             * Move the written image out of the sink, the sink is empty afterwards
+             * @return std::vector instance containing the whole image
+             */
+            std::vector<char> ReleaseImage();
+
+            ////////////////////////////////
+            // ***** Getter methods ***** //
+            ////////////////////////////////
+            inline const std::vector<char> &GetImage() const {
+                return m_image;
+            }
+    };
+
+
+    /**
+     * Output sink that passes all data to a user callback. Appends are reported with increasing offsets, while
+     * the header is patched with a callback call at offset smaller than the amount of already written bytes, once
+     * the writer is closed. Callbacks that cannot seek should hold back the first sizeof(DasHeader) bytes until then.
+     */
+    class LIBDAS_API CallbackSink : public OutputSink {
+        public:
+            typedef std::function<bool(uint64_t _offset, const char *_data, size_t _len)> WriteCallback;
+
+        private:
+            WriteCallback m_callback;
+            uint64_t m_size = 0;
+
+        public:
+            CallbackSink(const WriteCallback &_callback);
+
+            bool Write(const char *_data, size_t _len) override;
+            bool WriteAt(uint64_t _offset, const char *_data, size_t _len) override;
+
+            ////////////////////////////////
+            // ***** Getter methods ***** //
+            ////////////////////////////////
+            inline uint64_t GetSize() const {
+                return m_size;
+            }
+    };
+}
+
+#endif
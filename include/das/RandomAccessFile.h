@@ -0,0 +1,70 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: RandomAccessFile.h - positional file reader class header
+// author: Karl-Mihkel Ott
+
+#ifndef RANDOM_ACCESS_FILE_H
+#define RANDOM_ACCESS_FILE_H
+
+#ifdef RANDOM_ACCESS_FILE_CPP
+    #include <cstdint>
+    #include <string>
+    #include <vector>
+    #include <iostream>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+    #include "das/Api.h"
+    #include "das/ErrorHandlers.h"
+#endif
+
+namespace Libdas {
+
+    /**
+     * Read-only file handle that reads data from arbitrary file offsets without any shared read position,
+     * thus reads can be issued from multiple threads at once
+     */
+    class LIBDAS_API RandomAccessFile {
+        // file writer copies data between file handles without passing it through userspace
+        friend class FileWriter;
+
+        private:
+            std::string m_file_name;
+#ifdef _WIN32
+            void *m_file_handle = nullptr;
+#else
+            int m_fd = -1;
+#endif
+
+        public:
+            RandomAccessFile(const std::string &_file_name);
+            RandomAccessFile(const RandomAccessFile &_file) = delete;
+            ~RandomAccessFile();
+
+            void operator=(const RandomAccessFile &_file) = delete;
+
+            /**
+             * Read data from specified file offset
+             * @param _offset specifies the absolute file offset in bytes
+             * @param _dst specifies the destination memory area, that is at least _len bytes long
+             * @param _len specifies the amount of bytes to read
+             * @return true if all bytes were read, false otherwise
+             */
+            bool Read(uint64_t _offset, char *_dst, size_t _len) const;
+
+            ////////////////////////////////
+            // ***** Getter methods ***** //
+            ////////////////////////////////
+            inline const std::string &GetFileName() const {
+                return m_file_name;
+            }
+    };
+}
+
+#endif
@@ -29,7 +29,12 @@
     #include "das/LibdasAssert.h"
     #include "das/ErrorHandlers.h"
     #include "das/DasStructures.h"
+    #include "das/BoundingVolumes.h"
+    #include "das/MeshOptimizer.h"
+    #include "das/MeshletBuilder.h"
     #include "das/TextureReader.h"
+    #include "das/OutputSink.h"
+    #include "das/FileWriter.h"
     #include "das/DasWriterCore.h"
     #include "das/STLStructures.h"
 #endif
@@ -54,6 +59,14 @@ namespace Libdas {
             std::vector<TRS::Point3D<float>> m_unique_positions;
             std::vector<TRS::Point3D<float>> m_unique_normals;
             std::vector<uint32_t> m_indices;
+            // bounding volume of all unique positions, that is shared by mesh primitives, the mesh and the scene
+            DasBoundingVolume m_bounds;
+            bool m_optimize_meshes = false;
+
+            // meshlet buffer, that is written after the vertex buffer
+            bool m_build_meshlets = false;
+            std::vector<char> m_meshlet_data;
+            uint32_t m_meshlet_count = 0;
 
         private:
             /**
@@ -61,6 +74,14 @@ namespace Libdas {
              * @param _objects specifies a reference to const std::vector instance, containing all STL objects
              */
             void _IndexVertices(const std::vector<STLObject> &_objects);
+            /**
+             * Reorder indexed triangles for vertex cache efficiency and vertices for linear vertex fetching
+             */
+            void _OptimizeVertices();
+            /**
+             * Split indexed triangles into meshlets, that all mesh primitives share
+             */
+            void _BuildMeshlets();
             /**
              * Create a buffer object from parsed or generated vertices, normals and indices 
              * @return DasBuffer instance containing data
@@ -86,6 +107,10 @@ namespace Libdas {
 
         public:
             STLCompiler(const std::string &_out_file = "");
+            /**
+             * @param _sink specifies the output sink, where the compiled DAS image is written to
+             */
+            STLCompiler(const std::shared_ptr<OutputSink> &_sink);
             STLCompiler(std::vector<STLObject> &_objects, DasProperties &_props, std::string &_out_file);
 
             /**
@@ -95,7 +120,26 @@ namespace Libdas {
              * @param _out_file is an optional argument that specifies the output file name, if the file name was given in constructor 
              * it can be ignored
              */
-            void Compile(const std::vector<STLObject> &_objects, DasProperties &_props, const std::string &_out_file);
+            void Compile(const std::vector<STLObject> &_objects, DasProperties &_props, const std::string &_out_file = "");
+
+            /**
+             * Enable or disable vertex cache and vertex fetch optimization of compiled meshes, see MeshOptimizer
+             * @param _optimize specifies if meshes should be optimized, disabled by default
+             */
+            inline void SetMeshOptimization(bool _optimize) {
+                m_optimize_meshes = _optimize;
+            }
+
+            /**
+             * Enable or disable meshlet generation for compiled meshes, see MeshletBuilder
+             * @param _build specifies if meshlets should be generated, disabled by default
+             */
+            inline void SetMeshletGeneration(bool _build) {
+                m_build_meshlets = _build;
+            }
+
+            using DasWriterCore::CloseStream;
+            using DasWriterCore::SetBlobStore;
     };
 }
 
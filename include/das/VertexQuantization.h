@@ -0,0 +1,73 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: VertexQuantization.h - vertex attribute quantization functions header
+// author: Karl-Mihkel Ott
+
+#ifndef VERTEX_QUANTIZATION_H
+#define VERTEX_QUANTIZATION_H
+
+#ifdef VERTEX_QUANTIZATION_CPP
+    #include <cstdint>
+    #include <cmath>
+    #include <algorithm>
+
+    #include "trs/Vector.h"
+    #include "trs/Points.h"
+
+    #include "das/Api.h"
+#endif
+
+namespace Libdas {
+
+    /**
+     * Encoding and decoding functions for quantized vertex attributes, see LIBDAS_QUANTIZATION_* flags
+     */
+    namespace Quantization {
+        /**
+         * Quantize a value into unsigned normalized 16 bit integer
+         * @param _value specifies the value to quantize
+         * @param _offset specifies the smallest value in the quantized range
+         * @param _scale specifies the size of the quantized range
+         * @return quantized value
+         */
+        LIBDAS_API uint16_t EncodeUnorm16(float _value, float _offset, float _scale);
+        /**
+         * Decode an unsigned normalized 16 bit integer
+         * @param _value specifies the quantized value
+         * @param _offset specifies the smallest value in the quantized range
+         * @param _scale specifies the size of the quantized range
+         * @return decoded value
+         */
+        LIBDAS_API float DecodeUnorm16(uint16_t _value, float _offset, float _scale);
+
+        /**
+         * Find the dequantization scale for a value range, degenerate ranges are given a scale of 1
+         * @param _min specifies the smallest value in the range
+         * @param _max specifies the largest value in the range
+         * @return range size that is used as a dequantization scale
+         */
+        LIBDAS_API float FindScale(float _min, float _max);
+
+        /**
+         * Encode a unit vector into octahedral signed normalized 16 bit integer pair
+         * @param _dir specifies the unit vector to encode
+         * @return octahedral encoding of the vector
+         */
+        LIBDAS_API TRS::Vector2<int16_t> EncodeOctahedral(const TRS::Vector3<float> &_dir);
+        /**
+         * Decode an octahedral signed normalized 16 bit integer pair into a unit vector
+         * @param _oct specifies the octahedral encoding
+         * @return normalised unit vector
+         */
+        LIBDAS_API TRS::Vector3<float> DecodeOctahedral(const TRS::Vector2<int16_t> &_oct);
+
+        /**
+         * Quantize joint weights into unsigned normalized 8 bit integers, which always sum up to 255
+         * @param _weights specifies the joint weights to quantize
+         * @return quantized joint weights
+         */
+        LIBDAS_API TRS::Vector4<uint8_t> EncodeJointWeights(const TRS::Vector4<float> &_weights);
+    }
+}
+
+#endif
@@ -39,7 +39,13 @@
     #include "das/HuffmanCompression.h"
     #include "das/WavefrontObjStructures.h"
     #include "das/DasStructures.h"
+    #include "das/BoundingVolumes.h"
+    #include "das/MeshOptimizer.h"
+    #include "das/MeshletBuilder.h"
+    #include "das/BufferDeduplicator.h"
     #include "das/TextureReader.h"
+    #include "das/OutputSink.h"
+    #include "das/FileWriter.h"
     #include "das/DasWriterCore.h"
 #endif
 
@@ -67,6 +73,18 @@ namespace Libdas {
             std::vector<uint32_t> m_indices;
 
             std::vector<uint32_t> m_indices_offsets_per_group;
+            bool m_optimize_meshes = false;
+
+            // groups with identical indices refer to the index range of their first occurrence
+            bool m_deduplicate_buffers = false;
+            std::vector<size_t> m_index_source_groups;
+
+            // meshlet buffer, that is written after all other buffers
+            bool m_build_meshlets = false;
+            std::vector<char> m_meshlet_data;
+            uint32_t m_meshlet_buffer_id = UINT32_MAX;
+            std::vector<uint32_t> m_meshlet_offsets_per_group;
+            std::vector<uint32_t> m_meshlet_counts_per_group;
 
         private:
             /**
@@ -104,9 +122,29 @@ namespace Libdas {
              * @param _data specifies a reference to WavefrontObjData object
              */
             void _ReindexFaces(WavefrontObjData &_data);
+            /**
+             * Store identical index ranges of groups once, groups with identical faces share the same index buffer offset
+             * @param _data specifies a reference to WavefrontObjData object
+             */
+            void _DeduplicateIndices(const WavefrontObjData &_data);
+            /**
+             * Reorder triangles of each group for vertex cache efficiency and renumber all unique vertices for linear
+             * vertex fetching
+             * @param _data specifies a reference to WavefrontObjData object
+             */
+            void _OptimizeVertices(const WavefrontObjData &_data);
+            /**
+             * Split indexed triangles of each group into meshlets
+             * @param _data specifies a reference to WavefrontObjData object
+             */
+            void _BuildMeshlets(const WavefrontObjData &_data);
 
         public:
             WavefrontObjCompiler(const std::string &_out_file = "");
+            /**
+             * @param _sink specifies the output sink, where the compiled DAS image is written to
+             */
+            WavefrontObjCompiler(const std::shared_ptr<OutputSink> &_sink);
             WavefrontObjCompiler(WavefrontObjData &_data, const DasProperties &_props, const std::string &_out_file, 
                                  const std::vector<std::string> &_embedded_textures = {});
             /**
@@ -117,6 +155,33 @@ namespace Libdas {
              */
             void Compile(WavefrontObjData &_data, const DasProperties &_props, const std::string &_out_file = "", 
                          const std::vector<std::string> &_embedded_textures = {});
+
+            /**
+             * Enable or disable vertex cache and vertex fetch optimization of compiled meshes, see MeshOptimizer
+             * @param _optimize specifies if meshes should be optimized, disabled by default
+             */
+            inline void SetMeshOptimization(bool _optimize) {
+                m_optimize_meshes = _optimize;
+            }
+
+            /**
+             * Enable or disable meshlet generation for compiled meshes, see MeshletBuilder
+             * @param _build specifies if meshlets should be generated, disabled by default
+             */
+            inline void SetMeshletGeneration(bool _build) {
+                m_build_meshlets = _build;
+            }
+
+            /**
+             * Enable or disable storing identical group indices once, see BufferDeduplicator
+             * @param _deduplicate specifies if groups with identical faces should share their indices, disabled by default
+             */
+            inline void SetBufferDeduplication(bool _deduplicate) {
+                m_deduplicate_buffers = _deduplicate;
+            }
+
+            using DasWriterCore::CloseStream;
+            using DasWriterCore::SetBlobStore;
     };
 }
 
@@ -0,0 +1,267 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: BoundingVolumes.cpp - bounding volume calculation functions implementation
+// author: Karl-Mihkel Ott
+
+#define BOUNDING_VOLUMES_CPP
+#include "das/BoundingVolumes.h"
+
+namespace Libdas {
+
+    namespace Bounds {
+
+        static inline void _LoadPosition(const char *_src, float *_dst) {
+            std::memcpy(_dst, _src, 3 * sizeof(float));
+        }
+
+
+        static void _ExpandRowMajor(const TRS::Matrix4<float> &_mat, float *_elems) {
+            uint32_t i = 0;
+            for(auto it = _mat.BeginRowMajor(); it != _mat.EndRowMajor() && i < 16; it++, i++)
+                _elems[i] = *it;
+        }
+
+
+        DasBoundingVolume FromMinMax(const TRS::Point3D<float> &_min, const TRS::Point3D<float> &_max) {
+            DasBoundingVolume bounds;
+            bounds.min = _min;
+            bounds.max = _max;
+            bounds.center = { (_min.x + _max.x) * 0.5f, (_min.y + _max.y) * 0.5f, (_min.z + _max.z) * 0.5f };
+
+            const float dx = _max.x - _min.x;
+            const float dy = _max.y - _min.y;
+            const float dz = _max.z - _min.z;
+            bounds.radius = 0.5f * std::sqrt(dx * dx + dy * dy + dz * dz);
+            return bounds;
+        }
+
+
+        DasBoundingVolume FindPositionBounds(const char *_positions, size_t _stride, uint32_t _count) {
+            DasBoundingVolume bounds;
+            if(!_count)
+                return bounds;
+
+            LIBDAS_ASSERT(_stride >= 3 * sizeof(float));
+            float min[4] = { FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX };
+            float max[4] = { -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            float max_dist = 0.0f;
+            float pos[3];
+
+            // all positions except the last one can be loaded as four floats without reading past the stream end
+            const uint32_t vector_count = _count - 1;
+            uint32_t i = 0;
+
+#ifdef LIBDAS_BOUNDS_SSE
+            __m128 vmin = _mm_loadu_ps(min);
+            __m128 vmax = _mm_loadu_ps(max);
+            for(; i < vector_count; i++) {
+                const __m128 p = _mm_loadu_ps(reinterpret_cast<const float*>(_positions + i * _stride));
+                vmin = _mm_min_ps(vmin, p);
+                vmax = _mm_max_ps(vmax, p);
+            }
+            _mm_storeu_ps(min, vmin);
+            _mm_storeu_ps(max, vmax);
+#endif
+            for(; i < _count; i++) {
+                _LoadPosition(_positions + i * _stride, pos);
+                for(uint32_t j = 0; j < 3; j++) {
+                    min[j] = std::min(min[j], pos[j]);
+                    max[j] = std::max(max[j], pos[j]);
+                }
+            }
+
+            bounds = FromMinMax({ min[0], min[1], min[2] }, { max[0], max[1], max[2] });
+            const float center[3] = { bounds.center.x, bounds.center.y, bounds.center.z };
+
+            // the sphere is tightened by a second pass, that finds the farthest position from the box center
+            i = 0;
+#ifdef LIBDAS_BOUNDS_SSE
+            const __m128 cx = _mm_set1_ps(center[0]);
+            const __m128 cy = _mm_set1_ps(center[1]);
+            const __m128 cz = _mm_set1_ps(center[2]);
+            __m128 vdist = _mm_setzero_ps();
+            for(; i + 4 <= vector_count; i += 4) {
+                __m128 p0 = _mm_loadu_ps(reinterpret_cast<const float*>(_positions + i * _stride));
+                __m128 p1 = _mm_loadu_ps(reinterpret_cast<const float*>(_positions + (i + 1) * _stride));
+                __m128 p2 = _mm_loadu_ps(reinterpret_cast<const float*>(_positions + (i + 2) * _stride));
+                __m128 p3 = _mm_loadu_ps(reinterpret_cast<const float*>(_positions + (i + 3) * _stride));
+
+                // x, y and z components of four positions end up in p0, p1 and p2
+                _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+                const __m128 dx = _mm_sub_ps(p0, cx);
+                const __m128 dy = _mm_sub_ps(p1, cy);
+                const __m128 dz = _mm_sub_ps(p2, cz);
+                const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+                vdist = _mm_max_ps(vdist, dist);
+            }
+
+            float dists[4];
+            _mm_storeu_ps(dists, vdist);
+            max_dist = std::max(std::max(dists[0], dists[1]), std::max(dists[2], dists[3]));
+#endif
+            for(; i < _count; i++) {
+                _LoadPosition(_positions + i * _stride, pos);
+                const float dx = pos[0] - center[0];
+                const float dy = pos[1] - center[1];
+                const float dz = pos[2] - center[2];
+                max_dist = std::max(max_dist, dx * dx + dy * dy + dz * dz);
+            }
+
+            bounds.radius = std::min(bounds.radius, std::sqrt(max_dist));
+            return bounds;
+        }
+
+
+        DasBoundingVolume FindIndexedPositionBounds(const TRS::Point3D<float> *_positions, uint32_t _vertex_count, const uint32_t *_indices, uint32_t _index_count) {
+            // referenced positions are gathered into a tightly packed stream, so that each one is visited once
+            std::vector<bool> is_referenced(_vertex_count, false);
+            std::vector<float> gathered;
+            gathered.reserve(std::min(_index_count, _vertex_count) * 3);
+
+            for(uint32_t i = 0; i < _index_count; i++) {
+                LIBDAS_ASSERT(_indices[i] < _vertex_count);
+                if(is_referenced[_indices[i]])
+                    continue;
+
+                is_referenced[_indices[i]] = true;
+                const TRS::Point3D<float> &pos = _positions[_indices[i]];
+                gathered.push_back(pos.x);
+                gathered.push_back(pos.y);
+                gathered.push_back(pos.z);
+            }
+
+            return FindPositionBounds(reinterpret_cast<const char*>(gathered.data()), 3 * sizeof(float), static_cast<uint32_t>(gathered.size() / 3));
+        }
+
+
+        void Merge(DasBoundingVolume &_dst, const DasBoundingVolume &_src) {
+            if(_src.IsEmpty())
+                return;
+            if(_dst.IsEmpty()) {
+                _dst = _src;
+                return;
+            }
+
+            _dst.min = { std::min(_dst.min.x, _src.min.x), std::min(_dst.min.y, _src.min.y), std::min(_dst.min.z, _src.min.z) };
+            _dst.max = { std::max(_dst.max.x, _src.max.x), std::max(_dst.max.y, _src.max.y), std::max(_dst.max.z, _src.max.z) };
+
+            const float dx = _src.center.x - _dst.center.x;
+            const float dy = _src.center.y - _dst.center.y;
+            const float dz = _src.center.z - _dst.center.z;
+            const float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+            // one of the spheres already encloses the other one
+            if(dist + _src.radius <= _dst.radius)
+                return;
+            if(dist + _dst.radius <= _src.radius) {
+                _dst.center = _src.center;
+                _dst.radius = _src.radius;
+                return;
+            }
+
+            const float radius = (dist + _dst.radius + _src.radius) * 0.5f;
+            const float t = (radius - _dst.radius) / dist;
+            _dst.center = { _dst.center.x + dx * t, _dst.center.y + dy * t, _dst.center.z + dz * t };
+            _dst.radius = radius;
+        }
+
+
+        DasBoundingVolume Transform(const DasBoundingVolume &_bounds, const TRS::Matrix4<float> &_transform) {
+            if(_bounds.IsEmpty())
+                return _bounds;
+
+            float m[16];
+            _ExpandRowMajor(_transform, m);
+
+            // Arvo's method, each transformed box extent is the sum of the smaller and larger products per axis
+            const float min[3] = { _bounds.min.x, _bounds.min.y, _bounds.min.z };
+            const float max[3] = { _bounds.max.x, _bounds.max.y, _bounds.max.z };
+            const float center[3] = { _bounds.center.x, _bounds.center.y, _bounds.center.z };
+            float tmin[3], tmax[3], tcenter[3];
+            for(uint32_t i = 0; i < 3; i++) {
+                tmin[i] = tmax[i] = tcenter[i] = m[i * 4 + 3];
+                for(uint32_t j = 0; j < 3; j++) {
+                    const float a = m[i * 4 + j] * min[j];
+                    const float b = m[i * 4 + j] * max[j];
+                    tmin[i] += std::min(a, b);
+                    tmax[i] += std::max(a, b);
+                    tcenter[i] += m[i * 4 + j] * center[j];
+                }
+            }
+
+            // the sphere is scaled by the largest axis scale of the transformation
+            float max_scale = 0.0f;
+            for(uint32_t j = 0; j < 3; j++) {
+                const float scale = m[j] * m[j] + m[4 + j] * m[4 + j] + m[8 + j] * m[8 + j];
+                max_scale = std::max(max_scale, scale);
+            }
+
+            DasBoundingVolume bounds;
+            bounds.min = { tmin[0], tmin[1], tmin[2] };
+            bounds.max = { tmax[0], tmax[1], tmax[2] };
+            bounds.center = { tcenter[0], tcenter[1], tcenter[2] };
+            bounds.radius = _bounds.radius * std::sqrt(max_scale);
+            return bounds;
+        }
+
+
+        DasBoundingVolume FindMeshBounds(const DasMesh &_mesh, const std::vector<DasMeshPrimitive> &_primitives) {
+            DasBoundingVolume bounds;
+            for(uint32_t i = 0; i < _mesh.primitive_count; i++) {
+                LIBDAS_ASSERT(_mesh.primitives[i] < _primitives.size());
+                Merge(bounds, _primitives[_mesh.primitives[i]].bounds);
+            }
+
+            return bounds;
+        }
+
+
+        std::vector<DasBoundingVolume> FindNodeBounds(const DasScene &_scene, const std::vector<DasNode> &_nodes, const std::vector<DasMesh> &_meshes) {
+            std::vector<DasBoundingVolume> bounds(_nodes.size());
+
+            // scene roots are nodes, that are not children of any other scene node
+            std::vector<bool> is_child(_nodes.size(), false);
+            for(uint32_t i = 0; i < _scene.node_count; i++) {
+                const DasNode &node = _nodes[_scene.nodes[i]];
+                for(uint32_t j = 0; j < node.children_count; j++)
+                    is_child[node.children[j]] = true;
+            }
+
+            // depth first traversal with accumulated world transforms, nodes that are referenced more than once keep their first parent
+            std::vector<bool> is_visited(_nodes.size(), false);
+            std::vector<std::pair<uint32_t, TRS::Matrix4<float>>> stack;
+            for(uint32_t i = 0; i < _scene.node_count; i++) {
+                if(!is_child[_scene.nodes[i]])
+                    stack.push_back(std::make_pair(_scene.nodes[i], _nodes[_scene.nodes[i]].transform));
+            }
+
+            while(!stack.empty()) {
+                const std::pair<uint32_t, TRS::Matrix4<float>> entry = stack.back();
+                stack.pop_back();
+                if(is_visited[entry.first])
+                    continue;
+                is_visited[entry.first] = true;
+
+                const DasNode &node = _nodes[entry.first];
+                if(node.mesh < _meshes.size())
+                    bounds[entry.first] = Transform(_meshes[node.mesh].bounds, entry.second);
+
+                for(uint32_t j = 0; j < node.children_count; j++) {
+                    if(!is_visited[node.children[j]])
+                        stack.push_back(std::make_pair(node.children[j], entry.second * _nodes[node.children[j]].transform));
+                }
+            }
+
+            return bounds;
+        }
+
+
+        DasBoundingVolume FindSceneBounds(const DasScene &_scene, const std::vector<DasNode> &_nodes, const std::vector<DasMesh> &_meshes) {
+            DasBoundingVolume bounds;
+            for(const DasBoundingVolume &node_bounds : FindNodeBounds(_scene, _nodes, _meshes))
+                Merge(bounds, node_bounds);
+
+            return bounds;
+        }
+    }
+}
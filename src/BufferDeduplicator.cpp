@@ -0,0 +1,64 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: BufferDeduplicator.cpp - content based buffer region deduplication class implementation
+// author: Karl-Mihkel Ott
+
+#define BUFFER_DEDUPLICATOR_CPP
+#include "das/BufferDeduplicator.h"
+
+namespace Libdas {
+
+    uint32_t BufferDeduplicator::FindOrInsert(const char *_data, size_t _len, uint32_t _offset) {
+        if(!_len)
+            return _offset;
+
+        std::vector<Region> &regions = m_regions[HashFunc64(_data, _len)];
+        for(const Region &region : regions) {
+            // accessors that are shared between primitives point to the same memory and need no comparison
+            if(region.len == _len && (region.data == _data || !std::memcmp(region.data, _data, _len))) {
+                m_removed_size += _len;
+                return region.offset;
+            }
+        }
+
+        regions.push_back(Region{ _data, _len, _offset });
+        return _offset;
+    }
+
+
+    void BufferDeduplicator::Deduplicate(DasBuffer &_buffer) {
+        LIBDAS_ASSERT(_buffer.data_offsets.empty());
+        std::vector<std::pair<char*, size_t>> fragments;
+        fragments.reserve(_buffer.data_ptrs.size());
+        m_offsets.reserve(m_offsets.size() + _buffer.data_ptrs.size());
+
+        uint32_t offset = 0;
+        uint32_t data_len = 0;
+        for(const std::pair<char*, size_t> &fragment : _buffer.data_ptrs) {
+            const uint32_t new_offset = FindOrInsert(fragment.first, fragment.second, data_len);
+            m_offsets.push_back(std::make_pair(offset, new_offset));
+            if(new_offset == data_len) {
+                fragments.push_back(fragment);
+                data_len += static_cast<uint32_t>(fragment.second);
+            }
+
+            offset += static_cast<uint32_t>(fragment.second);
+        }
+
+        _buffer.data_ptrs = std::move(fragments);
+        _buffer.data_len = data_len;
+    }
+
+
+    uint32_t BufferDeduplicator::RemapOffset(uint32_t _offset) const {
+        // empty fragments share their offset with the next fragment, thus the last matching fragment is used
+        auto it = std::upper_bound(m_offsets.begin(), m_offsets.end(), _offset, [](uint32_t _off, const std::pair<uint32_t, uint32_t> &_entry) {
+            return _off < _entry.first;
+        });
+
+        if(it == m_offsets.begin())
+            return _offset;
+        it--;
+        return it->second + (_offset - it->first);
+    }
+}
@@ -0,0 +1,298 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: BvhBuilder.cpp - bounding volume hierarchy construction class implementation
+// author: Karl-Mihkel Ott
+
+#define BVH_BUILDER_CPP
+#include "das/BvhBuilder.h"
+
+namespace Libdas {
+
+    static inline float _HalfSurfaceArea(const float *_min, const float *_max) {
+        const float dx = _max[0] - _min[0];
+        const float dy = _max[1] - _min[1];
+        const float dz = _max[2] - _min[2];
+        return dx * dy + dy * dz + dz * dx;
+    }
+
+
+    static inline void _ExtendBox(float *_min, float *_max, const float *_src_min, const float *_src_max) {
+        for(uint32_t i = 0; i < 3; i++) {
+            _min[i] = std::min(_min[i], _src_min[i]);
+            _max[i] = std::max(_max[i], _src_max[i]);
+        }
+    }
+
+
+    BvhBuilder::BvhBuilder(const std::vector<DasBoundingVolume> &_item_bounds, uint32_t _max_leaf_items) :
+        m_max_leaf_items(std::max(_max_leaf_items, 1u))
+    {
+        m_boxes.resize(_item_bounds.size());
+        m_items.reserve(_item_bounds.size());
+        for(size_t i = 0; i < _item_bounds.size(); i++) {
+            const DasBoundingVolume &bounds = _item_bounds[i];
+            if(bounds.IsEmpty())
+                continue;
+
+            ItemBox &box = m_boxes[i];
+            box.min[0] = bounds.min.x, box.min[1] = bounds.min.y, box.min[2] = bounds.min.z;
+            box.max[0] = bounds.max.x, box.max[1] = bounds.max.y, box.max[2] = bounds.max.z;
+            for(uint32_t j = 0; j < 3; j++)
+                box.centroid[j] = (box.min[j] + box.max[j]) * 0.5f;
+            m_items.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+
+    void BvhBuilder::_CalculateBounds(BuildNode &_node, float *_cmin, float *_cmax) const {
+        for(uint32_t i = 0; i < 3; i++) {
+            _node.min[i] = _cmin[i] = FLT_MAX;
+            _node.max[i] = _cmax[i] = -FLT_MAX;
+        }
+
+        for(uint32_t i = _node.first; i < _node.first + _node.count; i++) {
+            const ItemBox &box = m_boxes[m_items[i]];
+            _ExtendBox(_node.min, _node.max, box.min, box.max);
+            _ExtendBox(_cmin, _cmax, box.centroid, box.centroid);
+        }
+    }
+
+
+    uint32_t BvhBuilder::_SplitItems(const BuildNode &_node, const float *_cmin, const float *_cmax) {
+        if(_node.count <= 1)
+            return 0;
+
+        // items are binned along the axis with the largest centroid extent
+        uint32_t axis = 0;
+        for(uint32_t i = 1; i < 3; i++) {
+            if(_cmax[i] - _cmin[i] > _cmax[axis] - _cmin[axis])
+                axis = i;
+        }
+
+        const float extent = _cmax[axis] - _cmin[axis];
+        if(extent > 0.0f) {
+            struct Bin {
+                float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+                float max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+                uint32_t count = 0;
+            } bins[LIBDAS_BVH_BIN_COUNT];
+
+            const float scale = static_cast<float>(LIBDAS_BVH_BIN_COUNT) / extent;
+            auto find_bin = [&](uint32_t _item) {
+                const float pos = (m_boxes[_item].centroid[axis] - _cmin[axis]) * scale;
+                return std::min(static_cast<uint32_t>(pos), static_cast<uint32_t>(LIBDAS_BVH_BIN_COUNT - 1));
+            };
+
+            for(uint32_t i = _node.first; i < _node.first + _node.count; i++) {
+                Bin &bin = bins[find_bin(m_items[i])];
+                _ExtendBox(bin.min, bin.max, m_boxes[m_items[i]].min, m_boxes[m_items[i]].max);
+                bin.count++;
+            }
+
+            // right side costs are accumulated first, so that all split planes are evaluated in two sweeps
+            float right_costs[LIBDAS_BVH_BIN_COUNT - 1];
+            float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+            float max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            uint32_t count = 0;
+            for(uint32_t i = LIBDAS_BVH_BIN_COUNT - 1; i > 0; i--) {
+                _ExtendBox(min, max, bins[i].min, bins[i].max);
+                count += bins[i].count;
+                right_costs[i - 1] = count ? _HalfSurfaceArea(min, max) * static_cast<float>(count) : 0.0f;
+            }
+
+            float best_cost = FLT_MAX;
+            uint32_t best_split = UINT32_MAX;
+            std::fill(min, min + 3, FLT_MAX);
+            std::fill(max, max + 3, -FLT_MAX);
+            count = 0;
+            for(uint32_t i = 0; i < LIBDAS_BVH_BIN_COUNT - 1; i++) {
+                _ExtendBox(min, max, bins[i].min, bins[i].max);
+                count += bins[i].count;
+                if(!count || count == _node.count)
+                    continue;
+
+                const float cost = _HalfSurfaceArea(min, max) * static_cast<float>(count) + right_costs[i];
+                if(cost < best_cost) {
+                    best_cost = cost;
+                    best_split = i;
+                }
+            }
+
+            // traversal cost is assumed to be equal to the cost of testing a single item
+            const float area = _HalfSurfaceArea(_node.min, _node.max);
+            if(_node.count <= m_max_leaf_items && (area <= 0.0f || static_cast<float>(_node.count) <= 1.0f + best_cost / area))
+                return 0;
+
+            if(best_split != UINT32_MAX) {
+                uint32_t *beg = m_items.data() + _node.first;
+                uint32_t *mid = std::partition(beg, beg + _node.count, [&](uint32_t _item) {
+                    return find_bin(_item) <= best_split;
+                });
+                return static_cast<uint32_t>(mid - beg);
+            }
+        }
+
+        if(_node.count <= m_max_leaf_items)
+            return 0;
+
+        // all centroids are at the same position, thus items are split in half in their current order
+        return _node.count / 2;
+    }
+
+
+    void BvhBuilder::_BuildPartition(Partition &_partition, std::vector<Partition> *_tasks) {
+        _partition.nodes.clear();
+        _partition.nodes.emplace_back();
+        _partition.nodes.back().first = _partition.first;
+        _partition.nodes.back().count = _partition.count;
+
+        std::vector<uint32_t> stack(1, 0);
+        float cmin[3], cmax[3];
+        while(!stack.empty()) {
+            const uint32_t index = stack.back();
+            stack.pop_back();
+            _CalculateBounds(_partition.nodes[index], cmin, cmax);
+
+            // small enough subtrees are left for tasks
+            const BuildNode node = _partition.nodes[index];
+            if(_tasks && node.count <= LIBDAS_BVH_TASK_ITEMS) {
+                _partition.nodes[index].task = static_cast<uint32_t>(_tasks->size()) + 1;
+                _tasks->emplace_back();
+                _tasks->back().first = node.first;
+                _tasks->back().count = node.count;
+                continue;
+            }
+
+            const uint32_t left_count = _SplitItems(node, cmin, cmax);
+            if(!left_count)
+                continue;
+
+            const uint32_t left = static_cast<uint32_t>(_partition.nodes.size());
+            _partition.nodes[index].left = left;
+            _partition.nodes[index].right = left + 1;
+
+            _partition.nodes.emplace_back();
+            _partition.nodes.back().first = node.first;
+            _partition.nodes.back().count = left_count;
+            _partition.nodes.emplace_back();
+            _partition.nodes.back().first = node.first + left_count;
+            _partition.nodes.back().count = node.count - left_count;
+
+            stack.push_back(left + 1);
+            stack.push_back(left);
+        }
+    }
+
+
+    void BvhBuilder::_Flatten(const std::vector<Partition> &_partitions) {
+        size_t node_count = 0;
+        for(const Partition &partition : _partitions)
+            node_count += partition.nodes.size();
+        m_nodes.clear();
+        m_nodes.reserve(node_count);
+
+        // second children patch the offset of their parent once their own index is known
+        struct Entry {
+            uint32_t partition;
+            uint32_t node;
+            uint32_t parent;
+        };
+
+        std::vector<Entry> stack;
+        stack.push_back(Entry{ 0, 0, UINT32_MAX });
+        while(!stack.empty()) {
+            Entry entry = stack.back();
+            stack.pop_back();
+
+            // task roots replace the nodes that spawned them
+            const BuildNode *node = &_partitions[entry.partition].nodes[entry.node];
+            while(node->task != UINT32_MAX) {
+                entry.partition = node->task;
+                entry.node = 0;
+                node = &_partitions[entry.partition].nodes[0];
+            }
+
+            const uint32_t index = static_cast<uint32_t>(m_nodes.size());
+            if(entry.parent != UINT32_MAX)
+                m_nodes[entry.parent].offset = index;
+
+            DasBvhNode bvh_node;
+            bvh_node.min = { node->min[0], node->min[1], node->min[2] };
+            bvh_node.max = { node->max[0], node->max[1], node->max[2] };
+            if(node->left == UINT32_MAX) {
+                bvh_node.offset = node->first;
+                bvh_node.item_count = node->count;
+            }
+            m_nodes.push_back(bvh_node);
+
+            if(node->left != UINT32_MAX) {
+                stack.push_back(Entry{ entry.partition, node->right, index });
+                stack.push_back(Entry{ entry.partition, node->left, UINT32_MAX });
+            }
+        }
+    }
+
+
+    void BvhBuilder::Build(uint32_t _thread_count) {
+        m_nodes.clear();
+        if(m_items.empty())
+            return;
+
+        std::vector<Partition> partitions(1);
+        partitions[0].first = 0;
+        partitions[0].count = static_cast<uint32_t>(m_items.size());
+
+        // small hierarchies are not worth splitting into tasks
+        if(m_items.size() <= LIBDAS_BVH_TASK_ITEMS) {
+            _BuildPartition(partitions[0], nullptr);
+            _Flatten(partitions);
+            return;
+        }
+
+        std::vector<Partition> tasks;
+        _BuildPartition(partitions[0], &tasks);
+        for(Partition &task : tasks)
+            partitions.push_back(std::move(task));
+
+        const uint32_t task_count = static_cast<uint32_t>(tasks.size());
+        std::atomic<uint32_t> next_task(0);
+        auto worker = [&]() {
+            for(uint32_t i = next_task++; i < task_count; i = next_task++)
+                _BuildPartition(partitions[i + 1], nullptr);
+        };
+
+        if(!_thread_count)
+            _thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        const uint32_t thread_count = std::min(_thread_count, task_count);
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count);
+        for(uint32_t i = 1; i < thread_count; i++)
+            threads.emplace_back(worker);
+
+        worker();
+        for(std::thread &thread : threads)
+            thread.join();
+
+        _Flatten(partitions);
+    }
+
+
+    DasBvh BvhBuilder::CreateBvh(uint32_t _scene) const {
+        DasBvh bvh;
+        bvh.scene = _scene;
+        bvh.node_count = static_cast<uint32_t>(m_nodes.size());
+        bvh.item_count = static_cast<uint32_t>(m_items.size());
+
+        if(bvh.node_count) {
+            bvh.nodes = new DasBvhNode[bvh.node_count];
+            std::copy(m_nodes.begin(), m_nodes.end(), bvh.nodes);
+        }
+
+        if(bvh.item_count) {
+            bvh.items = new uint32_t[bvh.item_count];
+            std::copy(m_items.begin(), m_items.end(), bvh.items);
+        }
+
+        return bvh;
+    }
+}
@@ -11,90 +11,165 @@
 ///////////////////////////////
 
 
-// incomplete method
+std::vector<char> DASTool::_ReadBufferRegion(Libdas::DasBuffer &_buffer, uint32_t _offset, size_t _size) {
+    std::vector<char> region;
+    region.reserve(_size);
+
+    // regions can span several payload fragments
+    size_t fragment_offset = 0;
+    for (size_t i = 0; i < _buffer.data_ptrs.size() && region.size() < _size; i++) {
+        const size_t fragment_size = _buffer.data_ptrs[i].second;
+        const size_t begin = _offset + region.size();
+        if (begin < fragment_offset + fragment_size) {
+            const char* data = _buffer.GetData(i);
+            if (!data)
+                break;
+
+            const size_t len = std::min(fragment_offset + fragment_size - begin, _size - region.size());
+            region.insert(region.end(), data + (begin - fragment_offset), data + (begin - fragment_offset) + len);
+        }
+        fragment_offset += fragment_size;
+    }
+
+    if (region.size() != _size) {
+        std::cerr << "Could not read " << _size << " bytes at offset " << _offset << " from buffer" << std::endl;
+        EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_DATA_LENGTH);
+    }
+
+    return region;
+}
+
+
 void DASTool::_ConvertDAS(const std::string &_input_file) {
     if (m_flags & USAGE_FLAG_LOD) {
-        Libdas::DasParser parser(_input_file);
-        parser.Parse();
+        // only geometry is parsed beforehand, buffer data points into the file mapping
+        Libdas::DasParser parser(_input_file, true);
+        parser.SetBlobStore(_MakeBlobStore());
+        const DasScopeMask mask = LIBDAS_DAS_SCOPE_MASK(Libdas::LIBDAS_DAS_SCOPE_BUFFER) | LIBDAS_DAS_SCOPE_MASK(Libdas::LIBDAS_DAS_SCOPE_MESH_PRIMITIVE);
+        parser.Parse(false, "", mask);
 
         Libdas::DasModel& model = parser.GetModel();
-
-        size_t buffer_size = 0;
-        std::vector<std::vector<uint32_t>> indices;
-        indices.resize(model.mesh_primitives.size());
-        std::vector<std::vector<TRS::Vector3<float>>> vertices;
-        vertices.resize(model.mesh_primitives.size());
-
-        for (size_t i = 0; i < model.mesh_primitives.size(); i++) {
-            Libdas::DasMeshPrimitive& prim = model.mesh_primitives[i];
+        for (const Libdas::DasMeshPrimitive& prim : model.mesh_primitives) {
             if (prim.index_buffer_id == UINT32_MAX) {
                 std::cout << "Generating LODs for unindexed meshes is not supported :(" << std::endl;
                 std::exit(0);
             }
 
-            Libdas::LodGenerator gen(
-                reinterpret_cast<uint32_t*>(model.buffers[prim.index_buffer_id].data_ptrs.back().first + prim.index_buffer_offset),
-                reinterpret_cast<TRS::Vector3<float>*>(model.buffers[prim.vertex_buffer_id].data_ptrs.back().first + prim.vertex_buffer_offset),
-                prim.draw_count);
-
-            gen.Simplify(static_cast<float>(m_lod) / 100.f);
-            indices[i] = gen.GetLodIndices();
-            vertices[i] = gen.GetLodVertices();
-
-            buffer_size += indices[i].size() * sizeof(uint32_t);
-            buffer_size += vertices[i].size() * sizeof(TRS::Vector3<float>);
+            if (prim.quantization & LIBDAS_QUANTIZATION_POSITION) {
+                std::cout << "Generating LODs for meshes with quantized positions is not supported :(" << std::endl;
+                std::exit(0);
+            }
         }
 
-        // create a new DasModel instance to write as output
-        Libdas::DasModel lod_model;
-        lod_model.props = std::move(model.props);
-        lod_model.buffers.emplace_back();
-        lod_model.buffers.back().data_len = static_cast<uint32_t>(buffer_size);
-        lod_model.buffers.back().data_ptrs.push_back(
-            std::make_pair(new char[buffer_size], buffer_size)
-        );
-        lod_model.buffers.back().type = LIBDAS_BUFFER_TYPE_INDICES | LIBDAS_BUFFER_TYPE_VERTEX;
-
-        lod_model.scenes = std::move(model.scenes);
-        lod_model.nodes = std::move(model.nodes);
-        lod_model.meshes = std::move(model.meshes);
-        lod_model.mesh_primitives.resize(model.mesh_primitives.size());
-    
-        size_t offset = 0;
-        for (size_t i = 0; i < lod_model.mesh_primitives.size(); i++) {
-            Libdas::DasMeshPrimitive& prim = lod_model.mesh_primitives[i];
-            prim.index_buffer_id = 0;
-            prim.index_buffer_offset = static_cast<uint32_t>(offset);
-            prim.draw_count = static_cast<uint32_t>(indices[i].size());
-
-            char* buf = lod_model.buffers.back().data_ptrs.back().first + offset;
-            std::memcpy(buf, indices[i].data(), indices[i].size() * sizeof(uint32_t));
-            offset += indices[i].size() * sizeof(uint32_t);
-            buf += indices[i].size() * sizeof(uint32_t);
-
-            prim.vertex_buffer_id = 0;
-            prim.vertex_buffer_offset = static_cast<uint32_t>(offset);
-
-            std::memcpy(buf, vertices[i].data(), vertices[i].size() * sizeof(TRS::Vector3<float>));
-            offset += vertices[i].size() * sizeof(TRS::Vector3<float>);
+        for (size_t i = 0; i < model.buffers.size(); i++) {
+            if (model.buffers[i].blob_hash && model.buffers[i].data_ptrs.empty()) {
+                std::cerr << "Buffer " << i << " references an external blob, specify its blob store with --blob-store" << std::endl;
+                EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+            }
         }
 
-        size_t pos = _input_file.find(".das");
-        Libdas::DasWriterCore writer(_input_file.substr(0, pos) + "_" + std::to_string(m_lod) + _input_file.substr(pos));
-        writer.InitialiseFile(lod_model.props);
-        writer.WriteBuffer(lod_model.buffers[0]);
-        
-        for (Libdas::DasScene& scene : lod_model.scenes)
-            writer.WriteScene(scene);
+        // LOD geometry is appended to the index buffer of each primitive, while the rest of the model is copied as it is
+        struct LodGeometry {
+            uint32_t buffer_id = UINT32_MAX;
+            uint32_t index_buffer_offset = 0;
+            uint32_t draw_count = 0;
+            uint32_t vertex_buffer_offset = 0;
+            Libdas::DasBoundingVolume bounds;
+        };
+        std::vector<LodGeometry> lods(model.mesh_primitives.size());
+        std::vector<char> lod_data;
+
+        Libdas::DasTranscodeCallbacks callbacks;
+        callbacks.on_buffer = [&](Libdas::DasBuffer& _buffer, uint32_t _id) {
+            lod_data.clear();
+            for (size_t i = 0; i < model.mesh_primitives.size(); i++) {
+                const Libdas::DasMeshPrimitive& prim = model.mesh_primitives[i];
+                if (prim.index_buffer_id != _id)
+                    continue;
+
+                const std::vector<char> index_data = _ReadBufferRegion(model.buffers[prim.index_buffer_id], prim.index_buffer_offset, 
+                                                                       prim.draw_count * sizeof(uint32_t));
+                const uint32_t* src_indices = reinterpret_cast<const uint32_t*>(index_data.data());
+                const uint32_t vertex_count = prim.draw_count ? *std::max_element(src_indices, src_indices + prim.draw_count) + 1 : 0;
+                const std::vector<char> vertex_data = _ReadBufferRegion(model.buffers[prim.vertex_buffer_id], prim.vertex_buffer_offset, 
+                                                                        vertex_count * sizeof(TRS::Vector3<float>));
+
+                Libdas::LodGenerator gen(src_indices, reinterpret_cast<const TRS::Vector3<float>*>(vertex_data.data()), prim.draw_count);
+                gen.Simplify(static_cast<float>(m_lod) / 100.f);
+                const std::vector<uint32_t> indices = gen.GetLodIndices();
+                const std::vector<TRS::Vector3<float>> vertices = gen.GetLodVertices();
+
+                LodGeometry& lod = lods[i];
+                lod.buffer_id = _id;
+                lod.index_buffer_offset = static_cast<uint32_t>(_buffer.data_len + lod_data.size());
+                lod.draw_count = static_cast<uint32_t>(indices.size());
+                lod_data.insert(lod_data.end(), reinterpret_cast<const char*>(indices.data()), 
+                                reinterpret_cast<const char*>(indices.data() + indices.size()));
+
+                lod.vertex_buffer_offset = static_cast<uint32_t>(_buffer.data_len + lod_data.size());
+                lod_data.insert(lod_data.end(), reinterpret_cast<const char*>(vertices.data()), 
+                                reinterpret_cast<const char*>(vertices.data() + vertices.size()));
+
+                if (!prim.bounds.IsEmpty()) {
+                    lod.bounds = Libdas::Bounds::FindPositionBounds(reinterpret_cast<const char*>(vertices.data()), sizeof(TRS::Vector3<float>), 
+                                                                    static_cast<uint32_t>(vertices.size()));
+                }
+            }
 
-        for (Libdas::DasNode& node : lod_model.nodes)
-            writer.WriteNode(node);
+            if (lod_data.size()) {
+                _buffer.data_ptrs.push_back(std::make_pair(lod_data.data(), lod_data.size()));
+                _buffer.data_len += static_cast<uint32_t>(lod_data.size());
+                _buffer.type |= LIBDAS_BUFFER_TYPE_INDICES | LIBDAS_BUFFER_TYPE_VERTEX;
+            }
+        };
+
+        // buffers are always transcoded before mesh primitives, only geometry of the primitive is replaced
+        callbacks.on_mesh_primitive = [&](Libdas::DasMeshPrimitive& _prim, uint32_t _id) {
+            LIBDAS_ASSERT(_id < lods.size() && lods[_id].buffer_id != UINT32_MAX);
+            const LodGeometry& lod = lods[_id];
+            _prim.index_buffer_id = lod.buffer_id;
+            _prim.index_buffer_offset = lod.index_buffer_offset;
+            _prim.draw_count = lod.draw_count;
+            _prim.vertex_buffer_id = lod.buffer_id;
+            _prim.vertex_buffer_offset = lod.vertex_buffer_offset;
+            _prim.bounds = lod.bounds;
+
+            // simplification creates new vertices, which other vertex attributes cannot be remapped to
+            if (_prim.vertex_normal_buffer_id != UINT32_MAX || _prim.vertex_tangent_buffer_id != UINT32_MAX || _prim.texture_count ||
+                _prim.color_mul_count || _prim.joint_set_count || _prim.morph_target_count || _prim.meshlet_count) {
+                std::cout << "Warning: mesh primitive " << _id << " keeps only vertex positions, other vertex attributes and meshlets are dropped" << std::endl;
+            }
 
-        for (Libdas::DasMesh& mesh : lod_model.meshes)
-            writer.WriteMesh(mesh);
-        
-        for (Libdas::DasMeshPrimitive& prim : lod_model.mesh_primitives)
-            writer.WriteMeshPrimitive(prim);
+            _prim.vertex_normal_buffer_id = UINT32_MAX;
+            _prim.vertex_normal_buffer_offset = 0;
+            _prim.vertex_tangent_buffer_id = UINT32_MAX;
+            _prim.vertex_tangent_buffer_offset = 0;
+            _prim.texture_count = 0;
+            _prim.color_mul_count = 0;
+            _prim.joint_set_count = 0;
+            _prim.morph_target_count = 0;
+            _prim.quantization = LIBDAS_QUANTIZATION_NONE;
+            _prim.meshlet_buffer_id = UINT32_MAX;
+            _prim.meshlet_buffer_offset = 0;
+            _prim.meshlet_count = 0;
+        };
+
+        // mesh bounds enclose the bounds of simplified primitives
+        callbacks.on_mesh = [&](Libdas::DasMesh& _mesh, uint32_t) {
+            if (_mesh.bounds.IsEmpty())
+                return;
+
+            _mesh.bounds = Libdas::DasBoundingVolume();
+            for (uint32_t i = 0; i < _mesh.primitive_count; i++) {
+                if (_mesh.primitives[i] < lods.size())
+                    Libdas::Bounds::Merge(_mesh.bounds, lods[_mesh.primitives[i]].bounds);
+            }
+        };
+
+        size_t pos = _input_file.find(".das");
+        Libdas::DasTranscoder transcoder(_input_file, _input_file.substr(0, pos) + "_" + std::to_string(m_lod) + _input_file.substr(pos));
+        transcoder.SetBlobStore(_MakeBlobStore());
+        transcoder.Transcode(callbacks);
     }
 }
 
@@ -106,13 +181,21 @@ void DASTool::_ConvertSTL(const std::string &_input_file) {
     if(is_ascii) {
         Libdas::AsciiSTLParser parser(_input_file);
         parser.Parse();
-        Libdas::STLCompiler cmp(parser.GetObjects(), m_props, m_out_file);
+        Libdas::STLCompiler cmp(m_out_file);
+        cmp.SetMeshOptimization(m_flags & USAGE_FLAG_OPTIMIZE);
+        cmp.SetMeshletGeneration(m_flags & USAGE_FLAG_MESHLETS);
+        cmp.SetBlobStore(_MakeBlobStore());
+        cmp.Compile(parser.GetObjects(), m_props);
     } else {
         Libdas::BinarySTLParser parser(_input_file);
         parser.Parse();
 
         std::vector<Libdas::STLObject> objects = {parser.GetObject()};
-        Libdas::STLCompiler cmp(objects, m_props, m_out_file);
+        Libdas::STLCompiler cmp(m_out_file);
+        cmp.SetMeshOptimization(m_flags & USAGE_FLAG_OPTIMIZE);
+        cmp.SetMeshletGeneration(m_flags & USAGE_FLAG_MESHLETS);
+        cmp.SetBlobStore(_MakeBlobStore());
+        cmp.Compile(objects, m_props);
     }
 }
 
@@ -123,7 +206,12 @@ void DASTool::_ConvertWavefrontObj(const std::string &_input_file) {
 
     Libdas::WavefrontObjParser parser(_input_file);
     parser.Parse();
-    Libdas::WavefrontObjCompiler cmp(parser.GetParsedData(), m_props, m_out_file, m_embedded_textures);
+    Libdas::WavefrontObjCompiler cmp(m_out_file);
+    cmp.SetMeshOptimization(m_flags & USAGE_FLAG_OPTIMIZE);
+    cmp.SetMeshletGeneration(m_flags & USAGE_FLAG_MESHLETS);
+    cmp.SetBufferDeduplication(m_flags & USAGE_FLAG_DEDUPLICATE);
+    cmp.SetBlobStore(_MakeBlobStore());
+    cmp.Compile(parser.GetParsedData(), m_props, "", m_embedded_textures);
 }
 
 
@@ -133,7 +221,14 @@ void DASTool::_ConvertGLTF(const std::string &_input_file) {
 
     Libdas::GLTFParser parser(_input_file);
     parser.Parse();
-    Libdas::GLTFCompiler compiler(Libdas::Algorithm::ExtractRootPath(_input_file), parser.GetRootObject(), m_props, m_out_file);
+    Libdas::GLTFCompiler compiler(Libdas::Algorithm::ExtractRootPath(_input_file), m_out_file);
+    compiler.SetVertexQuantization((m_flags & USAGE_FLAG_QUANTIZE) ? LIBDAS_QUANTIZATION_ALL : LIBDAS_QUANTIZATION_NONE);
+    compiler.SetMeshOptimization(m_flags & USAGE_FLAG_OPTIMIZE);
+    compiler.SetMeshletGeneration(m_flags & USAGE_FLAG_MESHLETS);
+    compiler.SetBvhGeneration(m_flags & USAGE_FLAG_BVH);
+    compiler.SetBufferDeduplication(m_flags & USAGE_FLAG_DEDUPLICATE);
+    compiler.SetBlobStore(_MakeBlobStore());
+    compiler.Compile(parser.GetRootObject(), m_props, {});
 }
 
 
@@ -321,13 +416,30 @@ void DASTool::_ListDasBuffers(Libdas::DasParser &_parser) {
             types += " bmp";
         if((it->type & LIBDAS_BUFFER_TYPE_TEXTURE_RAW) == LIBDAS_BUFFER_TYPE_TEXTURE_RAW)
             types += " textureraw";
+        if((it->type & LIBDAS_BUFFER_TYPE_QUANTIZED) == LIBDAS_BUFFER_TYPE_QUANTIZED)
+            types += " quantized";
+        if((it->type & LIBDAS_BUFFER_TYPE_MESHLET) == LIBDAS_BUFFER_TYPE_MESHLET)
+            types += " meshlets";
 
         std::cout << "Buffer types:" << types << std::endl;
         std::cout << "Data length: " << it->data_len << std::endl;
+        if(it->blob_hash)
+            std::cout << "Blob hash: " << std::hex << it->blob_hash << std::dec << std::endl;
     }
 }
 
 
+void DASTool::_ListDasBoundingVolume(const Libdas::DasBoundingVolume &_bounds, const std::string &_prefix) {
+    if(_bounds.IsEmpty())
+        return;
+
+    std::cout << _prefix << "Bounding box min: " << _bounds.min.x << " " << _bounds.min.y << " " << _bounds.min.z << std::endl;
+    std::cout << _prefix << "Bounding box max: " << _bounds.max.x << " " << _bounds.max.y << " " << _bounds.max.z << std::endl;
+    std::cout << _prefix << "Bounding sphere center: " << _bounds.center.x << " " << _bounds.center.y << " " << _bounds.center.z << std::endl;
+    std::cout << _prefix << "Bounding sphere radius: " << _bounds.radius << std::endl;
+}
+
+
 void DASTool::_ListDasScenes(Libdas::DasParser &_parser) {
     auto& scenes = _parser.GetModel().scenes;
     for (auto it = scenes.begin(); it != scenes.end(); it++) {
@@ -343,6 +455,7 @@ void DASTool::_ListDasScenes(Libdas::DasParser &_parser) {
         for(uint32_t j = 0; j < it->node_count; j++)
             std::cout << it->nodes[j] << " ";
         std::cout << std::endl;
+        _ListDasBoundingVolume(it->bounds, "");
     }
 }
 
@@ -386,6 +499,7 @@ void DASTool::_ListDasMeshes(Libdas::DasParser &_parser) {
         for(uint32_t j = 0; j < it->primitive_count; j++)
             std::cout << it->primitives[j] << " ";
         std::cout << std::endl;
+        _ListDasBoundingVolume(it->bounds, "");
 
         // for each primitive in mesh output its data
         for(uint32_t j = 0; j < it->primitive_count; j++)
@@ -394,12 +508,32 @@ void DASTool::_ListDasMeshes(Libdas::DasParser &_parser) {
 }
 
 
+void DASTool::_ListDasVertexCacheStatistics(Libdas::DasParser &_parser, const Libdas::DasMeshPrimitive &_prim) {
+    if(_prim.index_buffer_id >= _parser.GetModel().buffers.size())
+        return;
+
+    Libdas::DasBuffer &buffer = _parser.GetModel().buffers[_prim.index_buffer_id];
+    char *data = buffer.GetData();
+    if(!data || buffer.data_ptrs.front().second < _prim.index_buffer_offset + static_cast<size_t>(_prim.draw_count) * sizeof(uint32_t))
+        return;
+
+    // analysis does not modify indices, thus these are used directly from the buffer
+    uint32_t *indices = reinterpret_cast<uint32_t*>(data + _prim.index_buffer_offset);
+    const uint32_t vertex_count = _prim.draw_count ? *std::max_element(indices, indices + _prim.draw_count) + 1 : 0;
+    Libdas::MeshOptimizer optimizer(indices, _prim.draw_count, vertex_count);
+    const Libdas::VertexCacheStatistics stats = optimizer.AnalyzeVertexCache();
+    std::cout << "-- ACMR: " << stats.acmr << std::endl;
+    std::cout << "-- ATVR: " << stats.atvr << std::endl;
+}
+
+
 void DASTool::_ListDasMeshPrimitive(Libdas::DasParser &_parser, uint32_t _rel_id, uint32_t _id) {
     const Libdas::DasMeshPrimitive &prim = _parser.GetModel().mesh_primitives[_id];
     std::cout << "---- Primitive nr " << _rel_id << " ----" << std::endl;
     if(prim.index_buffer_id != UINT32_MAX) {
         std::cout << "-- Index buffer id: " << prim.index_buffer_id << std::endl;
         std::cout << "-- Index buffer offset: " << prim.index_buffer_offset << std::endl;
+        _ListDasVertexCacheStatistics(_parser, prim);
     }
     std::cout << "-- Draw count: " << prim.draw_count << std::endl;
     std::cout << "-- Vertex buffer id: " << prim.vertex_buffer_id << std::endl;
@@ -491,6 +625,40 @@ void DASTool::_ListDasMeshPrimitive(Libdas::DasParser &_parser, uint32_t _rel_id
         for(uint32_t i = 0; i < prim.morph_target_count; i++)
             _ListDasMorphTarget(_parser, i, prim.morph_targets[i]);
     }
+
+    _ListDasBoundingVolume(prim.bounds, "-- ");
+
+    // meshlets
+    if(prim.meshlet_count) {
+        std::cout << "-- Meshlet buffer id: " << prim.meshlet_buffer_id << std::endl;
+        std::cout << "-- Meshlet buffer offset: " << prim.meshlet_buffer_offset << std::endl;
+        std::cout << "-- Meshlet count: " << prim.meshlet_count << std::endl;
+    }
+
+    // quantized vertex attributes
+    if(prim.quantization != LIBDAS_QUANTIZATION_NONE) {
+        std::cout << "-- Quantized attributes:";
+        if(prim.quantization & LIBDAS_QUANTIZATION_POSITION)
+            std::cout << " position";
+        if(prim.quantization & LIBDAS_QUANTIZATION_NORMAL)
+            std::cout << " normal";
+        if(prim.quantization & LIBDAS_QUANTIZATION_TANGENT)
+            std::cout << " tangent";
+        if(prim.quantization & LIBDAS_QUANTIZATION_UV)
+            std::cout << " uv";
+        if(prim.quantization & LIBDAS_QUANTIZATION_JOINT_WEIGHTS)
+            std::cout << " jointweights";
+        std::cout << std::endl;
+
+        if(prim.quantization & LIBDAS_QUANTIZATION_POSITION) {
+            std::cout << "-- Position offset: " << prim.position_offset.x << " " << prim.position_offset.y << " " << prim.position_offset.z << std::endl;
+            std::cout << "-- Position scale: " << prim.position_scale.x << " " << prim.position_scale.y << " " << prim.position_scale.z << std::endl;
+        }
+        if(prim.quantization & LIBDAS_QUANTIZATION_UV) {
+            std::cout << "-- UV offset: " << prim.uv_offset.x << " " << prim.uv_offset.y << std::endl;
+            std::cout << "-- UV scale: " << prim.uv_scale.x << " " << prim.uv_scale.y << std::endl;
+        }
+    }
 }
 
 
@@ -772,9 +940,41 @@ void DASTool::_ListDasAnimations(Libdas::DasParser &_parser) {
 }
 
 
+void DASTool::_ListDasBvhs(Libdas::DasParser &_parser) {
+    auto& bvhs = _parser.GetModel().bvhs;
+    for (auto it = bvhs.begin(); it != bvhs.end(); it++) {
+        std::cout << std::endl << "-- BVH nr " << it - bvhs.begin() << " --" << std::endl;
+        std::cout << "Scene: " << it->scene << std::endl;
+        std::cout << "Node count: " << it->node_count << std::endl;
+
+        uint32_t leaf_count = 0;
+        for(uint32_t j = 0; j < it->node_count; j++) {
+            if(it->nodes[j].IsLeaf())
+                leaf_count++;
+        }
+        std::cout << "Leaf count: " << leaf_count << std::endl;
+        std::cout << "Item count: " << it->item_count << std::endl;
+        if(it->node_count) {
+            std::cout << "Root bounding box min: " << it->nodes[0].min.x << " " << it->nodes[0].min.y << " " << it->nodes[0].min.z << std::endl;
+            std::cout << "Root bounding box max: " << it->nodes[0].max.x << " " << it->nodes[0].max.y << " " << it->nodes[0].max.z << std::endl;
+        }
+    }
+}
+
+
 void DASTool::_ListDas(const std::string &_input_file) {
-    Libdas::DasParser parser(_input_file);
-    parser.Parse();
+    // listing never touches buffer payloads, thus these are loaded lazily
+    Libdas::DasParser parser(_input_file, true, true);
+    parser.SetBlobStore(_MakeBlobStore());
+
+    // non-verbose listing needs only properties and the scene hierarchy
+    DasScopeMask mask = LIBDAS_DAS_SCOPE_MASK_ALL;
+    if((m_flags & USAGE_FLAG_VERBOSE) != USAGE_FLAG_VERBOSE) {
+        mask = LIBDAS_DAS_SCOPE_MASK(Libdas::LIBDAS_DAS_SCOPE_PROPERTIES) | 
+               LIBDAS_DAS_SCOPE_MASK(Libdas::LIBDAS_DAS_SCOPE_SCENE) | 
+               LIBDAS_DAS_SCOPE_MASK(Libdas::LIBDAS_DAS_SCOPE_NODE);
+    }
+    parser.Parse(false, "", mask);
     
     const Libdas::DasProperties &props = parser.GetModel().props;
     _ListDasProperties(props);
@@ -787,6 +987,7 @@ void DASTool::_ListDas(const std::string &_input_file) {
         _ListDasSkeletonJoints(parser);
         _ListDasAnimationChannels(parser);
         _ListDasAnimations(parser);
+        _ListDasBvhs(parser);
     }
 
     _ListDasScenes(parser);
@@ -816,12 +1017,23 @@ void DASTool::_FetchArg(FlagType _type, const std::string &_arg) {
             m_lod = static_cast<uint32_t>(std::stoi(_arg));
             break;
 
+        case USAGE_FLAG_BLOB_STORE:
+            m_blob_store_path = _arg;
+            break;
+
         default:
             break;
     }
 }
 
 
+std::shared_ptr<Libdas::DasBlobStore> DASTool::_MakeBlobStore() {
+    if((m_flags & USAGE_FLAG_BLOB_STORE) != USAGE_FLAG_BLOB_STORE)
+        return nullptr;
+    return std::make_shared<Libdas::DasBlobStore>(m_blob_store_path);
+}
+
+
 void DASTool::_MakeOutputFile(const std::string &_input_file) {
     // check if there exists any directories or files with given file name
     if(std::filesystem::exists(m_out_file) && std::filesystem::is_directory(m_out_file)) {
@@ -890,6 +1102,21 @@ void DASTool::_ParseFlags(const std::vector<std::string> &_opts) {
             info_flag = USAGE_FLAG_OUT_FILE; 
             skip_it = true;
         }
+        else if(_opts[i] == "--blob-store") {
+            m_flags |= USAGE_FLAG_BLOB_STORE;
+            info_flag = USAGE_FLAG_BLOB_STORE;
+            skip_it = true;
+        }
+        else if(_opts[i] == "-q" || _opts[i] == "--quantize")
+            m_flags |= USAGE_FLAG_QUANTIZE;
+        else if(_opts[i] == "-O" || _opts[i] == "--optimize")
+            m_flags |= USAGE_FLAG_OPTIMIZE;
+        else if(_opts[i] == "-M" || _opts[i] == "--meshlets")
+            m_flags |= USAGE_FLAG_MESHLETS;
+        else if(_opts[i] == "-B" || _opts[i] == "--bvh")
+            m_flags |= USAGE_FLAG_BVH;
+        else if(_opts[i] == "-D" || _opts[i] == "--deduplicate")
+            m_flags |= USAGE_FLAG_DEDUPLICATE;
         else if(_opts[i] == "-v" || _opts[i] == "--verbose")
             m_flags |= USAGE_FLAG_VERBOSE;
         else {
@@ -916,6 +1143,11 @@ void DASTool::_ExcludeFlags(bool _is_convert) {
     // * -et / --embed-texture
     // * --model
     // * -o / --output
+    // * -q / --quantize
+    // * -O / --optimize
+    // * -M / --meshlets
+    // * -B / --bvh
+    // * -D / --deduplicate
     else {
         if((m_flags & USAGE_FLAG_AUTHOR) == USAGE_FLAG_AUTHOR) {
             std::cerr << "Invalid use of author flag in listing mode" << std::endl;
@@ -937,6 +1169,26 @@ void DASTool::_ExcludeFlags(bool _is_convert) {
             std::cerr << "Invalid use of output file specifier flag in listing mode" << std::endl;
             EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_KEYWORD);
         }
+        else if((m_flags & USAGE_FLAG_QUANTIZE) == USAGE_FLAG_QUANTIZE) {
+            std::cerr << "Invalid use of quantization flag in listing mode" << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_KEYWORD);
+        }
+        else if((m_flags & USAGE_FLAG_OPTIMIZE) == USAGE_FLAG_OPTIMIZE) {
+            std::cerr << "Invalid use of optimization flag in listing mode" << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_KEYWORD);
+        }
+        else if((m_flags & USAGE_FLAG_MESHLETS) == USAGE_FLAG_MESHLETS) {
+            std::cerr << "Invalid use of meshlet generation flag in listing mode" << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_KEYWORD);
+        }
+        else if((m_flags & USAGE_FLAG_BVH) == USAGE_FLAG_BVH) {
+            std::cerr << "Invalid use of BVH generation flag in listing mode" << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_KEYWORD);
+        }
+        else if((m_flags & USAGE_FLAG_DEDUPLICATE) == USAGE_FLAG_DEDUPLICATE) {
+            std::cerr << "Invalid use of deduplication flag in listing mode" << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_KEYWORD);
+        }
     }
 }
 
@@ -992,7 +1244,8 @@ void DASTool::List(const std::string &_input_file, const std::vector<std::string
 
 
 void DASTool::Validate(const std::string &_input_file) {
-    Libdas::DasParser parser(_input_file);
+    Libdas::DasParser parser(_input_file, true);
+    parser.SetThreadCount(0);
     parser.Parse(true);
 
     Libdas::DasValidator validator(parser.GetModel());
@@ -1007,10 +1260,30 @@ void DASTool::Validate(const std::string &_input_file) {
 }
 
 
+void DASTool::Compact(const std::string &_input_file, const std::vector<std::string> &_opts) {
+    _ParseFlags(_opts);
+    if(m_flags & ~USAGE_FLAG_OUT_FILE) {
+        std::cerr << "Only output file specifier flag is valid in compaction mode" << std::endl;
+        EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_KEYWORD);
+    }
+
+    if(Libdas::Algorithm::ExtractFileExtension(_input_file) != "das") {
+        std::cerr << "Invalid file '" << _input_file << "'" << std::endl;
+        EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+    }
+
+    // the output replaces its target only once it is completely written, thus compacting in place is safe
+    const std::string out_file = (m_flags & USAGE_FLAG_OUT_FILE) ? m_out_file : _input_file;
+    Libdas::DasTranscoder transcoder(_input_file, out_file);
+    transcoder.Transcode();
+}
+
+
 // main method
 int main(int argc, char *argv[]) {
     DASTool tool;
-    if(argc < 3 || (std::string(argv[1]) != "convert" && std::string(argv[1]) != "list" && std::string(argv[1]) != "validate")) {
+    if(argc < 3 || (std::string(argv[1]) != "convert" && std::string(argv[1]) != "list" && std::string(argv[1]) != "validate" &&
+                    std::string(argv[1]) != "compact")) {
         std::cout << tool.GetHelpText();
         return 0;
     }
@@ -1028,6 +1301,8 @@ int main(int argc, char *argv[]) {
         tool.List(argv[2], opts);
     else if(std::string(argv[1]) == "validate")
         tool.Validate(argv[2]);
+    else if(std::string(argv[1]) == "compact")
+        tool.Compact(argv[2], opts);
 
     return 0;
 }
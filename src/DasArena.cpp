@@ -0,0 +1,61 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasArena.cpp - monotonic memory arena class implementation
+// author: Karl-Mihkel Ott
+
+#define DAS_ARENA_CPP
+#include "das/DasArena.h"
+
+namespace Libdas {
+
+    DasArena::DasArena(size_t _block_size) :
+        m_block_size(_block_size ? _block_size : LIBDAS_ARENA_DEFAULT_BLOCK_SIZE) {}
+
+
+    DasArena::~DasArena() {
+        for(char *block : m_blocks)
+            std::free(block);
+    }
+
+
+    void DasArena::_NewBlock(size_t _len) {
+        // malloc guarantees alignment suitable for any fundamental type
+        const size_t len = std::max(_len, m_block_size);
+        char *block = reinterpret_cast<char*>(std::malloc(len));
+        if(!block) {
+            std::cerr << "Could not allocate " << len << " bytes for arena block" << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_DATA_LENGTH);
+        }
+
+        m_blocks.push_back(block);
+        m_ptr = block;
+        m_end = block + len;
+
+        // grow geometrically, so that large models need only a few blocks
+        m_block_size = std::min(m_block_size * 2, static_cast<size_t>(LIBDAS_ARENA_MAX_BLOCK_SIZE));
+    }
+
+
+    char *DasArena::_Allocate(size_t _len, size_t _alignment) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        uintptr_t beg = (reinterpret_cast<uintptr_t>(m_ptr) + _alignment - 1) & ~(static_cast<uintptr_t>(_alignment) - 1);
+        if(!m_ptr || beg + _len > reinterpret_cast<uintptr_t>(m_end)) {
+            _NewBlock(_len + _alignment);
+            beg = (reinterpret_cast<uintptr_t>(m_ptr) + _alignment - 1) & ~(static_cast<uintptr_t>(_alignment) - 1);
+        }
+
+        m_ptr = reinterpret_cast<char*>(beg + _len);
+        m_used += _len;
+        return reinterpret_cast<char*>(beg);
+    }
+
+
+    void DasArena::Reserve(size_t _len) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_ptr && static_cast<size_t>(m_end - m_ptr) >= _len)
+            return;
+
+        _NewBlock(_len);
+    }
+}
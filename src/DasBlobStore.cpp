@@ -0,0 +1,131 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasBlobStore.cpp - content addressed external buffer data store class implementation
+// author: Karl-Mihkel Ott
+
+#define DAS_BLOB_STORE_CPP
+#include "das/DasBlobStore.h"
+
+namespace Libdas {
+
+    DasBlobStore::DasBlobStore(const std::string &_root_path) : m_root_path(_root_path) {}
+
+
+    std::string DasBlobStore::_GetBlobPath(uint64_t _hash) const {
+        char name[32] = {};
+        std::snprintf(name, sizeof(name), "%02x/%016llx.blob", static_cast<unsigned>(_hash >> 56), static_cast<unsigned long long>(_hash));
+        return m_root_path + "/" + name;
+    }
+
+
+    bool DasBlobStore::_Publish(const std::string &_src, const std::string &_dst, bool &_exists) {
+#ifdef _WIN32
+        if(MoveFileExA(_src.c_str(), _dst.c_str(), 0))
+            return true;
+
+        const DWORD err = GetLastError();
+        _exists = err == ERROR_ALREADY_EXISTS || err == ERROR_FILE_EXISTS;
+        return false;
+#else
+        if(link(_src.c_str(), _dst.c_str())) {
+            _exists = errno == EEXIST;
+            return false;
+        }
+
+        unlink(_src.c_str());
+        return true;
+#endif
+    }
+
+
+    uint64_t DasBlobStore::Store(const char *_data, size_t _len) {
+        if(!_len)
+            return 0;
+
+        // zero hash marks embedded data
+        uint64_t hash = HashFunc64(_data, _len);
+        if(!hash) hash = 1;
+
+        std::shared_ptr<MappedFile> blob = Acquire(hash, _len);
+        if(blob)
+            return std::memcmp(blob->GetData(), _data, _len) ? 0 : hash;
+
+        const std::string path = _GetBlobPath(hash);
+        std::error_code err;
+        if(std::filesystem::exists(path, err))
+            return 0;
+
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), err);
+        if(err) {
+            std::cerr << "Could not create blob store directory for " << path << ": " << err.message() << std::endl;
+            return 0;
+        }
+
+        // every writer stages the blob in its own file, which is then published without replacing an existing blob
+        static std::atomic<uint64_t> s_counter(0);
+        const uint64_t unique = (s_counter++ << 32) ^ std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+                                static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        char suffix[24] = {};
+        std::snprintf(suffix, sizeof(suffix), ".%016llx", static_cast<unsigned long long>(unique));
+
+        const std::string unique_path = path + suffix;
+        FileWriter writer(unique_path);
+        if(!writer.Write(_data, _len) || !writer.Commit())
+            return 0;
+
+        bool exists = false;
+        if(!_Publish(unique_path, path, exists)) {
+            std::filesystem::remove(unique_path, err);
+            if(!exists) {
+                std::cerr << "Could not move blob " << unique_path << " into the store" << std::endl;
+                return 0;
+            }
+
+            // another writer published the blob first, which might be a different blob with colliding hash
+            blob = Acquire(hash, _len);
+            return blob && !std::memcmp(blob->GetData(), _data, _len) ? hash : 0;
+        }
+
+        return hash;
+    }
+
+
+    std::shared_ptr<MappedFile> DasBlobStore::Acquire(uint64_t _hash, size_t _len) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_cache.find(_hash);
+        if(it != m_cache.end()) {
+            std::shared_ptr<MappedFile> blob = it->second.lock();
+            if(blob)
+                return blob->GetSize() == _len ? blob : nullptr;
+        }
+
+        // MappedFile exits on missing files, thus the blob is checked beforehand
+        const std::string path = _GetBlobPath(_hash);
+        std::error_code err;
+        const uintmax_t size = std::filesystem::file_size(path, err);
+        if(err || size != static_cast<uintmax_t>(_len))
+            return nullptr;
+
+        std::shared_ptr<MappedFile> blob = std::make_shared<MappedFile>(path);
+        m_cache[_hash] = blob;
+        return blob;
+    }
+
+
+    bool DasBlobStore::Resolve(DasBuffer &_buffer) {
+        if(!_buffer.blob_hash)
+            return true;
+
+        std::shared_ptr<MappedFile> blob = Acquire(_buffer.blob_hash, _buffer.data_len);
+        if(!blob)
+            return false;
+
+        _buffer.data_ptrs.clear();
+        _buffer.data_ptrs.push_back(std::make_pair(blob->GetData(), _buffer.data_len));
+        _buffer.data_offsets.clear();
+        _buffer.source.reset();
+        _buffer.blob = std::move(blob);
+        _buffer._free_bit = false;
+        return true;
+    }
+}
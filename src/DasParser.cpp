@@ -48,70 +48,339 @@ namespace Libdas {
 #endif
 
 
-    DasParser::DasParser(const std::string &_file_name) : 
-        DasReaderCore(_file_name) {}
+    DasParser::DasParser(const std::string &_file_name, bool _use_mapping, bool _lazy_buffers) : 
+        DasReaderCore(_file_name, _use_mapping, _lazy_buffers) {}
+
+
+    DasParser::DasParser(std::vector<char> &&_image) {
+        NewImage(std::move(_image));
+    }
 
 
     DasParser::DasParser(DasParser &&_parser) noexcept :
         DasReaderCore(std::move(_parser)),
-        m_model(std::move(_parser.m_model)) {}
+        m_model(std::move(_parser.m_model)),
+        m_thread_count(_parser.m_thread_count),
+        m_blob_store(std::move(_parser.m_blob_store)) {}
+
+
+    void DasParser::_ReadScope(DasScopeType _type, bool _discard) {
+        switch(_type) {
+            case LIBDAS_DAS_SCOPE_PROPERTIES:
+                if(_discard) {
+                    DasProperties props;
+                    ReadScope(props);
+                } else {
+                    ReadScope(m_model.props);
+                }
+                break;
+
+            case LIBDAS_DAS_SCOPE_BUFFER:
+                _ReadScopeInto(m_model.buffers, _type, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_MESH_PRIMITIVE:
+                _ReadScopeInto(m_model.mesh_primitives, _type, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_MORPH_TARGET:
+                _ReadScopeInto(m_model.morph_targets, _type, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_MESH:
+                _ReadScopeInto(m_model.meshes, _type, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_NODE:
+                _ReadScopeInto(m_model.nodes, _type, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_SCENE:
+                _ReadScopeInto(m_model.scenes, _type, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_SKELETON:
+                _ReadScopeInto(m_model.skeletons, _type, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_SKELETON_JOINT:
+                _ReadScopeInto(m_model.joints, _type, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL:
+                _ReadScopeInto(m_model.channels, _type, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_ANIMATION:
+                _ReadScopeInto(m_model.animations, _type, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_BVH:
+                _ReadScopeInto(m_model.bvhs, _type, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS:
+                {
+                    // table of contents is never a part of the model
+                    DasTableOfContents toc;
+                    ReadScope(toc);
+                }
+                break;
+
+            case LIBDAS_DAS_SCOPE_OVERRIDE:
+                m_override = DasScopeOverride();
+                ReadScope(m_override);
+                break;
+
+            default:
+                LIBDAS_ASSERT(false);
+                break;
+        }
+    }
+
+
+    void DasParser::_EmitScope(DasScopeType _type) {
+        switch(_type) {
+            case LIBDAS_DAS_SCOPE_BUFFER:
+                // callbacks receive buffers with their data, even if it is kept in the blob store
+                if(m_blob_store && !m_model.buffers.empty()) {
+                    const size_t index = m_override.type == _type && m_override.index < m_model.buffers.size() ? m_override.index : m_model.buffers.size() - 1;
+                    _ResolveBlob(m_model.buffers[index]);
+                }
+                _EmitScopeFrom(m_callbacks.on_buffer, m_model.buffers, _type);
+                break;
+
+            case LIBDAS_DAS_SCOPE_MESH_PRIMITIVE:
+                _EmitScopeFrom(m_callbacks.on_mesh_primitive, m_model.mesh_primitives, _type);
+                break;
+
+            case LIBDAS_DAS_SCOPE_MESH:
+                _EmitScopeFrom(m_callbacks.on_mesh, m_model.meshes, _type);
+                break;
+
+            case LIBDAS_DAS_SCOPE_NODE:
+                _EmitScopeFrom(m_callbacks.on_node, m_model.nodes, _type);
+                break;
+
+            default:
+                break;
+        }
+
+    }
+
+
+    void DasParser::_ReportProgress(uint64_t _bytes_read) {
+        m_bytes_read = _bytes_read;
+        if(m_callbacks.on_progress && _GetMappedFile())
+            m_callbacks.on_progress(m_bytes_read, m_progress_total);
+    }
+
+
+    std::vector<uint64_t> DasParser::_FindScopeSizes(const DasTableOfContents &_toc) {
+        // the table of contents scope itself ends the last listed scope
+        std::vector<uint64_t> ends(_toc.scope_offsets);
+        ends.push_back(GetHeader().toc_offset);
+        std::sort(ends.begin(), ends.end());
+
+        std::vector<uint64_t> sizes(_toc.scope_offsets.size());
+        for(size_t i = 0; i < sizes.size(); i++) {
+            auto it = std::upper_bound(ends.begin(), ends.end(), _toc.scope_offsets[i]);
+            sizes[i] = it != ends.end() ? *it - _toc.scope_offsets[i] : 0;
+        }
+
+        return sizes;
+    }
 
 
-    void DasParser::_DataCast(std::any &_any_scope, DasScopeType _type) {
+    void DasParser::_ReadScopeAt(DasModel &_model, DasScopeType _type, size_t _index) {
         switch(_type) {
             case LIBDAS_DAS_SCOPE_PROPERTIES:
-                m_model.props = std::any_cast<DasProperties&&>(std::move(_any_scope));
+                ReadScope(_model.props);
                 break;
 
             case LIBDAS_DAS_SCOPE_BUFFER:
-                m_model.buffers.emplace_back(std::any_cast<DasBuffer&&>(std::move(_any_scope)));
+                ReadScope(_model.buffers[_index]);
                 break;
 
             case LIBDAS_DAS_SCOPE_MESH_PRIMITIVE:
-                m_model.mesh_primitives.emplace_back(std::any_cast<DasMeshPrimitive&&>(std::move(_any_scope)));
+                ReadScope(_model.mesh_primitives[_index]);
                 break;
 
             case LIBDAS_DAS_SCOPE_MORPH_TARGET:
-                m_model.morph_targets.emplace_back(std::any_cast<DasMorphTarget&&>(std::move(_any_scope)));
+                ReadScope(_model.morph_targets[_index]);
                 break;
 
             case LIBDAS_DAS_SCOPE_MESH:
-                m_model.meshes.emplace_back(std::any_cast<DasMesh&&>(std::move(_any_scope)));
+                ReadScope(_model.meshes[_index]);
                 break;
 
             case LIBDAS_DAS_SCOPE_NODE:
-                m_model.nodes.emplace_back(std::any_cast<DasNode&&>(std::move(_any_scope)));
+                ReadScope(_model.nodes[_index]);
                 break;
 
             case LIBDAS_DAS_SCOPE_SCENE:
-                m_model.scenes.emplace_back(std::any_cast<DasScene&&>(std::move(_any_scope)));
+                ReadScope(_model.scenes[_index]);
                 break;
 
             case LIBDAS_DAS_SCOPE_SKELETON:
-                m_model.skeletons.emplace_back(std::any_cast<DasSkeleton&&>(std::move(_any_scope)));
+                ReadScope(_model.skeletons[_index]);
                 break;
 
             case LIBDAS_DAS_SCOPE_SKELETON_JOINT:
-                m_model.joints.emplace_back(std::any_cast<DasSkeletonJoint&&>(std::move(_any_scope)));
+                ReadScope(_model.joints[_index]);
                 break;
 
             case LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL:
-                m_model.channels.emplace_back(std::any_cast<DasAnimationChannel&&>(std::move(_any_scope)));
+                ReadScope(_model.channels[_index]);
                 break;
 
             case LIBDAS_DAS_SCOPE_ANIMATION:
-                m_model.animations.emplace_back(std::any_cast<DasAnimation&&>(std::move(_any_scope)));
+                ReadScope(_model.animations[_index]);
+                break;
+
+            case LIBDAS_DAS_SCOPE_BVH:
+                ReadScope(_model.bvhs[_index]);
                 break;
 
             default:
+                LIBDAS_ASSERT(false);
                 break;
         }
     }
 
 
+    void DasParser::_ParseParallel(const DasTableOfContents &_toc, DasScopeMask _mask) {
+        // resize all scope vectors beforehand and remember where new scopes begin
+        std::vector<size_t> model_offsets(LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS, 0);
+        size_t total = 0;
+        for(uint32_t i = 0; i < static_cast<uint32_t>(LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS); i++) {
+            const DasScopeType type = static_cast<DasScopeType>(i);
+            const uint32_t count = _toc.GetScopeCount(type);
+            if(!(_mask & LIBDAS_DAS_SCOPE_MASK(type)) || !count)
+                continue;
+
+            total += count;
+            switch(type) {
+                case LIBDAS_DAS_SCOPE_BUFFER:
+                    model_offsets[i] = m_model.buffers.size();
+                    m_model.buffers.resize(model_offsets[i] + count);
+                    break;
+
+                case LIBDAS_DAS_SCOPE_MESH_PRIMITIVE:
+                    model_offsets[i] = m_model.mesh_primitives.size();
+                    m_model.mesh_primitives.resize(model_offsets[i] + count);
+                    break;
+
+                case LIBDAS_DAS_SCOPE_MORPH_TARGET:
+                    model_offsets[i] = m_model.morph_targets.size();
+                    m_model.morph_targets.resize(model_offsets[i] + count);
+                    break;
+
+                case LIBDAS_DAS_SCOPE_MESH:
+                    model_offsets[i] = m_model.meshes.size();
+                    m_model.meshes.resize(model_offsets[i] + count);
+                    break;
+
+                case LIBDAS_DAS_SCOPE_NODE:
+                    model_offsets[i] = m_model.nodes.size();
+                    m_model.nodes.resize(model_offsets[i] + count);
+                    break;
+
+                case LIBDAS_DAS_SCOPE_SCENE:
+                    model_offsets[i] = m_model.scenes.size();
+                    m_model.scenes.resize(model_offsets[i] + count);
+                    break;
+
+                case LIBDAS_DAS_SCOPE_SKELETON:
+                    model_offsets[i] = m_model.skeletons.size();
+                    m_model.skeletons.resize(model_offsets[i] + count);
+                    break;
+
+                case LIBDAS_DAS_SCOPE_SKELETON_JOINT:
+                    model_offsets[i] = m_model.joints.size();
+                    m_model.joints.resize(model_offsets[i] + count);
+                    break;
+
+                case LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL:
+                    model_offsets[i] = m_model.channels.size();
+                    m_model.channels.resize(model_offsets[i] + count);
+                    break;
+
+                case LIBDAS_DAS_SCOPE_ANIMATION:
+                    model_offsets[i] = m_model.animations.size();
+                    m_model.animations.resize(model_offsets[i] + count);
+                    break;
+
+                case LIBDAS_DAS_SCOPE_BVH:
+                    model_offsets[i] = m_model.bvhs.size();
+                    m_model.bvhs.resize(model_offsets[i] + count);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        // split scopes into several ranges per thread for better load balancing
+        const uint32_t range_size = std::max(static_cast<uint32_t>(total / (static_cast<size_t>(m_thread_count) * 4)), 1u);
+        std::vector<ScopeRange> ranges;
+        for(uint32_t i = 0; i < static_cast<uint32_t>(LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS); i++) {
+            const DasScopeType type = static_cast<DasScopeType>(i);
+            if(!(_mask & LIBDAS_DAS_SCOPE_MASK(type)))
+                continue;
+
+            const uint32_t count = _toc.GetScopeCount(type);
+            for(uint32_t j = 0; j < count; j += range_size)
+                ranges.push_back(ScopeRange{ type, j, std::min(j + range_size, count), model_offsets[i] });
+        }
+
+        std::atomic<size_t> next_range(0);
+        auto worker = [&]() {
+            // every thread uses its own read position in the shared mapping
+            DasParser reader;
+            reader._ShareFile(*this);
+
+            for(size_t i = next_range++; i < ranges.size(); i = next_range++) {
+                const ScopeRange &range = ranges[i];
+                for(uint32_t j = range.beg; j < range.end; j++) {
+                    reader.SeekScope(range.type, j);
+                    reader._ReadScopeAt(m_model, range.type, range.model_offset + j);
+                }
+            }
+        };
+
+        const size_t thread_count = std::min(static_cast<size_t>(m_thread_count), ranges.size());
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count);
+        for(size_t i = 1; i < thread_count; i++)
+            threads.emplace_back(worker);
+
+        worker();
+        for(std::thread &thread : threads)
+            thread.join();
+    }
+
+
+    void DasParser::_ReserveScopes(const DasTableOfContents &_toc) {
+        m_model.buffers.reserve(m_model.buffers.size() + _toc.GetScopeCount(LIBDAS_DAS_SCOPE_BUFFER));
+        m_model.mesh_primitives.reserve(m_model.mesh_primitives.size() + _toc.GetScopeCount(LIBDAS_DAS_SCOPE_MESH_PRIMITIVE));
+        m_model.morph_targets.reserve(m_model.morph_targets.size() + _toc.GetScopeCount(LIBDAS_DAS_SCOPE_MORPH_TARGET));
+        m_model.meshes.reserve(m_model.meshes.size() + _toc.GetScopeCount(LIBDAS_DAS_SCOPE_MESH));
+        m_model.nodes.reserve(m_model.nodes.size() + _toc.GetScopeCount(LIBDAS_DAS_SCOPE_NODE));
+        m_model.scenes.reserve(m_model.scenes.size() + _toc.GetScopeCount(LIBDAS_DAS_SCOPE_SCENE));
+        m_model.joints.reserve(m_model.joints.size() + _toc.GetScopeCount(LIBDAS_DAS_SCOPE_SKELETON_JOINT));
+        m_model.skeletons.reserve(m_model.skeletons.size() + _toc.GetScopeCount(LIBDAS_DAS_SCOPE_SKELETON));
+        m_model.animations.reserve(m_model.animations.size() + _toc.GetScopeCount(LIBDAS_DAS_SCOPE_ANIMATION));
+        m_model.channels.reserve(m_model.channels.size() + _toc.GetScopeCount(LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL));
+        m_model.bvhs.reserve(m_model.bvhs.size() + _toc.GetScopeCount(LIBDAS_DAS_SCOPE_BVH));
+    }
+
+
     void DasParser::_FindSceneNodeRoots(DasScene &_scene) {
-        // allocate memory for scene roots
-        _scene.roots = new uint32_t[_scene.node_count];
+        // allocate memory for scene roots the same way as other scene arrays were allocated
+        if(!_scene._free_bit && m_model.arena)
+            _scene.roots = m_model.arena->Allocate<uint32_t>(_scene.node_count);
+        else _scene.roots = new uint32_t[_scene.node_count];
         _scene.root_count = 0;
 
         // array for containing boolean values about nodes being used as children
@@ -132,34 +401,149 @@ namespace Libdas {
     }
 
 
-    void DasParser::Parse(bool _clean_read, const std::string &_file_name) {
+    void DasParser::_ResolveBlob(DasBuffer &_buffer) {
+        if(!m_blob_store || !_buffer.blob_hash || _buffer.blob)
+            return;
+
+        if(!m_blob_store->Resolve(_buffer)) {
+            std::cerr << "Could not find blob " << std::hex << _buffer.blob_hash << std::dec << " of " << _buffer.data_len << 
+                         " bytes from blob store " << m_blob_store->GetRootPath() << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+        }
+    }
+
+
+    void DasParser::Parse(bool _clean_read, const std::string &_file_name, DasScopeMask _mask) {
         if(_file_name != "")
-            NewFile(_file_name);
+            _OpenFile(_file_name);
 
         ReadSignature();
 
-        // verify file signature
-        DasScopeType type = LIBDAS_DAS_SCOPE_END;
-        do {
-            type = ParseScopeDeclaration();
-            if(type == LIBDAS_DAS_SCOPE_END)
-                break;
-            std::any any_scope = ReadScopeData(type);
-            _DataCast(any_scope, type);
-        } while(true);
+        // all scope arrays are carved out of the model's arena
+        if(!m_model.arena)
+            m_model.arena = std::make_shared<DasArena>();
+        _SetArena(m_model.arena);
+
+        // table of contents allows to read only the requested scopes
+        if(ReadTableOfContents()) {
+            const DasTableOfContents &toc = GetTableOfContents();
+            // callbacks expect scopes in table of contents order, thus streaming parse is always sequential
+            if(m_thread_count > 1 && !m_use_callbacks) {
+                _ParseParallel(toc, _mask);
+            } else {
+                _ReserveScopes(toc);
+
+                // scopes that are not selected by the mask are never visited, thus only selected scopes are counted
+                std::vector<uint64_t> sizes;
+                if(m_use_callbacks && m_callbacks.on_progress) {
+                    sizes = _FindScopeSizes(toc);
+                    m_progress_total = 0;
+                    size_t index = 0;
+                    for(uint32_t i = 0; i < static_cast<uint32_t>(LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS); i++) {
+                        for(uint32_t j = 0; j < toc.GetScopeCount(static_cast<DasScopeType>(i)); j++, index++) {
+                            if(_mask & LIBDAS_DAS_SCOPE_MASK(static_cast<DasScopeType>(i)))
+                                m_progress_total += sizes[index];
+                        }
+                    }
+                }
 
-        if(_clean_read) CloseFile();
+                size_t index = 0;
+                for(uint32_t i = 0; i < static_cast<uint32_t>(LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS); i++) {
+                    const DasScopeType type = static_cast<DasScopeType>(i);
+                    if(!(_mask & LIBDAS_DAS_SCOPE_MASK(type))) {
+                        index += toc.GetScopeCount(type);
+                        continue;
+                    }
+
+                    for(uint32_t j = 0; j < toc.GetScopeCount(type); j++, index++) {
+                        SeekScope(type, j);
+                        _ReadScope(type, false);
+                        if(m_use_callbacks) {
+                            _EmitScope(type);
+                            if(!sizes.empty())
+                                _ReportProgress(m_bytes_read + sizes[index]);
+                        }
+                    }
+                }
+            }
+        } else {
+            // sequential reading passes every scope, including the discarded ones
+            if(_GetMappedFile())
+                m_progress_total = static_cast<uint64_t>(_GetMappedFile()->GetSize());
+
+            m_override = DasScopeOverride();
+            DasScopeType type = LIBDAS_DAS_SCOPE_END;
+            do {
+                type = ParseScopeDeclaration();
+                if(type == LIBDAS_DAS_SCOPE_END)
+                    break;
+
+                // overrides of patched files apply to the scope that follows them
+                const bool is_discarded = !(_mask & LIBDAS_DAS_SCOPE_MASK(type));
+                _ReadScope(type, is_discarded);
+                if(m_use_callbacks && !is_discarded && type != LIBDAS_DAS_SCOPE_OVERRIDE)
+                    _EmitScope(type);
+                if(m_use_callbacks)
+                    _ReportProgress(_GetReadOffset());
+
+                if(type != LIBDAS_DAS_SCOPE_OVERRIDE)
+                    m_override = DasScopeOverride();
+            } while(true);
+
+            // trailing whitespace after the last scope is consumed while looking for the next declaration
+            if(m_use_callbacks && m_bytes_read < m_progress_total)
+                _ReportProgress(m_progress_total);
+        }
+
+        // buffer data points into the mapping, thus the model needs to share its ownership
+        // lazily loaded buffers read their payloads from a separate file handle instead
+        if(_GetMappedFile() && !_IsLazyBufferLoading())
+            m_model.mapped_file = _GetMappedFile();
+        else if(_clean_read) CloseFile();
+
+        for(DasBuffer &buffer : m_model.buffers)
+            _ResolveBlob(buffer);
 
         // search and find root nodes for each given scene
-        for(auto it = m_model.scenes.begin(); it != m_model.scenes.end(); it++)
-            _FindSceneNodeRoots(*it);
+        if(_mask & LIBDAS_DAS_SCOPE_MASK(LIBDAS_DAS_SCOPE_NODE)) {
+            for(auto it = m_model.scenes.begin(); it != m_model.scenes.end(); it++)
+                _FindSceneNodeRoots(*it);
+        }
 
         Clear();
     }
 
 
+    std::future<void> DasParser::ParseAsync(const DasParseCallbacks &_callbacks, const std::string &_file_name, DasScopeMask _mask) {
+        m_callbacks = _callbacks;
+        m_use_callbacks = true;
+        m_bytes_read = 0;
+        m_progress_total = 0;
+
+        return std::async(std::launch::async, [this, _file_name, _mask]() {
+            Parse(false, _file_name, _mask);
+
+            m_callbacks = DasParseCallbacks();
+            m_use_callbacks = false;
+        });
+    }
+
+
+    void DasParser::SetThreadCount(uint32_t _thread_count) {
+        m_thread_count = _thread_count ? _thread_count : std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+
+    void DasParser::SetBlobStore(const std::shared_ptr<DasBlobStore> &_store) {
+        m_blob_store = _store;
+    }
+
+
     void DasParser::DeleteBuffers() {
         for (auto buf_it = m_model.buffers.begin(); buf_it != m_model.buffers.end(); buf_it++) {
+            if (!buf_it->_free_bit)
+                continue;
+
             for (auto ptr_it = buf_it->data_ptrs.begin(); ptr_it != buf_it->data_ptrs.end(); ptr_it++) {
                 std::free(ptr_it->first);
             }
@@ -167,5 +551,6 @@ namespace Libdas {
 
         _ClearBlobs();
         m_model.buffers.clear();
+        m_model.mapped_file.reset();
     }
 }
@@ -0,0 +1,94 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasPatcher.cpp - incremental DAS file patching class implementation
+// author: Karl-Mihkel Ott
+
+#define DAS_PATCHER_CPP
+#include "das/DasPatcher.h"
+
+namespace Libdas {
+
+    DasPatcher::DasPatcher(const std::string &_file_name) {
+        m_file_name = _file_name;
+
+        // only the header and the table of contents are read from the existing file
+        {
+            DasReaderCore reader(_file_name, true);
+            reader.ReadSignature();
+            if(!reader.ReadTableOfContents()) {
+                std::cerr << "Could not patch file " << _file_name << ", because it has no table of contents" << std::endl;
+                EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+            }
+            m_toc = reader.GetTableOfContents();
+        }
+
+        std::shared_ptr<FileWriter> file = std::make_shared<FileWriter>(_file_name, true);
+        _AppendTo(file, file->GetSize(), m_toc);
+    }
+
+
+    void DasPatcher::ReplaceBuffer(uint32_t _index, const DasBuffer &_buffer, uint32_t _alignment) {
+        _OverrideNextScope(LIBDAS_DAS_SCOPE_BUFFER, _index);
+        WriteBuffer(_buffer, _alignment);
+    }
+
+
+    void DasPatcher::ReplaceMeshPrimitive(uint32_t _index, const DasMeshPrimitive &_primitive) {
+        _OverrideNextScope(LIBDAS_DAS_SCOPE_MESH_PRIMITIVE, _index);
+        WriteMeshPrimitive(_primitive);
+    }
+
+
+    void DasPatcher::ReplaceMorphTarget(uint32_t _index, const DasMorphTarget &_morph_target) {
+        _OverrideNextScope(LIBDAS_DAS_SCOPE_MORPH_TARGET, _index);
+        WriteMorphTarget(_morph_target);
+    }
+
+
+    void DasPatcher::ReplaceMesh(uint32_t _index, const DasMesh &_mesh) {
+        _OverrideNextScope(LIBDAS_DAS_SCOPE_MESH, _index);
+        WriteMesh(_mesh);
+    }
+
+
+    void DasPatcher::ReplaceNode(uint32_t _index, const DasNode &_node) {
+        _OverrideNextScope(LIBDAS_DAS_SCOPE_NODE, _index);
+        WriteNode(_node);
+    }
+
+
+    void DasPatcher::ReplaceScene(uint32_t _index, const DasScene &_scene) {
+        _OverrideNextScope(LIBDAS_DAS_SCOPE_SCENE, _index);
+        WriteScene(_scene);
+    }
+
+
+    void DasPatcher::ReplaceSkeleton(uint32_t _index, const DasSkeleton &_skeleton) {
+        _OverrideNextScope(LIBDAS_DAS_SCOPE_SKELETON, _index);
+        WriteSkeleton(_skeleton);
+    }
+
+
+    void DasPatcher::ReplaceSkeletonJoint(uint32_t _index, const DasSkeletonJoint &_joint) {
+        _OverrideNextScope(LIBDAS_DAS_SCOPE_SKELETON_JOINT, _index);
+        WriteSkeletonJoint(_joint);
+    }
+
+
+    void DasPatcher::ReplaceAnimationChannel(uint32_t _index, const DasAnimationChannel &_channel) {
+        _OverrideNextScope(LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL, _index);
+        WriteAnimationChannel(_channel);
+    }
+
+
+    void DasPatcher::ReplaceAnimation(uint32_t _index, const DasAnimation &_animation) {
+        _OverrideNextScope(LIBDAS_DAS_SCOPE_ANIMATION, _index);
+        WriteAnimation(_animation);
+    }
+
+
+    void DasPatcher::ReplaceBvh(uint32_t _index, const DasBvh &_bvh) {
+        _OverrideNextScope(LIBDAS_DAS_SCOPE_BVH, _index);
+        WriteBvh(_bvh);
+    }
+}
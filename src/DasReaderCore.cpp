@@ -8,22 +8,171 @@
 
 namespace Libdas {
 
-    DasReaderCore::DasReaderCore(const std::string &_file_name) : 
-        MAR::AsciiLineReader(_file_name, DEFAULT_CHUNK, std::string("ENDSCOPE") + LIBDAS_DAS_NEWLINE), 
-        m_error(MODEL_FORMAT_DAS) 
+    // scope and value declaration keywords, looked up without any runtime initialisation
+    static constexpr Keyword<DasScopeType> s_scope_keywords[] = {
+        { "PROPERTIES", LIBDAS_DAS_SCOPE_PROPERTIES },
+        { "BUFFER", LIBDAS_DAS_SCOPE_BUFFER },
+        { "MORPHTARGET", LIBDAS_DAS_SCOPE_MORPH_TARGET },
+        { "MESHPRIMITIVE", LIBDAS_DAS_SCOPE_MESH_PRIMITIVE },
+        { "MESH", LIBDAS_DAS_SCOPE_MESH },
+        { "NODE", LIBDAS_DAS_SCOPE_NODE },
+        { "SCENE", LIBDAS_DAS_SCOPE_SCENE },
+        { "JOINT", LIBDAS_DAS_SCOPE_SKELETON_JOINT },
+        { "SKELETON", LIBDAS_DAS_SCOPE_SKELETON },
+        { "ANIMATION", LIBDAS_DAS_SCOPE_ANIMATION },
+        { "ANIMATIONCHANNEL", LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL },
+        { "BVH", LIBDAS_DAS_SCOPE_BVH },
+        { "TOC", LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS },
+        { "OVERRIDE", LIBDAS_DAS_SCOPE_OVERRIDE }
+    };
+
+    static constexpr Keyword<DasUniqueValueType> s_value_keywords[] = {
+        // PROPERTIES
+        { "MODEL", LIBDAS_DAS_UNIQUE_VALUE_TYPE_MODEL },
+        { "AUTHOR", LIBDAS_DAS_UNIQUE_VALUE_TYPE_AUTHOR },
+        { "COPYRIGHT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_COPYRIGHT },
+        { "MODDATE", LIBDAS_DAS_UNIQUE_VALUE_TYPE_MODDATE },
+        { "DEFAULTSCENE", LIBDAS_DAS_UNIQUE_VALUE_TYPE_DEFAULT_SCENE },
+
+        // BUFFER
+        { "BUFFERTYPE", LIBDAS_DAS_UNIQUE_VALUE_TYPE_BUFFER_TYPE },
+        { "DATALEN", LIBDAS_DAS_UNIQUE_VALUE_TYPE_DATA_LEN },
+        { "DATAPADDING", LIBDAS_DAS_UNIQUE_VALUE_TYPE_DATA_PADDING },
+        { "DATA", LIBDAS_DAS_UNIQUE_VALUE_TYPE_DATA },
+        { "BLOBHASH", LIBDAS_DAS_UNIQUE_VALUE_TYPE_BLOB_HASH },
+
+        // MESH
+        { "PRIMITIVECOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_PRIMITIVE_COUNT },
+        { "PRIMITIVES", LIBDAS_DAS_UNIQUE_VALUE_TYPE_PRIMITIVES },
+
+        // MESHPRIMITIVE
+        { "INDEXBUFFERID", LIBDAS_DAS_UNIQUE_VALUE_TYPE_INDEX_BUFFER_ID },
+        { "INDEXBUFFEROFFSET", LIBDAS_DAS_UNIQUE_VALUE_TYPE_INDEX_BUFFER_OFFSET },
+        { "DRAWCOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_DRAW_COUNT },
+        { "TEXTURECOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_TEXTURE_COUNT },
+        { "TEXTUREIDS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_TEXTURE_IDS },
+        { "COLORMULCOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_COLOR_MUL_COUNT },
+        { "COLORMULBUFFERIDS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_COLOR_MUL_BUFFER_IDS },
+        { "COLORMULBUFFEROFFSETS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_COLOR_MUL_BUFFER_OFFSETS },
+        { "JOINTSETCOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_SET_COUNT },
+        { "JOINTINDEXBUFFERIDS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_INDEX_BUFFER_IDS },
+        { "JOINTINDEXBUFFEROFFSETS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_INDEX_BUFFER_OFFSETS },
+        { "JOINTWEIGHTBUFFERIDS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_WEIGHT_BUFFER_IDS },
+        { "JOINTWEIGHTBUFFEROFFSETS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_WEIGHT_BUFFER_OFFSETS },
+        { "MORPHTARGETCOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_MORPH_TARGET_COUNT },
+        { "MORPHTARGETS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_MORPH_TARGETS },
+        { "MORPHWEIGHTS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_MORPH_WEIGHTS },
+        { "QUANTIZATION", LIBDAS_DAS_UNIQUE_VALUE_TYPE_QUANTIZATION },
+        { "POSITIONOFFSET", LIBDAS_DAS_UNIQUE_VALUE_TYPE_POSITION_OFFSET },
+        { "POSITIONSCALE", LIBDAS_DAS_UNIQUE_VALUE_TYPE_POSITION_SCALE },
+        { "UVOFFSET", LIBDAS_DAS_UNIQUE_VALUE_TYPE_UV_OFFSET },
+        { "UVSCALE", LIBDAS_DAS_UNIQUE_VALUE_TYPE_UV_SCALE },
+        { "MESHLETBUFFERID", LIBDAS_DAS_UNIQUE_VALUE_TYPE_MESHLET_BUFFER_ID },
+        { "MESHLETBUFFEROFFSET", LIBDAS_DAS_UNIQUE_VALUE_TYPE_MESHLET_BUFFER_OFFSET },
+        { "MESHLETCOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_MESHLET_COUNT },
+
+        // NODE
+        { "MESH", LIBDAS_DAS_UNIQUE_VALUE_TYPE_MESH },
+        { "SKELETON", LIBDAS_DAS_UNIQUE_VALUE_TYPE_SKELETON },
+
+        // SCENE
+        { "NODECOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_NODE_COUNT },
+        { "NODES", LIBDAS_DAS_UNIQUE_VALUE_TYPE_NODES },
+
+        // SKELETON
+        { "JOINTCOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_COUNT },
+        { "JOINTS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINTS },
+
+        // JOINT
+        { "INVERSEBINDPOS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_INVERSE_BIND_POS },
+        { "PARENT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_PARENT },
+        { "SCALE", LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCALE },
+        { "ROTATION", LIBDAS_DAS_UNIQUE_VALUE_TYPE_ROTATION },
+        { "TRANSLATION", LIBDAS_DAS_UNIQUE_VALUE_TYPE_TRANSLATION },
+
+        // ANIMATION
+        { "CHANNELCOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHANNEL_COUNT },
+        { "CHANNELS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHANNELS },
+
+        // ANIMATIONCHANNEL
+        { "NODEID", LIBDAS_DAS_UNIQUE_VALUE_TYPE_NODE_ID },
+        { "JOINTID", LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_ID },
+        { "TARGET", LIBDAS_DAS_UNIQUE_VALUE_TYPE_TARGET },
+        { "INTERPOLATION", LIBDAS_DAS_UNIQUE_VALUE_TYPE_INTERPOLATION },
+        { "KEYFRAMECOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_KEYFRAME_COUNT },
+        { "WEIGHTCOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_WEIGHT_COUNT },
+        { "KEYFRAMES", LIBDAS_DAS_UNIQUE_VALUE_TYPE_KEYFRAMES },
+        { "TANGENTS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_TANGENTS },
+        { "TARGETVALUES", LIBDAS_DAS_UNIQUE_VALUE_TYPE_TARGET_VALUES },
+
+        // BVH
+        { "SCENE", LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCENE },
+        { "BVHNODECOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_BVH_NODE_COUNT },
+        { "BVHNODES", LIBDAS_DAS_UNIQUE_VALUE_TYPE_BVH_NODES },
+        { "ITEMCOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_ITEM_COUNT },
+        { "ITEMS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_ITEMS },
+
+        // TOC
+        { "SCOPETYPECOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_TYPE_COUNT },
+        { "SCOPECOUNTS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_COUNTS },
+        { "SCOPEOFFSETS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_OFFSETS },
+
+        // OVERRIDE
+        { "SCOPETYPE", LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_TYPE },
+        { "SCOPEINDEX", LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_INDEX },
+
+        // Not so unique value types, since these values can be present in multiple scopes
+        { "NAME", LIBDAS_DAS_UNIQUE_VALUE_TYPE_NAME },
+        { "TRANSFORM", LIBDAS_DAS_UNIQUE_VALUE_TYPE_TRANSFORM },
+        { "VERTEXBUFFERID", LIBDAS_DAS_UNIQUE_VALUE_TYPE_VERTEX_BUFFER_ID },
+        { "VERTEXBUFFEROFFSET", LIBDAS_DAS_UNIQUE_VALUE_TYPE_VERTEX_BUFFER_OFFSET },
+        { "UVBUFFERIDS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_UV_BUFFER_IDS },
+        { "UVBUFFEROFFSETS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_UV_BUFFER_OFFSETS },
+        { "VERTEXNORMALBUFFERID", LIBDAS_DAS_UNIQUE_VALUE_TYPE_VERTEX_NORMAL_BUFFER_ID },
+        { "VERTEXNORMALBUFFEROFFSET", LIBDAS_DAS_UNIQUE_VALUE_TYPE_VERTEX_NORMAL_BUFFER_OFFSET },
+        { "VERTEXTANGENTBUFFERID", LIBDAS_DAS_UNIQUE_VALUE_TYPE_VERTEX_TANGENT_BUFFER_ID },
+        { "VERTEXTANGENTBUFFEROFFSET", LIBDAS_DAS_UNIQUE_VALUE_TYPE_VERTEX_TANGENT_BUFFER_OFFSET },
+        { "CHILDRENCOUNT", LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHILDREN_COUNT },
+        { "CHILDREN", LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHILDREN },
+        { "BOUNDS", LIBDAS_DAS_UNIQUE_VALUE_TYPE_BOUNDS }
+    };
+
+    static constexpr KeywordMatcher s_scope_matcher(s_scope_keywords, LIBDAS_DAS_SCOPE_UNDEFINED);
+    static constexpr KeywordMatcher s_value_matcher(s_value_keywords, LIBDAS_DAS_UNIQUE_VALUE_TYPE_UNKNOWN);
+
+    static_assert(s_scope_matcher.Find("MESH") == LIBDAS_DAS_SCOPE_MESH, "Invalid scope keyword table");
+    static_assert(s_value_matcher.Find("TARGETVALUES") == LIBDAS_DAS_UNIQUE_VALUE_TYPE_TARGET_VALUES, "Invalid value keyword table");
+    static_assert(s_value_matcher.Find("DATALEN:") == LIBDAS_DAS_UNIQUE_VALUE_TYPE_UNKNOWN, "Invalid value keyword table");
+
+
+    DasReaderCore::DasReaderCore(const std::string &_file_name, bool _use_mapping, bool _lazy_buffers) : 
+        MAR::AsciiLineReader(_use_mapping || _lazy_buffers ? "" : _file_name, DEFAULT_CHUNK, std::string("ENDSCOPE") + LIBDAS_DAS_NEWLINE), 
+        m_error(MODEL_FORMAT_DAS),
+        m_lazy_buffers(_lazy_buffers),
+        m_use_mapping(_use_mapping || _lazy_buffers)
     {
-        _CreateScopeNameMap();
-        _CreateScopeValueTypeMap();
         _SetLineBounds(std::make_pair(m_buffer, m_buffer + m_buffer_size - 1));
+
+        if(m_use_mapping && _file_name != "")
+            _OpenFile(_file_name);
     }
 
 
     DasReaderCore::DasReaderCore(DasReaderCore &&_drc) noexcept :
         MAR::AsciiLineReader(std::move(_drc)),
         m_error(std::move(_drc.m_error)),
-        m_scope_name_map(std::move(_drc.m_scope_name_map)),
-        m_unique_val_map(std::move(_drc.m_unique_val_map)),
-        m_buffer_blobs(std::move(_drc.m_buffer_blobs)) {}
+        m_buffer_blobs(std::move(_drc.m_buffer_blobs)),
+        m_lazy_buffers(_drc.m_lazy_buffers),
+        m_lazy_source(std::move(_drc.m_lazy_source)),
+        m_use_mapping(_drc.m_use_mapping),
+        m_mapped_file(std::move(_drc.m_mapped_file)),
+        m_map_ptr(_drc.m_map_ptr),
+        m_map_end(_drc.m_map_end),
+        m_arena(std::move(_drc.m_arena))
+    {
+        _drc.m_map_ptr = nullptr;
+        _drc.m_map_end = nullptr;
+    }
 
 
     DasReaderCore::~DasReaderCore() {
@@ -32,126 +181,102 @@ namespace Libdas {
     }
 
 
-    void DasReaderCore::_CreateScopeNameMap() {
-        m_scope_name_map["PROPERTIES"] = LIBDAS_DAS_SCOPE_PROPERTIES;
-        m_scope_name_map["BUFFER"] = LIBDAS_DAS_SCOPE_BUFFER;
-        m_scope_name_map["MORPHTARGET"] = LIBDAS_DAS_SCOPE_MORPH_TARGET;
-        m_scope_name_map["MESHPRIMITIVE"] = LIBDAS_DAS_SCOPE_MESH_PRIMITIVE;
-        m_scope_name_map["MESH"] = LIBDAS_DAS_SCOPE_MESH;
-        m_scope_name_map["NODE"] = LIBDAS_DAS_SCOPE_NODE;
-        m_scope_name_map["SCENE"] = LIBDAS_DAS_SCOPE_SCENE;
-        m_scope_name_map["JOINT"] = LIBDAS_DAS_SCOPE_SKELETON_JOINT;
-        m_scope_name_map["SKELETON"] = LIBDAS_DAS_SCOPE_SKELETON;
-        m_scope_name_map["ANIMATION"] = LIBDAS_DAS_SCOPE_ANIMATION; 
-        m_scope_name_map["ANIMATIONCHANNEL"] = LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL;
+    DasUniqueValueType DasReaderCore::_FindUniqueValueType(std::string_view _value) {
+        return s_value_matcher.Find(_value);
     }
 
 
-    void DasReaderCore::_CreateScopeValueTypeMap() {
-        // PROPERTIES
-        m_unique_val_map["MODEL"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_MODEL;
-        m_unique_val_map["AUTHOR"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_AUTHOR;
-        m_unique_val_map["COPYRIGHT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_COPYRIGHT;
-        m_unique_val_map["MODDATE"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_MODDATE;
-        m_unique_val_map["DEFAULTSCENE"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_DEFAULT_SCENE;
+    std::string_view DasReaderCore::_ReadDeclaration() {
+        if(m_mapped_file) {
+            // skip all whitespaces and newlines preceding the declaration
+            while(m_map_ptr < m_map_end && (*m_map_ptr == ' ' || *m_map_ptr == '\t' || *m_map_ptr == '\r' || *m_map_ptr == '\n'))
+                m_map_ptr++;
 
-        // BUFFER
-        m_unique_val_map["BUFFERTYPE"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_BUFFER_TYPE;
-        m_unique_val_map["DATALEN"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_DATA_LEN;
-        m_unique_val_map["DATA"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_DATA;
+            char *beg = m_map_ptr;
+            while(m_map_ptr < m_map_end && *m_map_ptr != ' ' && *m_map_ptr != '\t' && *m_map_ptr != '\r' && *m_map_ptr != '\n')
+                m_map_ptr++;
 
-        // MESH
-        m_unique_val_map["PRIMITIVECOUNT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_PRIMITIVE_COUNT;
-        m_unique_val_map["PRIMITIVES"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_PRIMITIVES;
+            return std::string_view(beg, m_map_ptr - beg);
+        }
 
-        // MESHPRIMITIVE
-        m_unique_val_map["INDEXBUFFERID"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_INDEX_BUFFER_ID;
-        m_unique_val_map["INDEXBUFFEROFFSET"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_INDEX_BUFFER_OFFSET;
-        m_unique_val_map["DRAWCOUNT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_DRAW_COUNT;
-        m_unique_val_map["TEXTURECOUNT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_TEXTURE_COUNT;
-        m_unique_val_map["TEXTUREIDS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_TEXTURE_IDS;
-        m_unique_val_map["COLORMULCOUNT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_COLOR_MUL_COUNT;
-        m_unique_val_map["COLORMULBUFFERIDS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_COLOR_MUL_BUFFER_IDS;
-        m_unique_val_map["COLORMULBUFFEROFFSETS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_COLOR_MUL_BUFFER_OFFSETS;
-        m_unique_val_map["JOINTSETCOUNT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_SET_COUNT;
-        m_unique_val_map["JOINTINDEXBUFFERIDS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_INDEX_BUFFER_IDS;
-        m_unique_val_map["JOINTINDEXBUFFEROFFSETS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_INDEX_BUFFER_OFFSETS;
-        m_unique_val_map["JOINTWEIGHTBUFFERIDS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_WEIGHT_BUFFER_IDS;
-        m_unique_val_map["JOINTWEIGHTBUFFEROFFSETS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_WEIGHT_BUFFER_OFFSETS;
-        m_unique_val_map["MORPHTARGETCOUNT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_MORPH_TARGET_COUNT;
-        m_unique_val_map["MORPHTARGETS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_MORPH_TARGETS;
-        m_unique_val_map["MORPHWEIGHTS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_MORPH_WEIGHTS;
+        _SkipSkippableCharacters(true);
+        char *beg = _GetReadPtr();
+        char *end = _ExtractWord();
+        _SetReadPtr(end);
 
-        // NODE
-        m_unique_val_map["MESH"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_MESH;
-        m_unique_val_map["SKELETON"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_SKELETON;
+        // no more data in buffer chunk
+        if(beg == end) {
+            bool is_read = _ReadNewChunk();
+            _SetReadPtr(m_buffer);
+            if(!is_read) return std::string_view();
 
-        // SCENE
-        m_unique_val_map["NODECOUNT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_NODE_COUNT;
-        m_unique_val_map["NODES"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_NODES;
+            _SkipSkippableCharacters(true);
+            beg = _GetReadPtr();
+            end = _ExtractWord();
+            _SetReadPtr(end);
+        }
 
-        // SKELETON
-        m_unique_val_map["JOINTCOUNT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_COUNT;
-        m_unique_val_map["JOINTS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINTS;
+        return std::string_view(beg, end - beg);
+    }
 
-        // JOINT
-        m_unique_val_map["INVERSEBINDPOS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_INVERSE_BIND_POS;
-        m_unique_val_map["PARENT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_PARENT;
-        m_unique_val_map["SCALE"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCALE;
-        m_unique_val_map["ROTATION"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_ROTATION;
-        m_unique_val_map["TRANSLATION"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_TRANSLATION;
 
-        // ANIMATION
-        m_unique_val_map["CHANNELCOUNT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHANNEL_COUNT;
-        m_unique_val_map["CHANNELS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHANNELS;
+    bool DasReaderCore::_SkipBytes(size_t _len) {
+        if(m_mapped_file) {
+            if(static_cast<size_t>(m_map_end - m_map_ptr) < _len)
+                return false;
+            m_map_ptr += _len;
+            return true;
+        }
 
-        // ANIMATIONCHANNEL
-        m_unique_val_map["NODEID"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_NODE_ID;
-        m_unique_val_map["JOINTID"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINT_ID;
-        m_unique_val_map["TARGET"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_TARGET;
-        m_unique_val_map["INTERPOLATION"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_INTERPOLATION;
-        m_unique_val_map["KEYFRAMECOUNT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_KEYFRAME_COUNT;
-        m_unique_val_map["WEIGHTCOUNT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_WEIGHT_COUNT;
-        m_unique_val_map["KEYFRAMES"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_KEYFRAMES;
-        m_unique_val_map["TANGENTS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_TANGENTS;
-        m_unique_val_map["TARGETVALUES"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_TARGET_VALUES;
+        return _SkipData(_len);
+    }
 
-        // Not so unique value types, since these values can be present in multiple scopes
-        m_unique_val_map["NAME"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_NAME;
-        m_unique_val_map["TRANSFORM"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_TRANSFORM;
-        m_unique_val_map["VERTEXBUFFERID"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_VERTEX_BUFFER_ID;
-        m_unique_val_map["VERTEXBUFFEROFFSET"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_VERTEX_BUFFER_OFFSET;
-        m_unique_val_map["UVBUFFERIDS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_UV_BUFFER_IDS;
-        m_unique_val_map["UVBUFFEROFFSETS"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_UV_BUFFER_OFFSETS;
-        m_unique_val_map["VERTEXNORMALBUFFERID"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_VERTEX_NORMAL_BUFFER_ID;
-        m_unique_val_map["VERTEXNORMALBUFFEROFFSET"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_VERTEX_NORMAL_BUFFER_OFFSET;
-        m_unique_val_map["VERTEXTANGENTBUFFERID"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_VERTEX_TANGENT_BUFFER_ID;
-        m_unique_val_map["VERTEXTANGENTBUFFEROFFSET"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_VERTEX_TANGENT_BUFFER_OFFSET;
-        m_unique_val_map["CHILDRENCOUNT"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHILDREN_COUNT;
-        m_unique_val_map["CHILDREN"] = LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHILDREN;
+
+    std::string DasReaderCore::_ReadString() {
+        if(m_mapped_file) {
+            if(m_map_ptr >= m_map_end || *m_map_ptr != '"')
+                m_error.Error(LIBDAS_ERROR_INVALID_VALUE, std::string(m_map_ptr, m_map_ptr < m_map_end ? 1 : 0));
+
+            char *beg = ++m_map_ptr;
+            char *end = reinterpret_cast<char*>(std::memchr(beg, '"', m_map_end - beg));
+            if(!end) m_error.Error(LIBDAS_ERROR_INVALID_DATA_LENGTH);
+
+            m_map_ptr = end + 1;
+            return std::string(beg, end - beg);
+        }
+
+        return _ExtractString();
     }
 
 
-    DasUniqueValueType DasReaderCore::_FindUniqueValueType(const std::string &_value) {
-        if(m_unique_val_map.find(_value) == m_unique_val_map.end())
-            return LIBDAS_DAS_UNIQUE_VALUE_TYPE_UNKNOWN;
+    char *DasReaderCore::_ReadBlob(size_t _len) {
+        if(m_mapped_file) {
+            if(static_cast<size_t>(m_map_end - m_map_ptr) < _len)
+                return nullptr;
+
+            char *blob = m_map_ptr;
+            m_map_ptr += _len;
+            return blob;
+        }
 
-        return m_unique_val_map[_value];
+        char *blob = _ExtractBlob(_len);
+        if(blob) m_buffer_blobs.push_back(blob);
+        return blob;
     }
 
 
     void DasReaderCore::_ReadPropertiesValue(DasProperties *_props, DasUniqueValueType _type) {
         switch(_type) {
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_MODEL:
-                _props->model = _ExtractString();
+                _props->model = _ReadString();
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_AUTHOR:
-                _props->author = _ExtractString();
+                _props->author = _ReadString();
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_COPYRIGHT:
-                _props->copyright = _ExtractString();
+                _props->copyright = _ReadString();
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_MODDATE: 
@@ -179,13 +304,47 @@ namespace Libdas {
                 _ReadSingleValue(_buffer->data_len);
                 break;
 
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_DATA_PADDING:
+                _ReadSingleValue(_buffer->data_padding);
+                break;
+
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_DATA:
-                _buffer->data_ptrs.push_back(std::make_pair(_ExtractBlob(_buffer->data_len), _buffer->data_len));
+                // padding bytes only align the payload start in the file
+                if(_buffer->data_padding) {
+                    if(m_mapped_file) {
+                        if(!_SkipBytes(_buffer->data_padding))
+                            m_error.Error(LIBDAS_ERROR_INVALID_DATA_LENGTH);
+                    } else {
+                        std::vector<char> padding(_buffer->data_padding);
+                        if(!_ExtractBlob(padding.size(), padding.data()))
+                            m_error.Error(LIBDAS_ERROR_INVALID_DATA_LENGTH);
+                    }
+                }
+
+                // record payload location and skip it
+                if(m_lazy_source) {
+                    _buffer->data_offsets.push_back(static_cast<uint64_t>(m_map_ptr - m_mapped_file->GetData()));
+                    _buffer->data_ptrs.push_back(std::make_pair(nullptr, _buffer->data_len));
+                    _buffer->source = m_lazy_source;
+                    if(!_SkipBytes(_buffer->data_len))
+                        m_error.Error(LIBDAS_ERROR_INVALID_DATA_LENGTH);
+                    break;
+                }
+
+                _buffer->data_ptrs.push_back(std::make_pair(_ReadBlob(_buffer->data_len), _buffer->data_len));
 
                 // check if blob reading was successful
                 if(!_buffer->data_ptrs.back().first)
                     m_error.Error(LIBDAS_ERROR_INVALID_DATA_LENGTH);
-                m_buffer_blobs.push_back(const_cast<char*>(_buffer->data_ptrs.back().first));
+
+                // mapped memory is owned by the mapping itself
+                if(m_mapped_file)
+                    _buffer->_free_bit = false;
+                break;
+
+            // payload is kept in an external blob store and resolved by the parser
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_BLOB_HASH:
+                _ReadSingleValue(_buffer->blob_hash);
                 break;
 
             default:
@@ -238,8 +397,8 @@ namespace Libdas {
 
                 // allocate memory for uv buffer ids and offsets
                 if(_primitive->texture_count) {
-                    _primitive->uv_buffer_ids = new uint32_t[_primitive->texture_count];
-                    _primitive->uv_buffer_offsets = new uint32_t[_primitive->texture_count];
+                    _primitive->uv_buffer_ids = _AllocateArray<uint32_t>(_primitive->texture_count, _primitive->_free_bit);
+                    _primitive->uv_buffer_offsets = _AllocateArray<uint32_t>(_primitive->texture_count, _primitive->_free_bit);
                 }
                 break;
 
@@ -254,7 +413,7 @@ namespace Libdas {
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_TEXTURE_IDS:
                 // allocate memory for texture ids
                 if(_primitive->texture_count) {
-                    _primitive->texture_ids = new uint32_t[_primitive->texture_count];
+                    _primitive->texture_ids = _AllocateArray<uint32_t>(_primitive->texture_count, _primitive->_free_bit);
                     _ReadArrayValues(_primitive->texture_ids, _primitive->texture_count);
                 }
                 break;
@@ -264,8 +423,8 @@ namespace Libdas {
 
                 // allocate enough memory for buffer ids / offsets
                 if(_primitive->color_mul_count) {
-                    _primitive->color_mul_buffer_ids = new uint32_t[_primitive->color_mul_count];
-                    _primitive->color_mul_buffer_offsets = new uint32_t[_primitive->color_mul_count];
+                    _primitive->color_mul_buffer_ids = _AllocateArray<uint32_t>(_primitive->color_mul_count, _primitive->_free_bit);
+                    _primitive->color_mul_buffer_offsets = _AllocateArray<uint32_t>(_primitive->color_mul_count, _primitive->_free_bit);
                 }
                 break;
 
@@ -282,10 +441,10 @@ namespace Libdas {
 
                 // allocate memory for index and weight buffer ids / offsets
                 if(_primitive->joint_set_count) {
-                    _primitive->joint_index_buffer_ids = new uint32_t[_primitive->joint_set_count];
-                    _primitive->joint_index_buffer_offsets = new uint32_t[_primitive->joint_set_count];
-                    _primitive->joint_weight_buffer_ids = new uint32_t[_primitive->joint_set_count];
-                    _primitive->joint_weight_buffer_offsets = new uint32_t[_primitive->joint_set_count];
+                    _primitive->joint_index_buffer_ids = _AllocateArray<uint32_t>(_primitive->joint_set_count, _primitive->_free_bit);
+                    _primitive->joint_index_buffer_offsets = _AllocateArray<uint32_t>(_primitive->joint_set_count, _primitive->_free_bit);
+                    _primitive->joint_weight_buffer_ids = _AllocateArray<uint32_t>(_primitive->joint_set_count, _primitive->_free_bit);
+                    _primitive->joint_weight_buffer_offsets = _AllocateArray<uint32_t>(_primitive->joint_set_count, _primitive->_free_bit);
                 }
                 break;
 
@@ -310,8 +469,8 @@ namespace Libdas {
 
                 // allocate memory for morph target references
                 if(_primitive->morph_target_count) {
-                    _primitive->morph_targets = new uint32_t[_primitive->morph_target_count];
-                    _primitive->morph_weights = new float[_primitive->morph_target_count];
+                    _primitive->morph_targets = _AllocateArray<uint32_t>(_primitive->morph_target_count, _primitive->_free_bit);
+                    _primitive->morph_weights = _AllocateArray<float>(_primitive->morph_target_count, _primitive->_free_bit);
                 }
                 break;
 
@@ -323,6 +482,42 @@ namespace Libdas {
                 _ReadArrayValues(_primitive->morph_weights, _primitive->morph_target_count);
                 break;
 
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_QUANTIZATION:
+                _ReadSingleValue(_primitive->quantization);
+                break;
+
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_POSITION_OFFSET:
+                _ReadSingleValue(_primitive->position_offset);
+                break;
+
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_POSITION_SCALE:
+                _ReadSingleValue(_primitive->position_scale);
+                break;
+
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_UV_OFFSET:
+                _ReadSingleValue(_primitive->uv_offset);
+                break;
+
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_UV_SCALE:
+                _ReadSingleValue(_primitive->uv_scale);
+                break;
+
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_MESHLET_BUFFER_ID:
+                _ReadSingleValue(_primitive->meshlet_buffer_id);
+                break;
+
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_MESHLET_BUFFER_OFFSET:
+                _ReadSingleValue(_primitive->meshlet_buffer_offset);
+                break;
+
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_MESHLET_COUNT:
+                _ReadSingleValue(_primitive->meshlet_count);
+                break;
+
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_BOUNDS:
+                _ReadSingleValue(_primitive->bounds);
+                break;
+
             default:
                 LIBDAS_ASSERT(false);
                 break;
@@ -345,8 +540,8 @@ namespace Libdas {
 
                 // allocate memory for buffer ids and offsets
                 if(_morph_target->texture_count) {
-                    _morph_target->uv_buffer_ids = new uint32_t[_morph_target->texture_count];
-                    _morph_target->uv_buffer_offsets = new uint32_t[_morph_target->texture_count];
+                    _morph_target->uv_buffer_ids = _AllocateArray<uint32_t>(_morph_target->texture_count, _morph_target->_free_bit);
+                    _morph_target->uv_buffer_offsets = _AllocateArray<uint32_t>(_morph_target->texture_count, _morph_target->_free_bit);
                 }
                 break;
 
@@ -363,8 +558,8 @@ namespace Libdas {
 
                 // allocate memory for buffer ids and offsets
                 if(_morph_target->color_mul_count) {
-                    _morph_target->color_mul_buffer_ids = new uint32_t[_morph_target->color_mul_count];
-                    _morph_target->color_mul_buffer_offsets = new uint32_t[_morph_target->color_mul_count];
+                    _morph_target->color_mul_buffer_ids = _AllocateArray<uint32_t>(_morph_target->color_mul_count, _morph_target->_free_bit);
+                    _morph_target->color_mul_buffer_offsets = _AllocateArray<uint32_t>(_morph_target->color_mul_count, _morph_target->_free_bit);
                 }
                 break;
 
@@ -403,20 +598,24 @@ namespace Libdas {
     void DasReaderCore::_ReadMeshValue(DasMesh *_mesh, DasUniqueValueType _type) {
         switch(_type) {
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_NAME:
-                _mesh->name = _ExtractString();
+                _mesh->name = _ReadString();
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_PRIMITIVE_COUNT:
                 _ReadSingleValue(_mesh->primitive_count);
 
                 // allocate memory for primitive references
-                _mesh->primitives = new uint32_t[_mesh->primitive_count];
+                _mesh->primitives = _AllocateArray<uint32_t>(_mesh->primitive_count, _mesh->_free_bit);
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_PRIMITIVES:
                 _ReadArrayValues(_mesh->primitives, _mesh->primitive_count);
                 break;
 
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_BOUNDS:
+                _ReadSingleValue(_mesh->bounds);
+                break;
+
             default:
                 LIBDAS_ASSERT(false);
                 break;
@@ -427,14 +626,14 @@ namespace Libdas {
     void DasReaderCore::_ReadNodeValue(DasNode *_node, DasUniqueValueType _type) {
         switch(_type) {
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_NAME:
-                _node->name = _ExtractString();
+                _node->name = _ReadString();
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHILDREN_COUNT:
                 _ReadSingleValue(_node->children_count);
 
                 // allocate memory for children
-                _node->children = new uint32_t[_node->children_count];
+                _node->children = _AllocateArray<uint32_t>(_node->children_count, _node->_free_bit);
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHILDREN:
@@ -463,20 +662,24 @@ namespace Libdas {
     void DasReaderCore::_ReadSceneValue(DasScene *_scene, DasUniqueValueType _type) {
         switch(_type) {
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_NAME:
-                _scene->name = _ExtractString();
+                _scene->name = _ReadString();
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_NODE_COUNT:
                 _ReadSingleValue(_scene->node_count);
 
                 // allocate memory for scene nodes
-                _scene->nodes = new uint32_t[_scene->node_count];
+                _scene->nodes = _AllocateArray<uint32_t>(_scene->node_count, _scene->_free_bit);
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_NODES:
                 _ReadArrayValues(_scene->nodes, _scene->node_count);
                 break;
 
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_BOUNDS:
+                _ReadSingleValue(_scene->bounds);
+                break;
+
             default:
                 LIBDAS_ASSERT(false);
                 break;
@@ -487,7 +690,7 @@ namespace Libdas {
     void DasReaderCore::_ReadSkeletonValue(DasSkeleton *_skeleton, DasUniqueValueType _type) {
         switch(_type) {
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_NAME:
-                _skeleton->name = _ExtractString();
+                _skeleton->name = _ReadString();
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_PARENT:
@@ -498,7 +701,7 @@ namespace Libdas {
                 _ReadSingleValue(_skeleton->joint_count);
 
                 // allocate memory for skeletons
-                _skeleton->joints = new uint32_t[_skeleton->joint_count];
+                _skeleton->joints = _AllocateArray<uint32_t>(_skeleton->joint_count, _skeleton->_free_bit);
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_JOINTS:
@@ -518,14 +721,14 @@ namespace Libdas {
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_NAME:
-                _joint->name = _ExtractString();
+                _joint->name = _ReadString();
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHILDREN_COUNT:
                 _ReadSingleValue(_joint->children_count);
 
                 // allocate memory for children
-                _joint->children = new uint32_t[_joint->children_count];
+                _joint->children = _AllocateArray<uint32_t>(_joint->children_count, _joint->_free_bit);
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHILDREN:
@@ -553,14 +756,14 @@ namespace Libdas {
     void DasReaderCore::_ReadAnimationValue(DasAnimation *_animation, DasUniqueValueType _type) {
         switch(_type) {
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_NAME:
-                _animation->name = _ExtractString();
+                _animation->name = _ReadString();
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHANNEL_COUNT:
                 _ReadSingleValue(_animation->channel_count);
 
                 // allocate memory for channels
-                _animation->channels = new uint32_t[_animation->channel_count];
+                _animation->channels = _AllocateArray<uint32_t>(_animation->channel_count, _animation->_free_bit);
                 break;
 
             case LIBDAS_DAS_UNIQUE_VALUE_TYPE_CHANNELS:
@@ -598,7 +801,7 @@ namespace Libdas {
                 // allocate memory for keyframe data
                 LIBDAS_ASSERT(_channel->keyframe_count);
                 if(_channel->keyframe_count) {
-                    _channel->keyframes = new float[_channel->keyframe_count];
+                    _channel->keyframes = _AllocateArray<float>(_channel->keyframe_count, _channel->_free_bit);
                     uint32_t type_stride = 0;
                     switch(_channel->target) {
                         case LIBDAS_ANIMATION_TARGET_TRANSLATION:
@@ -619,8 +822,8 @@ namespace Libdas {
 
                     if(type_stride) {
                         if(_channel->interpolation == LIBDAS_INTERPOLATION_VALUE_CUBICSPLINE)
-                            _channel->tangents = new char[type_stride * _channel->keyframe_count * 2];
-                        _channel->target_values = new char[type_stride * _channel->keyframe_count];
+                            _channel->tangents = _AllocateArray<char>(type_stride * _channel->keyframe_count * 2, _channel->_free_bit);
+                        _channel->target_values = _AllocateArray<char>(type_stride * _channel->keyframe_count, _channel->_free_bit);
                     }
                 }
                 break;
@@ -641,7 +844,7 @@ namespace Libdas {
                             type_stride = static_cast<uint32_t>(sizeof(float)) * _channel->weight_count;
 
                             // allocate memory for tangents 
-                            _channel->tangents = new char[type_stride * 2 * _channel->keyframe_count];
+                            _channel->tangents = _AllocateArray<char>(type_stride * 2 * _channel->keyframe_count, _channel->_free_bit);
                             break;
 
                         case LIBDAS_ANIMATION_TARGET_TRANSLATION:
@@ -661,10 +864,7 @@ namespace Libdas {
                             break;
                     }
 
-                    for(uint32_t i = 0; i < type_stride * 2 * _channel->keyframe_count; i++) {
-                        _channel->tangents[i] = *_GetReadPtr();
-                        if(!_SkipData(sizeof(char))) m_error.Error(LIBDAS_ERROR_INVALID_DATA_LENGTH);
-                    }
+                    _ReadArrayValues(_channel->tangents, type_stride * 2 * _channel->keyframe_count);
                 }
                 break;
 
@@ -676,7 +876,7 @@ namespace Libdas {
                             type_stride = static_cast<uint32_t>(sizeof(float)) * _channel->weight_count;
 
                             // allocate memory for target values 
-                            _channel->target_values = new char[type_stride * _channel->keyframe_count];
+                            _channel->target_values = _AllocateArray<char>(type_stride * _channel->keyframe_count, _channel->_free_bit);
                             break;
 
                         case LIBDAS_ANIMATION_TARGET_TRANSLATION:
@@ -696,10 +896,7 @@ namespace Libdas {
                             break;
                     }
 
-                    for(uint32_t i = 0; i < type_stride * _channel->keyframe_count; i++) {
-                        _channel->target_values[i] = *_GetReadPtr();
-                        if(!_SkipData(sizeof(char))) m_error.Error(LIBDAS_ERROR_INVALID_DATA_LENGTH);
-                    }
+                    _ReadArrayValues(_channel->target_values, type_stride * _channel->keyframe_count);
                 }
                 break;
 
@@ -710,51 +907,32 @@ namespace Libdas {
     }
 
 
-    void DasReaderCore::_ReadScopeValueDataCaller(std::any &_scope, DasScopeType _type, DasUniqueValueType _value_type) {
-        // any type check is necessary for correct error output
+    void DasReaderCore::_ReadBvhValue(DasBvh *_bvh, DasUniqueValueType _type) {
         switch(_type) {
-            case LIBDAS_DAS_SCOPE_PROPERTIES:
-                _ReadPropertiesValue(std::any_cast<DasProperties>(&_scope), _value_type);
-                break;
-
-            case LIBDAS_DAS_SCOPE_BUFFER:
-                _ReadBufferValue(std::any_cast<DasBuffer>(&_scope), _value_type);
-                break;
-
-            case LIBDAS_DAS_SCOPE_MESH_PRIMITIVE:
-                _ReadMeshPrimitiveValue(std::any_cast<DasMeshPrimitive>(&_scope), _value_type);
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCENE:
+                _ReadSingleValue(_bvh->scene);
                 break;
 
-            case LIBDAS_DAS_SCOPE_MORPH_TARGET:
-                _ReadMorphTargetValue(std::any_cast<DasMorphTarget>(&_scope), _value_type);
-                break;
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_BVH_NODE_COUNT:
+                _ReadSingleValue(_bvh->node_count);
 
-            case LIBDAS_DAS_SCOPE_MESH:
-                _ReadMeshValue(std::any_cast<DasMesh>(&_scope), _value_type);
+                // allocate memory for hierarchy nodes
+                _bvh->nodes = _AllocateArray<DasBvhNode>(_bvh->node_count, _bvh->_free_bit);
                 break;
 
-            case LIBDAS_DAS_SCOPE_NODE:
-                _ReadNodeValue(std::any_cast<DasNode>(&_scope), _value_type);
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_BVH_NODES:
+                _ReadArrayValues(_bvh->nodes, _bvh->node_count);
                 break;
 
-            case LIBDAS_DAS_SCOPE_SCENE:
-                _ReadSceneValue(std::any_cast<DasScene>(&_scope), _value_type);
-                break;
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_ITEM_COUNT:
+                _ReadSingleValue(_bvh->item_count);
 
-            case LIBDAS_DAS_SCOPE_SKELETON:
-                _ReadSkeletonValue(std::any_cast<DasSkeleton>(&_scope), _value_type);
+                // allocate memory for leaf items
+                _bvh->items = _AllocateArray<uint32_t>(_bvh->item_count, _bvh->_free_bit);
                 break;
 
-            case LIBDAS_DAS_SCOPE_SKELETON_JOINT:
-                _ReadSkeletonJointValue(std::any_cast<DasSkeletonJoint>(&_scope), _value_type);
-                break;
-
-            case LIBDAS_DAS_SCOPE_ANIMATION:
-                _ReadAnimationValue(std::any_cast<DasAnimation>(&_scope), _value_type);
-                break;
-
-            case LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL:
-                _ReadAnimationChannelValue(std::any_cast<DasAnimationChannel>(&_scope), _value_type);
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_ITEMS:
+                _ReadArrayValues(_bvh->items, _bvh->item_count);
                 break;
 
             default:
@@ -764,47 +942,80 @@ namespace Libdas {
     }
 
 
-    inline std::any DasReaderCore::_GetAnyScopeStructure(DasScopeType _type) {
-        switch(_type) {
-            case LIBDAS_DAS_SCOPE_PROPERTIES:
-                return std::any(DasProperties());
+    void DasReaderCore::_RejectTableOfContents(DasTableOfContents *_toc, const std::string &_value) {
+        // extent of the remaining table of contents data is unknown, thus streamed reading cannot continue
+        if(!m_mapped_file)
+            m_error.Error(LIBDAS_ERROR_INVALID_VALUE, _value);
 
-            case LIBDAS_DAS_SCOPE_BUFFER:
-                return std::any(DasBuffer());
+        *_toc = DasTableOfContents();
+        m_map_ptr = m_map_end;
+    }
 
-            case LIBDAS_DAS_SCOPE_MORPH_TARGET:
-                return std::any(DasMorphTarget());
 
-            case LIBDAS_DAS_SCOPE_MESH_PRIMITIVE:
-                return std::any(DasMeshPrimitive());
+    void DasReaderCore::_ReadTableOfContentsValue(DasTableOfContents *_toc, DasUniqueValueType _type) {
+        switch(_type) {
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_TYPE_COUNT:
+                {
+                    uint32_t type_count = 0;
+                    _ReadSingleValue(type_count);
+                    if(type_count > static_cast<uint32_t>(LIBDAS_DAS_SCOPE_END)) {
+                        _RejectTableOfContents(_toc, "SCOPETYPECOUNT");
+                        break;
+                    }
+                    _toc->scope_counts.resize(type_count);
+                }
+                break;
 
-            case LIBDAS_DAS_SCOPE_MESH:
-                return std::any(DasMesh());
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_COUNTS:
+                {
+                    _ReadArrayValues(_toc->scope_counts.data(), static_cast<uint32_t>(_toc->scope_counts.size()));
 
-            case LIBDAS_DAS_SCOPE_SCENE:
-                return std::any(DasScene());
+                    size_t total = 0;
+                    for(uint32_t count : _toc->scope_counts)
+                        total += count;
 
-            case LIBDAS_DAS_SCOPE_NODE:
-                return std::any(DasNode());
+                    // every scope offset must fit into the remaining mapping, before any memory is allocated for them
+                    if(m_mapped_file && total > static_cast<size_t>(m_map_end - m_map_ptr) / sizeof(uint64_t)) {
+                        _RejectTableOfContents(_toc, "SCOPECOUNTS");
+                        break;
+                    }
+                    _toc->scope_offsets.resize(total);
+                }
+                break;
 
-            case LIBDAS_DAS_SCOPE_SKELETON:
-                return std::any(DasSkeleton());
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_OFFSETS:
+                _ReadArrayValues(_toc->scope_offsets.data(), static_cast<uint32_t>(_toc->scope_offsets.size()));
+                break;
 
-            case LIBDAS_DAS_SCOPE_SKELETON_JOINT:
-                return std::any(DasSkeletonJoint());
+            default:
+                LIBDAS_ASSERT(false);
+                break;
+        }
+    }
 
-            case LIBDAS_DAS_SCOPE_ANIMATION:
-                return std::any(DasAnimation());
 
-            case LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL:
-                return std::any(DasAnimationChannel());
+    void DasReaderCore::_ReadScopeOverrideValue(DasScopeOverride *_override, DasUniqueValueType _type) {
+        switch(_type) {
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_TYPE:
+                {
+                    uint32_t type = 0;
+                    _ReadSingleValue(type);
+
+                    // only scopes that are listed in the table of contents can be overridden
+                    if(type >= static_cast<uint32_t>(LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS))
+                        m_error.Error(LIBDAS_ERROR_INVALID_VALUE, "SCOPETYPE");
+                    _override->type = static_cast<DasScopeType>(type);
+                }
+                break;
+
+            case LIBDAS_DAS_UNIQUE_VALUE_TYPE_SCOPE_INDEX:
+                _ReadSingleValue(_override->index);
+                break;
 
             default:
                 LIBDAS_ASSERT(false);
                 break;
         }
-
-        return std::any();
     }
 
 
@@ -812,10 +1023,31 @@ namespace Libdas {
         DasSignature exp_sig;
         DasSignature sig;
 
-        char *sig_ptr = _ExtractBlob(sizeof(DasSignature), reinterpret_cast<char*>(&sig));
+        char *sig_ptr = nullptr;
+        if(m_mapped_file) {
+            if(static_cast<size_t>(m_map_end - m_map_ptr) >= sizeof(DasSignature)) {
+                std::memcpy(&sig, m_map_ptr, sizeof(DasSignature));
+                sig_ptr = m_map_ptr;
+                m_map_ptr += sizeof(DasSignature);
+            }
+        } else {
+            sig_ptr = _ExtractBlob(sizeof(DasSignature), reinterpret_cast<char*>(&sig));
+        }
+
         if(!sig_ptr)
             m_error.Error(LIBDAS_ERROR_INVALID_SIGNATURE);
 
+        // DAS v2 header is stored in place of padding bytes
+        m_header.magic = sig.magic;
+        std::memcpy(&m_header.version, sig.padding, sizeof(uint32_t));
+        std::memcpy(&m_header.toc_offset, sig.padding + sizeof(uint32_t), sizeof(uint64_t));
+        if(m_header.magic == LIBDAS_DAS_MAGIC && m_header.version == LIBDAS_DAS_VERSION_2)
+            return;
+
+        m_header = DasHeader();
+        m_header.version = LIBDAS_DAS_VERSION_1;
+        m_toc = DasTableOfContents();
+
         bool is_pad = false;
         
         // verify signature integrity
@@ -842,101 +1074,178 @@ namespace Libdas {
     }
 
 
+    bool DasReaderCore::ReadTableOfContents() {
+        // random access is only possible with memory mapped files
+        if(!m_mapped_file || m_header.version < LIBDAS_DAS_VERSION_2 || !m_header.toc_offset || 
+           m_header.toc_offset >= m_mapped_file->GetSize()) 
+        {
+            return false;
+        }
+
+        char *rd_ptr = m_map_ptr;
+        m_map_ptr = m_mapped_file->GetData() + m_header.toc_offset;
+
+        bool is_read = false;
+        if(ParseScopeDeclaration() == LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS) {
+            m_toc = DasTableOfContents();
+            ReadScope(m_toc);
+            // rejected table of contents has no scope counts
+            is_read = !m_toc.scope_counts.empty();
+
+            // all offsets must point inside the file
+            for(uint64_t offset : m_toc.scope_offsets) {
+                if(offset >= m_mapped_file->GetSize()) {
+                    m_toc = DasTableOfContents();
+                    is_read = false;
+                    break;
+                }
+            }
+        }
+
+        m_map_ptr = rd_ptr;
+        return is_read;
+    }
+
+
+    bool DasReaderCore::SeekScope(DasScopeType _type, uint32_t _index) {
+        const uint64_t offset = m_toc.GetScopeOffset(_type, _index);
+        if(!m_mapped_file || offset >= m_mapped_file->GetSize())
+            return false;
+
+        m_map_ptr = m_mapped_file->GetData() + offset;
+
+        // table of contents does not correspond to the file contents
+        if(ParseScopeDeclaration() != _type)
+            m_error.Error(LIBDAS_ERROR_INVALID_VALUE, "TOC");
+        return true;
+    }
+
+
+    template<typename T>
+    inline std::any _ReadAnyScope(DasReaderCore *_reader) {
+        T scope;
+        _reader->ReadScope(scope);
+        return std::any(std::move(scope));
+    }
+
+
     std::any DasReaderCore::ReadScopeData(DasScopeType _type) {
-        std::any scope(_GetAnyScopeStructure(_type));
-        std::string val_decl, val_statement;
+        switch(_type) {
+            case LIBDAS_DAS_SCOPE_PROPERTIES:
+                return _ReadAnyScope<DasProperties>(this);
 
-        do {
-            _SkipSkippableCharacters(true);
-            char *beg = _GetReadPtr();
-            char *end = _ExtractWord();
-            _SetReadPtr(end);
+            case LIBDAS_DAS_SCOPE_BUFFER:
+                return _ReadAnyScope<DasBuffer>(this);
 
-            val_decl = std::string(beg, end - beg);
+            case LIBDAS_DAS_SCOPE_MORPH_TARGET:
+                return _ReadAnyScope<DasMorphTarget>(this);
 
-            // no more data in buffer chunk
-            if(val_decl == "") {
-                bool is_read = _ReadNewChunk();
-                _SetReadPtr(m_buffer);
-                if(!is_read)
-                    m_error.Error(LIBDAS_ERROR_INCOMPLETE_SCOPE);
+            case LIBDAS_DAS_SCOPE_MESH_PRIMITIVE:
+                return _ReadAnyScope<DasMeshPrimitive>(this);
 
-                _SkipSkippableCharacters(true);
-                beg = _GetReadPtr();
-                end = _ExtractWord();
-                _SetReadPtr(end);
-                val_decl = std::string(beg, end - beg);
-            }
+            case LIBDAS_DAS_SCOPE_MESH:
+                return _ReadAnyScope<DasMesh>(this);
 
-            val_statement = val_decl.substr(0, val_decl.size() - 1);
+            case LIBDAS_DAS_SCOPE_SCENE:
+                return _ReadAnyScope<DasScene>(this);
 
-            // check if value declaration is present
-            // in ReadProperties method there can be only single non-value statement "ENDSCOPE"
-            if(val_decl[val_decl.size() - 1] != ':') {
-                DasScopeType sub_scope = ParseScopeDeclaration(val_decl);
-                if(sub_scope == LIBDAS_DAS_SCOPE_UNDEFINED && val_decl != "ENDSCOPE") 
-                    m_error.Error(LIBDAS_ERROR_INVALID_DATA_LENGTH);
-                else if(val_decl == "ENDSCOPE") 
-                    break;
-                else 
-                    m_error.Error(LIBDAS_ERROR_INVALID_DATA_LENGTH);
-            }
-                
-            // skip the whitespace following the declaration
-            _SkipData(1);
+            case LIBDAS_DAS_SCOPE_NODE:
+                return _ReadAnyScope<DasNode>(this);
 
-            DasUniqueValueType val = _FindUniqueValueType(val_statement);
-            
-            // data is in correct format type thus read its value
-            _ReadScopeValueDataCaller(scope, _type, val);
+            case LIBDAS_DAS_SCOPE_SKELETON:
+                return _ReadAnyScope<DasSkeleton>(this);
 
-        } while(_GetReadPtr() < m_buffer + m_buffer_size);
+            case LIBDAS_DAS_SCOPE_SKELETON_JOINT:
+                return _ReadAnyScope<DasSkeletonJoint>(this);
 
-        return scope;
-    }
+            case LIBDAS_DAS_SCOPE_ANIMATION:
+                return _ReadAnyScope<DasAnimation>(this);
 
+            case LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL:
+                return _ReadAnyScope<DasAnimationChannel>(this);
 
-    DasScopeType DasReaderCore::ParseScopeDeclaration(const std::string &_scope_str) {
-        if(_scope_str == "") {
-            _SkipSkippableCharacters(true);
-            char *beg = _GetReadPtr();
-            char *end = _ExtractWord();
-            _SetReadPtr(end);
+            case LIBDAS_DAS_SCOPE_BVH:
+                return _ReadAnyScope<DasBvh>(this);
 
-            std::string decl = std::string(beg, end - beg);
-            if(decl == "") {
-                bool is_read = _ReadNewChunk();
-                _SetReadPtr(m_buffer);
-                if(!is_read) return LIBDAS_DAS_SCOPE_END;
-
-                _SkipSkippableCharacters(true);
-                beg = _GetReadPtr();
-                end = _ExtractWord();
-                _SetReadPtr(end);
-                decl = std::string(beg, end - beg);
-            }
+            case LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS:
+                return _ReadAnyScope<DasTableOfContents>(this);
 
-            if(m_scope_name_map.find(decl) == m_scope_name_map.end())
-                return LIBDAS_DAS_SCOPE_UNDEFINED;
+            case LIBDAS_DAS_SCOPE_OVERRIDE:
+                return _ReadAnyScope<DasScopeOverride>(this);
 
-            return m_scope_name_map[decl];
+            default:
+                LIBDAS_ASSERT(false);
+                break;
         }
 
-        else {
-            if(_scope_str == "")
+        return std::any();
+    }
+
+
+    DasScopeType DasReaderCore::ParseScopeDeclaration(std::string_view _scope_str) {
+        if(_scope_str.empty()) {
+            _scope_str = _ReadDeclaration();
+            if(_scope_str.empty())
                 return LIBDAS_DAS_SCOPE_END;
+        }
+
+        return s_scope_matcher.Find(_scope_str);
+    }
 
-            else if(m_scope_name_map.find(_scope_str) == m_scope_name_map.end())
-                return LIBDAS_DAS_SCOPE_UNDEFINED;
 
-            return m_scope_name_map[_scope_str];
+    void DasReaderCore::_OpenFile(const std::string &_file_name) {
+        if(!m_use_mapping) {
+            NewFile(_file_name);
+            return;
         }
+
+        m_mapped_file = std::make_shared<MappedFile>(_file_name);
+        if(m_lazy_buffers)
+            m_lazy_source = std::make_shared<RandomAccessFile>(_file_name);
+        m_map_ptr = m_mapped_file->GetData();
+        m_map_end = m_map_ptr + m_mapped_file->GetSize();
+    }
+
+
+    void DasReaderCore::NewImage(std::vector<char> &&_image) {
+        if(m_mapped_file)
+            Clear();
+
+        // images have no backing file, thus payloads can't be loaded lazily
+        m_use_mapping = true;
+        m_lazy_buffers = false;
+        m_mapped_file = std::make_shared<MappedFile>(std::move(_image), "<memory image>");
+        m_map_ptr = m_mapped_file->GetData();
+        m_map_end = m_map_ptr + m_mapped_file->GetSize();
+    }
+
+
+    uint64_t DasReaderCore::_GetReadOffset() {
+        return m_mapped_file ? static_cast<uint64_t>(m_map_ptr - m_mapped_file->GetData()) : 0;
+    }
+
+
+    void DasReaderCore::_ShareFile(const DasReaderCore &_reader) {
+        m_use_mapping = true;
+        m_lazy_buffers = _reader.m_lazy_buffers;
+        m_lazy_source = _reader.m_lazy_source;
+        m_mapped_file = _reader.m_mapped_file;
+        m_map_ptr = _reader.m_map_ptr;
+        m_map_end = _reader.m_map_end;
+        m_header = _reader.m_header;
+        m_toc = _reader.m_toc;
+        m_arena = _reader.m_arena;
     }
 
 
     void DasReaderCore::Clear() {
-        CloseFile();
-        m_scope_name_map.clear();
-        m_unique_val_map.clear();
+        if(m_mapped_file) {
+            m_mapped_file.reset();
+            m_lazy_source.reset();
+            m_map_ptr = nullptr;
+            m_map_end = nullptr;
+        } else {
+            CloseFile();
+        }
     }
 }
@@ -0,0 +1,136 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasSceneGraph.cpp - structure of arrays scene graph view class implementation
+// author: Karl-Mihkel Ott
+
+#define DAS_SCENE_GRAPH_CPP
+#include "das/DasSceneGraph.h"
+
+namespace Libdas {
+
+    DasSceneGraph::DasSceneGraph(const DasModel &_model, uint32_t _scene_id) {
+        Build(_model, _scene_id);
+    }
+
+
+    std::vector<uint32_t> DasSceneGraph::_FindRoots(const DasModel &_model, const DasScene &_scene) {
+        // scenes parsed with DasParser already know their roots
+        if(_scene.roots && _scene.root_count)
+            return std::vector<uint32_t>(_scene.roots, _scene.roots + _scene.root_count);
+
+        std::vector<bool> is_child(_model.nodes.size(), false);
+        for(uint32_t i = 0; i < _scene.node_count; i++) {
+            const DasNode &node = _model.nodes[_scene.nodes[i]];
+            for(uint32_t j = 0; j < node.children_count; j++)
+                is_child[node.children[j]] = true;
+        }
+
+        std::vector<uint32_t> roots;
+        for(uint32_t i = 0; i < _scene.node_count; i++) {
+            if(!is_child[_scene.nodes[i]])
+                roots.push_back(_scene.nodes[i]);
+        }
+
+        return roots;
+    }
+
+
+    void DasSceneGraph::_AppendNode(const DasModel &_model, uint32_t _node_id, uint32_t _parent, std::unordered_map<std::string, uint32_t> &_names) {
+        const DasNode &node = _model.nodes[_node_id];
+        const uint32_t graph_id = static_cast<uint32_t>(m_node_ids.size());
+
+        m_graph_ids[_node_id] = graph_id;
+        m_node_ids.push_back(_node_id);
+        m_parents.push_back(_parent);
+        m_first_children.push_back(UINT32_MAX);
+        m_next_siblings.push_back(UINT32_MAX);
+        m_meshes.push_back(node.mesh);
+        m_skeletons.push_back(node.skeleton);
+        m_local_transforms.push_back(node.transform);
+
+        auto name_it = _names.find(node.name);
+        if(name_it == _names.end()) {
+            name_it = _names.insert(std::make_pair(node.name, static_cast<uint32_t>(m_names.size()))).first;
+            m_names.push_back(node.name);
+        }
+        m_name_ids.push_back(name_it->second);
+    }
+
+
+    void DasSceneGraph::Build(const DasModel &_model, uint32_t _scene_id) {
+        LIBDAS_ASSERT(_scene_id < _model.scenes.size());
+        const DasScene &scene = _model.scenes[_scene_id];
+
+        m_node_ids.clear();
+        m_parents.clear();
+        m_first_children.clear();
+        m_next_siblings.clear();
+        m_level_offsets.clear();
+        m_meshes.clear();
+        m_skeletons.clear();
+        m_local_transforms.clear();
+        m_world_transforms.clear();
+        m_name_ids.clear();
+        m_names.clear();
+        m_graph_ids.assign(_model.nodes.size(), UINT32_MAX);
+
+        m_node_ids.reserve(scene.node_count);
+        m_parents.reserve(scene.node_count);
+        m_first_children.reserve(scene.node_count);
+        m_next_siblings.reserve(scene.node_count);
+        m_meshes.reserve(scene.node_count);
+        m_skeletons.reserve(scene.node_count);
+        m_local_transforms.reserve(scene.node_count);
+        m_name_ids.reserve(scene.node_count);
+
+        std::unordered_map<std::string, uint32_t> names;
+
+        // level 0 consists of all root nodes
+        m_level_offsets.push_back(0);
+        for(uint32_t root : _FindRoots(_model, scene)) {
+            if(m_graph_ids[root] == UINT32_MAX)
+                _AppendNode(_model, root, UINT32_MAX, names);
+        }
+
+        // breadth first traversal, where the graph itself is used as a queue
+        uint32_t level_beg = 0;
+        while(level_beg < static_cast<uint32_t>(m_node_ids.size())) {
+            const uint32_t level_end = static_cast<uint32_t>(m_node_ids.size());
+            m_level_offsets.push_back(level_end);
+
+            for(uint32_t i = level_beg; i < level_end; i++) {
+                const DasNode &node = _model.nodes[m_node_ids[i]];
+                uint32_t prev_sibling = UINT32_MAX;
+                for(uint32_t j = 0; j < node.children_count; j++) {
+                    // nodes that are referenced more than once keep their first parent
+                    if(m_graph_ids[node.children[j]] != UINT32_MAX)
+                        continue;
+
+                    const uint32_t child = static_cast<uint32_t>(m_node_ids.size());
+                    _AppendNode(_model, node.children[j], i, names);
+                    if(prev_sibling == UINT32_MAX)
+                        m_first_children[i] = child;
+                    else m_next_siblings[prev_sibling] = child;
+                    prev_sibling = child;
+                }
+            }
+
+            level_beg = level_end;
+        }
+
+        m_world_transforms.resize(m_local_transforms.size());
+        UpdateWorldTransforms();
+    }
+
+
+    void DasSceneGraph::UpdateWorldTransforms() {
+        const size_t count = m_local_transforms.size();
+        const uint32_t root_count = m_level_offsets.size() > 1 ? m_level_offsets[1] : static_cast<uint32_t>(count);
+
+        // parents always precede their children, thus a single forward pass is enough
+        for(uint32_t i = 0; i < root_count; i++)
+            m_world_transforms[i] = m_local_transforms[i];
+        for(size_t i = root_count; i < count; i++)
+            m_world_transforms[i] = m_world_transforms[m_parents[i]] * m_local_transforms[i];
+    }
+}
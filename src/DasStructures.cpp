@@ -17,7 +17,7 @@ namespace Libdas {
         default_scene(_props.default_scene) {}
 
 
-    DasProperties::DasProperties(DasProperties &&_props) : 
+    DasProperties::DasProperties(DasProperties &&_props) noexcept : 
         model(std::move(_props.model)), 
         author(std::move(_props.author)), 
         copyright(std::move(_props.copyright)), 
@@ -48,21 +48,39 @@ namespace Libdas {
         data_ptrs(_buf.data_ptrs), 
         data_len(_buf.data_len), 
         type(_buf.type),
-        _free_bit(_buf._free_bit) {}
+        data_padding(_buf.data_padding),
+        data_offsets(_buf.data_offsets),
+        source(_buf.source),
+        blob_hash(_buf.blob_hash),
+        blob(_buf.blob),
+        _free_bit(_buf._free_bit),
+        _loaded_payloads(_buf._loaded_payloads) {}
 
 
-    DasBuffer::DasBuffer(DasBuffer &&_buf) : 
+    DasBuffer::DasBuffer(DasBuffer &&_buf) noexcept : 
         data_ptrs(std::move(_buf.data_ptrs)), 
         data_len(_buf.data_len), 
         type(_buf.type),
-        _free_bit(_buf._free_bit) {}
+        data_padding(_buf.data_padding),
+        data_offsets(std::move(_buf.data_offsets)),
+        source(std::move(_buf.source)),
+        blob_hash(_buf.blob_hash),
+        blob(std::move(_buf.blob)),
+        _free_bit(_buf._free_bit),
+        _loaded_payloads(std::move(_buf._loaded_payloads)) {}
 
 
     void DasBuffer::operator=(const DasBuffer &_buf) {
         data_ptrs = _buf.data_ptrs;
         data_len = _buf.data_len;
         type = _buf.type;
+        data_padding = _buf.data_padding;
+        data_offsets = _buf.data_offsets;
+        source = _buf.source;
+        blob_hash = _buf.blob_hash;
+        blob = _buf.blob;
         _free_bit = _buf._free_bit;
+        _loaded_payloads = _buf._loaded_payloads;
     }
 
 
@@ -70,14 +88,53 @@ namespace Libdas {
         data_ptrs = std::move(_buf.data_ptrs);
         data_len = _buf.data_len;
         type = _buf.type;
+        data_padding = _buf.data_padding;
+        data_offsets = std::move(_buf.data_offsets);
+        source = std::move(_buf.source);
+        blob_hash = _buf.blob_hash;
+        blob = std::move(_buf.blob);
         _free_bit = _buf._free_bit;
+        _loaded_payloads = std::move(_buf._loaded_payloads);
+    }
+
+
+    char *DasBuffer::GetData(size_t _index) {
+        if(_index >= data_ptrs.size())
+            return nullptr;
+
+        std::pair<char*, size_t> &data = data_ptrs[_index];
+        if(!data.first && source && _index < data_offsets.size()) {
+            // loaded payloads are owned by the buffer the same way as regularly read blobs
+            char *payload = reinterpret_cast<char*>(std::malloc(data.second ? data.second : 1));
+            if(payload && !source->Read(data_offsets[_index], payload, data.second)) {
+                std::free(payload);
+                payload = nullptr;
+            }
+            if(payload)
+                _loaded_payloads.push_back(payload);
+            data.first = payload;
+        }
+
+        return data.first;
+    }
+
+
+    bool DasBuffer::Load() {
+        bool is_loaded = true;
+        for(size_t i = 0; i < data_ptrs.size(); i++) {
+            if(!GetData(i))
+                is_loaded = false;
+        }
+
+        return is_loaded;
     }
 
 
     // **** DasMesh **** //
     DasMesh::DasMesh(const DasMesh &_mesh) : 
         name(_mesh.name), 
-        primitive_count(_mesh.primitive_count) 
+        primitive_count(_mesh.primitive_count),
+        bounds(_mesh.bounds)
     {
         primitives = new uint32_t[primitive_count];
         for(uint32_t i = 0; i < primitive_count; i++)
@@ -85,16 +142,20 @@ namespace Libdas {
     }
 
 
-    DasMesh::DasMesh(DasMesh &&_mesh) : 
+    DasMesh::DasMesh(DasMesh &&_mesh) noexcept : 
         name(std::move(_mesh.name)), 
         primitive_count(_mesh.primitive_count), 
-        primitives(_mesh.primitives) 
+        primitives(_mesh.primitives),
+        bounds(_mesh.bounds),
+        _free_bit(_mesh._free_bit)
     {
         _mesh.primitives = nullptr;
     }
 
 
     DasMesh::~DasMesh() {
+        if(!_free_bit) return;
+
         delete [] primitives;
     }
 
@@ -125,7 +186,16 @@ namespace Libdas {
         texture_count(_prim.texture_count),
         color_mul_count(_prim.color_mul_count),
         joint_set_count(_prim.joint_set_count),
-        morph_target_count(_prim.morph_target_count)
+        morph_target_count(_prim.morph_target_count),
+        quantization(_prim.quantization),
+        position_offset(_prim.position_offset),
+        position_scale(_prim.position_scale),
+        uv_offset(_prim.uv_offset),
+        uv_scale(_prim.uv_scale),
+        meshlet_buffer_id(_prim.meshlet_buffer_id),
+        meshlet_buffer_offset(_prim.meshlet_buffer_offset),
+        meshlet_count(_prim.meshlet_count),
+        bounds(_prim.bounds)
     {
         // copy texture data
         if(texture_count) {
@@ -187,7 +257,7 @@ namespace Libdas {
     }
 
 
-    DasMeshPrimitive::DasMeshPrimitive(DasMeshPrimitive &&_prim) : 
+    DasMeshPrimitive::DasMeshPrimitive(DasMeshPrimitive &&_prim) noexcept : 
         index_buffer_id(_prim.index_buffer_id), 
         index_buffer_offset(_prim.index_buffer_offset),
         draw_count(_prim.draw_count), 
@@ -211,7 +281,17 @@ namespace Libdas {
         joint_weight_buffer_offsets(_prim.joint_weight_buffer_offsets),
         morph_target_count(_prim.morph_target_count),
         morph_targets(_prim.morph_targets), 
-        morph_weights(_prim.morph_weights)
+        morph_weights(_prim.morph_weights),
+        quantization(_prim.quantization),
+        position_offset(_prim.position_offset),
+        position_scale(_prim.position_scale),
+        uv_offset(_prim.uv_offset),
+        uv_scale(_prim.uv_scale),
+        meshlet_buffer_id(_prim.meshlet_buffer_id),
+        meshlet_buffer_offset(_prim.meshlet_buffer_offset),
+        meshlet_count(_prim.meshlet_count),
+        bounds(_prim.bounds),
+        _free_bit(_prim._free_bit)
     {
         _prim.uv_buffer_ids = nullptr;
         _prim.uv_buffer_offsets = nullptr;
@@ -231,6 +311,8 @@ namespace Libdas {
 
 
     DasMeshPrimitive::~DasMeshPrimitive() {
+        if(!_free_bit) return;
+
         delete [] uv_buffer_ids;
         delete [] uv_buffer_offsets;
         delete [] texture_ids;
@@ -295,7 +377,7 @@ namespace Libdas {
     }
 
 
-    DasMorphTarget::DasMorphTarget(DasMorphTarget &&_morph) :
+    DasMorphTarget::DasMorphTarget(DasMorphTarget &&_morph) noexcept :
         vertex_buffer_id(_morph.vertex_buffer_id),
         vertex_buffer_offset(_morph.vertex_buffer_offset),
         vertex_normal_buffer_id(_morph.vertex_normal_buffer_id),
@@ -307,7 +389,8 @@ namespace Libdas {
         uv_buffer_offsets(_morph.uv_buffer_offsets),
         color_mul_count(_morph.color_mul_count),
         color_mul_buffer_ids(_morph.color_mul_buffer_ids),
-        color_mul_buffer_offsets(_morph.color_mul_buffer_offsets)
+        color_mul_buffer_offsets(_morph.color_mul_buffer_offsets),
+        _free_bit(_morph._free_bit)
     {
         _morph.uv_buffer_ids = nullptr;
         _morph.uv_buffer_offsets = nullptr;
@@ -318,6 +401,8 @@ namespace Libdas {
 
 
     DasMorphTarget::~DasMorphTarget() {
+        if(!_free_bit) return;
+
         delete [] uv_buffer_ids;
         delete [] uv_buffer_offsets;
 
@@ -354,19 +439,22 @@ namespace Libdas {
     }
 
 
-    DasNode::DasNode(DasNode &&_node) : 
+    DasNode::DasNode(DasNode &&_node) noexcept : 
         name(std::move(_node.name)), 
         children_count(_node.children_count), 
         children(_node.children), 
         mesh(_node.mesh), 
         skeleton(_node.skeleton), 
-        transform(_node.transform) 
+        transform(_node.transform),
+        _free_bit(_node._free_bit)
     {
         _node.children = nullptr;
     }
 
 
     DasNode::~DasNode() {
+        if(!_free_bit) return;
+
         delete [] children;
     }
 
@@ -387,6 +475,7 @@ namespace Libdas {
     DasScene::DasScene(const DasScene &_scene) : 
         name(_scene.name), 
         node_count(_scene.node_count), 
+        bounds(_scene.bounds),
         root_count(_scene.root_count) 
     {
         if(node_count) {
@@ -403,12 +492,14 @@ namespace Libdas {
     }
 
 
-    DasScene::DasScene(DasScene &&_scene) :
+    DasScene::DasScene(DasScene &&_scene) noexcept :
         name(std::move(_scene.name)),
         node_count(_scene.node_count),
         nodes(_scene.nodes),
+        bounds(_scene.bounds),
         root_count(_scene.root_count),
-        roots(_scene.roots)
+        roots(_scene.roots),
+        _free_bit(_scene._free_bit)
     {
         _scene.nodes = nullptr;
         _scene.roots = nullptr;
@@ -416,6 +507,8 @@ namespace Libdas {
 
 
     DasScene::~DasScene() {
+        if(!_free_bit) return;
+
         delete [] nodes;
         delete [] roots;
     }
@@ -433,6 +526,59 @@ namespace Libdas {
     }
 
 
+    // **** DasBvh **** //
+    DasBvh::DasBvh(const DasBvh &_bvh) :
+        scene(_bvh.scene),
+        node_count(_bvh.node_count),
+        item_count(_bvh.item_count)
+    {
+        if(node_count) {
+            nodes = new DasBvhNode[node_count];
+            for(uint32_t i = 0; i < node_count; i++)
+                nodes[i] = _bvh.nodes[i];
+        }
+
+        if(item_count) {
+            items = new uint32_t[item_count];
+            for(uint32_t i = 0; i < item_count; i++)
+                items[i] = _bvh.items[i];
+        }
+    }
+
+
+    DasBvh::DasBvh(DasBvh &&_bvh) noexcept :
+        scene(_bvh.scene),
+        node_count(_bvh.node_count),
+        nodes(_bvh.nodes),
+        item_count(_bvh.item_count),
+        items(_bvh.items),
+        _free_bit(_bvh._free_bit)
+    {
+        _bvh.nodes = nullptr;
+        _bvh.items = nullptr;
+    }
+
+
+    DasBvh::~DasBvh() {
+        if(!_free_bit) return;
+
+        delete [] nodes;
+        delete [] items;
+    }
+
+
+    void DasBvh::operator=(const DasBvh &_bvh) {
+        this->~DasBvh();
+        new (this) DasBvh(_bvh);
+    }
+
+
+    void DasBvh::operator=(DasBvh &&_bvh) {
+        this->~DasBvh();
+        new (this) DasBvh(_bvh);
+    }
+
+
     // **** DasSkeleton **** //
     DasSkeleton::DasSkeleton(const DasSkeleton &_skel) : 
         name(_skel.name), 
@@ -447,17 +593,20 @@ namespace Libdas {
     }
 
 
-    DasSkeleton::DasSkeleton(DasSkeleton &&_skel) : 
+    DasSkeleton::DasSkeleton(DasSkeleton &&_skel) noexcept : 
         name(std::move(_skel.name)), 
         parent(_skel.parent),
         joint_count(_skel.joint_count), 
-        joints(_skel.joints) 
+        joints(_skel.joints),
+        _free_bit(_skel._free_bit)
     {
         _skel.joints = nullptr;
     }
 
 
     DasSkeleton::~DasSkeleton() {
+        if(!_free_bit) return;
+
         delete [] joints;
     }
 
@@ -491,20 +640,23 @@ namespace Libdas {
     }
 
 
-    DasSkeletonJoint::DasSkeletonJoint(DasSkeletonJoint &&_joint) : 
+    DasSkeletonJoint::DasSkeletonJoint(DasSkeletonJoint &&_joint) noexcept : 
         inverse_bind_pos(_joint.inverse_bind_pos), 
         name(std::move(_joint.name)), 
         children_count(_joint.children_count),
         children(_joint.children), 
         scale(_joint.scale), 
         rotation(_joint.rotation), 
-        translation(_joint.translation) 
+        translation(_joint.translation),
+        _free_bit(_joint._free_bit)
     {
         _joint.children = nullptr;
     }
 
 
     DasSkeletonJoint::~DasSkeletonJoint() {
+        if(!_free_bit) return;
+
         delete [] children;
     }
 
@@ -535,16 +687,19 @@ namespace Libdas {
     }
 
 
-    DasAnimation::DasAnimation(DasAnimation &&_ani) : 
+    DasAnimation::DasAnimation(DasAnimation &&_ani) noexcept : 
         name(std::move(_ani.name)), 
         channel_count(_ani.channel_count), 
-        channels(_ani.channels)
+        channels(_ani.channels),
+        _free_bit(_ani._free_bit)
     {
         _ani.channels = nullptr;
     }
 
 
     DasAnimation::~DasAnimation() {
+        if(!_free_bit) return;
+
         delete [] channels;
     }
 
@@ -609,7 +764,7 @@ namespace Libdas {
     }
 
 
-    DasAnimationChannel::DasAnimationChannel(DasAnimationChannel &&_ch) :
+    DasAnimationChannel::DasAnimationChannel(DasAnimationChannel &&_ch) noexcept :
         node_id(_ch.node_id),
         joint_id(_ch.joint_id),
         target(_ch.target),
@@ -618,7 +773,8 @@ namespace Libdas {
         weight_count(_ch.weight_count),
         keyframes(_ch.keyframes),
         tangents(_ch.tangents),
-        target_values(_ch.target_values)
+        target_values(_ch.target_values),
+        _free_bit(_ch._free_bit)
     {
         _ch.keyframes = nullptr;
         _ch.tangents = nullptr;
@@ -627,6 +783,8 @@ namespace Libdas {
 
 
     DasAnimationChannel::~DasAnimationChannel() {
+        if(!_free_bit) return;
+
         delete [] keyframes;
         delete [] tangents;
         delete [] target_values;
@@ -655,5 +813,6 @@ namespace Libdas {
         }
 
         buffers.clear();
+        mapped_file.reset();
     }
 }
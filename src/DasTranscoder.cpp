@@ -0,0 +1,197 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasTranscoder.cpp - streaming DAS to DAS transcoder class implementation
+// author: Karl-Mihkel Ott
+
+#define DAS_TRANSCODER_CPP
+#include "das/DasTranscoder.h"
+
+namespace Libdas {
+
+    DasTranscoder::DasTranscoder(const std::string &_in_file, const std::string &_out_file) :
+        DasReaderCore(_in_file, true, true),
+        m_writer(_out_file) {}
+
+
+    DasTranscoder::DasTranscoder(const std::string &_in_file, const std::shared_ptr<OutputSink> &_sink) :
+        DasReaderCore(_in_file, true, true),
+        m_writer(_sink) {}
+
+
+    void DasTranscoder::_InitialiseOutput(const DasProperties &_props) {
+        if(m_is_initialised)
+            return;
+
+        m_writer.InitialiseFile(_props);
+        m_is_initialised = true;
+    }
+
+
+    uint32_t DasTranscoder::_FindInputAlignment(const DasBuffer &_buffer) {
+        if(!_buffer.data_padding || _buffer.data_offsets.empty())
+            return 0;
+
+        // the original alignment is not recorded, but it divides the padded payload offset, thus the largest power 
+        // of two dividing the offset is never weaker than the original alignment
+        uint32_t alignment = LIBDAS_DAS_WRITER_MAX_BUFFER_ALIGNMENT;
+        while(alignment > 1 && _buffer.data_offsets[0] % alignment)
+            alignment >>= 1;
+
+        return alignment > _buffer.data_padding ? alignment : 0;
+    }
+
+
+    void DasTranscoder::_TranscodeBuffer(uint32_t _index, bool _discard) {
+        DasBuffer buffer;
+        ReadScope(buffer);
+        if(_discard)
+            return;
+
+        // alignment is found before the callback has a chance to replace input payloads
+        uint32_t alignment = m_buffer_alignment;
+        if(alignment == LIBDAS_DAS_TRANSCODER_INPUT_ALIGNMENT)
+            alignment = _FindInputAlignment(buffer);
+
+        if(m_callbacks.on_buffer) {
+            if(buffer.blob_hash && m_blob_store && !m_blob_store->Resolve(buffer))
+                std::cerr << "Could not resolve blob " << std::hex << buffer.blob_hash << std::dec << " of buffer " << _index << std::endl;
+
+            const std::vector<std::pair<char*, size_t>> data_ptrs = buffer.data_ptrs;
+            const uint32_t data_len = buffer.data_len;
+            m_callbacks.on_buffer(buffer, _index);
+
+            // modified payloads no longer match the referenced blob, thus these are embedded instead
+            if(buffer.blob_hash && (buffer.data_len != data_len || buffer.data_ptrs != data_ptrs)) {
+                if(data_ptrs.empty()) {
+                    std::cerr << "Buffer " << _index << " references an unresolved blob and cannot be modified" << std::endl;
+                    EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_DATA_LENGTH);
+                }
+                buffer.blob_hash = 0;
+            }
+        }
+
+        _InitialiseOutput(DasProperties());
+        m_writer.WriteBuffer(buffer, alignment);
+
+        // payloads loaded with DasBuffer::GetData() are owned by the buffer, even if the callback replaced them
+        for(char *payload : buffer._loaded_payloads)
+            std::free(payload);
+    }
+
+
+    void DasTranscoder::_Transcode(DasScopeType _type, uint32_t _index, bool _discard) {
+        switch(_type) {
+            case LIBDAS_DAS_SCOPE_PROPERTIES:
+                {
+                    DasProperties props;
+                    ReadScope(props);
+                    if(m_callbacks.on_properties)
+                        m_callbacks.on_properties(props);
+                    _InitialiseOutput(props);
+                }
+                break;
+
+            case LIBDAS_DAS_SCOPE_BUFFER:
+                _TranscodeBuffer(_index, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_MESH_PRIMITIVE:
+                _TranscodeScope(m_callbacks.on_mesh_primitive, &DasWriterCore::WriteMeshPrimitive, _index, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_MORPH_TARGET:
+                _TranscodeScope(m_callbacks.on_morph_target, &DasWriterCore::WriteMorphTarget, _index, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_MESH:
+                _TranscodeScope(m_callbacks.on_mesh, &DasWriterCore::WriteMesh, _index, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_NODE:
+                _TranscodeScope(m_callbacks.on_node, &DasWriterCore::WriteNode, _index, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_SCENE:
+                _TranscodeScope(m_callbacks.on_scene, &DasWriterCore::WriteScene, _index, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_SKELETON_JOINT:
+                _TranscodeScope(m_callbacks.on_skeleton_joint, &DasWriterCore::WriteSkeletonJoint, _index, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_SKELETON:
+                _TranscodeScope(m_callbacks.on_skeleton, &DasWriterCore::WriteSkeleton, _index, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_ANIMATION:
+                _TranscodeScope(m_callbacks.on_animation, &DasWriterCore::WriteAnimation, _index, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL:
+                _TranscodeScope(m_callbacks.on_animation_channel, &DasWriterCore::WriteAnimationChannel, _index, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_BVH:
+                _TranscodeScope(m_callbacks.on_bvh, &DasWriterCore::WriteBvh, _index, _discard);
+                break;
+
+            case LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS:
+                {
+                    // output table of contents is generated by the writer
+                    DasTableOfContents toc;
+                    ReadScope(toc);
+                }
+                break;
+
+            case LIBDAS_DAS_SCOPE_OVERRIDE:
+                {
+                    // patched files always have a table of contents, which already points to replacement scopes
+                    DasScopeOverride scope_override;
+                    ReadScope(scope_override);
+                }
+                break;
+
+            default:
+                LIBDAS_ASSERT(false);
+                break;
+        }
+    }
+
+
+    void DasTranscoder::Transcode(const DasTranscodeCallbacks &_callbacks, DasScopeMask _mask) {
+        m_callbacks = _callbacks;
+        _mask |= LIBDAS_DAS_SCOPE_MASK(LIBDAS_DAS_SCOPE_PROPERTIES);
+        ReadSignature();
+
+        // table of contents allows to skip unwanted scopes without decoding them
+        if(ReadTableOfContents()) {
+            const DasTableOfContents &toc = GetTableOfContents();
+            for(uint32_t i = 0; i < static_cast<uint32_t>(LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS); i++) {
+                const DasScopeType type = static_cast<DasScopeType>(i);
+                if(!(_mask & LIBDAS_DAS_SCOPE_MASK(type)))
+                    continue;
+
+                for(uint32_t j = 0; j < toc.GetScopeCount(type); j++) {
+                    SeekScope(type, j);
+                    _Transcode(type, j, false);
+                }
+            }
+        } else {
+            std::vector<uint32_t> indices(LIBDAS_DAS_SCOPE_END, 0);
+            DasScopeType type = LIBDAS_DAS_SCOPE_END;
+            do {
+                type = ParseScopeDeclaration();
+                if(type == LIBDAS_DAS_SCOPE_END)
+                    break;
+
+                _Transcode(type, indices[type]++, !(_mask & LIBDAS_DAS_SCOPE_MASK(type)));
+            } while(true);
+        }
+
+        // files without any scopes still produce a valid output
+        _InitialiseOutput(DasProperties());
+        m_writer.CloseStream();
+        m_callbacks = DasTranscodeCallbacks();
+        Clear();
+    }
+}
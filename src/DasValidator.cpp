@@ -25,6 +25,8 @@ namespace Libdas {
     void DasValidator::_CheckJointProperties(const DasMeshPrimitive &_prim, uint32_t _cur_index, uint32_t _max_index) {
         // check joint set properties
         if(_prim.joint_set_count) {
+            const uint32_t weight_size = _FindAttributeSize(_prim, LIBDAS_QUANTIZATION_JOINT_WEIGHTS, LIBDAS_QUANTIZED_JOINT_WEIGHTS_SIZE, 
+                                                            static_cast<uint32_t>(sizeof(TRS::Vector4<float>)));
             for(uint32_t i = 0; i < _prim.joint_set_count; i++) {
                 // indices
                 if(_prim.joint_index_buffer_ids[i] >= (uint32_t) m_model.buffers.size()) {
@@ -42,10 +44,10 @@ namespace Libdas {
                 if(_prim.joint_weight_buffer_ids[i] >= (uint32_t) m_model.buffers.size()) {
                     std::string errme = "DAS validation error: Invalid joint weight buffer id " + std::to_string(_prim.joint_weight_buffer_ids[i]) + " for mesh primitive " + std::to_string(_cur_index);
                     m_error_stack.push(errme);
-                } else if(m_model.buffers[_prim.joint_weight_buffer_ids[i]].data_len < _prim.joint_weight_buffer_offsets[i] + _max_index * static_cast<uint32_t>(sizeof(TRS::Vector4<float>))) {
+                } else if(m_model.buffers[_prim.joint_weight_buffer_ids[i]].data_len < _prim.joint_weight_buffer_offsets[i] + _max_index * weight_size) {
                     std::string errme = "DAS validation error: Invalid joint weight buffer(" + std::to_string(_prim.joint_weight_buffer_ids[i]) +
                                         ") region with offset " + std::to_string(_prim.joint_weight_buffer_offsets[i]) + " and size " +
-                                        std::to_string(_max_index * static_cast<uint32_t>(sizeof(TRS::Vector4<float>))) +
+                                        std::to_string(_max_index * weight_size) +
                                         " for mesh primitive " + std::to_string(i); 
                     m_error_stack.push(errme);
                 }
@@ -93,6 +95,27 @@ namespace Libdas {
     }
 
 
+    void DasValidator::_CheckMeshlets(const DasMeshPrimitive &_prim, uint32_t _cur_index) {
+        if(!_prim.meshlet_count)
+            return;
+
+        if(_prim.meshlet_buffer_id >= (uint32_t) m_model.buffers.size()) {
+            const std::string errme = "DAS validation error: Invalid meshlet buffer id " + std::to_string(_prim.meshlet_buffer_id) + " for mesh primitive " + std::to_string(_cur_index);
+            m_error_stack.push(errme);
+        } else if(m_model.buffers[_prim.meshlet_buffer_id].data_len < _prim.meshlet_buffer_offset + _prim.meshlet_count * static_cast<uint32_t>(sizeof(DasMeshlet))) {
+            const std::string errme = "DAS validation error: Invalid meshlet buffer(" + std::to_string(_prim.meshlet_buffer_id) + 
+                                      ") region with offset " + std::to_string(_prim.meshlet_buffer_offset) + " and size " +
+                                      std::to_string(_prim.meshlet_count * static_cast<uint32_t>(sizeof(DasMeshlet))) +
+                                      " for mesh primitive " + std::to_string(_cur_index);
+            m_error_stack.push(errme);
+        } else if(!(m_model.buffers[_prim.meshlet_buffer_id].type & LIBDAS_BUFFER_TYPE_MESHLET)) {
+            const std::string warnme = "DAS validation warning: Meshlet buffer " + std::to_string(_prim.meshlet_buffer_id) + 
+                                       " of mesh primitive " + std::to_string(_cur_index) + " is not flagged as a meshlet buffer";
+            m_warning_stack.push(warnme);
+        }
+    }
+
+
     void DasValidator::_VerifyProperties() {
         const DasProperties &props = m_model.props;
         if(props.default_scene >= (uint32_t)m_model.scenes.size()) {
@@ -134,6 +157,11 @@ namespace Libdas {
                                           std::to_string(it->draw_count * static_cast<uint32_t>(sizeof(uint32_t))) +
                                           " for mesh primitive " + std::to_string(index);
                 m_error_stack.push(errme);
+            } else if(m_model.buffers[it->index_buffer_id].data_ptrs.empty()) {
+                // blob references are left unresolved when the model is parsed without a blob store
+                const std::string errme = "DAS validation error: Index buffer(" + std::to_string(it->index_buffer_id) + 
+                                          ") data is not available for mesh primitive " + std::to_string(index);
+                m_error_stack.push(errme);
             } else {
                 // get the max index
                 const DasBuffer &index_buffer = m_model.buffers[it->index_buffer_id];
@@ -154,6 +182,9 @@ namespace Libdas {
 
                 // check indices continuity (2.4)
                 _CheckMeshPrimitiveIndicesContinuity(*it, index);
+
+                // check meshlet descriptors
+                _CheckMeshlets(*it, index);
             }
         }
 
@@ -318,6 +349,44 @@ namespace Libdas {
     }
 
 
+    void DasValidator::_VerifyBvhs() {
+        for (auto it = m_model.bvhs.begin(); it != m_model.bvhs.end(); it++) {
+            const std::string bvh_index = std::to_string(it - m_model.bvhs.begin());
+
+            // check if scene and item node ids are correct (6.1)
+            if(it->scene >= (uint32_t)m_model.scenes.size()) {
+                const std::string errme = "DAS validation error: Invalid scene id " + std::to_string(it->scene) + " for BVH " + bvh_index;
+                m_error_stack.push(errme);
+                m_critical_bit = true;
+            }
+
+            for(uint32_t j = 0; j < it->item_count; j++) {
+                if(it->items[j] >= (uint32_t)m_model.nodes.size()) {
+                    const std::string errme = "DAS validation error: Invalid item node id " + std::to_string(it->items[j]) + " for BVH " + bvh_index;
+                    m_error_stack.push(errme);
+                    m_critical_bit = true;
+                }
+            }
+
+            // check if child node indices and leaf item ranges are correct (6.2)
+            for(uint32_t j = 0; j < it->node_count; j++) {
+                const DasBvhNode &node = it->nodes[j];
+                if(node.IsLeaf() && (node.offset >= it->item_count || it->item_count - node.offset < node.item_count)) {
+                    const std::string errme = "DAS validation error: Invalid item range with offset " + std::to_string(node.offset) + " and count " +
+                                              std::to_string(node.item_count) + " for BVH " + bvh_index + " node " + std::to_string(j);
+                    m_error_stack.push(errme);
+                    m_critical_bit = true;
+                } else if(!node.IsLeaf() && (node.offset <= j + 1 || node.offset >= it->node_count)) {
+                    const std::string errme = "DAS validation error: Invalid child node index " + std::to_string(node.offset) +
+                                              " for BVH " + bvh_index + " node " + std::to_string(j);
+                    m_error_stack.push(errme);
+                    m_critical_bit = true;
+                }
+            }
+        }
+    }
+
+
     void DasValidator::Validate() {
         _VerifyProperties();
         if(m_critical_bit)
@@ -330,5 +399,8 @@ namespace Libdas {
         if(m_critical_bit) 
             return;
         _VerifySkeletons();
+        if(m_critical_bit) 
+            return;
+        _VerifyBvhs();
     }
 }
@@ -9,6 +9,7 @@
 namespace Libdas {
 
     DasWriterCore::DasWriterCore(const std::string &_file_name) :
+        m_thread_count(std::max(std::thread::hardware_concurrency(), 1u)),
         m_file_name(_file_name) 
     {
         // open a file stream if possible
@@ -19,10 +20,15 @@ namespace Libdas {
     }
 
 
+    DasWriterCore::DasWriterCore(const std::shared_ptr<OutputSink> &_sink) :
+        m_thread_count(std::max(std::thread::hardware_concurrency(), 1u))
+    {
+        NewSink(_sink);
+    }
+
+
     DasWriterCore::~DasWriterCore() {
-        // close the stream if it is open
-        if(m_out_stream.is_open())
-            m_out_stream.close();
+        CloseStream();
     }
 
 
@@ -43,56 +49,327 @@ namespace Libdas {
 
     void DasWriterCore::_OpenFileStream() {
         // file stream is currently open, close it
-        if(m_out_stream.is_open())
-            m_out_stream.close();
+        CloseStream();
 
-        m_out_stream.open(m_file_name, std::ios_base::binary);
-        
-        // file opening failed, exit the program
-        if(m_out_stream.fail()) {
-            std::cerr << "Could not open file " + m_file_name << " for writing. Check permissions!" << std::endl;
+        // file opening failure exits the program
+        m_out_file = std::make_shared<FileWriter>(m_file_name);
+        m_flushed_size = 0;
+        m_staging.reserve(LIBDAS_DAS_WRITER_STAGING_SIZE);
+    }
+
+
+    void DasWriterCore::_Flush() {
+        if(m_staging.empty() || m_is_detached)
+            return;
+
+        if(!m_out_file->Write(m_staging.data(), m_staging.size())) {
+            std::cerr << "Could not write to file " << m_file_name << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+        }
+
+        m_flushed_size += static_cast<uint64_t>(m_staging.size());
+        m_staging.clear();
+    }
+
+
+    void DasWriterCore::_WriteLarge(const char *_data, size_t _len) {
+        // detached writers keep everything in memory
+        if(m_is_detached) {
+            m_staging.insert(m_staging.end(), _data, _data + _len);
+            return;
+        }
+
+        if(_len < LIBDAS_DAS_WRITER_DIRECT_WRITE_THRESHOLD) {
+            _Flush();
+            m_staging.insert(m_staging.end(), _data, _data + _len);
+            return;
+        }
+
+        // staged data and the large block are written with a single system call
+        const std::pair<const char*, size_t> fragments[] = {
+            std::make_pair(m_staging.data(), m_staging.size()),
+            std::make_pair(_data, _len)
+        };
+
+        if(!m_out_file->WriteVectored(fragments, 2)) {
+            std::cerr << "Could not write to file " << m_file_name << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+        }
+
+        m_flushed_size += static_cast<uint64_t>(m_staging.size() + _len);
+        m_staging.clear();
+    }
+
+
+    void DasWriterCore::_WriteFragments(const std::vector<std::pair<const char*, size_t>> &_fragments) {
+        size_t total = 0;
+        for(const std::pair<const char*, size_t> &fragment : _fragments)
+            total += fragment.second;
+
+        if(total < LIBDAS_DAS_WRITER_DIRECT_WRITE_THRESHOLD || m_is_detached) {
+            for(const std::pair<const char*, size_t> &fragment : _fragments)
+                _Write(fragment.first, fragment.second);
+            return;
+        }
+
+        // staged data is written out together with all fragments
+        std::vector<std::pair<const char*, size_t>> fragments;
+        fragments.reserve(_fragments.size() + 1);
+        fragments.push_back(std::make_pair(m_staging.data(), m_staging.size()));
+        fragments.insert(fragments.end(), _fragments.begin(), _fragments.end());
+
+        if(!m_out_file->WriteVectored(fragments.data(), fragments.size())) {
+            std::cerr << "Could not write to file " << m_file_name << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+        }
+
+        m_flushed_size += static_cast<uint64_t>(m_staging.size() + total);
+        m_staging.clear();
+    }
+
+
+    void DasWriterCore::_WriteFileData(const RandomAccessFile &_src, uint64_t _offset, size_t _len) {
+        if(_len < LIBDAS_DAS_WRITER_DIRECT_WRITE_THRESHOLD || m_is_detached) {
+            if(m_staging.size() + _len > m_staging.capacity())
+                _Flush();
+
+            const size_t beg = m_staging.size();
+            m_staging.resize(beg + _len);
+            if(!_src.Read(_offset, m_staging.data() + beg, _len)) {
+                std::cerr << "Could not read buffer data from file " << _src.GetFileName() << std::endl;
+                EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+            }
+            return;
+        }
+
+        _Flush();
+        if(!m_out_file->CopyFrom(_src, _offset, _len)) {
+            std::cerr << "Could not copy buffer data from file " << _src.GetFileName() << " to " << m_file_name << std::endl;
             EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
         }
+        m_flushed_size += static_cast<uint64_t>(_len);
     }
 
 
     void DasWriterCore::_WriteStringValue(const std::string &_value_name, const std::string &_value) {
-        LIBDAS_ASSERT(m_out_stream.is_open());
+        LIBDAS_ASSERT(m_out_file || m_is_detached);
 
-        m_out_stream.write(_value_name.c_str(), _value_name.size());
-        m_out_stream.write(": \"", 3);
-        m_out_stream.write(_value.c_str(), _value.size());
-        m_out_stream.write("\"", 1);
-        m_out_stream.write(LIBDAS_DAS_NEWLINE, strlen(LIBDAS_DAS_NEWLINE));
+        _Write(_value_name.c_str(), _value_name.size());
+        _Write(": \"", 3);
+        _Write(_value.c_str(), _value.size());
+        _Write("\"", 1);
+        _Write(LIBDAS_DAS_NEWLINE, sizeof(LIBDAS_DAS_NEWLINE) - 1);
     }
 
 
     void DasWriterCore::_WriteGenericDataValue(const char *_data, const size_t _len, bool _append_nl, const std::string &_value_name) {
-        LIBDAS_ASSERT(m_out_stream.is_open());
+        LIBDAS_ASSERT(m_out_file || m_is_detached);
 
         if(_value_name != "") {
-            m_out_stream.write(_value_name.c_str(), _value_name.size());
-            m_out_stream.write(": ", 2);
+            _Write(_value_name.c_str(), _value_name.size());
+            _Write(": ", 2);
         }
 
-        m_out_stream.write(_data, _len);
+        _Write(_data, _len);
 
-        if(_append_nl) m_out_stream.write(LIBDAS_DAS_NEWLINE, strlen(LIBDAS_DAS_NEWLINE));
+        if(_append_nl) _Write(LIBDAS_DAS_NEWLINE, sizeof(LIBDAS_DAS_NEWLINE) - 1);
     }
 
 
-    void DasWriterCore::_WriteScopeBeginning(const std::string &_scope_name) {
-        LIBDAS_ASSERT(m_out_stream.is_open());
-        m_out_stream.write(_scope_name.c_str(), _scope_name.size());
-        m_out_stream.write(LIBDAS_DAS_NEWLINE, strlen(LIBDAS_DAS_NEWLINE));
+    void DasWriterCore::_WriteScopeBeginning(const std::string &_scope_name, DasScopeType _type) {
+        LIBDAS_ASSERT(m_out_file || m_is_detached);
+        if(m_override.type == _type) {
+            // sequential readers learn about the replacement from the override scope preceding it
+            static const char override_decl[] = "OVERRIDE" LIBDAS_DAS_NEWLINE;
+            _Write(override_decl, sizeof(override_decl) - 1);
+            _WriteNumericalValue<uint32_t>("SCOPETYPE", static_cast<uint32_t>(m_override.type));
+            _WriteNumericalValue<uint32_t>("SCOPEINDEX", m_override.index);
+            _EndScope();
+
+            m_scope_offsets[_type][m_override.index] = _GetOffset();
+            m_override = DasScopeOverride();
+        } else if(m_is_toc_pending) {
+            m_scope_offsets[_type].push_back(_GetOffset());
+        }
+
+        _Write(_scope_name.c_str(), _scope_name.size());
+        _Write(LIBDAS_DAS_NEWLINE, sizeof(LIBDAS_DAS_NEWLINE) - 1);
     }
 
 
     void DasWriterCore::_EndScope() {
-        LIBDAS_ASSERT(m_out_stream.is_open());
-        const std::string end_decl = "ENDSCOPE";
-        m_out_stream.write(end_decl.c_str(), end_decl.size());
-        m_out_stream.write(LIBDAS_DAS_NEWLINE, strlen(LIBDAS_DAS_NEWLINE));
+        LIBDAS_ASSERT(m_out_file || m_is_detached);
+        static const char end_decl[] = "ENDSCOPE" LIBDAS_DAS_NEWLINE;
+        _Write(end_decl, sizeof(end_decl) - 1);
+    }
+
+
+    void DasWriterCore::_WriteTableOfContents() {
+        if(!m_is_toc_pending)
+            return;
+
+        m_is_toc_pending = false;
+        const uint64_t toc_offset = _GetOffset();
+
+        // scope counts are followed by all scope offsets in the order of scope types
+        std::vector<uint32_t> scope_counts;
+        std::vector<uint64_t> scope_offsets;
+        scope_counts.reserve(m_scope_offsets.size());
+        for(const std::vector<uint64_t> &offsets : m_scope_offsets) {
+            scope_counts.push_back(static_cast<uint32_t>(offsets.size()));
+            scope_offsets.insert(scope_offsets.end(), offsets.begin(), offsets.end());
+        }
+
+        _WriteScopeBeginning("TOC", LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS);
+        _WriteNumericalValue<uint32_t>("SCOPETYPECOUNT", static_cast<uint32_t>(scope_counts.size()));
+        _WriteArrayValue<uint32_t>("SCOPECOUNTS", static_cast<uint32_t>(scope_counts.size()), scope_counts.data());
+        _WriteArrayValue<uint64_t>("SCOPEOFFSETS", static_cast<uint32_t>(scope_offsets.size()), scope_offsets.data());
+        _EndScope();
+
+        // patch the table of contents offset into the header
+        _Flush();
+        if(!m_out_file->WriteAt(offsetof(DasHeader, toc_offset), reinterpret_cast<const char*>(&toc_offset), sizeof(uint64_t))) {
+            std::cerr << "Could not write to file " << m_file_name << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+        }
+        m_scope_offsets.clear();
+    }
+
+
+    uint64_t DasWriterCore::_GetBufferScopeSize(const DasBuffer &_buffer, uint32_t _alignment) {
+        const uint64_t nl = sizeof(LIBDAS_DAS_NEWLINE) - 1;
+        uint64_t size = (sizeof("BUFFER") - 1) + nl +
+                        (sizeof("BUFFERTYPE: ") - 1) + sizeof(BufferType) + nl +
+                        (sizeof("DATALEN: ") - 1) + sizeof(uint32_t) + nl +
+                        (sizeof("ENDSCOPE") - 1) + nl;
+
+        // blob references contain no payload, payloads that are yet to be stored are accounted for as embedded
+        if(_buffer.blob_hash)
+            return size + (sizeof("BLOBHASH: ") - 1) + sizeof(uint64_t) + nl;
+        size += (sizeof("DATA: ") - 1) + nl;
+
+        if(_alignment > 1)
+            size += (sizeof("DATAPADDING: ") - 1) + sizeof(uint32_t) + nl + _alignment - 1;
+
+        for(const std::pair<char*, size_t> &ptr : _buffer.data_ptrs)
+            size += static_cast<uint64_t>(ptr.second);
+        return size;
+    }
+
+
+    uint64_t DasWriterCore::_StoreBlob(const DasBuffer &_buffer) {
+        if(_buffer.blob_hash)
+            return _buffer.blob_hash;
+        if(!m_blob_store || _buffer.data_len < m_blob_min_size)
+            return 0;
+
+        // single in-memory payloads are hashed in place, other payloads are gathered first
+        if(_buffer.data_ptrs.size() == 1 && _buffer.data_ptrs[0].first && _buffer.data_ptrs[0].second == _buffer.data_len)
+            return m_blob_store->Store(_buffer.data_ptrs[0].first, _buffer.data_len);
+
+        std::vector<char> data;
+        data.reserve(_buffer.data_len);
+        for(size_t i = 0; i < _buffer.data_ptrs.size(); i++) {
+            const std::pair<char*, size_t> &ptr = _buffer.data_ptrs[i];
+            if(!ptr.first && _buffer.source && i < _buffer.data_offsets.size()) {
+                data.resize(data.size() + ptr.second);
+                if(!_buffer.source->Read(_buffer.data_offsets[i], data.data() + data.size() - ptr.second, ptr.second))
+                    return 0;
+                continue;
+            } else if(!ptr.first) {
+                return 0;
+            }
+
+            data.insert(data.end(), ptr.first, ptr.first + ptr.second);
+        }
+
+        if(data.size() != _buffer.data_len)
+            return 0;
+        return m_blob_store->Store(data.data(), data.size());
+    }
+
+
+    void DasWriterCore::_WriteBlobReference(BufferType _type, uint32_t _data_len, uint64_t _blob_hash) {
+        _WriteScopeBeginning("BUFFER", LIBDAS_DAS_SCOPE_BUFFER);
+        _WriteNumericalValue<BufferType>("BUFFERTYPE", _type);
+        _WriteNumericalValue<uint32_t>("DATALEN", _data_len);
+        _WriteNumericalValue<uint64_t>("BLOBHASH", _blob_hash);
+        _EndScope();
+    }
+
+
+    void DasWriterCore::_WritePadding(size_t _len) {
+        static const char zeros[LIBDAS_DAS_WRITER_MAX_BUFFER_ALIGNMENT] = {};
+        while(_len) {
+            const size_t len = std::min(_len, sizeof(zeros));
+            _Write(zeros, len);
+            _len -= len;
+        }
+    }
+
+
+    void DasWriterCore::_AppendDetached(const DasWriterCore &_writer) {
+        // scope offsets of the detached writer are relative to its own beginning
+        if(m_is_toc_pending) {
+            const uint64_t base = _GetOffset();
+            for(size_t i = 0; i < _writer.m_scope_offsets.size() && i < m_scope_offsets.size(); i++) {
+                for(uint64_t offset : _writer.m_scope_offsets[i])
+                    m_scope_offsets[i].push_back(base + offset);
+            }
+        }
+
+        _Write(_writer.m_staging.data(), _writer.m_staging.size());
+    }
+
+
+    template<typename T>
+    void DasWriterCore::_WriteScopes(const std::vector<T> &_scopes, void (DasWriterCore::*_WriteScope)(const T&)) {
+        if(m_thread_count < 2 || _scopes.size() < LIBDAS_DAS_WRITER_PARALLEL_THRESHOLD) {
+            for(const T &scope : _scopes)
+                (this->*_WriteScope)(scope);
+            return;
+        }
+
+        // split scopes into several ranges per thread for better load balancing
+        const size_t range_size = std::max(_scopes.size() / (static_cast<size_t>(m_thread_count) * 4), static_cast<size_t>(1));
+        const size_t range_count = (_scopes.size() + range_size - 1) / range_size;
+        // detached writers stage only their own range, which is usually far smaller than the output staging buffer
+        const size_t staging_size = std::min(range_size * sizeof(T) * 2, static_cast<size_t>(LIBDAS_DAS_WRITER_STAGING_SIZE));
+        std::vector<DasWriterCore> writers(range_count);
+        for(DasWriterCore &writer : writers) {
+            writer.m_staging.reserve(staging_size);
+            writer.m_is_detached = true;
+            writer.m_is_toc_pending = true;
+            writer.m_scope_offsets.resize(LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS);
+        }
+
+        std::atomic<size_t> next_range(0);
+        auto worker = [&]() {
+            for(size_t i = next_range++; i < range_count; i = next_range++) {
+                const size_t end = std::min((i + 1) * range_size, _scopes.size());
+                for(size_t j = i * range_size; j < end; j++)
+                    (writers[i].*_WriteScope)(_scopes[j]);
+            }
+        };
+
+        const size_t thread_count = std::min(static_cast<size_t>(m_thread_count), range_count);
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count);
+        for(size_t i = 1; i < thread_count; i++)
+            threads.emplace_back(worker);
+
+        worker();
+        for(std::thread &thread : threads)
+            thread.join();
+
+        // serialized ranges are appended in their original order, their total size is known beforehand
+        uint64_t total = 0;
+        for(const DasWriterCore &writer : writers)
+            total += static_cast<uint64_t>(writer.m_staging.size());
+        _Preallocate(total);
+
+        for(const DasWriterCore &writer : writers)
+            _AppendDetached(writer);
     }
 
 
@@ -104,17 +381,70 @@ namespace Libdas {
     }
 
 
+    void DasWriterCore::NewSink(const std::shared_ptr<OutputSink> &_sink) {
+        LIBDAS_ASSERT(_sink);
+        CloseStream();
+
+        m_out_file = _sink;
+        m_flushed_size = 0;
+        m_staging.reserve(LIBDAS_DAS_WRITER_STAGING_SIZE);
+    }
+
+
+    void DasWriterCore::_AppendTo(const std::shared_ptr<OutputSink> &_sink, uint64_t _size, const DasTableOfContents &_toc) {
+        NewSink(_sink);
+        m_flushed_size = _size;
+
+        m_scope_offsets.clear();
+        m_scope_offsets.resize(LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS);
+        for(uint32_t i = 0; i < static_cast<uint32_t>(LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS); i++) {
+            const DasScopeType type = static_cast<DasScopeType>(i);
+            m_scope_offsets[i].reserve(_toc.GetScopeCount(type));
+            for(uint32_t j = 0; j < _toc.GetScopeCount(type); j++)
+                m_scope_offsets[i].push_back(_toc.GetScopeOffset(type, j));
+        }
+        m_is_toc_pending = true;
+    }
+
+
+    void DasWriterCore::_OverrideNextScope(DasScopeType _type, uint32_t _index) {
+        LIBDAS_ASSERT(m_is_toc_pending && !m_is_detached);
+        LIBDAS_ASSERT(static_cast<size_t>(_type) < m_scope_offsets.size() && _index < m_scope_offsets[_type].size());
+        m_override.type = _type;
+        m_override.index = _index;
+    }
+
+
     void DasWriterCore::CloseStream() {
-        if(m_out_stream.is_open())
-            m_out_stream.close();
+        if(m_out_file) {
+            _WriteTableOfContents();
+            _Flush();
+
+            // file outputs replace their target files only now, thus partially written files are never visible
+            if(!m_out_file->Commit()) {
+                std::cerr << "Could not commit output file " << m_file_name << std::endl;
+                EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+            }
+            m_out_file.reset();
+        }
+    }
+
+
+    void DasWriterCore::SetBlobStore(const std::shared_ptr<DasBlobStore> &_store, uint32_t _min_size) {
+        m_blob_store = _store;
+        m_blob_min_size = _min_size;
     }
 
 
     void DasWriterCore::InitialiseFile(const DasProperties &_properties) {
-        DasSignature sig;
-        m_out_stream.write(reinterpret_cast<char*>(&sig), sizeof(DasSignature));
+        // table of contents offset is written once the file is closed
+        DasHeader header;
+        _Write(reinterpret_cast<const char*>(&header), sizeof(DasHeader));
+        m_scope_offsets.clear();
+        m_scope_offsets.resize(LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS);
+        m_is_toc_pending = true;
 
-        _WriteScopeBeginning("PROPERTIES");
+        _WriteScopeBeginning("PROPERTIES", LIBDAS_DAS_SCOPE_PROPERTIES);
 
         // write model name if present
         if(_properties.model != "")
@@ -140,15 +470,50 @@ namespace Libdas {
     }
 
 
-    void DasWriterCore::WriteBuffer(const DasBuffer &_buffer) {
-        _WriteScopeBeginning("BUFFER");
+    void DasWriterCore::WriteBuffer(const DasBuffer &_buffer, uint32_t _alignment) {
+        LIBDAS_ASSERT(_alignment <= LIBDAS_DAS_WRITER_MAX_BUFFER_ALIGNMENT && !(_alignment & (_alignment - 1)));
+
+        // stored payloads need no alignment, since they are mapped from their own files
+        const uint64_t blob_hash = _StoreBlob(_buffer);
+        if(blob_hash) {
+            _WriteBlobReference(_buffer.type, _buffer.data_len, blob_hash);
+            return;
+        }
+
+        _WriteScopeBeginning("BUFFER", LIBDAS_DAS_SCOPE_BUFFER);
         _WriteNumericalValue<BufferType>("BUFFERTYPE", _buffer.type);
         _WriteNumericalValue<uint32_t>("DATALEN", _buffer.data_len);
 
-        m_out_stream.write("DATA: ", 6);
-        for(auto it = _buffer.data_ptrs.begin(); it != _buffer.data_ptrs.end(); it++)
-            m_out_stream.write(it->first, it->second);
-        m_out_stream.write(LIBDAS_DAS_NEWLINE, strlen(LIBDAS_DAS_NEWLINE));
+        // padding is placed between the data declaration and the payload, so that the payload starts at an 
+        // aligned absolute file offset, detached writers do not know their absolute offsets
+        uint32_t padding = 0;
+        if(_alignment > 1 && !m_is_detached) {
+            const uint64_t nl = sizeof(LIBDAS_DAS_NEWLINE) - 1;
+            const uint64_t payload_offset = _GetOffset() + (sizeof("DATAPADDING: ") - 1) + sizeof(uint32_t) + nl + (sizeof("DATA: ") - 1);
+            padding = static_cast<uint32_t>((_alignment - payload_offset % _alignment) % _alignment);
+            _WriteNumericalValue<uint32_t>("DATAPADDING", padding);
+        }
+
+        // buffer payload fragments are passed to the file as they are, without copying them
+        _Write("DATA: ", 6);
+        _WritePadding(padding);
+        std::vector<std::pair<const char*, size_t>> fragments;
+        fragments.reserve(_buffer.data_ptrs.size() + 1);
+        for(size_t i = 0; i < _buffer.data_ptrs.size(); i++) {
+            const std::pair<char*, size_t> &ptr = _buffer.data_ptrs[i];
+
+            // lazily loaded payloads that are not in memory yet are copied straight from their source file
+            if(!ptr.first && _buffer.source && i < _buffer.data_offsets.size()) {
+                _WriteFragments(fragments);
+                fragments.clear();
+                _WriteFileData(*_buffer.source, _buffer.data_offsets[i], ptr.second);
+                continue;
+            }
+
+            fragments.push_back(std::make_pair(ptr.first, ptr.second));
+        }
+        fragments.push_back(std::make_pair(LIBDAS_DAS_NEWLINE, sizeof(LIBDAS_DAS_NEWLINE) - 1));
+        _WriteFragments(fragments);
 
         _EndScope();
     }
@@ -156,21 +521,28 @@ namespace Libdas {
 
     void DasWriterCore::WriteTextureBuffer(const std::vector<std::string> &_textures) {
         for(const std::string &file_name : _textures) {
-            _WriteScopeBeginning("BUFFER");
             TextureReader rd = TextureReader(file_name);
             BufferType type = rd.GetImageBufferType();
-            _WriteNumericalValue<BufferType>("BUFFERTYPE", type);
-            
+
             size_t len = 0;
             const char *data = rd.GetBuffer(len);
+            const uint64_t blob_hash = m_blob_store && len >= m_blob_min_size ? m_blob_store->Store(data, len) : 0;
+            if(blob_hash) {
+                _WriteBlobReference(type, static_cast<uint32_t>(len), blob_hash);
+                continue;
+            }
+
+            _WriteScopeBeginning("BUFFER", LIBDAS_DAS_SCOPE_BUFFER);
+            _WriteNumericalValue<BufferType>("BUFFERTYPE", type);
             _WriteNumericalValue<uint32_t>("DATALEN", static_cast<uint32_t>(len));
             _WriteGenericDataValue(data, len, true, "DATA");
+            _EndScope();
         }
     }
 
 
     void DasWriterCore::WriteMeshPrimitive(const DasMeshPrimitive &_primitive) {
-        _WriteScopeBeginning("MESHPRIMITIVE");
+        _WriteScopeBeginning("MESHPRIMITIVE", LIBDAS_DAS_SCOPE_MESH_PRIMITIVE);
 
         // indices are optional
         if (_primitive.index_buffer_id != UINT32_MAX) {
@@ -226,12 +598,34 @@ namespace Libdas {
             _WriteArrayValue<float>("MORPHWEIGHTS", _primitive.morph_target_count, _primitive.morph_weights);
         }
 
+        if(_primitive.quantization != LIBDAS_QUANTIZATION_NONE) {
+            _WriteNumericalValue<VertexQuantization>("QUANTIZATION", _primitive.quantization);
+            if(_primitive.quantization & LIBDAS_QUANTIZATION_POSITION) {
+                _WriteGenericDataValue(reinterpret_cast<const char*>(&_primitive.position_offset), sizeof(TRS::Point3D<float>), true, "POSITIONOFFSET");
+                _WriteGenericDataValue(reinterpret_cast<const char*>(&_primitive.position_scale), sizeof(TRS::Point3D<float>), true, "POSITIONSCALE");
+            }
+
+            if(_primitive.quantization & LIBDAS_QUANTIZATION_UV) {
+                _WriteGenericDataValue(reinterpret_cast<const char*>(&_primitive.uv_offset), sizeof(TRS::Point2D<float>), true, "UVOFFSET");
+                _WriteGenericDataValue(reinterpret_cast<const char*>(&_primitive.uv_scale), sizeof(TRS::Point2D<float>), true, "UVSCALE");
+            }
+        }
+
+        if(_primitive.meshlet_count) {
+            _WriteNumericalValue<uint32_t>("MESHLETBUFFERID", _primitive.meshlet_buffer_id);
+            _WriteNumericalValue<uint32_t>("MESHLETBUFFEROFFSET", _primitive.meshlet_buffer_offset);
+            _WriteNumericalValue<uint32_t>("MESHLETCOUNT", _primitive.meshlet_count);
+        }
+
+        if(!_primitive.bounds.IsEmpty())
+            _WriteGenericDataValue(reinterpret_cast<const char*>(&_primitive.bounds), sizeof(DasBoundingVolume), true, "BOUNDS");
+
         _EndScope();
     }
 
 
     void DasWriterCore::WriteMorphTarget(const DasMorphTarget &_morph_target) {
-        _WriteScopeBeginning("MORPHTARGET");
+        _WriteScopeBeginning("MORPHTARGET", LIBDAS_DAS_SCOPE_MORPH_TARGET);
 
         if(_morph_target.vertex_buffer_id != UINT32_MAX) {
             _WriteNumericalValue<uint32_t>("VERTEXBUFFERID", _morph_target.vertex_buffer_id);
@@ -268,7 +662,7 @@ namespace Libdas {
 
 
     void DasWriterCore::WriteMesh(const DasMesh &_mesh) {
-        _WriteScopeBeginning("MESH");
+        _WriteScopeBeginning("MESH", LIBDAS_DAS_SCOPE_MESH);
         
         // check if name should be written
         if(_mesh.name != "")
@@ -276,13 +670,15 @@ namespace Libdas {
 
         _WriteNumericalValue<uint32_t>("PRIMITIVECOUNT", _mesh.primitive_count);
         _WriteArrayValue<uint32_t>("PRIMITIVES", _mesh.primitive_count, _mesh.primitives);
+        if(!_mesh.bounds.IsEmpty())
+            _WriteGenericDataValue(reinterpret_cast<const char*>(&_mesh.bounds), sizeof(DasBoundingVolume), true, "BOUNDS");
 
         _EndScope();
     }
 
 
     void DasWriterCore::WriteNode(const DasNode &_node) {
-        _WriteScopeBeginning("NODE");
+        _WriteScopeBeginning("NODE", LIBDAS_DAS_SCOPE_NODE);
 
         if(_node.name != "") _WriteStringValue("NAME", _node.name);
         if(_node.children_count) {
@@ -301,17 +697,19 @@ namespace Libdas {
 
 
     void DasWriterCore::WriteScene(const DasScene &_scene) {
-        _WriteScopeBeginning("SCENE");
+        _WriteScopeBeginning("SCENE", LIBDAS_DAS_SCOPE_SCENE);
         if(_scene.name != "") _WriteStringValue("NAME", _scene.name);
         _WriteNumericalValue<uint32_t>("NODECOUNT", _scene.node_count);
         _WriteArrayValue<uint32_t>("NODES", _scene.node_count, _scene.nodes);
+        if(!_scene.bounds.IsEmpty())
+            _WriteGenericDataValue(reinterpret_cast<const char*>(&_scene.bounds), sizeof(DasBoundingVolume), true, "BOUNDS");
 
         _EndScope();
     }
 
 
     void DasWriterCore::WriteSkeleton(const DasSkeleton &_skeleton) {
-        _WriteScopeBeginning("SKELETON");
+        _WriteScopeBeginning("SKELETON", LIBDAS_DAS_SCOPE_SKELETON);
         if(_skeleton.name != "") _WriteStringValue("NAME", _skeleton.name);
         _WriteNumericalValue<uint32_t>("PARENT", _skeleton.parent);
         _WriteNumericalValue<uint32_t>("JOINTCOUNT", _skeleton.joint_count);
@@ -322,7 +720,7 @@ namespace Libdas {
 
 
     void DasWriterCore::WriteSkeletonJoint(const DasSkeletonJoint &_joint) {
-        _WriteScopeBeginning("JOINT");
+        _WriteScopeBeginning("JOINT", LIBDAS_DAS_SCOPE_SKELETON_JOINT);
         _WriteMatrixValue<float>("INVERSEBINDPOS", _joint.inverse_bind_pos);
 
         if(_joint.name != "") _WriteStringValue("NAME", _joint.name);
@@ -337,7 +735,7 @@ namespace Libdas {
 
 
     void DasWriterCore::WriteAnimationChannel(const DasAnimationChannel &_channel) {
-        _WriteScopeBeginning("ANIMATIONCHANNEL");
+        _WriteScopeBeginning("ANIMATIONCHANNEL", LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL);
         if(_channel.node_id != UINT32_MAX)
             _WriteNumericalValue<uint32_t>("NODEID", _channel.node_id);
         else if(_channel.joint_id != UINT32_MAX)
@@ -381,7 +779,7 @@ namespace Libdas {
 
 
     void DasWriterCore::WriteAnimation(const DasAnimation &_animation) {
-        _WriteScopeBeginning("ANIMATION");
+        _WriteScopeBeginning("ANIMATION", LIBDAS_DAS_SCOPE_ANIMATION);
         if(_animation.name != "") _WriteStringValue("NAME", _animation.name);
         _WriteNumericalValue<uint32_t>("CHANNELCOUNT", _animation.channel_count);
         _WriteArrayValue<uint32_t>("CHANNELS", _animation.channel_count, _animation.channels);
@@ -390,6 +788,86 @@ namespace Libdas {
     }
 
 
+    void DasWriterCore::WriteBvh(const DasBvh &_bvh) {
+        _WriteScopeBeginning("BVH", LIBDAS_DAS_SCOPE_BVH);
+        _WriteNumericalValue<uint32_t>("SCENE", _bvh.scene);
+        _WriteNumericalValue<uint32_t>("BVHNODECOUNT", _bvh.node_count);
+        _WriteArrayValue<DasBvhNode>("BVHNODES", _bvh.node_count, _bvh.nodes);
+        _WriteNumericalValue<uint32_t>("ITEMCOUNT", _bvh.item_count);
+        _WriteArrayValue<uint32_t>("ITEMS", _bvh.item_count, _bvh.items);
+
+        _EndScope();
+    }
+
+
+    void DasWriterCore::WriteBuffers(const std::vector<DasBuffer> &_buffers, uint32_t _alignment) {
+        // all buffer scope sizes are known ahead, thus the whole buffer section is allocated at once
+        uint64_t total = 0;
+        for(const DasBuffer &buffer : _buffers)
+            total += _GetBufferScopeSize(buffer, _alignment);
+        _Preallocate(total);
+
+        // buffer scopes are dominated by their payloads, which are passed to the file without serialization
+        for(const DasBuffer &buffer : _buffers)
+            WriteBuffer(buffer, _alignment);
+    }
+
+
+    void DasWriterCore::WriteMeshPrimitives(const std::vector<DasMeshPrimitive> &_primitives) {
+        _WriteScopes(_primitives, &DasWriterCore::WriteMeshPrimitive);
+    }
+
+
+    void DasWriterCore::WriteMorphTargets(const std::vector<DasMorphTarget> &_morph_targets) {
+        _WriteScopes(_morph_targets, &DasWriterCore::WriteMorphTarget);
+    }
+
+
+    void DasWriterCore::WriteMeshes(const std::vector<DasMesh> &_meshes) {
+        _WriteScopes(_meshes, &DasWriterCore::WriteMesh);
+    }
+
+
+    void DasWriterCore::WriteNodes(const std::vector<DasNode> &_nodes) {
+        _WriteScopes(_nodes, &DasWriterCore::WriteNode);
+    }
+
+
+    void DasWriterCore::WriteScenes(const std::vector<DasScene> &_scenes) {
+        _WriteScopes(_scenes, &DasWriterCore::WriteScene);
+    }
+
+
+    void DasWriterCore::WriteSkeletons(const std::vector<DasSkeleton> &_skeletons) {
+        _WriteScopes(_skeletons, &DasWriterCore::WriteSkeleton);
+    }
+
+
+    void DasWriterCore::WriteSkeletonJoints(const std::vector<DasSkeletonJoint> &_joints) {
+        _WriteScopes(_joints, &DasWriterCore::WriteSkeletonJoint);
+    }
+
+
+    void DasWriterCore::WriteAnimationChannels(const std::vector<DasAnimationChannel> &_channels) {
+        _WriteScopes(_channels, &DasWriterCore::WriteAnimationChannel);
+    }
+
+
+    void DasWriterCore::WriteAnimations(const std::vector<DasAnimation> &_animations) {
+        _WriteScopes(_animations, &DasWriterCore::WriteAnimation);
+    }
+
+
+    void DasWriterCore::WriteBvhs(const std::vector<DasBvh> &_bvhs) {
+        _WriteScopes(_bvhs, &DasWriterCore::WriteBvh);
+    }
+
+
+    void DasWriterCore::SetThreadCount(uint32_t _thread_count) {
+        m_thread_count = _thread_count ? _thread_count : std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+
     void DasWriterCore::AppendTextures(std::vector<DasBuffer> &_buffers, const std::vector<std::string> &_embedded_textures, bool _use_raw) {
         m_texture_readers.reserve(_embedded_textures.size());
         for(const std::string &file_name : _embedded_textures) {
@@ -0,0 +1,329 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: FileWriter.cpp - unbuffered file writer class implementation
+// author: Karl-Mihkel Ott
+
+#define FILE_WRITER_CPP
+#include "das/FileWriter.h"
+
+#ifndef IOV_MAX
+    #define IOV_MAX 1024
+#endif
+
+namespace Libdas {
+
+    // temporary files are unique per writer, so that writers targeting the same file never share a temporary file
+    static std::string _MakeTempFileName(const std::string &_file_name) {
+        static std::atomic<uint64_t> s_counter(0);
+#ifdef _WIN32
+        const unsigned long pid = static_cast<unsigned long>(GetCurrentProcessId());
+#else
+        const unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+        return _file_name + "." + std::to_string(pid) + "." + std::to_string(s_counter++) + ".tmp";
+    }
+
+
+    FileWriter::FileWriter(const std::string &_file_name, bool _append) : 
+        m_file_name(_file_name), 
+        m_tmp_file_name(_append ? _file_name : _MakeTempFileName(_file_name)),
+        m_is_append(_append)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(m_tmp_file_name.c_str(), GENERIC_WRITE, 0, NULL, m_is_append ? OPEN_EXISTING : CREATE_ALWAYS, 
+                                  FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if(file == INVALID_HANDLE_VALUE) {
+            std::cerr << "Could not open file " << m_tmp_file_name << " for writing. Check permissions!" << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+        }
+        m_file_handle = file;
+
+        if(m_is_append) {
+            LARGE_INTEGER zero = {};
+            LARGE_INTEGER size = {};
+            SetFilePointerEx(file, zero, &size, FILE_END);
+            m_size = static_cast<uint64_t>(size.QuadPart);
+        }
+#else
+        m_fd = open(m_tmp_file_name.c_str(), m_is_append ? O_WRONLY : (O_WRONLY | O_CREAT | O_TRUNC), 0644);
+        if(m_fd == -1) {
+            std::cerr << "Could not open file " << m_tmp_file_name << " for writing. Check permissions!" << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+        }
+
+        // O_APPEND is not used, since it would make positional writes append as well
+        if(m_is_append) {
+            const off_t size = lseek(m_fd, 0, SEEK_END);
+            if(size == -1) {
+                std::cerr << "Could not seek to the end of file " << m_tmp_file_name << std::endl;
+                EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+            }
+            m_size = static_cast<uint64_t>(size);
+        }
+#endif
+        m_base_size = m_size;
+        m_allocated_size = m_size;
+    }
+
+
+    FileWriter::~FileWriter() {
+        Close();
+    }
+
+
+    bool FileWriter::Write(const char *_data, size_t _len) {
+        while(_len) {
+#ifdef _WIN32
+            DWORD len = _len > 0x40000000 ? 0x40000000 : static_cast<DWORD>(_len);
+            DWORD wr = 0;
+            if(!WriteFile(reinterpret_cast<HANDLE>(m_file_handle), _data, len, &wr, NULL) || !wr)
+                return false;
+#else
+            ssize_t wr = write(m_fd, _data, _len);
+            if(wr == -1 && errno == EINTR)
+                continue;
+            else if(wr <= 0)
+                return false;
+#endif
+            _data += wr;
+            _len -= static_cast<size_t>(wr);
+            m_size += static_cast<uint64_t>(wr);
+        }
+
+        return true;
+    }
+
+
+    bool FileWriter::WriteVectored(const std::pair<const char*, size_t> *_fragments, size_t _count) {
+#ifdef _WIN32
+        for(size_t i = 0; i < _count; i++) {
+            if(!Write(_fragments[i].first, _fragments[i].second))
+                return false;
+        }
+
+        return true;
+#else
+        std::vector<iovec> iov;
+        iov.reserve(std::min(_count, static_cast<size_t>(IOV_MAX)));
+
+        size_t i = 0;
+        while(i < _count) {
+            // fill the io vector with as many fragments as the kernel accepts at once
+            iov.clear();
+            size_t total = 0;
+            for(; i < _count && iov.size() < static_cast<size_t>(IOV_MAX); i++) {
+                if(!_fragments[i].second) continue;
+                iov.push_back(iovec{ const_cast<char*>(_fragments[i].first), _fragments[i].second });
+                total += _fragments[i].second;
+            }
+
+            // partial writes advance through the io vector until everything is written
+            iovec *cur = iov.data();
+            size_t cur_count = iov.size();
+            while(total) {
+                ssize_t wr = writev(m_fd, cur, static_cast<int>(cur_count));
+                if(wr == -1 && errno == EINTR)
+                    continue;
+                else if(wr <= 0)
+                    return false;
+
+                total -= static_cast<size_t>(wr);
+                m_size += static_cast<uint64_t>(wr);
+                size_t left = static_cast<size_t>(wr);
+                while(cur_count && left >= cur->iov_len) {
+                    left -= cur->iov_len;
+                    cur++;
+                    cur_count--;
+                }
+
+                if(cur_count) {
+                    cur->iov_base = reinterpret_cast<char*>(cur->iov_base) + left;
+                    cur->iov_len -= left;
+                }
+            }
+        }
+
+        return true;
+#endif
+    }
+
+
+    bool FileWriter::WriteAt(uint64_t _offset, const char *_data, size_t _len) {
+        // existing data must never refer to appended data, that could be lost on a crash
+        if(m_is_append && _offset < m_base_size) {
+#ifdef _WIN32
+            if(!FlushFileBuffers(reinterpret_cast<HANDLE>(m_file_handle)))
+                return false;
+#else
+            if(fsync(m_fd) == -1)
+                return false;
+#endif
+        }
+
+        while(_len) {
+#ifdef _WIN32
+            OVERLAPPED ov = {};
+            ov.Offset = static_cast<DWORD>(_offset & 0xffffffff);
+            ov.OffsetHigh = static_cast<DWORD>(_offset >> 32);
+
+            DWORD len = _len > 0x40000000 ? 0x40000000 : static_cast<DWORD>(_len);
+            DWORD wr = 0;
+            if(!WriteFile(reinterpret_cast<HANDLE>(m_file_handle), _data, len, &wr, &ov) || !wr)
+                return false;
+#else
+            ssize_t wr = pwrite(m_fd, _data, _len, static_cast<off_t>(_offset));
+            if(wr == -1 && errno == EINTR)
+                continue;
+            else if(wr <= 0)
+                return false;
+#endif
+            _data += wr;
+            _offset += static_cast<uint64_t>(wr);
+            _len -= static_cast<size_t>(wr);
+        }
+
+#ifdef _WIN32
+        // positional writes move the file pointer of synchronous handles, all other writes are appends
+        LARGE_INTEGER zero = {};
+        SetFilePointerEx(reinterpret_cast<HANDLE>(m_file_handle), zero, NULL, FILE_END);
+#endif
+        return true;
+    }
+
+
+    bool FileWriter::CopyFrom(const RandomAccessFile &_src, uint64_t _offset, size_t _len) {
+#ifdef __linux__
+        // try to copy data inside the kernel first, copy_file_range() can even share extents on some file systems
+        bool is_copy_range = true;
+        while(_len) {
+            off_t in_offset = static_cast<off_t>(_offset);
+            ssize_t wr = is_copy_range ? copy_file_range(_src.m_fd, &in_offset, m_fd, NULL, _len, 0) :
+                                         sendfile(m_fd, _src.m_fd, &in_offset, _len);
+            if(wr == -1 && errno == EINTR)
+                continue;
+            else if(wr == -1 && is_copy_range && (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP)) {
+                is_copy_range = false;
+                continue;
+            } else if(wr == -1 && (errno == ENOSYS || errno == EINVAL)) 
+                break;
+            else if(wr <= 0)
+                return false;
+
+            _offset += static_cast<uint64_t>(wr);
+            _len -= static_cast<size_t>(wr);
+            m_size += static_cast<uint64_t>(wr);
+        }
+
+        if(!_len)
+            return true;
+#endif
+        // fall back to reading the data through an intermediate buffer
+        return OutputSink::CopyFrom(_src, _offset, _len);
+    }
+
+
+    void FileWriter::Preallocate(uint64_t _size) {
+        if(_size <= m_allocated_size)
+            return;
+
+        // failing to preallocate is not an error, the file is merely more likely to be fragmented
+#ifdef _WIN32
+        FILE_ALLOCATION_INFO info = {};
+        info.AllocationSize.QuadPart = static_cast<LONGLONG>(_size);
+        if(SetFileInformationByHandle(reinterpret_cast<HANDLE>(m_file_handle), FileAllocationInfo, &info, sizeof(info)))
+            m_allocated_size = _size;
+#elif defined(__linux__)
+        // allocation does not change the file size, so the appended data and the final size stay intact
+        if(!fallocate(m_fd, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(m_allocated_size), static_cast<off_t>(_size - m_allocated_size)))
+            m_allocated_size = _size;
+#else
+        (void)_size;
+#endif
+    }
+
+
+    bool FileWriter::Commit() {
+#ifdef _WIN32
+        if(!m_file_handle)
+            return false;
+
+        // allocated space beyond the written data is released by setting the end of file
+        LARGE_INTEGER size = {};
+        size.QuadPart = static_cast<LONGLONG>(m_size);
+        if(m_allocated_size > m_size) {
+            if(!SetFilePointerEx(reinterpret_cast<HANDLE>(m_file_handle), size, NULL, FILE_BEGIN) || 
+               !SetEndOfFile(reinterpret_cast<HANDLE>(m_file_handle)))
+                return false;
+        }
+
+        if(!FlushFileBuffers(reinterpret_cast<HANDLE>(m_file_handle)))
+            return false;
+        _CloseHandle();
+
+        // appended data is already in place
+        if(m_is_append)
+            return true;
+        return MoveFileExA(m_tmp_file_name.c_str(), m_file_name.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+        if(m_fd == -1)
+            return false;
+
+        // allocated space beyond the written data is released by truncating the file to its actual size
+        if(m_allocated_size > m_size && ftruncate(m_fd, static_cast<off_t>(m_size)) == -1)
+            return false;
+
+        if(fsync(m_fd) == -1)
+            return false;
+        _CloseHandle();
+
+        // appended data is already in place
+        if(m_is_append)
+            return true;
+        if(rename(m_tmp_file_name.c_str(), m_file_name.c_str()) == -1)
+            return false;
+
+        // make the rename itself durable
+        const size_t sep = m_file_name.find_last_of('/');
+        const std::string dir = sep == std::string::npos ? "." : (sep ? m_file_name.substr(0, sep) : "/");
+        int dir_fd = open(dir.c_str(), O_RDONLY);
+        if(dir_fd != -1) {
+            fsync(dir_fd);
+            close(dir_fd);
+        }
+
+        return true;
+#endif
+    }
+
+
+    void FileWriter::_CloseHandle() {
+#ifdef _WIN32
+        if(m_file_handle) CloseHandle(reinterpret_cast<HANDLE>(m_file_handle));
+        m_file_handle = nullptr;
+#else
+        if(m_fd != -1) close(m_fd);
+        m_fd = -1;
+#endif
+    }
+
+
+    void FileWriter::Close() {
+        // the handle is still open only if the output was never committed
+#ifdef _WIN32
+        const bool is_uncommitted = m_file_handle != nullptr;
+        if(is_uncommitted && m_is_append) {
+            LARGE_INTEGER size = {};
+            size.QuadPart = static_cast<LONGLONG>(m_base_size);
+            if(SetFilePointerEx(reinterpret_cast<HANDLE>(m_file_handle), size, NULL, FILE_BEGIN))
+                SetEndOfFile(reinterpret_cast<HANDLE>(m_file_handle));
+        }
+#else
+        const bool is_uncommitted = m_fd != -1;
+        if(is_uncommitted && m_is_append && ftruncate(m_fd, static_cast<off_t>(m_base_size)) == -1)
+            std::cerr << "Could not discard appended data from file " << m_file_name << std::endl;
+#endif
+        _CloseHandle();
+        if(is_uncommitted && !m_is_append)
+            std::remove(m_tmp_file_name.c_str());
+    }
+}
@@ -12,9 +12,14 @@ namespace Libdas {
     GLTFCompiler::GLTFCompiler(const std::string &_in_path, const std::string &_out_file, bool _use_raw_textures) : 
         DasWriterCore(_out_file), m_use_raw_textures(_use_raw_textures), m_root_path(_in_path) {}
 
+    GLTFCompiler::GLTFCompiler(const std::string &_in_path, const std::shared_ptr<OutputSink> &_sink, bool _use_raw_textures) : 
+        DasWriterCore(_sink), m_use_raw_textures(_use_raw_textures), m_root_path(_in_path) {}
+
     GLTFCompiler::GLTFCompiler(const std::string &_in_path, GLTFRoot &_root, const DasProperties &_props, 
-                               const std::string &_out_file, const std::vector<std::string> &_embedded_textures, bool _use_raw_textures) : 
+                               const std::string &_out_file, const std::vector<std::string> &_embedded_textures, bool _use_raw_textures,
+                               VertexQuantization _quantization) : 
         m_use_raw_textures(_use_raw_textures), 
+        m_quantization(_quantization),
         m_root_path(_in_path)
     {
         Compile(_root, _props, _embedded_textures, _out_file);
@@ -182,6 +187,104 @@ namespace Libdas {
     }
 
 
+    size_t GLTFCompiler::_FindFragment(const DasBuffer &_buffer, size_t _first_fragment, uint32_t _offset) {
+        uint32_t offset = _buffer.data_len;
+        for(size_t i = _first_fragment; i < _buffer.data_ptrs.size(); i++)
+            offset -= static_cast<uint32_t>(_buffer.data_ptrs[i].second);
+
+        for(size_t i = _first_fragment; i < _buffer.data_ptrs.size(); i++) {
+            if(offset == _offset)
+                return i;
+            offset += static_cast<uint32_t>(_buffer.data_ptrs[i].second);
+        }
+
+        LIBDAS_ASSERT(false);
+        return _buffer.data_ptrs.size();
+    }
+
+
+    void GLTFCompiler::_RemapVertexFragment(DasBuffer &_buffer, size_t _first_fragment, uint32_t _offset, size_t _elem_size, const std::vector<uint32_t> &_remap) {
+        auto &fragment = _buffer.data_ptrs[_FindFragment(_buffer, _first_fragment, _offset)];
+        const size_t remapped_len = _remap.size() * _elem_size;
+        LIBDAS_ASSERT(fragment.second >= remapped_len);
+
+        // tightly packed fragments point to resolved GLTF buffers, thus remapped data is always written into a copy
+        char *buf = new char[fragment.second]{};
+        MeshOptimizer::RemapVertexStream(buf, fragment.first, _elem_size, _remap);
+        std::memcpy(buf + remapped_len, fragment.first + remapped_len, fragment.second - remapped_len);
+        fragment.first = buf;
+        m_allocated_memory.push_back(buf);
+    }
+
+
+    void GLTFCompiler::_OptimizeMeshPrimitive(DasBuffer &_buffer, size_t _first_fragment, uint32_t _vertex_count) {
+        DasMeshPrimitive &prim = m_mesh_primitives.back();
+
+        // index fragment is always allocated by the compiler and can be reordered in place
+        uint32_t *indices = reinterpret_cast<uint32_t*>(_buffer.data_ptrs[_FindFragment(_buffer, _first_fragment, prim.index_buffer_offset)].first);
+        MeshOptimizer optimizer(indices, prim.draw_count, _vertex_count);
+        optimizer.OptimizeVertexCache();
+        const std::vector<uint32_t> remap = optimizer.OptimizeVertexFetch();
+
+        _RemapPrimitiveVertices(_buffer, _first_fragment, prim, remap);
+        for(uint32_t i = 0; i < prim.morph_target_count; i++)
+            _RemapPrimitiveVertices(_buffer, _first_fragment, m_morph_targets[prim.morph_targets[i]], remap);
+    }
+
+
+    void GLTFCompiler::_BuildMeshlets(DasBuffer &_buffer, size_t _first_fragment, uint32_t _vertex_count) {
+        DasMeshPrimitive &prim = m_mesh_primitives.back();
+        const uint32_t *indices = reinterpret_cast<const uint32_t*>(_buffer.data_ptrs[_FindFragment(_buffer, _first_fragment, prim.index_buffer_offset)].first);
+        const char *pos_data = _buffer.data_ptrs[_FindFragment(_buffer, _first_fragment, prim.vertex_buffer_offset)].first;
+
+        // meshlet bounds are always calculated from dequantized positions
+        std::vector<TRS::Point3D<float>> positions(_vertex_count);
+        for(uint32_t i = 0; i < _vertex_count; i++) {
+            if(prim.quantization & LIBDAS_QUANTIZATION_POSITION) {
+                const uint16_t *q = reinterpret_cast<const uint16_t*>(pos_data + i * LIBDAS_QUANTIZED_POSITION_SIZE);
+                positions[i].x = Quantization::DecodeUnorm16(q[0], prim.position_offset.x, prim.position_scale.x);
+                positions[i].y = Quantization::DecodeUnorm16(q[1], prim.position_offset.y, prim.position_scale.y);
+                positions[i].z = Quantization::DecodeUnorm16(q[2], prim.position_offset.z, prim.position_scale.z);
+            } else {
+                std::memcpy(&positions[i], pos_data + i * sizeof(TRS::Point3D<float>), sizeof(TRS::Point3D<float>));
+            }
+        }
+
+        MeshletBuilder builder(indices, prim.draw_count, positions.data(), _vertex_count);
+        builder.Build(0);
+        if(!builder.GetMeshletCount())
+            return;
+
+        const size_t len = builder.GetSerializedSize();
+        char *buf = new char[len];
+        builder.Serialize(buf);
+        m_allocated_memory.push_back(buf);
+
+        prim.meshlet_buffer_offset = m_meshlet_buffer.data_len;
+        prim.meshlet_count = builder.GetMeshletCount();
+        m_meshlet_buffer.data_ptrs.push_back(std::make_pair(buf, len));
+        m_meshlet_buffer.data_len += static_cast<uint32_t>(len);
+    }
+
+
+    void GLTFCompiler::_DeduplicateMeshBuffers(DasBuffer &_buffer) {
+        BufferDeduplicator dedup;
+        dedup.Deduplicate(_buffer);
+        for(DasMeshPrimitive &prim : m_mesh_primitives)
+            _RemapPrimitiveBufferOffsets(dedup, prim);
+        for(DasMorphTarget &morph : m_morph_targets)
+            _RemapPrimitiveBufferOffsets(dedup, morph);
+
+        // meshlet offsets are relative to the meshlet buffer offset of the primitive, thus meshlet fragments can be shared as well
+        BufferDeduplicator meshlet_dedup;
+        meshlet_dedup.Deduplicate(m_meshlet_buffer);
+        for(DasMeshPrimitive &prim : m_mesh_primitives) {
+            if(prim.meshlet_count)
+                prim.meshlet_buffer_offset = meshlet_dedup.RemapOffset(prim.meshlet_buffer_offset);
+        }
+    }
+
+
     // TODO: add accessor buffer offset correction to the implementation
     // right now only supplementation is done
     DasBuffer GLTFCompiler::_RewriteMeshBuffer(GLTFRoot &_root) {
@@ -204,6 +307,9 @@ namespace Libdas {
                 if (prim_it->indices != INT32_MAX)
                     gen_acc.indices_accessor = prim_it->indices;
 
+                // fragments written from here on belong to the current primitive and its morph targets
+                const size_t first_fragment = buffer.data_ptrs.size();
+                const uint32_t vertex_count = _root.accessors[gen_acc.pos_accessor].count;
                 m_mesh_primitives.emplace_back();
                 _WritePrimitiveData(_root, gen_acc, buffer, m_mesh_primitives.back());
 
@@ -229,11 +335,24 @@ namespace Libdas {
 
                 }
 
+                if(prim_it->mode == KHRONOS_TRIANGLES && m_mesh_primitives.back().index_buffer_id != UINT32_MAX) {
+                    if(m_optimize_meshes)
+                        _OptimizeMeshPrimitive(buffer, first_fragment, vertex_count);
+                    if(m_build_meshlets)
+                        _BuildMeshlets(buffer, first_fragment, vertex_count);
+                }
+
                 const size_t id = prim_it - mesh_it->primitives.begin();
                 m_meshes[mesh_id].primitives[id] = static_cast<uint32_t>(m_mesh_primitives.size() - 1);
             }
+
+            m_meshes[mesh_id].bounds = Bounds::FindMeshBounds(m_meshes[mesh_id], m_mesh_primitives);
         }
 
+        // fragments are no longer looked up by primitive after this point
+        if(m_deduplicate_buffers)
+            _DeduplicateMeshBuffers(buffer);
+
         return buffer;
     }
 
@@ -414,6 +533,106 @@ namespace Libdas {
 
 
 
+    TRS::Vector3<float> GLTFCompiler::_GetVector3(BufferAccessorData &_ad, uint32_t _index) {
+        const char *ptr = m_uri_resolvers[_ad.buffer_id].GetBuffer().first + _ad.buffer_offset + _index * _ad.unit_stride;
+        if(_ad.component_type != KHRONOS_FLOAT) {
+            std::cerr << "GLTF error: Quantized vertex attribute type must be VEC3 with component type of float" << std::endl;
+            std::exit(LIBDAS_ERROR_INVALID_TYPE);
+        }
+
+        TRS::Vector3<float> vec;
+        vec.first = *reinterpret_cast<const float*>(ptr);
+        vec.second = *reinterpret_cast<const float*>(ptr + sizeof(float));
+        vec.third = *reinterpret_cast<const float*>(ptr + 2 * sizeof(float));
+        return vec;
+    }
+
+
+    TRS::Vector4<float> GLTFCompiler::_GetVector4(BufferAccessorData &_ad, uint32_t _index) {
+        const char *ptr = m_uri_resolvers[_ad.buffer_id].GetBuffer().first + _ad.buffer_offset + _index * _ad.unit_stride;
+        if(_ad.component_type != KHRONOS_FLOAT) {
+            std::cerr << "GLTF error: Quantized vertex attribute type must be VEC4 with component type of float" << std::endl;
+            std::exit(LIBDAS_ERROR_INVALID_TYPE);
+        }
+
+        TRS::Vector4<float> vec;
+        vec.first = *reinterpret_cast<const float*>(ptr);
+        vec.second = *reinterpret_cast<const float*>(ptr + sizeof(float));
+        vec.third = *reinterpret_cast<const float*>(ptr + 2 * sizeof(float));
+        vec.fourth = *reinterpret_cast<const float*>(ptr + 3 * sizeof(float));
+        return vec;
+    }
+
+
+    DasBoundingVolume GLTFCompiler::_FindPositionBounds(const GLTFRoot &_root, uint32_t _accessor) {
+        const GLTFAccessor &accessor = _root.accessors[_accessor];
+
+        // position accessors are required to specify their bounds, but they are not always present
+        if(accessor.min.size() == 3 && accessor.max.size() == 3)
+            return Bounds::FromMinMax({ accessor.min[0], accessor.min[1], accessor.min[2] }, { accessor.max[0], accessor.max[1], accessor.max[2] });
+
+        BufferAccessorData acc = _FindAccessorData(_root, _accessor);
+        if(acc.component_type != KHRONOS_FLOAT)
+            return DasBoundingVolume();
+
+        const char *positions = m_uri_resolvers[acc.buffer_id].GetBuffer().first + acc.buffer_offset;
+        return Bounds::FindPositionBounds(positions, acc.unit_stride, static_cast<uint32_t>(accessor.count));
+    }
+
+
+    void GLTFCompiler::_QuantizePositions(GLTFRoot &_root, uint32_t _accessor, const DasBoundingVolume &_bounds, DasBuffer &_buffer, uint32_t &_prim_id, 
+                                          uint32_t &_prim_offset, QuantizationParameters &_quant) {
+        const TRS::Point3D<float> min = _bounds.min;
+        const TRS::Point3D<float> max = _bounds.max;
+
+        _quant.position_offset = min;
+        _quant.position_scale = { Quantization::FindScale(min.x, max.x), Quantization::FindScale(min.y, max.y), Quantization::FindScale(min.z, max.z) };
+        _quant.used |= LIBDAS_QUANTIZATION_POSITION;
+
+        const TRS::Point3D<float> offset = _quant.position_offset;
+        const TRS::Point3D<float> scale = _quant.position_scale;
+        _QuantizeSingleAttributeAccessorDataToBuffer<TRS::Vector4<uint16_t>>(_root, _accessor, _prim_id, _prim_offset, _buffer,
+            [this, offset, scale](BufferAccessorData &_acc, uint32_t _index) {
+                const TRS::Vector3<float> pos = _GetVector3(_acc, _index);
+                return TRS::Vector4<uint16_t>(Quantization::EncodeUnorm16(pos.first, offset.x, scale.x),
+                                              Quantization::EncodeUnorm16(pos.second, offset.y, scale.y),
+                                              Quantization::EncodeUnorm16(pos.third, offset.z, scale.z),
+                                              0);
+            });
+    }
+
+
+    void GLTFCompiler::_QuantizeUVs(GLTFRoot &_root, std::vector<uint32_t> &_accessors, DasBuffer &_buffer, uint32_t *_prim_ids, uint32_t *_prim_offsets,
+                                    QuantizationParameters &_quant) {
+        // all uv sets share the same coordinate range
+        TRS::Point2D<float> min = { FLT_MAX, FLT_MAX };
+        TRS::Point2D<float> max = { -FLT_MAX, -FLT_MAX };
+        for(auto it = _accessors.begin(); it != _accessors.end(); it++) {
+            BufferAccessorData acc = _FindAccessorData(_root, *it);
+            for(uint32_t i = 0; i < static_cast<uint32_t>(_root.accessors[*it].count); i++) {
+                const TRS::Vector2<float> uv = _GetUV(acc, i);
+                min = { std::min(min.x, uv.first), std::min(min.y, uv.second) };
+                max = { std::max(max.x, uv.first), std::max(max.y, uv.second) };
+            }
+        }
+
+        _quant.uv_offset = min;
+        _quant.uv_scale = { Quantization::FindScale(min.x, max.x), Quantization::FindScale(min.y, max.y) };
+        _quant.used |= LIBDAS_QUANTIZATION_UV;
+
+        const TRS::Point2D<float> offset = _quant.uv_offset;
+        const TRS::Point2D<float> scale = _quant.uv_scale;
+        for(size_t i = 0; i < _accessors.size(); i++) {
+            _QuantizeSingleAttributeAccessorDataToBuffer<TRS::Vector2<uint16_t>>(_root, _accessors[i], _prim_ids[i], _prim_offsets[i], _buffer,
+                [this, offset, scale](BufferAccessorData &_acc, uint32_t _index) {
+                    const TRS::Vector2<float> uv = _GetUV(_acc, _index);
+                    return TRS::Vector2<uint16_t>(Quantization::EncodeUnorm16(uv.first, offset.x, scale.x),
+                                                  Quantization::EncodeUnorm16(uv.second, offset.y, scale.y));
+                });
+        }
+    }
+
+
     GLTFCompiler::GenericVertexAttributeAccessors GLTFCompiler::_GenerateGenericVertexAttributeAccessors(GLTFMeshPrimitive::AttributesType &_attrs) {
         GenericVertexAttributeAccessors attr_accessors;
 
@@ -506,10 +725,9 @@ namespace Libdas {
             _attr_offset = _buffer.data_len;
             _buffer.data_len += (uint32_t)len;
         } else {
+            // tightly packed data is referenced directly from the resolved buffer, writer passes it to the file as is
             size_t len = acc.used_size;
-            char *buf = new char[len]{};
-            std::memcpy(buf, m_uri_resolvers[acc.buffer_id].GetBuffer().first + acc.buffer_offset, acc.used_size);
-            m_allocated_memory.push_back(buf);
+            char *buf = m_uri_resolvers[acc.buffer_id].GetBuffer().first + acc.buffer_offset;
             _buffer.data_ptrs.push_back(std::make_pair(buf, len));
             _attr_id = 0;
             _attr_offset = _buffer.data_len;
@@ -586,6 +804,16 @@ namespace Libdas {
         AppendTextures(buffers, _embedded_textures);
         _FlagBuffersAccordingToMeshes(_root, buffers);
 
+        // meshlets are appended last, thus no other buffer id is shifted
+        if(m_meshlet_buffer.data_len) {
+            m_meshlet_buffer.type = LIBDAS_BUFFER_TYPE_MESHLET;
+            for(DasMeshPrimitive &prim : m_mesh_primitives) {
+                if(prim.meshlet_count)
+                    prim.meshlet_buffer_id = static_cast<uint32_t>(buffers.size());
+            }
+            buffers.push_back(m_meshlet_buffer);
+        }
+
         return buffers;
     }
 
@@ -875,49 +1103,55 @@ namespace Libdas {
 
         // write buffers to file
         std::vector<DasBuffer> buffers(_CreateBuffers(_root, _embedded_textures));
-        for(auto it = buffers.begin(); it != buffers.end(); it++)
-            WriteBuffer(*it);
+        WriteBuffers(buffers);
 
         // write mesh primitives to the file
-        for(auto it = m_mesh_primitives.begin(); it != m_mesh_primitives.end(); it++)
-            WriteMeshPrimitive(*it);
+        WriteMeshPrimitives(m_mesh_primitives);
 
         // write morph targets to the file
-        for(auto it = m_morph_targets.begin(); it != m_morph_targets.end(); it++)
-            WriteMorphTarget(*it);
+        WriteMorphTargets(m_morph_targets);
 
         // write meshes to the file
-        for(auto it = m_meshes.begin(); it != m_meshes.end(); it++)
-            WriteMesh(*it);
+        WriteMeshes(m_meshes);
 
         // write scene nodes to the file
         std::vector<DasNode> nodes(_CreateNodes(_root)); 
-        for(auto it = nodes.begin(); it != nodes.end(); it++)
-            WriteNode(*it);
+        WriteNodes(nodes);
 
-        // write scenes to the file
+        // write scenes to the file, node bounds of each scene are shared by the scene bounds and the hierarchy
         std::vector<DasScene> scenes(_CreateScenes(_root));
-        for(auto it = scenes.begin(); it != scenes.end(); it++)
-            WriteScene(*it);
+        std::vector<DasBvh> bvhs;
+        for(size_t i = 0; i < scenes.size(); i++) {
+            const std::vector<DasBoundingVolume> node_bounds = Bounds::FindNodeBounds(scenes[i], nodes, m_meshes);
+            for(const DasBoundingVolume &bounds : node_bounds)
+                Bounds::Merge(scenes[i].bounds, bounds);
+
+            if(m_build_bvhs) {
+                BvhBuilder builder(node_bounds);
+                builder.Build(0);
+                if(builder.GetNodes().size())
+                    bvhs.push_back(builder.CreateBvh(static_cast<uint32_t>(i)));
+            }
+        }
+        WriteScenes(scenes);
 
         // write skeleton joints to the file
         std::vector<DasSkeletonJoint> joints(_CreateSkeletonJoints(_root));
-        for(auto it = joints.begin(); it != joints.end(); it++)
-            WriteSkeletonJoint(*it);
+        WriteSkeletonJoints(joints);
 
         // write skeletons to the file
         std::vector<DasSkeleton> skeletons(_CreateSkeletons(_root));
-        for(auto it = skeletons.begin(); it != skeletons.end(); it++)
-            WriteSkeleton(*it);
+        WriteSkeletons(skeletons);
 
         // write animation channels to file
         std::vector<DasAnimationChannel> channels(_CreateAnimationChannels(_root));
-        for(auto it = channels.begin(); it != channels.end(); it++)
-            WriteAnimationChannel(*it);
+        WriteAnimationChannels(channels);
 
         // write animations to file
         std::vector<DasAnimation> animations(_CreateAnimations(_root));
-        for(auto it = animations.begin(); it != animations.end(); it++)
-            WriteAnimation(*it);
+        WriteAnimations(animations);
+
+        // write scene bounding volume hierarchies to file
+        WriteBvhs(bvhs);
     }
 }
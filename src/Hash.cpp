@@ -81,4 +81,38 @@ namespace Libdas {
         key *= (key >> 5) * PRIME;
         return key;
     }
+
+
+    static inline uint64_t _Rotl64(uint64_t _x, uint32_t _r) {
+        return (_x << _r) | (_x >> (64 - _r));
+    }
+
+
+    uint64_t HashFunc64(char const *_data, size_t _len) {
+        uint64_t key = PRIME64_3 + static_cast<uint64_t>(_len) * PRIME64_1;
+
+        // data is consumed in 8 byte words, remaining bytes are mixed in one at a time
+        size_t i = 0;
+        for(; i + sizeof(uint64_t) <= _len; i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, _data + i, sizeof(uint64_t));
+            word *= PRIME64_2;
+            word = _Rotl64(word, 31);
+            word *= PRIME64_1;
+            key ^= word;
+            key = _Rotl64(key, 27) * PRIME64_1 + PRIME64_3;
+        }
+
+        for(; i < _len; i++) {
+            key ^= static_cast<uint64_t>(static_cast<uint8_t>(_data[i])) * PRIME64_3;
+            key = _Rotl64(key, 11) * PRIME64_1;
+        }
+
+        key ^= key >> 33;
+        key *= PRIME64_2;
+        key ^= key >> 29;
+        key *= PRIME64_3;
+        key ^= key >> 32;
+        return key;
+    }
 }
@@ -0,0 +1,122 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: MappedFile.cpp - memory mapped file class implementation
+// author: Karl-Mihkel Ott
+
+#define MAPPED_FILE_CPP
+#include "das/MappedFile.h"
+
+namespace Libdas {
+
+    MappedFile::MappedFile(const std::string &_file_name) : m_file_name(_file_name) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(m_file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        LARGE_INTEGER size = {};
+        if(file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size)) {
+            std::cerr << "Could not open file " << m_file_name << " for mapping" << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+        }
+
+        m_file_handle = file;
+        m_size = static_cast<size_t>(size.QuadPart);
+
+        // zero sized files cannot be mapped
+        if(!m_size) return;
+
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        if(!mapping) {
+            std::cerr << "Could not create file mapping for " << m_file_name << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+        }
+
+        m_mapping_handle = mapping;
+        m_data = reinterpret_cast<char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+#else
+        m_fd = open(m_file_name.c_str(), O_RDONLY);
+        struct stat st = {};
+        if(m_fd == -1 || fstat(m_fd, &st) == -1) {
+            std::cerr << "Could not open file " << m_file_name << " for mapping" << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+        }
+
+        m_size = static_cast<size_t>(st.st_size);
+
+        // zero sized files cannot be mapped
+        if(!m_size) return;
+
+        void *data = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, m_fd, 0);
+        if(data != MAP_FAILED) {
+            m_data = reinterpret_cast<char*>(data);
+            // the file is mostly read front to back
+            madvise(data, m_size, MADV_SEQUENTIAL);
+        }
+#endif
+
+        if(!m_data) {
+            std::cerr << "Could not map file " << m_file_name << " into memory" << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+        }
+    }
+
+
+    MappedFile::MappedFile(std::vector<char> &&_image, const std::string &_name) :
+        m_file_name(_name),
+        m_image(std::move(_image))
+    {
+        m_data = m_image.empty() ? nullptr : m_image.data();
+        m_size = m_image.size();
+    }
+
+
+    MappedFile::MappedFile(MappedFile &&_file) noexcept :
+        m_file_name(std::move(_file.m_file_name)),
+        m_data(_file.m_data),
+        m_size(_file.m_size),
+        m_image(std::move(_file.m_image)),
+#ifdef _WIN32
+        m_file_handle(_file.m_file_handle),
+        m_mapping_handle(_file.m_mapping_handle)
+#else
+        m_fd(_file.m_fd)
+#endif
+    {
+        _file.m_data = nullptr;
+        _file.m_size = 0;
+#ifdef _WIN32
+        _file.m_file_handle = nullptr;
+        _file.m_mapping_handle = nullptr;
+#else
+        _file.m_fd = -1;
+#endif
+    }
+
+
+    MappedFile::~MappedFile() {
+        _Unmap();
+    }
+
+
+    void MappedFile::_Unmap() {
+        // in-memory images have no mapping or file handles
+        if(!m_image.empty()) {
+            m_image.clear();
+            m_data = nullptr;
+            m_size = 0;
+            return;
+        }
+
+#ifdef _WIN32
+        if(m_data) UnmapViewOfFile(m_data);
+        if(m_mapping_handle) CloseHandle(reinterpret_cast<HANDLE>(m_mapping_handle));
+        if(m_file_handle) CloseHandle(reinterpret_cast<HANDLE>(m_file_handle));
+        m_mapping_handle = nullptr;
+        m_file_handle = nullptr;
+#else
+        if(m_data) munmap(m_data, m_size);
+        if(m_fd != -1) close(m_fd);
+        m_fd = -1;
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
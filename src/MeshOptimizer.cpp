@@ -0,0 +1,209 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: MeshOptimizer.cpp - vertex cache and vertex fetch optimization class implementation
+// author: Karl-Mihkel Ott
+
+#define MESH_OPTIMIZER_CPP
+#include "das/MeshOptimizer.h"
+
+namespace Libdas {
+
+    // scoring constants as proposed by Tom Forsyth
+    static constexpr float s_cache_decay_power = 1.5f;
+    static constexpr float s_last_triangle_score = 0.75f;
+    static constexpr float s_valence_boost_scale = 2.0f;
+    static constexpr float s_valence_boost_power = 0.5f;
+
+    MeshOptimizer::MeshOptimizer(uint32_t *_indices, uint32_t _index_count, uint32_t _vertex_count) :
+        m_indices(_indices), m_index_count(_index_count), m_vertex_count(_vertex_count) {}
+
+
+    float MeshOptimizer::_FindVertexScore(int32_t _cache_pos, uint32_t _valence) const {
+        // vertices without remaining triangles are never needed again
+        if(!_valence)
+            return -1.0f;
+
+        float score = 0.0f;
+        if(_cache_pos >= 0) {
+            // vertices of the last emitted triangle get a fixed score, so that strip-like order is not preferred
+            if(_cache_pos < 3) score = s_last_triangle_score;
+            else if(_cache_pos < LIBDAS_MESH_OPTIMIZER_SCORE_CACHE_SIZE) {
+                const float scaler = 1.0f / static_cast<float>(LIBDAS_MESH_OPTIMIZER_SCORE_CACHE_SIZE - 3);
+                score = std::pow(1.0f - static_cast<float>(_cache_pos - 3) * scaler, s_cache_decay_power);
+            }
+        }
+
+        // boost vertices with few remaining triangles, to get rid of lone triangles
+        score += s_valence_boost_scale * std::pow(static_cast<float>(_valence), -s_valence_boost_power);
+        return score;
+    }
+
+
+    void MeshOptimizer::OptimizeVertexCache() {
+        const uint32_t tri_count = m_index_count / 3;
+        if(tri_count < 2 || !m_vertex_count)
+            return;
+
+        // build vertex to triangle adjacency in compressed row form
+        std::vector<uint32_t> valences(m_vertex_count, 0);
+        for(uint32_t i = 0; i < tri_count * 3; i++) {
+            LIBDAS_ASSERT(m_indices[i] < m_vertex_count);
+            valences[m_indices[i]]++;
+        }
+
+        std::vector<uint32_t> adjacency_offsets(m_vertex_count + 1, 0);
+        for(uint32_t i = 0; i < m_vertex_count; i++)
+            adjacency_offsets[i + 1] = adjacency_offsets[i] + valences[i];
+
+        std::vector<uint32_t> adjacency(tri_count * 3);
+        std::vector<uint32_t> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+        for(uint32_t i = 0; i < tri_count; i++) {
+            for(uint32_t j = 0; j < 3; j++)
+                adjacency[fill[m_indices[i * 3 + j]]++] = i;
+        }
+
+        // initial scores, when the cache is empty
+        std::vector<int32_t> cache_positions(m_vertex_count, -1);
+        std::vector<float> vertex_scores(m_vertex_count);
+        for(uint32_t i = 0; i < m_vertex_count; i++)
+            vertex_scores[i] = _FindVertexScore(-1, valences[i]);
+
+        std::vector<float> triangle_scores(tri_count);
+        std::vector<bool> is_emitted(tri_count, false);
+        for(uint32_t i = 0; i < tri_count; i++) {
+            triangle_scores[i] = vertex_scores[m_indices[i * 3]] + vertex_scores[m_indices[i * 3 + 1]] +
+                                 vertex_scores[m_indices[i * 3 + 2]];
+        }
+
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> new_cache;
+        cache.reserve(LIBDAS_MESH_OPTIMIZER_SCORE_CACHE_SIZE + 3);
+        new_cache.reserve(LIBDAS_MESH_OPTIMIZER_SCORE_CACHE_SIZE + 3);
+
+        std::vector<uint32_t> output(tri_count * 3);
+        uint32_t best_triangle = static_cast<uint32_t>(std::max_element(triangle_scores.begin(), triangle_scores.end()) - triangle_scores.begin());
+        uint32_t input_cursor = 0;
+
+        for(uint32_t out_tri = 0; out_tri < tri_count; out_tri++) {
+            // no candidates in the cache, continue with the next triangle in input order
+            if(best_triangle == UINT32_MAX) {
+                while(is_emitted[input_cursor])
+                    input_cursor++;
+                best_triangle = input_cursor;
+            }
+
+            const uint32_t *tri = m_indices + best_triangle * 3;
+            std::memcpy(output.data() + out_tri * 3, tri, 3 * sizeof(uint32_t));
+            is_emitted[best_triangle] = true;
+
+            // remove the emitted triangle from adjacency lists of its vertices
+            for(uint32_t j = 0; j < 3; j++) {
+                const uint32_t v = tri[j];
+                uint32_t *begin = adjacency.data() + adjacency_offsets[v];
+                uint32_t *end = begin + valences[v];
+                uint32_t *it = std::find(begin, end, best_triangle);
+                LIBDAS_ASSERT(it != end);
+                std::swap(*it, *(end - 1));
+                valences[v]--;
+            }
+
+            // emitted triangle vertices are moved to the front of the LRU cache
+            new_cache.clear();
+            new_cache.insert(new_cache.end(), tri, tri + 3);
+            for(uint32_t v : cache) {
+                if(v != tri[0] && v != tri[1] && v != tri[2])
+                    new_cache.push_back(v);
+            }
+            cache.swap(new_cache);
+
+            // update scores of all vertices that were in the cache, including the ones that were just evicted
+            for(size_t j = 0; j < cache.size(); j++) {
+                const uint32_t v = cache[j];
+                const int32_t pos = j < LIBDAS_MESH_OPTIMIZER_SCORE_CACHE_SIZE ? static_cast<int32_t>(j) : -1;
+                cache_positions[v] = pos;
+                vertex_scores[v] = _FindVertexScore(pos, valences[v]);
+            }
+
+            // rescore remaining triangles that use cached vertices and pick the best one among them
+            best_triangle = UINT32_MAX;
+            float best_score = -1.0f;
+            for(uint32_t v : cache) {
+                for(uint32_t k = 0; k < valences[v]; k++) {
+                    const uint32_t t = adjacency[adjacency_offsets[v] + k];
+                    const float score = vertex_scores[m_indices[t * 3]] + vertex_scores[m_indices[t * 3 + 1]] +
+                                        vertex_scores[m_indices[t * 3 + 2]];
+                    triangle_scores[t] = score;
+                    if(score > best_score) {
+                        best_score = score;
+                        best_triangle = t;
+                    }
+                }
+            }
+
+            if(cache.size() > LIBDAS_MESH_OPTIMIZER_SCORE_CACHE_SIZE)
+                cache.resize(LIBDAS_MESH_OPTIMIZER_SCORE_CACHE_SIZE);
+        }
+
+        std::memcpy(m_indices, output.data(), output.size() * sizeof(uint32_t));
+    }
+
+
+    std::vector<uint32_t> MeshOptimizer::OptimizeVertexFetch() {
+        std::vector<uint32_t> remap(m_vertex_count, UINT32_MAX);
+        uint32_t next_vertex = 0;
+
+        for(uint32_t i = 0; i < m_index_count; i++) {
+            LIBDAS_ASSERT(m_indices[i] < m_vertex_count);
+            uint32_t &new_index = remap[m_indices[i]];
+            if(new_index == UINT32_MAX)
+                new_index = next_vertex++;
+            m_indices[i] = new_index;
+        }
+
+        // unreferenced vertices are kept after all referenced ones
+        for(uint32_t i = 0; i < m_vertex_count; i++) {
+            if(remap[i] == UINT32_MAX)
+                remap[i] = next_vertex++;
+        }
+
+        return remap;
+    }
+
+
+    VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(uint32_t _cache_size) const {
+        VertexCacheStatistics stats;
+        const uint32_t tri_count = m_index_count / 3;
+        if(!tri_count || !_cache_size)
+            return stats;
+
+        // FIFO cache is simulated with per vertex timestamps, a vertex is cached when it was inserted recently enough
+        std::vector<uint32_t> timestamps(m_vertex_count, 0);
+        std::vector<bool> is_referenced(m_vertex_count, false);
+        uint32_t time = _cache_size + 1;
+        uint32_t referenced_count = 0;
+
+        for(uint32_t i = 0; i < tri_count * 3; i++) {
+            const uint32_t v = m_indices[i];
+            LIBDAS_ASSERT(v < m_vertex_count);
+            if(time - timestamps[v] > _cache_size) {
+                timestamps[v] = time++;
+                stats.transformed_vertex_count++;
+            }
+
+            if(!is_referenced[v]) {
+                is_referenced[v] = true;
+                referenced_count++;
+            }
+        }
+
+        stats.acmr = static_cast<float>(stats.transformed_vertex_count) / static_cast<float>(tri_count);
+        stats.atvr = static_cast<float>(stats.transformed_vertex_count) / static_cast<float>(referenced_count);
+        return stats;
+    }
+
+
+    void MeshOptimizer::RemapVertexStream(char *_dst, const char *_src, size_t _stride, const std::vector<uint32_t> &_remap) {
+        for(size_t i = 0; i < _remap.size(); i++)
+            std::memcpy(_dst + _remap[i] * _stride, _src + i * _stride, _stride);
+    }
+}
@@ -0,0 +1,279 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: MeshletBuilder.cpp - meshlet generation class implementation
+// author: Karl-Mihkel Ott
+
+#define MESHLET_BUILDER_CPP
+#include "das/MeshletBuilder.h"
+
+namespace Libdas {
+
+    static_assert(sizeof(DasMeshlet) % sizeof(uint32_t) == 0, "Meshlet descriptors must keep vertex indices aligned");
+
+    // open addressing table, that maps vertex indices to meshlet local indices, must be larger than 256
+    static constexpr uint32_t s_local_table_size = 512;
+
+    static inline float _Component(const TRS::Point3D<float> &_p, uint32_t _axis) {
+        return _axis == 0 ? _p.x : (_axis == 1 ? _p.y : _p.z);
+    }
+
+
+    MeshletBuilder::MeshletBuilder(const uint32_t *_indices, uint32_t _index_count, const TRS::Point3D<float> *_positions, uint32_t _vertex_count,
+                                   uint32_t _max_vertices, uint32_t _max_triangles) :
+        m_indices(_indices),
+        m_index_count(_index_count),
+        m_positions(_positions),
+        m_vertex_count(_vertex_count),
+        m_max_vertices(std::clamp(_max_vertices, 3u, 256u)),
+        m_max_triangles(std::max(_max_triangles, 1u)) {}
+
+
+    void MeshletBuilder::_PartitionTriangles(uint32_t _first_triangle, uint32_t _triangle_count, Partition &_partition) const {
+        uint32_t keys[s_local_table_size];
+        uint8_t values[s_local_table_size];
+        std::fill(keys, keys + s_local_table_size, UINT32_MAX);
+
+        DasMeshlet meshlet;
+        auto flush = [&]() {
+            if(!meshlet.triangle_count)
+                return;
+
+            _CalculateBounds(meshlet, _partition);
+            _partition.meshlets.push_back(meshlet);
+            meshlet = DasMeshlet();
+            meshlet.vertex_offset = static_cast<uint32_t>(_partition.vertices.size());
+            meshlet.triangle_offset = static_cast<uint32_t>(_partition.triangles.size() / 3);
+            std::fill(keys, keys + s_local_table_size, UINT32_MAX);
+        };
+
+        // find the slot of a vertex in the local table
+        auto find_slot = [&](uint32_t _vertex) {
+            uint32_t slot = (_vertex * 2654435761u) & (s_local_table_size - 1);
+            while(keys[slot] != UINT32_MAX && keys[slot] != _vertex)
+                slot = (slot + 1) & (s_local_table_size - 1);
+            return slot;
+        };
+
+        for(uint32_t i = _first_triangle; i < _first_triangle + _triangle_count; i++) {
+            const uint32_t *tri = m_indices + i * 3;
+            LIBDAS_ASSERT(tri[0] < m_vertex_count && tri[1] < m_vertex_count && tri[2] < m_vertex_count);
+
+            uint32_t new_vertices = 0;
+            for(uint32_t j = 0; j < 3; j++) {
+                if(keys[find_slot(tri[j])] == UINT32_MAX && (j < 1 || tri[j] != tri[0]) && (j < 2 || tri[j] != tri[1]))
+                    new_vertices++;
+            }
+
+            if(meshlet.vertex_count + new_vertices > m_max_vertices || meshlet.triangle_count + 1 > m_max_triangles)
+                flush();
+
+            for(uint32_t j = 0; j < 3; j++) {
+                const uint32_t slot = find_slot(tri[j]);
+                if(keys[slot] == UINT32_MAX) {
+                    keys[slot] = tri[j];
+                    values[slot] = static_cast<uint8_t>(meshlet.vertex_count++);
+                    _partition.vertices.push_back(tri[j]);
+                }
+                _partition.triangles.push_back(values[slot]);
+            }
+            meshlet.triangle_count++;
+        }
+
+        flush();
+    }
+
+
+    void MeshletBuilder::_CalculateBounds(DasMeshlet &_meshlet, const Partition &_partition) const {
+        const uint32_t *vertices = _partition.vertices.data() + _meshlet.vertex_offset;
+        const uint8_t *triangles = _partition.triangles.data() + _meshlet.triangle_offset * 3;
+
+        // Ritter's bounding sphere, initial sphere spans the most distant pair of axis extreme points
+        uint32_t min_ids[3] = {}, max_ids[3] = {};
+        for(uint32_t i = 0; i < _meshlet.vertex_count; i++) {
+            const TRS::Point3D<float> &p = m_positions[vertices[i]];
+            for(uint32_t axis = 0; axis < 3; axis++) {
+                if(_Component(p, axis) < _Component(m_positions[vertices[min_ids[axis]]], axis)) min_ids[axis] = i;
+                if(_Component(p, axis) > _Component(m_positions[vertices[max_ids[axis]]], axis)) max_ids[axis] = i;
+            }
+        }
+
+        auto dist2 = [](const TRS::Point3D<float> &_a, const TRS::Point3D<float> &_b) {
+            const float dx = _a.x - _b.x, dy = _a.y - _b.y, dz = _a.z - _b.z;
+            return dx * dx + dy * dy + dz * dz;
+        };
+
+        uint32_t span_axis = 0;
+        float span = -1.0f;
+        for(uint32_t axis = 0; axis < 3; axis++) {
+            const float d = dist2(m_positions[vertices[min_ids[axis]]], m_positions[vertices[max_ids[axis]]]);
+            if(d > span) {
+                span = d;
+                span_axis = axis;
+            }
+        }
+
+        const TRS::Point3D<float> &a = m_positions[vertices[min_ids[span_axis]]];
+        const TRS::Point3D<float> &b = m_positions[vertices[max_ids[span_axis]]];
+        float cx = (a.x + b.x) * 0.5f, cy = (a.y + b.y) * 0.5f, cz = (a.z + b.z) * 0.5f;
+        float radius = std::sqrt(span) * 0.5f;
+
+        for(uint32_t i = 0; i < _meshlet.vertex_count; i++) {
+            const TRS::Point3D<float> &p = m_positions[vertices[i]];
+            const float d2 = dist2(p, TRS::Point3D<float>{cx, cy, cz});
+            if(d2 > radius * radius) {
+                const float d = std::sqrt(d2);
+                const float k = 0.5f - 0.5f * radius / d;
+                radius = (radius + d) * 0.5f;
+                cx += (p.x - cx) * k;
+                cy += (p.y - cy) * k;
+                cz += (p.z - cz) * k;
+            }
+        }
+
+        _meshlet.center = {cx, cy, cz};
+        _meshlet.radius = radius;
+
+        // normal cone axis is the average of triangle normals
+        std::vector<float> normals(_meshlet.triangle_count * 3, 0.0f);
+        float ax = 0.0f, ay = 0.0f, az = 0.0f;
+        for(uint32_t i = 0; i < _meshlet.triangle_count; i++) {
+            const TRS::Point3D<float> &p0 = m_positions[vertices[triangles[i * 3]]];
+            const TRS::Point3D<float> &p1 = m_positions[vertices[triangles[i * 3 + 1]]];
+            const TRS::Point3D<float> &p2 = m_positions[vertices[triangles[i * 3 + 2]]];
+            const float e1x = p1.x - p0.x, e1y = p1.y - p0.y, e1z = p1.z - p0.z;
+            const float e2x = p2.x - p0.x, e2y = p2.y - p0.y, e2z = p2.z - p0.z;
+            float nx = e1y * e2z - e1z * e2y;
+            float ny = e1z * e2x - e1x * e2z;
+            float nz = e1x * e2y - e1y * e2x;
+
+            // degenerate triangles do not contribute to the cone
+            const float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+            if(len == 0.0f)
+                continue;
+
+            nx /= len; ny /= len; nz /= len;
+            normals[i * 3] = nx;
+            normals[i * 3 + 1] = ny;
+            normals[i * 3 + 2] = nz;
+            ax += nx; ay += ny; az += nz;
+        }
+
+        const float axis_len = std::sqrt(ax * ax + ay * ay + az * az);
+        if(axis_len == 0.0f) {
+            _meshlet.cone_apex = _meshlet.center;
+            _meshlet.cone_cutoff = 1.0f;
+            return;
+        }
+
+        ax /= axis_len; ay /= axis_len; az /= axis_len;
+        float min_dot = 1.0f;
+        for(uint32_t i = 0; i < _meshlet.triangle_count; i++) {
+            if(normals[i * 3] == 0.0f && normals[i * 3 + 1] == 0.0f && normals[i * 3 + 2] == 0.0f)
+                continue;
+            min_dot = std::min(min_dot, ax * normals[i * 3] + ay * normals[i * 3 + 1] + az * normals[i * 3 + 2]);
+        }
+
+        _meshlet.cone_axis = {ax, ay, az};
+
+        // normals spread over a hemisphere or more, thus the meshlet can never be culled
+        if(min_dot <= 0.0f) {
+            _meshlet.cone_apex = _meshlet.center;
+            _meshlet.cone_cutoff = 1.0f;
+            return;
+        }
+
+        // apex is moved back along the axis, so that it is behind all triangle planes
+        float max_t = 0.0f;
+        for(uint32_t i = 0; i < _meshlet.triangle_count; i++) {
+            const float dn = ax * normals[i * 3] + ay * normals[i * 3 + 1] + az * normals[i * 3 + 2];
+            if(dn <= 0.0f)
+                continue;
+
+            const TRS::Point3D<float> &p0 = m_positions[vertices[triangles[i * 3]]];
+            const float dc = (cx - p0.x) * normals[i * 3] + (cy - p0.y) * normals[i * 3 + 1] + (cz - p0.z) * normals[i * 3 + 2];
+            max_t = std::max(max_t, dc / dn);
+        }
+
+        _meshlet.cone_apex = {cx - ax * max_t, cy - ay * max_t, cz - az * max_t};
+        _meshlet.cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+    }
+
+
+    void MeshletBuilder::Build(uint32_t _thread_count) {
+        m_meshlets.clear();
+        m_meshlet_vertices.clear();
+        m_meshlet_triangles.clear();
+
+        const uint32_t tri_count = m_index_count / 3;
+        if(!tri_count)
+            return;
+
+        const uint32_t task_count = (tri_count + LIBDAS_MESHLET_TASK_TRIANGLES - 1) / LIBDAS_MESHLET_TASK_TRIANGLES;
+        std::vector<Partition> partitions(task_count);
+
+        std::atomic<uint32_t> next_task(0);
+        auto worker = [&]() {
+            for(uint32_t i = next_task++; i < task_count; i = next_task++) {
+                const uint32_t first = i * LIBDAS_MESHLET_TASK_TRIANGLES;
+                _PartitionTriangles(first, std::min(tri_count - first, static_cast<uint32_t>(LIBDAS_MESHLET_TASK_TRIANGLES)), partitions[i]);
+            }
+        };
+
+        if(!_thread_count)
+            _thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        const uint32_t thread_count = std::min(_thread_count, task_count);
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count);
+        for(uint32_t i = 1; i < thread_count; i++)
+            threads.emplace_back(worker);
+
+        worker();
+        for(std::thread &thread : threads)
+            thread.join();
+
+        // concatenate partitions in task order
+        size_t meshlet_count = 0, vertex_count = 0, triangle_index_count = 0;
+        for(const Partition &partition : partitions) {
+            meshlet_count += partition.meshlets.size();
+            vertex_count += partition.vertices.size();
+            triangle_index_count += partition.triangles.size();
+        }
+
+        m_meshlets.reserve(meshlet_count);
+        m_meshlet_vertices.reserve(vertex_count);
+        m_meshlet_triangles.reserve(triangle_index_count);
+
+        // element offsets are converted into byte offsets relative to the beginning of serialized meshlet data
+        const size_t vertices_begin = meshlet_count * sizeof(DasMeshlet);
+        const size_t triangles_begin = vertices_begin + vertex_count * sizeof(uint32_t);
+        for(const Partition &partition : partitions) {
+            for(DasMeshlet meshlet : partition.meshlets) {
+                meshlet.vertex_offset = static_cast<uint32_t>(vertices_begin + (m_meshlet_vertices.size() + meshlet.vertex_offset) * sizeof(uint32_t));
+                meshlet.triangle_offset = static_cast<uint32_t>(triangles_begin + m_meshlet_triangles.size() + meshlet.triangle_offset * 3);
+                m_meshlets.push_back(meshlet);
+            }
+
+            m_meshlet_vertices.insert(m_meshlet_vertices.end(), partition.vertices.begin(), partition.vertices.end());
+            m_meshlet_triangles.insert(m_meshlet_triangles.end(), partition.triangles.begin(), partition.triangles.end());
+        }
+    }
+
+
+    size_t MeshletBuilder::GetSerializedSize() const {
+        const size_t size = m_meshlets.size() * sizeof(DasMeshlet) + m_meshlet_vertices.size() * sizeof(uint32_t) + m_meshlet_triangles.size();
+        return (size + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1);
+    }
+
+
+    void MeshletBuilder::Serialize(char *_dst) const {
+        const size_t descriptors_size = m_meshlets.size() * sizeof(DasMeshlet);
+        const size_t vertices_size = m_meshlet_vertices.size() * sizeof(uint32_t);
+        std::memcpy(_dst, m_meshlets.data(), descriptors_size);
+        std::memcpy(_dst + descriptors_size, m_meshlet_vertices.data(), vertices_size);
+        std::memcpy(_dst + descriptors_size + vertices_size, m_meshlet_triangles.data(), m_meshlet_triangles.size());
+
+        // padding
+        const size_t written = descriptors_size + vertices_size + m_meshlet_triangles.size();
+        std::memset(_dst + written, 0, GetSerializedSize() - written);
+    }
+}
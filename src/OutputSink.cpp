@@ -0,0 +1,102 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: OutputSink.cpp - DAS writer output sink classes implementation
+// author: Karl-Mihkel Ott
+
+#define OUTPUT_SINK_CPP
+#include "das/OutputSink.h"
+
+namespace Libdas {
+
+    // **** OutputSink **** //
+    bool OutputSink::WriteVectored(const std::pair<const char*, size_t> *_fragments, size_t _count) {
+        for(size_t i = 0; i < _count; i++) {
+            if(!Write(_fragments[i].first, _fragments[i].second))
+                return false;
+        }
+
+        return true;
+    }
+
+
+    bool OutputSink::CopyFrom(const RandomAccessFile &_src, uint64_t _offset, size_t _len) {
+        std::vector<char> buf(std::min(_len, static_cast<size_t>(LIBDAS_OUTPUT_SINK_COPY_BUFFER_SIZE)));
+        while(_len) {
+            const size_t len = std::min(_len, buf.size());
+            if(!_src.Read(_offset, buf.data(), len) || !Write(buf.data(), len))
+                return false;
+
+            _offset += static_cast<uint64_t>(len);
+            _len -= len;
+        }
+
+        return true;
+    }
+
+
+    // **** MemorySink **** //
+    MemorySink::MemorySink(size_t _reserve) {
+        m_image.reserve(_reserve);
+    }
+
+
+    bool MemorySink::Write(const char *_data, size_t _len) {
+        m_image.insert(m_image.end(), _data, _data + _len);
+        return true;
+    }
+
+
+    bool MemorySink::WriteAt(uint64_t _offset, const char *_data, size_t _len) {
+        if(_offset + _len > static_cast<uint64_t>(m_image.size()))
+            return false;
+
+        std::memcpy(m_image.data() + _offset, _data, _len);
+        return true;
+    }
+
+
+    bool MemorySink::CopyFrom(const RandomAccessFile &_src, uint64_t _offset, size_t _len) {
+        // file data is read directly into the image
+        const size_t beg = m_image.size();
+        m_image.resize(beg + _len);
+        if(!_src.Read(_offset, m_image.data() + beg, _len)) {
+            m_image.resize(beg);
+            return false;
+        }
+
+        return true;
+    }
+
+
+    void MemorySink::Preallocate(uint64_t _size) {
+        m_image.reserve(static_cast<size_t>(_size));
+    }
+
+
+    std::vector<char> MemorySink::ReleaseImage() {
+        std::vector<char> image(std::move(m_image));
+        m_image.clear();
+        return image;
+    }
+
+
+    // **** CallbackSink **** //
+    CallbackSink::CallbackSink(const WriteCallback &_callback) : m_callback(_callback) {}
+
+
+    bool CallbackSink::Write(const char *_data, size_t _len) {
+        if(!m_callback(m_size, _data, _len))
+            return false;
+
+        m_size += static_cast<uint64_t>(_len);
+        return true;
+    }
+
+
+    bool CallbackSink::WriteAt(uint64_t _offset, const char *_data, size_t _len) {
+        if(_offset + _len > m_size)
+            return false;
+
+        return m_callback(_offset, _data, _len);
+    }
+}
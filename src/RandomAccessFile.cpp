@@ -0,0 +1,63 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: RandomAccessFile.cpp - positional file reader class implementation
+// author: Karl-Mihkel Ott
+
+#define RANDOM_ACCESS_FILE_CPP
+#include "das/RandomAccessFile.h"
+
+namespace Libdas {
+
+    RandomAccessFile::RandomAccessFile(const std::string &_file_name) : m_file_name(_file_name) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(m_file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+        if(file == INVALID_HANDLE_VALUE) {
+            std::cerr << "Could not open file " << m_file_name << " for reading" << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+        }
+        m_file_handle = file;
+#else
+        m_fd = open(m_file_name.c_str(), O_RDONLY);
+        if(m_fd == -1) {
+            std::cerr << "Could not open file " << m_file_name << " for reading" << std::endl;
+            EXIT_ON_ERROR(LIBDAS_ERROR_INVALID_FILE);
+        }
+#endif
+    }
+
+
+    RandomAccessFile::~RandomAccessFile() {
+#ifdef _WIN32
+        if(m_file_handle) CloseHandle(reinterpret_cast<HANDLE>(m_file_handle));
+#else
+        if(m_fd != -1) close(m_fd);
+#endif
+    }
+
+
+    bool RandomAccessFile::Read(uint64_t _offset, char *_dst, size_t _len) const {
+        while(_len) {
+#ifdef _WIN32
+            OVERLAPPED ov = {};
+            ov.Offset = static_cast<DWORD>(_offset & 0xffffffff);
+            ov.OffsetHigh = static_cast<DWORD>(_offset >> 32);
+
+            DWORD len = _len > 0x40000000 ? 0x40000000 : static_cast<DWORD>(_len);
+            DWORD rd = 0;
+            if(!ReadFile(reinterpret_cast<HANDLE>(m_file_handle), _dst, len, &rd, &ov) || !rd)
+                return false;
+#else
+            ssize_t rd = pread(m_fd, _dst, _len, static_cast<off_t>(_offset));
+            if(rd == -1 && errno == EINTR)
+                continue;
+            else if(rd <= 0)
+                return false;
+#endif
+            _dst += rd;
+            _offset += static_cast<uint64_t>(rd);
+            _len -= static_cast<size_t>(rd);
+        }
+
+        return true;
+    }
+}
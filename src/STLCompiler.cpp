@@ -11,6 +11,9 @@ namespace Libdas {
     STLCompiler::STLCompiler(const std::string &_out_file) : DasWriterCore(_out_file) {}
 
 
+    STLCompiler::STLCompiler(const std::shared_ptr<OutputSink> &_sink) : DasWriterCore(_sink) {}
+
+
     STLCompiler::STLCompiler(std::vector<STLObject> &_objects, DasProperties &_props, std::string &_out_file) {
         Compile(_objects, _props, _out_file);
     }
@@ -41,6 +44,26 @@ namespace Libdas {
     }
 
 
+    void STLCompiler::_OptimizeVertices() {
+        MeshOptimizer optimizer(m_indices.data(), static_cast<uint32_t>(m_indices.size()), static_cast<uint32_t>(m_unique_positions.size()));
+        optimizer.OptimizeVertexCache();
+
+        const std::vector<uint32_t> remap = optimizer.OptimizeVertexFetch();
+        MeshOptimizer::RemapVertices(m_unique_positions, remap);
+        MeshOptimizer::RemapVertices(m_unique_normals, remap);
+    }
+
+
+    void STLCompiler::_BuildMeshlets() {
+        MeshletBuilder builder(m_indices.data(), static_cast<uint32_t>(m_indices.size()), m_unique_positions.data(), static_cast<uint32_t>(m_unique_positions.size()));
+        builder.Build(0);
+
+        m_meshlet_count = builder.GetMeshletCount();
+        m_meshlet_data.resize(builder.GetSerializedSize());
+        builder.Serialize(m_meshlet_data.data());
+    }
+
+
     DasBuffer STLCompiler::_CreateBuffers() {
         // - position vertices memory area
         // - normal vertices memory area
@@ -80,6 +103,13 @@ namespace Libdas {
             // vertex normals
             prim.vertex_normal_buffer_id = 0;
             prim.vertex_normal_buffer_offset = pos_size;
+            prim.bounds = m_bounds;
+
+            // meshlets
+            if(m_meshlet_count) {
+                prim.meshlet_buffer_id = 1;
+                prim.meshlet_count = m_meshlet_count;
+            }
 
             primitives.emplace_back(prim);
         }
@@ -91,6 +121,7 @@ namespace Libdas {
     DasMesh STLCompiler::_CreateMesh(uint32_t _primitive_count) {
         DasMesh mesh;
         mesh.primitive_count = _primitive_count;
+        mesh.bounds = m_bounds;
         mesh.primitives = new uint32_t[_primitive_count];
 
         for(uint32_t i = 0; i < _primitive_count; i++)
@@ -112,6 +143,7 @@ namespace Libdas {
         scene.node_count = 1;
         scene.nodes = new uint32_t[1];
         scene.nodes[0] = 0;
+        scene.bounds = m_bounds;
         
         WriteScene(scene);
     }
@@ -124,14 +156,27 @@ namespace Libdas {
 
         InitialiseFile(_props);
         _IndexVertices(_objects);
+        if(m_optimize_meshes)
+            _OptimizeVertices();
+        if(m_build_meshlets)
+            _BuildMeshlets();
+        m_bounds = Bounds::FindPositionBounds(reinterpret_cast<const char*>(m_unique_positions.data()), sizeof(TRS::Point3D<float>), 
+                                              static_cast<uint32_t>(m_unique_positions.size()));
 
         // write all buffers to the file
         DasBuffer buf(_CreateBuffers());
         WriteBuffer(buf);
 
+        if(m_meshlet_count) {
+            DasBuffer meshlet_buffer;
+            meshlet_buffer.type = LIBDAS_BUFFER_TYPE_MESHLET;
+            meshlet_buffer.data_len = static_cast<uint32_t>(m_meshlet_data.size());
+            meshlet_buffer.data_ptrs.push_back(std::make_pair(m_meshlet_data.data(), m_meshlet_data.size()));
+            WriteBuffer(meshlet_buffer);
+        }
+
         std::vector<DasMeshPrimitive> mesh_primitives(_CreateMeshPrimitives(_objects));
-        for(DasMeshPrimitive &prim : mesh_primitives)
-            WriteMeshPrimitive(prim);
+        WriteMeshPrimitives(mesh_primitives);
 
         // write mesh object to the file
         WriteMesh(_CreateMesh(static_cast<uint32_t>(mesh_primitives.size())));
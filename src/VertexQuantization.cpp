@@ -0,0 +1,94 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: VertexQuantization.cpp - vertex attribute quantization functions implementation
+// author: Karl-Mihkel Ott
+
+#define VERTEX_QUANTIZATION_CPP
+#include "das/VertexQuantization.h"
+
+namespace Libdas {
+
+    namespace Quantization {
+
+        static inline int16_t _EncodeSnorm16(float _value) {
+            return static_cast<int16_t>(std::round(std::clamp(_value, -1.0f, 1.0f) * 32767.0f));
+        }
+
+
+        static inline float _SignNotZero(float _value) {
+            return _value >= 0.0f ? 1.0f : -1.0f;
+        }
+
+
+        uint16_t EncodeUnorm16(float _value, float _offset, float _scale) {
+            const float norm = std::clamp((_value - _offset) / _scale, 0.0f, 1.0f);
+            return static_cast<uint16_t>(std::round(norm * 65535.0f));
+        }
+
+
+        float DecodeUnorm16(uint16_t _value, float _offset, float _scale) {
+            return _offset + static_cast<float>(_value) / 65535.0f * _scale;
+        }
+
+
+        float FindScale(float _min, float _max) {
+            return _max > _min ? _max - _min : 1.0f;
+        }
+
+
+        TRS::Vector2<int16_t> EncodeOctahedral(const TRS::Vector3<float> &_dir) {
+            const float l1 = std::fabs(_dir.first) + std::fabs(_dir.second) + std::fabs(_dir.third);
+            if(l1 == 0.0f)
+                return TRS::Vector2<int16_t>(0, 0);
+
+            // project onto the octahedron and fold the lower hemisphere over the diagonals
+            float x = _dir.first / l1;
+            float y = _dir.second / l1;
+            if(_dir.third < 0.0f) {
+                const float fx = (1.0f - std::fabs(y)) * _SignNotZero(x);
+                const float fy = (1.0f - std::fabs(x)) * _SignNotZero(y);
+                x = fx;
+                y = fy;
+            }
+
+            return TRS::Vector2<int16_t>(_EncodeSnorm16(x), _EncodeSnorm16(y));
+        }
+
+
+        TRS::Vector3<float> DecodeOctahedral(const TRS::Vector2<int16_t> &_oct) {
+            float x = std::max(static_cast<float>(_oct.first) / 32767.0f, -1.0f);
+            float y = std::max(static_cast<float>(_oct.second) / 32767.0f, -1.0f);
+            const float z = 1.0f - std::fabs(x) - std::fabs(y);
+
+            // unfold the lower hemisphere
+            const float t = std::max(-z, 0.0f);
+            x += x >= 0.0f ? -t : t;
+            y += y >= 0.0f ? -t : t;
+
+            const float len = std::sqrt(x * x + y * y + z * z);
+            return TRS::Vector3<float>(x / len, y / len, z / len);
+        }
+
+
+        TRS::Vector4<uint8_t> EncodeJointWeights(const TRS::Vector4<float> &_weights) {
+            const float w[4] = { _weights.first, _weights.second, _weights.third, _weights.fourth };
+            const float sum = w[0] + w[1] + w[2] + w[3];
+            int32_t q[4] = {};
+            int32_t qsum = 0;
+            uint32_t max_id = 0;
+
+            for(uint32_t i = 0; i < 4; i++) {
+                const float norm = sum > 0.0f ? std::clamp(w[i] / sum, 0.0f, 1.0f) : (i ? 0.0f : 1.0f);
+                q[i] = static_cast<int32_t>(std::round(norm * 255.0f));
+                qsum += q[i];
+                if(q[i] > q[max_id])
+                    max_id = i;
+            }
+
+            // rounding error is corrected on the most influential joint
+            q[max_id] = std::clamp(q[max_id] + 255 - qsum, 0, 255);
+            return TRS::Vector4<uint8_t>(static_cast<uint8_t>(q[0]), static_cast<uint8_t>(q[1]),
+                                         static_cast<uint8_t>(q[2]), static_cast<uint8_t>(q[3]));
+        }
+    }
+}
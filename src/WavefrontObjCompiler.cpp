@@ -11,6 +11,10 @@ namespace Libdas {
 
     WavefrontObjCompiler::WavefrontObjCompiler(const std::string &_out_file) : 
         DasWriterCore(_out_file) {}
+
+
+    WavefrontObjCompiler::WavefrontObjCompiler(const std::shared_ptr<OutputSink> &_sink) :
+        DasWriterCore(_sink) {}
     
 
     WavefrontObjCompiler::WavefrontObjCompiler(WavefrontObjData &_data, const DasProperties &_props, const std::string &_out_file,
@@ -28,7 +32,7 @@ namespace Libdas {
         //  - Vertex normal data
         //  - Vertex indices data
         std::vector<DasBuffer> buffers(1);
-        buffers.reserve(1 + _embedded_textures.size());
+        buffers.reserve(2 + _embedded_textures.size());
 
         buffers.back().type = LIBDAS_BUFFER_TYPE_VERTEX | LIBDAS_BUFFER_TYPE_INDICES;
         buffers.back().data_len = static_cast<uint32_t>(m_unique_pos.size() * sizeof(TRS::Point3D<float>));
@@ -60,6 +64,14 @@ namespace Libdas {
             buffers.back().data_ptrs.push_back(std::make_pair(data, size));
         }
 
+        if(m_meshlet_data.size()) {
+            m_meshlet_buffer_id = static_cast<uint32_t>(buffers.size());
+            buffers.emplace_back();
+            buffers.back().type = LIBDAS_BUFFER_TYPE_MESHLET;
+            buffers.back().data_len = static_cast<uint32_t>(m_meshlet_data.size());
+            buffers.back().data_ptrs.push_back(std::make_pair(m_meshlet_data.data(), m_meshlet_data.size()));
+        }
+
         return buffers;
     }
 
@@ -97,6 +109,16 @@ namespace Libdas {
 
                 primitives.back().index_buffer_id = buffer_id;
                 primitives.back().index_buffer_offset = base_index_offset + m_indices_offsets_per_group[i];
+
+                const uint32_t *group_indices = m_indices.data() + m_indices_offsets_per_group[i] / sizeof(uint32_t);
+                primitives.back().bounds = Bounds::FindIndexedPositionBounds(m_unique_pos.data(), static_cast<uint32_t>(m_unique_pos.size()), 
+                                                                             group_indices, _data.groups[i].indices.indices_count);
+
+                if(m_meshlet_buffer_id != UINT32_MAX && m_meshlet_counts_per_group[i]) {
+                    primitives.back().meshlet_buffer_id = m_meshlet_buffer_id;
+                    primitives.back().meshlet_buffer_offset = m_meshlet_offsets_per_group[i];
+                    primitives.back().meshlet_count = m_meshlet_counts_per_group[i];
+                }
             }
         }
 
@@ -121,6 +143,9 @@ namespace Libdas {
             meshes[type_mask].primitives[meshes[type_mask].primitive_count++] = static_cast<uint32_t>(it - _primitives.begin());
         }
 
+        for(auto it = meshes.begin(); it != meshes.end(); it++)
+            it->bounds = Bounds::FindMeshBounds(*it, _primitives);
+
         return meshes;
     }
 
@@ -144,6 +169,10 @@ namespace Libdas {
         scene.name = "Imported from Wavefront Obj";
         scene.node_count = 1;
 
+        // all nodes use identity transforms, thus mesh bounds are already in world space
+        for(size_t i = 0; i < _meshes.size(); i++)
+            Bounds::Merge(scene.bounds, _meshes[i].bounds);
+
         scene.nodes = new uint32_t[_meshes.size()];
         for(size_t i = 0; i < _meshes.size(); i++) {
             scene.nodes[i] = static_cast<uint32_t>(i);
@@ -246,6 +275,77 @@ namespace Libdas {
     }
 
 
+    void WavefrontObjCompiler::_DeduplicateIndices(const WavefrontObjData &_data) {
+        // regions point into the original index array, which is kept alive until all groups are processed
+        std::vector<uint32_t> indices;
+        indices.reserve(m_indices.size());
+        BufferDeduplicator dedup;
+        std::unordered_map<uint32_t, size_t> group_offsets;
+
+        m_index_source_groups.resize(_data.groups.size());
+        for(size_t i = 0; i < _data.groups.size(); i++) {
+            const char *data = reinterpret_cast<const char*>(m_indices.data()) + m_indices_offsets_per_group[i];
+            const size_t len = _data.groups[i].indices.indices_count * sizeof(uint32_t);
+            const uint32_t offset = static_cast<uint32_t>(indices.size() * sizeof(uint32_t));
+            const uint32_t new_offset = dedup.FindOrInsert(data, len, offset);
+
+            m_index_source_groups[i] = i;
+            m_indices_offsets_per_group[i] = new_offset;
+            if(new_offset == offset) {
+                if(len)
+                    group_offsets[offset] = i;
+                indices.insert(indices.end(), reinterpret_cast<const uint32_t*>(data), reinterpret_cast<const uint32_t*>(data + len));
+            } else {
+                m_index_source_groups[i] = group_offsets[new_offset];
+            }
+        }
+
+        m_indices = std::move(indices);
+    }
+
+
+    void WavefrontObjCompiler::_OptimizeVertices(const WavefrontObjData &_data) {
+        const uint32_t vertex_count = static_cast<uint32_t>(m_unique_pos.size());
+        for(size_t i = 0; i < _data.groups.size(); i++) {
+            // shared index ranges are optimized once
+            if(i < m_index_source_groups.size() && m_index_source_groups[i] != i)
+                continue;
+
+            uint32_t *group_indices = m_indices.data() + m_indices_offsets_per_group[i] / sizeof(uint32_t);
+            MeshOptimizer optimizer(group_indices, _data.groups[i].indices.indices_count, vertex_count);
+            optimizer.OptimizeVertexCache();
+        }
+
+        // groups share unique vertices, thus vertices are renumbered once over all group indices
+        MeshOptimizer optimizer(m_indices.data(), static_cast<uint32_t>(m_indices.size()), vertex_count);
+        const std::vector<uint32_t> remap = optimizer.OptimizeVertexFetch();
+        MeshOptimizer::RemapVertices(m_unique_pos, remap);
+        MeshOptimizer::RemapVertices(m_unique_uv, remap);
+        MeshOptimizer::RemapVertices(m_unique_normals, remap);
+    }
+
+
+    void WavefrontObjCompiler::_BuildMeshlets(const WavefrontObjData &_data) {
+        for(size_t i = 0; i < _data.groups.size(); i++) {
+            // groups with shared index ranges share their meshlets as well
+            if(i < m_index_source_groups.size() && m_index_source_groups[i] != i) {
+                m_meshlet_offsets_per_group.push_back(m_meshlet_offsets_per_group[m_index_source_groups[i]]);
+                m_meshlet_counts_per_group.push_back(m_meshlet_counts_per_group[m_index_source_groups[i]]);
+                continue;
+            }
+
+            const uint32_t *group_indices = m_indices.data() + m_indices_offsets_per_group[i] / sizeof(uint32_t);
+            MeshletBuilder builder(group_indices, _data.groups[i].indices.indices_count, m_unique_pos.data(), static_cast<uint32_t>(m_unique_pos.size()));
+            builder.Build(0);
+
+            m_meshlet_offsets_per_group.push_back(static_cast<uint32_t>(m_meshlet_data.size()));
+            m_meshlet_counts_per_group.push_back(builder.GetMeshletCount());
+            m_meshlet_data.resize(m_meshlet_data.size() + builder.GetSerializedSize());
+            builder.Serialize(m_meshlet_data.data() + m_meshlet_offsets_per_group.back());
+        }
+    }
+
+
     void WavefrontObjCompiler::Compile(WavefrontObjData &_data, const DasProperties &_props, const std::string &_out_file, 
                                        const std::vector<std::string> &_embedded_textures) {
         // open a new file if specified
@@ -257,17 +357,21 @@ namespace Libdas {
         // some indexing method call here
         _TriangulateFaces(_data);
         _ReindexFaces(_data);
+        if(m_deduplicate_buffers)
+            _DeduplicateIndices(_data);
+        if(m_optimize_meshes)
+            _OptimizeVertices(_data);
+        if(m_build_meshlets)
+            _BuildMeshlets(_data);
         // end of some indexing method call
 
         // write all buffers to the output file
         std::vector<DasBuffer> buffers(_CreateBuffers(_embedded_textures));
-        for(const DasBuffer &buffer : buffers)
-            WriteBuffer(buffer);
+        WriteBuffers(buffers);
 
         // write all given models to the output file
         std::vector<DasMeshPrimitive> primitives(_CreateMeshPrimitives(_data));
-        for(DasMeshPrimitive &prim : primitives)
-            WriteMeshPrimitive(prim);
+        WriteMeshPrimitives(primitives);
 
         std::vector<DasMesh> meshes(_CreateMeshes(primitives));
         for(DasMesh &mesh : meshes) {
@@ -0,0 +1,164 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: BoundingVolumesTest.cpp - bounding volume calculation functions test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <iostream>
+
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "das/Api.h"
+#include "das/DasStructures.h"
+#include "das/BoundingVolumes.h"
+
+#include "TestUtils.h"
+
+#define EPSILON 1e-4f
+
+
+static bool IsClose(float _a, float _b) {
+    return std::fabs(_a - _b) <= EPSILON * std::max(1.0f, std::fabs(_b));
+}
+
+
+static bool IsClose(const TRS::Point3D<float> &_a, float _x, float _y, float _z) {
+    return IsClose(_a.x, _x) && IsClose(_a.y, _y) && IsClose(_a.z, _z);
+}
+
+
+static bool SphereContains(const Libdas::DasBoundingVolume &_bounds, float _x, float _y, float _z) {
+    const float dx = _x - _bounds.center.x, dy = _y - _bounds.center.y, dz = _z - _bounds.center.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz) <= _bounds.radius + EPSILON;
+}
+
+
+static bool BoxContains(const Libdas::DasBoundingVolume &_bounds, const Libdas::DasBoundingVolume &_inner) {
+    return _bounds.min.x <= _inner.min.x + EPSILON && _bounds.min.y <= _inner.min.y + EPSILON && _bounds.min.z <= _inner.min.z + EPSILON &&
+           _bounds.max.x >= _inner.max.x - EPSILON && _bounds.max.y >= _inner.max.y - EPSILON && _bounds.max.z >= _inner.max.z - EPSILON;
+}
+
+
+static bool SphereContains(const Libdas::DasBoundingVolume &_bounds, const Libdas::DasBoundingVolume &_inner) {
+    const float dx = _inner.center.x - _bounds.center.x, dy = _inner.center.y - _bounds.center.y, dz = _inner.center.z - _bounds.center.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz) + _inner.radius <= _bounds.radius + EPSILON;
+}
+
+
+static void TestPositionBounds() {
+    // positions are interleaved with a fourth float, that must never be read as a coordinate
+    const float stream[] = {
+        1.0f, 2.0f, 3.0f, 100.0f,
+        -1.0f, 0.0f, 5.0f, -100.0f,
+        0.5f, -4.0f, 4.0f, 100.0f,
+        0.0f, 1.0f, 3.5f, -100.0f,
+        0.0f, 0.0f, 4.0f, 100.0f,
+        0.25f, 0.5f, 4.5f, -100.0f
+    };
+    const uint32_t count = sizeof(stream) / (4 * sizeof(float));
+
+    const Libdas::DasBoundingVolume bounds = Libdas::Bounds::FindPositionBounds(reinterpret_cast<const char*>(stream), 4 * sizeof(float), count);
+    Check(IsClose(bounds.min, -1.0f, -4.0f, 3.0f), "position bounds minimum");
+    Check(IsClose(bounds.max, 1.0f, 2.0f, 5.0f), "position bounds maximum");
+    Check(IsClose(bounds.center, 0.0f, -1.0f, 4.0f), "position bounds center");
+    for(uint32_t i = 0; i < count; i++)
+        Check(SphereContains(bounds, stream[i * 4], stream[i * 4 + 1], stream[i * 4 + 2]), "bounding sphere contains all positions");
+
+    Check(Libdas::Bounds::FindPositionBounds(reinterpret_cast<const char*>(stream), 4 * sizeof(float), 0).IsEmpty(), "empty stream has empty bounds");
+
+    // only referenced positions contribute to indexed bounds
+    const TRS::Point3D<float> positions[] = { {0.0f, 0.0f, 0.0f}, {10.0f, 10.0f, 10.0f}, {1.0f, 1.0f, 1.0f}, {-1.0f, 2.0f, 0.0f} };
+    const uint32_t indices[] = { 0, 2, 3, 3, 2, 0 };
+    const Libdas::DasBoundingVolume indexed = Libdas::Bounds::FindIndexedPositionBounds(positions, 4, indices, 6);
+    Check(IsClose(indexed.min, -1.0f, 0.0f, 0.0f) && IsClose(indexed.max, 1.0f, 2.0f, 1.0f), "indexed bounds skip unreferenced positions");
+}
+
+
+static void TestMerge() {
+    const Libdas::DasBoundingVolume a = Libdas::Bounds::FromMinMax({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f});
+    const Libdas::DasBoundingVolume b = Libdas::Bounds::FromMinMax({4.0f, -2.0f, 0.5f}, {5.0f, -1.0f, 3.0f});
+    const Libdas::DasBoundingVolume inner = Libdas::Bounds::FromMinMax({0.25f, 0.25f, 0.25f}, {0.5f, 0.5f, 0.5f});
+
+    Check(IsClose(a.center, 0.5f, 0.5f, 0.5f) && IsClose(a.radius, 0.5f * std::sqrt(3.0f)), "bounding sphere from box extents encloses the box");
+
+    Libdas::DasBoundingVolume merged;
+    Libdas::Bounds::Merge(merged, a);
+    Check(IsClose(merged.min, 0.0f, 0.0f, 0.0f) && IsClose(merged.max, 1.0f, 1.0f, 1.0f) && IsClose(merged.radius, a.radius), "merging into empty bounds copies the bounds");
+
+    Libdas::Bounds::Merge(merged, Libdas::DasBoundingVolume());
+    Check(IsClose(merged.radius, a.radius), "merging empty bounds changes nothing");
+
+    Libdas::Bounds::Merge(merged, b);
+    Check(IsClose(merged.min, 0.0f, -2.0f, 0.0f) && IsClose(merged.max, 5.0f, 1.0f, 3.0f), "merged box is the union of both boxes");
+    Check(BoxContains(merged, a) && BoxContains(merged, b), "merged box encloses both boxes");
+    Check(SphereContains(merged, a) && SphereContains(merged, b), "merged sphere encloses both spheres");
+
+    Libdas::DasBoundingVolume contained = a;
+    Libdas::Bounds::Merge(contained, inner);
+    Check(IsClose(contained.center, 0.5f, 0.5f, 0.5f) && IsClose(contained.radius, a.radius), "merging enclosed bounds keeps the sphere");
+}
+
+
+static void TestTransform() {
+    const Libdas::DasBoundingVolume bounds = Libdas::Bounds::FromMinMax({-1.0f, -2.0f, -3.0f}, {1.0f, 2.0f, 3.0f});
+
+    // scale by 2 and translate
+    const TRS::Matrix4<float> scale = {
+        { 2.0f, 0.0f, 0.0f, 10.0f },
+        { 0.0f, 2.0f, 0.0f, 20.0f },
+        { 0.0f, 0.0f, 2.0f, 30.0f },
+        { 0.0f, 0.0f, 0.0f, 1.0f }
+    };
+    const Libdas::DasBoundingVolume scaled = Libdas::Bounds::Transform(bounds, scale);
+    Check(IsClose(scaled.min, 8.0f, 16.0f, 24.0f) && IsClose(scaled.max, 12.0f, 24.0f, 36.0f), "scaled and translated box");
+    Check(IsClose(scaled.center, 10.0f, 20.0f, 30.0f) && IsClose(scaled.radius, bounds.radius * 2.0f), "scaled and translated sphere");
+
+    // rotate by 90 degrees around z axis, which swaps x and y extents
+    const TRS::Matrix4<float> rotation = {
+        { 0.0f, -1.0f, 0.0f, 0.0f },
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f, 0.0f },
+        { 0.0f, 0.0f, 0.0f, 1.0f }
+    };
+    const Libdas::DasBoundingVolume rotated = Libdas::Bounds::Transform(bounds, rotation);
+    Check(IsClose(rotated.min, -2.0f, -1.0f, -3.0f) && IsClose(rotated.max, 2.0f, 1.0f, 3.0f), "rotated box");
+    Check(IsClose(rotated.radius, bounds.radius), "rotation keeps the sphere radius");
+
+    // rotating by 45 degrees must enclose all rotated box corners
+    const float c = std::sqrt(0.5f);
+    const TRS::Matrix4<float> diagonal = {
+        { c, -c, 0.0f, 0.0f },
+        { c, c, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f, 0.0f },
+        { 0.0f, 0.0f, 0.0f, 1.0f }
+    };
+    const Libdas::DasBoundingVolume diag = Libdas::Bounds::Transform(bounds, diagonal);
+    for(uint32_t i = 0; i < 8; i++) {
+        const float x = (i & 1) ? 1.0f : -1.0f, y = (i & 2) ? 2.0f : -2.0f, z = (i & 4) ? 3.0f : -3.0f;
+        const float tx = c * x - c * y, ty = c * x + c * y;
+        Check(tx >= diag.min.x - EPSILON && tx <= diag.max.x + EPSILON && ty >= diag.min.y - EPSILON && ty <= diag.max.y + EPSILON &&
+              z >= diag.min.z - EPSILON && z <= diag.max.z + EPSILON, "transformed box encloses rotated corners");
+        Check(SphereContains(diag, tx, ty, z), "transformed sphere encloses rotated corners");
+    }
+
+    Check(Libdas::Bounds::Transform(Libdas::DasBoundingVolume(), scale).IsEmpty(), "transformed empty bounds stay empty");
+}
+
+
+int main() {
+    TestPositionBounds();
+    TestMerge();
+    TestTransform();
+
+    return ReportChecks("bounding volume");
+}
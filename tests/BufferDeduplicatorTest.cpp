@@ -0,0 +1,131 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: BufferDeduplicatorTest.cpp - BufferDeduplicator class and HashFunc64 function test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <iostream>
+
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "das/Api.h"
+#include "das/Hash.h"
+#include "das/DasStructures.h"
+#include "das/BufferDeduplicator.h"
+
+#include "TestUtils.h"
+
+// same constants as used by HashFunc64()
+#define TEST_PRIME64_1      0x9E3779B185EBCA87ULL
+#define TEST_PRIME64_2      0xC2B2AE3D27D4EB4FULL
+#define TEST_PRIME64_3      0x165667B19E3779F9ULL
+
+
+static uint64_t Rotl64(uint64_t _x, uint32_t _r) {
+    return (_x << _r) | (_x >> (64 - _r));
+}
+
+
+// multiplicative inverse of an odd number modulo 2^64 with Newton's iteration
+static uint64_t InverseOdd(uint64_t _a) {
+    uint64_t x = _a;
+    for(uint32_t i = 0; i < 5; i++)
+        x *= 2 - _a * x;
+    return x;
+}
+
+
+// HashFunc64() mixes each 8 byte word into the key with a bijective function, thus a second word can be chosen so
+// that two 16 byte regions with different first words end up with the same key
+static void MakeCollision(const uint64_t _words[2], uint64_t _first_word, uint64_t _collision[2]) {
+    auto mix = [](uint64_t _word) { return Rotl64(_word * TEST_PRIME64_2, 31) * TEST_PRIME64_1; };
+    auto unmix = [](uint64_t _mixed) { return Rotl64(_mixed * InverseOdd(TEST_PRIME64_1), 33) * InverseOdd(TEST_PRIME64_2); };
+    auto round = [&](uint64_t _key, uint64_t _word) { return Rotl64(_key ^ mix(_word), 27) * TEST_PRIME64_1 + TEST_PRIME64_3; };
+
+    const uint64_t key = TEST_PRIME64_3 + 2 * sizeof(uint64_t) * TEST_PRIME64_1;
+    const uint64_t key1 = round(key, _words[0]);
+    const uint64_t key2 = round(key, _first_word);
+    _collision[0] = _first_word;
+    _collision[1] = unmix(key1 ^ key2 ^ mix(_words[1]));
+}
+
+
+static void TestHash() {
+    const std::string a = "deduplicated buffer region";
+    const std::string b = a;
+    std::string c = a;
+    c.back() = 'X';
+
+    Check(Libdas::HashFunc64(a.data(), a.size()) == Libdas::HashFunc64(b.data(), b.size()), "identical regions at different addresses hash equally");
+    Check(Libdas::HashFunc64(a.data(), a.size()) != Libdas::HashFunc64(c.data(), c.size()), "regions differing in the last byte hash differently");
+    Check(Libdas::HashFunc64(a.data(), a.size()) != Libdas::HashFunc64(a.data(), a.size() - 1), "region prefixes hash differently");
+}
+
+
+static void TestDeduplicate() {
+    const uint64_t a[2] = { 0x0123456789abcdefULL, 0xfedcba9876543210ULL };
+    const uint64_t a_copy[2] = { a[0], a[1] };
+    const uint64_t b = 0x1122334455667788ULL;
+    uint64_t collision[2];
+    MakeCollision(a, 0x0f0f0f0f0f0f0f0fULL, collision);
+
+    Check(std::memcmp(a, collision, sizeof(a)) != 0, "colliding region differs from the original region");
+    Check(Libdas::HashFunc64(reinterpret_cast<const char*>(a), sizeof(a)) == Libdas::HashFunc64(reinterpret_cast<const char*>(collision), sizeof(collision)),
+          "constructed regions have colliding hashes");
+
+    // original offsets: a 0, b 16, a_copy 24, empty 40, collision 40
+    Libdas::DasBuffer buffer;
+    buffer.data_ptrs.push_back(std::make_pair(const_cast<char*>(reinterpret_cast<const char*>(a)), sizeof(a)));
+    buffer.data_ptrs.push_back(std::make_pair(const_cast<char*>(reinterpret_cast<const char*>(&b)), sizeof(b)));
+    buffer.data_ptrs.push_back(std::make_pair(const_cast<char*>(reinterpret_cast<const char*>(a_copy)), sizeof(a_copy)));
+    buffer.data_ptrs.push_back(std::make_pair(nullptr, 0));
+    buffer.data_ptrs.push_back(std::make_pair(reinterpret_cast<char*>(collision), sizeof(collision)));
+    buffer.data_len = 56;
+    buffer._free_bit = false;
+
+    Libdas::BufferDeduplicator dedup;
+    dedup.Deduplicate(buffer);
+
+    Check(buffer.data_len == 40, "identical region is removed from the buffer");
+    Check(dedup.GetRemovedSize() == sizeof(a), "removed size equals the size of the identical region");
+    Check(buffer.data_ptrs.size() == 4, "unique, empty and colliding fragments are kept");
+    if(buffer.data_ptrs.size() == 4) {
+        Check(buffer.data_ptrs[0].first == reinterpret_cast<const char*>(a), "first occurrence of a region is kept");
+        Check(buffer.data_ptrs[3].first == reinterpret_cast<const char*>(collision), "region with colliding hash is never merged");
+    }
+
+    // offsets inside and on the boundaries of kept, removed and following fragments
+    Check(dedup.RemapOffset(0) == 0, "offset of the first fragment is unchanged");
+    Check(dedup.RemapOffset(15) == 15, "last byte of the first fragment is unchanged");
+    Check(dedup.RemapOffset(16) == 16, "offset of the second fragment is unchanged");
+    Check(dedup.RemapOffset(23) == 23, "last byte of the second fragment is unchanged");
+    Check(dedup.RemapOffset(24) == 0, "removed fragment points to its identical region");
+    Check(dedup.RemapOffset(30) == 6, "offset inside a removed fragment keeps its relative position");
+    Check(dedup.RemapOffset(39) == 15, "last byte of a removed fragment maps to the last byte of its identical region");
+    Check(dedup.RemapOffset(40) == 24, "fragment following an empty fragment is moved back");
+    Check(dedup.RemapOffset(55) == 39, "last byte of the buffer is moved back");
+
+    // regions at the same address need no comparison
+    Libdas::BufferDeduplicator shared;
+    Check(shared.FindOrInsert(reinterpret_cast<const char*>(a), sizeof(a), 0) == 0, "first region is inserted");
+    Check(shared.FindOrInsert(reinterpret_cast<const char*>(a), sizeof(a), 100) == 0, "region at the same address is found");
+    Check(shared.FindOrInsert(reinterpret_cast<const char*>(a), 0, 200) == 200, "empty regions are never deduplicated");
+    Check(shared.GetRemovedSize() == sizeof(a), "only the shared region is counted as removed");
+}
+
+
+int main() {
+    TestHash();
+    TestDeduplicate();
+
+    return ReportChecks("BufferDeduplicator");
+}
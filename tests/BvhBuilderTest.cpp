@@ -0,0 +1,148 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: BvhBuilderTest.cpp - BvhBuilder class test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <iostream>
+
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "das/Api.h"
+#include "das/DasStructures.h"
+#include "das/BoundingVolumes.h"
+#include "das/BvhBuilder.h"
+
+#include "TestUtils.h"
+
+// large enough to be split into parallel tasks
+#define ITEM_COUNT      10000
+#define MAX_LEAF_ITEMS  4
+
+
+static std::vector<Libdas::DasBoundingVolume> MakeItems(uint32_t _count) {
+    std::vector<Libdas::DasBoundingVolume> items(_count);
+    uint32_t state = 12345;
+    auto next = [&]() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) / static_cast<float>(1 << 24);
+    };
+
+    for(uint32_t i = 0; i < _count; i++) {
+        // every tenth item has no geometry and is left out of the hierarchy
+        if(i % 10 == 9)
+            continue;
+
+        const TRS::Point3D<float> min = { next() * 100.0f, next() * 100.0f, next() * 10.0f };
+        const TRS::Point3D<float> max = { min.x + next(), min.y + next(), min.z + next() };
+        items[i] = Libdas::Bounds::FromMinMax(min, max);
+    }
+
+    // a few identical items, whose centroids cannot be separated
+    for(uint32_t i = 0; i < 16 && i < _count; i++)
+        items[i] = Libdas::Bounds::FromMinMax({ 50.0f, 50.0f, 5.0f }, { 51.0f, 51.0f, 6.0f });
+    return items;
+}
+
+
+static bool Encloses(const Libdas::DasBvhNode &_node, const TRS::Point3D<float> &_min, const TRS::Point3D<float> &_max) {
+    return _node.min.x <= _min.x && _node.min.y <= _min.y && _node.min.z <= _min.z &&
+           _node.max.x >= _max.x && _node.max.y >= _max.y && _node.max.z >= _max.z;
+}
+
+
+// recursively verify the subtree, returns the index of the node following the subtree
+static uint32_t CheckSubtree(const std::vector<Libdas::DasBvhNode> &_nodes, const std::vector<uint32_t> &_items,
+                             const std::vector<Libdas::DasBoundingVolume> &_bounds, uint32_t _index, std::vector<uint32_t> &_visits) {
+    if(_index >= _nodes.size()) {
+        Check(false, "node index is inside the node array");
+        return static_cast<uint32_t>(_nodes.size());
+    }
+
+    const Libdas::DasBvhNode &node = _nodes[_index];
+    if(node.IsLeaf()) {
+        Check(node.item_count <= MAX_LEAF_ITEMS, "leaf item count does not exceed the limit");
+        Check(node.offset + node.item_count <= _items.size(), "leaf item range is inside the item array");
+        for(uint32_t i = node.offset; i < node.offset + node.item_count && i < _items.size(); i++) {
+            const Libdas::DasBoundingVolume &item = _bounds[_items[i]];
+            Check(Encloses(node, item.min, item.max), "leaf encloses its items");
+            _visits[_items[i]]++;
+        }
+        return _index + 1;
+    }
+
+    // first child follows its parent, offset points to the second child
+    const uint32_t first = _index + 1;
+    const uint32_t second = node.offset;
+    Check(second > first && second < _nodes.size(), "second child index is valid");
+    if(second <= first || second >= _nodes.size())
+        return static_cast<uint32_t>(_nodes.size());
+
+    Check(Encloses(node, _nodes[first].min, _nodes[first].max) && Encloses(node, _nodes[second].min, _nodes[second].max), "inner node encloses its children");
+    const uint32_t end = CheckSubtree(_nodes, _items, _bounds, first, _visits);
+    Check(end == second, "second child follows the subtree of the first child");
+    return CheckSubtree(_nodes, _items, _bounds, second, _visits);
+}
+
+
+static void TestHierarchy(const std::vector<Libdas::DasBoundingVolume> &_bounds, uint32_t _thread_count) {
+    Libdas::BvhBuilder builder(_bounds, MAX_LEAF_ITEMS);
+    builder.Build(_thread_count);
+
+    const std::vector<Libdas::DasBvhNode> &nodes = builder.GetNodes();
+    const std::vector<uint32_t> &items = builder.GetItems();
+    Check(!nodes.empty(), "hierarchy has nodes");
+    if(nodes.empty())
+        return;
+
+    std::vector<uint32_t> visits(_bounds.size(), 0);
+    Check(CheckSubtree(nodes, items, _bounds, 0, visits) == nodes.size(), "all nodes belong to the hierarchy");
+    for(size_t i = 0; i < _bounds.size(); i++) {
+        if(_bounds[i].IsEmpty())
+            Check(visits[i] == 0, "items without bounds are skipped");
+        else Check(visits[i] == 1, "every item is referenced by exactly one leaf");
+    }
+
+    Libdas::DasBvh bvh = builder.CreateBvh(3);
+    Check(bvh.scene == 3 && bvh.node_count == nodes.size() && bvh.item_count == items.size(), "BVH scope matches the built hierarchy");
+    Check(bvh.nodes && !std::memcmp(bvh.nodes, nodes.data(), nodes.size() * sizeof(Libdas::DasBvhNode)), "BVH scope nodes are copied");
+}
+
+
+static void TestDeterminism(const std::vector<Libdas::DasBoundingVolume> &_bounds) {
+    Libdas::BvhBuilder single(_bounds, MAX_LEAF_ITEMS);
+    single.Build(1);
+    Libdas::BvhBuilder multi(_bounds, MAX_LEAF_ITEMS);
+    multi.Build(0);
+
+    Check(single.GetItems() == multi.GetItems(), "item order does not depend on the thread count");
+    Check(single.GetNodes().size() == multi.GetNodes().size() &&
+          !std::memcmp(single.GetNodes().data(), multi.GetNodes().data(), single.GetNodes().size() * sizeof(Libdas::DasBvhNode)),
+          "nodes do not depend on the thread count");
+}
+
+
+int main() {
+    const std::vector<Libdas::DasBoundingVolume> bounds = MakeItems(ITEM_COUNT);
+    TestHierarchy(bounds, 1);
+    TestHierarchy(bounds, 0);
+    TestHierarchy(MakeItems(7), 1);
+    TestDeterminism(bounds);
+
+    // hierarchy without any items has no nodes
+    Libdas::BvhBuilder empty(std::vector<Libdas::DasBoundingVolume>(5), MAX_LEAF_ITEMS);
+    empty.Build();
+    Check(empty.GetNodes().empty() && empty.GetItems().empty(), "items without bounds produce no hierarchy");
+
+    return ReportChecks("BvhBuilder");
+}
@@ -0,0 +1,152 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasBlobStoreTest.cpp - DasBlobStore class test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+#include <unordered_map>
+
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "das/Api.h"
+#include "das/Hash.h"
+#include "das/RandomAccessFile.h"
+#include "das/MappedFile.h"
+#include "das/DasStructures.h"
+#include "das/DasBlobStore.h"
+
+#include "TestUtils.h"
+
+#define THREAD_COUNT    8
+
+
+static std::vector<char> MakeData(size_t _len, uint32_t _seed) {
+    std::vector<char> data(_len);
+    uint32_t state = _seed;
+    for(char &c : data) {
+        state = state * 1664525u + 1013904223u;
+        c = static_cast<char>(state >> 24);
+    }
+    return data;
+}
+
+
+// same layout as used by the store
+static std::string GetBlobPath(const std::string &_root, uint64_t _hash) {
+    char name[32] = {};
+    std::snprintf(name, sizeof(name), "%02x/%016llx.blob", static_cast<unsigned>(_hash >> 56), static_cast<unsigned long long>(_hash));
+    return _root + "/" + name;
+}
+
+
+static void TestRoundTrip(const std::string &_root) {
+    Libdas::DasBlobStore store(_root);
+    const std::vector<char> data = MakeData(100000, 1);
+
+    const uint64_t hash = store.Store(data.data(), data.size());
+    Check(hash != 0, "data is stored");
+    Check(std::filesystem::exists(GetBlobPath(_root, hash)), "blob file is created");
+    Check(store.Store(data.data(), data.size()) == hash, "storing identical data again returns the same hash");
+    Check(store.Store(data.data(), 0) == 0, "empty data is never stored");
+
+    std::shared_ptr<Libdas::MappedFile> blob = store.Acquire(hash, data.size());
+    Check(blob && blob->GetSize() == data.size() && !std::memcmp(blob->GetData(), data.data(), data.size()), "acquired blob contains stored data");
+    Check(store.Acquire(hash, data.size()) == blob, "mapped blobs are shared");
+    Check(!store.Acquire(hash, data.size() + 1), "blob with different length is not acquired");
+    Check(!store.Acquire(hash ^ 1, data.size()), "missing blob is not acquired");
+
+    Libdas::DasBuffer buffer;
+    buffer.blob_hash = hash;
+    buffer.data_len = static_cast<uint32_t>(data.size());
+    Check(store.Resolve(buffer), "buffer referencing a stored blob is resolved");
+    Check(buffer.data_ptrs.size() == 1 && buffer.data_ptrs[0].second == data.size() &&
+          !std::memcmp(buffer.data_ptrs[0].first, data.data(), data.size()), "resolved buffer points to blob data");
+    Check(buffer.blob == blob && !buffer._free_bit, "resolved buffer shares the blob mapping");
+
+    Libdas::DasBuffer embedded;
+    Check(store.Resolve(embedded) && embedded.data_ptrs.empty(), "buffer with embedded data is left as it is");
+
+    Libdas::DasBuffer missing;
+    missing.blob_hash = hash ^ 1;
+    missing.data_len = static_cast<uint32_t>(data.size());
+    Check(!store.Resolve(missing), "buffer referencing a missing blob is not resolved");
+}
+
+
+static void TestCollision(const std::string &_root) {
+    Libdas::DasBlobStore store(_root);
+    const std::vector<char> data = MakeData(4096, 2);
+    uint64_t hash = Libdas::HashFunc64(data.data(), data.size());
+    if(!hash) hash = 1;
+
+    // blob with the same hash but different content already occupies the path
+    const std::string path = GetBlobPath(_root, hash);
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+    {
+        const std::vector<char> other = MakeData(data.size(), 3);
+        std::ofstream file(path, std::ios::binary);
+        file.write(other.data(), other.size());
+    }
+    Check(store.Store(data.data(), data.size()) == 0, "data colliding with a different blob of the same length is not stored");
+
+    {
+        const std::vector<char> other = MakeData(data.size() / 2, 3);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(other.data(), other.size());
+    }
+    Libdas::DasBlobStore fresh_store(_root);
+    Check(fresh_store.Store(data.data(), data.size()) == 0, "data colliding with a different blob of another length is not stored");
+}
+
+
+static void TestConcurrentStore(const std::string &_root) {
+    Libdas::DasBlobStore store(_root);
+    const std::vector<char> data = MakeData(1 << 20, 4);
+
+    std::vector<uint64_t> hashes(THREAD_COUNT, 0);
+    std::vector<std::thread> threads;
+    for(uint32_t i = 0; i < THREAD_COUNT; i++)
+        threads.emplace_back([&, i]() { hashes[i] = store.Store(data.data(), data.size()); });
+    for(std::thread &thread : threads)
+        thread.join();
+
+    for(uint32_t i = 0; i < THREAD_COUNT; i++)
+        Check(hashes[i] != 0 && hashes[i] == hashes[0], "concurrent writers of the same data agree on the hash");
+
+    // staged files of writers that lost the race are removed
+    const std::string path = GetBlobPath(_root, hashes[0]);
+    uint32_t file_count = 0;
+    for(const auto &entry : std::filesystem::directory_iterator(std::filesystem::path(path).parent_path()))
+        file_count += entry.path().string().rfind(path, 0) == 0 ? 1 : 0;
+    Check(file_count == 1, "a single blob file is left after concurrent writes");
+
+    std::shared_ptr<Libdas::MappedFile> blob = store.Acquire(hashes[0], data.size());
+    Check(blob && !std::memcmp(blob->GetData(), data.data(), data.size()), "concurrently stored blob contains stored data");
+}
+
+
+int main() {
+    const std::string root = (std::filesystem::temp_directory_path() / "libdas_blob_store_test").string();
+    std::filesystem::remove_all(root);
+
+    TestRoundTrip(root);
+    TestCollision(root);
+    TestConcurrentStore(root);
+
+    std::filesystem::remove_all(root);
+    return ReportChecks("DasBlobStore");
+}
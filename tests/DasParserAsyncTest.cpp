@@ -0,0 +1,217 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasParserAsyncTest.cpp - DasParser streaming parse test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <any>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <cstdio>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "trs/Iterators.h"
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "mar/AsciiStreamReader.h"
+#include "mar/AsciiLineReader.h"
+
+#include "das/Api.h"
+#include "das/ErrorHandlers.h"
+#include "das/DasStructures.h"
+#include "das/MappedFile.h"
+#include "das/RandomAccessFile.h"
+#include "das/OutputSink.h"
+#include "das/FileWriter.h"
+#include "das/TextureReader.h"
+#include "das/DasWriterCore.h"
+#include "das/DasArena.h"
+#include "das/DasReaderCore.h"
+#include "das/DasParser.h"
+
+#include "TestUtils.h"
+
+#define TOC_FILE        "DasParserAsyncTest.das"
+#define NO_TOC_FILE     "DasParserAsyncTestNoToc.das"
+#define GROUP_COUNT     8
+
+
+// single emitted scope with the values it had during the callback
+struct EmittedScope {
+    Libdas::DasScopeType type;
+    uint32_t index;
+    std::string value;
+};
+
+
+static std::string PayloadOf(const Libdas::DasBuffer &_buffer) {
+    std::string data;
+    for(const std::pair<char*, size_t> &ptr : _buffer.data_ptrs)
+        data.append(ptr.first, ptr.second);
+    return data;
+}
+
+
+// scope types are interleaved in the file, thus sequential and table of contents order differ
+static void WriteModel(std::vector<Libdas::DasScopeType> &_file_order) {
+    Libdas::DasWriterCore writer(TOC_FILE);
+    writer.InitialiseFile(Libdas::DasProperties());
+
+    for(uint32_t i = 0; i < GROUP_COUNT; i++) {
+        std::vector<char> payload(16 + i * 40);
+        for(size_t j = 0; j < payload.size(); j++)
+            payload[j] = static_cast<char>(i * 17 + j);
+        Libdas::DasBuffer buffer;
+        buffer.type = LIBDAS_BUFFER_TYPE_VERTEX;
+        buffer.data_len = static_cast<uint32_t>(payload.size());
+        buffer.data_ptrs.push_back(std::make_pair(payload.data(), payload.size()));
+        buffer._free_bit = false;
+        writer.WriteBuffer(buffer);
+
+        Libdas::DasNode node;
+        node.name = "node" + std::to_string(i);
+        node.mesh = i;
+        writer.WriteNode(node);
+
+        Libdas::DasMeshPrimitive prim;
+        prim.index_buffer_id = i;
+        prim.draw_count = 3 * (i + 1);
+        prim.vertex_buffer_id = i;
+        writer.WriteMeshPrimitive(prim);
+
+        Libdas::DasMesh mesh;
+        mesh.name = "mesh" + std::to_string(i);
+        mesh.primitive_count = 1;
+        mesh.primitives = new uint32_t[1] { i };
+        writer.WriteMesh(mesh);
+
+        _file_order.insert(_file_order.end(), { Libdas::LIBDAS_DAS_SCOPE_BUFFER, Libdas::LIBDAS_DAS_SCOPE_NODE, 
+                                                Libdas::LIBDAS_DAS_SCOPE_MESH_PRIMITIVE, Libdas::LIBDAS_DAS_SCOPE_MESH });
+    }
+
+    writer.CloseStream();
+}
+
+
+// copy of the file, whose header does not reference the table of contents
+static void WriteNoTocCopy() {
+    std::vector<char> data;
+    {
+        std::ifstream file(TOC_FILE, std::ios_base::binary);
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    const uint64_t toc_offset = 0;
+    std::memcpy(data.data() + offsetof(Libdas::DasHeader, toc_offset), &toc_offset, sizeof(uint64_t));
+    std::ofstream file(NO_TOC_FILE, std::ios_base::binary);
+    file.write(data.data(), data.size());
+}
+
+
+static std::string ValueOf(Libdas::DasModel &_model, Libdas::DasScopeType _type, uint32_t _index) {
+    switch(_type) {
+        case Libdas::LIBDAS_DAS_SCOPE_BUFFER: return _index < _model.buffers.size() ? PayloadOf(_model.buffers[_index]) : "";
+        case Libdas::LIBDAS_DAS_SCOPE_MESH_PRIMITIVE: return _index < _model.mesh_primitives.size() ? std::to_string(_model.mesh_primitives[_index].draw_count) : "";
+        case Libdas::LIBDAS_DAS_SCOPE_MESH: return _index < _model.meshes.size() ? _model.meshes[_index].name : "";
+        case Libdas::LIBDAS_DAS_SCOPE_NODE: return _index < _model.nodes.size() ? _model.nodes[_index].name : "";
+        default: return "";
+    }
+}
+
+
+static bool HasTableOfContents(const std::string &_file_name) {
+    Libdas::DasReaderCore reader(_file_name, true);
+    reader.ReadSignature();
+    return reader.ReadTableOfContents();
+}
+
+
+static void TestParseAsync(const std::string &_file_name, const std::vector<Libdas::DasScopeType> &_expected_order, const std::string &_name) {
+    Libdas::DasParser sync_parser(_file_name, true);
+    sync_parser.Parse();
+    Libdas::DasModel &sync_model = sync_parser.GetModel();
+
+    std::vector<EmittedScope> emitted;
+    std::vector<std::pair<uint64_t, uint64_t>> progress;
+    Libdas::DasParseCallbacks callbacks;
+    callbacks.on_buffer = [&](const Libdas::DasBuffer &_buffer, uint32_t _index) { 
+        emitted.push_back({ Libdas::LIBDAS_DAS_SCOPE_BUFFER, _index, PayloadOf(_buffer) }); 
+    };
+    callbacks.on_mesh_primitive = [&](const Libdas::DasMeshPrimitive &_prim, uint32_t _index) { 
+        emitted.push_back({ Libdas::LIBDAS_DAS_SCOPE_MESH_PRIMITIVE, _index, std::to_string(_prim.draw_count) }); 
+    };
+    callbacks.on_mesh = [&](const Libdas::DasMesh &_mesh, uint32_t _index) { 
+        emitted.push_back({ Libdas::LIBDAS_DAS_SCOPE_MESH, _index, _mesh.name }); 
+    };
+    callbacks.on_node = [&](const Libdas::DasNode &_node, uint32_t _index) { 
+        emitted.push_back({ Libdas::LIBDAS_DAS_SCOPE_NODE, _index, _node.name }); 
+    };
+    callbacks.on_progress = [&](uint64_t _bytes_read, uint64_t _total) { 
+        progress.push_back(std::make_pair(_bytes_read, _total)); 
+    };
+
+    Libdas::DasParser async_parser(_file_name, true);
+    std::future<void> done = async_parser.ParseAsync(callbacks);
+    done.get();
+    Libdas::DasModel &async_model = async_parser.GetModel();
+
+    // every scope is emitted exactly once, in expected order and with the same values as the synchronous parse
+    Check(emitted.size() == _expected_order.size(), _name + " every parsed scope is emitted");
+    std::unordered_map<uint32_t, uint32_t> next_index;
+    bool is_ordered = true, is_equal = true;
+    for(size_t i = 0; i < emitted.size() && i < _expected_order.size(); i++) {
+        is_ordered = is_ordered && emitted[i].type == _expected_order[i] && emitted[i].index == next_index[emitted[i].type]++;
+        is_equal = is_equal && emitted[i].value == ValueOf(sync_model, emitted[i].type, emitted[i].index);
+    }
+    Check(is_ordered, _name + " scopes are emitted in expected order");
+    Check(is_equal, _name + " emitted scopes match the synchronous parse");
+
+    Check(async_model.buffers.size() == sync_model.buffers.size() && async_model.mesh_primitives.size() == sync_model.mesh_primitives.size() &&
+          async_model.meshes.size() == sync_model.meshes.size() && async_model.nodes.size() == sync_model.nodes.size(), 
+          _name + " asynchronously parsed model has the same scope counts as the synchronous parse");
+    bool is_model_equal = true;
+    for(const EmittedScope &scope : emitted)
+        is_model_equal = is_model_equal && ValueOf(async_model, scope.type, scope.index) == scope.value;
+    Check(is_model_equal, _name + " emitted scopes are stored in the model");
+
+    bool is_monotonic = !progress.empty();
+    for(size_t i = 1; i < progress.size(); i++)
+        is_monotonic = is_monotonic && progress[i].first >= progress[i - 1].first && progress[i].second == progress[0].second;
+    Check(is_monotonic, _name + " progress grows monotonically towards a fixed total");
+    Check(!progress.empty() && progress.back().second && progress.back().first == progress.back().second, _name + " progress reaches the total");
+}
+
+
+int main() {
+    std::vector<Libdas::DasScopeType> file_order;
+    WriteModel(file_order);
+    WriteNoTocCopy();
+    Check(HasTableOfContents(TOC_FILE) && !HasTableOfContents(NO_TOC_FILE), "only the original file has a table of contents");
+
+    // table of contents groups the scopes by their type
+    std::vector<Libdas::DasScopeType> toc_order = file_order;
+    std::stable_sort(toc_order.begin(), toc_order.end());
+
+    TestParseAsync(TOC_FILE, toc_order, "(table of contents)");
+    TestParseAsync(NO_TOC_FILE, file_order, "(sequential)");
+
+    std::remove(TOC_FILE);
+    std::remove(NO_TOC_FILE);
+    return ReportChecks("DasParserAsync");
+}
@@ -0,0 +1,348 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasParserTest.cpp - DasParser table of contents and arena parsing test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <any>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "trs/Iterators.h"
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "mar/AsciiStreamReader.h"
+#include "mar/AsciiLineReader.h"
+
+#include "das/Api.h"
+#include "das/ErrorHandlers.h"
+#include "das/DasStructures.h"
+#include "das/MappedFile.h"
+#include "das/RandomAccessFile.h"
+#include "das/OutputSink.h"
+#include "das/FileWriter.h"
+#include "das/TextureReader.h"
+#include "das/DasWriterCore.h"
+#include "das/DasArena.h"
+#include "das/DasReaderCore.h"
+#include "das/DasParser.h"
+
+#include "TestUtils.h"
+
+// enough scopes of each type to be split between several threads
+#define SCOPE_COUNT     256
+#define OUT_FILE        "DasParserTest.das"
+#define CORRUPTED_FILE  "DasParserTestCorrupted.das"
+
+
+template<typename T>
+static T *CopyArray(const std::vector<T> &_values) {
+    T *arr = new T[_values.size()];
+    std::copy(_values.begin(), _values.end(), arr);
+    return arr;
+}
+
+
+// write a model with scopes of varying sizes and optional values, payloads are kept in _payloads
+static void WriteModel(const std::string &_file_name, std::vector<std::vector<char>> &_payloads) {
+    Libdas::DasWriterCore writer(_file_name);
+    Libdas::DasProperties props;
+    props.model = "DasParserTest";
+    writer.InitialiseFile(props);
+
+    for(uint32_t i = 0; i < SCOPE_COUNT; i++) {
+        std::vector<char> &payload = _payloads.emplace_back(1 + (i * 37) % 300);
+        for(size_t j = 0; j < payload.size(); j++)
+            payload[j] = static_cast<char>(i * 31 + j);
+
+        Libdas::DasBuffer buffer;
+        buffer.type = i % 2 ? LIBDAS_BUFFER_TYPE_VERTEX : LIBDAS_BUFFER_TYPE_INDICES;
+        buffer.data_len = static_cast<uint32_t>(payload.size());
+        buffer.data_ptrs.push_back(std::make_pair(payload.data(), payload.size()));
+        buffer._free_bit = false;
+        writer.WriteBuffer(buffer, i % 3 ? 0 : 16);
+    }
+
+    for(uint32_t i = 0; i < SCOPE_COUNT; i++) {
+        Libdas::DasMeshPrimitive prim;
+        prim.index_buffer_id = i;
+        prim.index_buffer_offset = i * 4;
+        prim.draw_count = i * 3 + 3;
+        prim.vertex_buffer_id = (i + 1) % SCOPE_COUNT;
+        prim.vertex_buffer_offset = i * 12;
+        prim.texture_count = i % 3;
+        if(prim.texture_count) {
+            prim.uv_buffer_ids = CopyArray(std::vector<uint32_t>(prim.texture_count, i));
+            prim.uv_buffer_offsets = CopyArray(std::vector<uint32_t>(prim.texture_count, i * 8));
+            prim.texture_ids = CopyArray(std::vector<uint32_t>(prim.texture_count, UINT32_MAX));
+        }
+        writer.WriteMeshPrimitive(prim);
+    }
+
+    for(uint32_t i = 0; i < SCOPE_COUNT; i++) {
+        Libdas::DasMesh mesh;
+        mesh.name = "mesh" + std::to_string(i);
+        mesh.primitive_count = 1 + i % 4;
+        std::vector<uint32_t> primitives(mesh.primitive_count);
+        for(uint32_t j = 0; j < mesh.primitive_count; j++)
+            primitives[j] = (i + j) % SCOPE_COUNT;
+        mesh.primitives = CopyArray(primitives);
+        writer.WriteMesh(mesh);
+    }
+
+    for(uint32_t i = 0; i < SCOPE_COUNT; i++) {
+        Libdas::DasNode node;
+        node.name = i % 5 ? "node" + std::to_string(i) : "";
+        if(2 * i + 2 < SCOPE_COUNT) {
+            node.children_count = 2;
+            node.children = CopyArray(std::vector<uint32_t>{ 2 * i + 1, 2 * i + 2 });
+        }
+        node.mesh = i % 2 ? i : UINT32_MAX;
+        node.transform = TRS::Matrix4<float> {
+            { 1.0f, 0.0f, 0.0f, static_cast<float>(i) },
+            { 0.0f, 1.0f, 0.0f, 0.0f },
+            { 0.0f, 0.0f, 1.0f, 0.0f },
+            { 0.0f, 0.0f, 0.0f, 1.0f }
+        };
+        writer.WriteNode(node);
+    }
+
+    for(uint32_t i = 0; i < 3; i++) {
+        Libdas::DasScene scene;
+        scene.name = "scene" + std::to_string(i);
+        scene.node_count = SCOPE_COUNT - i;
+        std::vector<uint32_t> nodes(scene.node_count);
+        for(uint32_t j = 0; j < scene.node_count; j++)
+            nodes[j] = j + i;
+        scene.nodes = CopyArray(nodes);
+        writer.WriteScene(scene);
+    }
+
+    writer.CloseStream();
+}
+
+
+// reference model, that is decoded sequentially in file order without using the table of contents
+static Libdas::DasModel ReadBaseline(const std::string &_file_name) {
+    Libdas::DasReaderCore reader(_file_name, true);
+    reader.ReadSignature();
+
+    Libdas::DasModel model;
+    Libdas::DasScopeType type = Libdas::LIBDAS_DAS_SCOPE_END;
+    while((type = reader.ParseScopeDeclaration()) != Libdas::LIBDAS_DAS_SCOPE_END) {
+        switch(type) {
+            case Libdas::LIBDAS_DAS_SCOPE_PROPERTIES: reader.ReadScope(model.props); break;
+            case Libdas::LIBDAS_DAS_SCOPE_BUFFER: {
+                // payloads are copied, since they point into the reader's own file mapping
+                Libdas::DasBuffer buffer;
+                reader.ReadScope(buffer);
+                std::vector<char> data;
+                for(size_t i = 0; i < buffer.data_ptrs.size(); i++)
+                    data.insert(data.end(), buffer.GetData(i), buffer.GetData(i) + buffer.data_ptrs[i].second);
+
+                Libdas::DasBuffer &copy = model.buffers.emplace_back();
+                copy.type = buffer.type;
+                copy.data_len = buffer.data_len;
+                if(!data.empty()) {
+                    char *ptr = static_cast<char*>(std::malloc(data.size()));
+                    std::memcpy(ptr, data.data(), data.size());
+                    copy.data_ptrs.push_back(std::make_pair(ptr, data.size()));
+                }
+                break;
+            }
+            case Libdas::LIBDAS_DAS_SCOPE_MESH_PRIMITIVE: reader.ReadScope(model.mesh_primitives.emplace_back()); break;
+            case Libdas::LIBDAS_DAS_SCOPE_MESH: reader.ReadScope(model.meshes.emplace_back()); break;
+            case Libdas::LIBDAS_DAS_SCOPE_NODE: reader.ReadScope(model.nodes.emplace_back()); break;
+            case Libdas::LIBDAS_DAS_SCOPE_SCENE: reader.ReadScope(model.scenes.emplace_back()); break;
+            case Libdas::LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS: {
+                Libdas::DasTableOfContents toc;
+                reader.ReadScope(toc);
+                break;
+            }
+            default:
+                Check(false, "test file contains only expected scope types");
+                return model;
+        }
+    }
+
+    return model;
+}
+
+
+template<typename T>
+static bool IsEqualArray(const T *_a, const T *_b, uint32_t _count) {
+    return !_count || (_a && _b && !std::memcmp(_a, _b, _count * sizeof(T)));
+}
+
+
+static bool IsEqualBuffer(Libdas::DasBuffer &_a, Libdas::DasBuffer &_b) {
+    if(_a.type != _b.type || _a.data_len != _b.data_len)
+        return false;
+
+    std::vector<char> a, b;
+    for(size_t i = 0; i < _a.data_ptrs.size(); i++)
+        a.insert(a.end(), _a.GetData(i), _a.GetData(i) + _a.data_ptrs[i].second);
+    for(size_t i = 0; i < _b.data_ptrs.size(); i++)
+        b.insert(b.end(), _b.GetData(i), _b.GetData(i) + _b.data_ptrs[i].second);
+    return a == b;
+}
+
+
+static bool IsEqualPrimitive(const Libdas::DasMeshPrimitive &_a, const Libdas::DasMeshPrimitive &_b) {
+    return _a.index_buffer_id == _b.index_buffer_id && _a.index_buffer_offset == _b.index_buffer_offset &&
+           _a.draw_count == _b.draw_count && _a.vertex_buffer_id == _b.vertex_buffer_id &&
+           _a.vertex_buffer_offset == _b.vertex_buffer_offset && _a.texture_count == _b.texture_count &&
+           IsEqualArray(_a.uv_buffer_ids, _b.uv_buffer_ids, _a.texture_count) &&
+           IsEqualArray(_a.uv_buffer_offsets, _b.uv_buffer_offsets, _a.texture_count) &&
+           IsEqualArray(_a.texture_ids, _b.texture_ids, _a.texture_count);
+}
+
+
+static bool IsEqualMesh(const Libdas::DasMesh &_a, const Libdas::DasMesh &_b) {
+    return _a.name == _b.name && _a.primitive_count == _b.primitive_count && IsEqualArray(_a.primitives, _b.primitives, _a.primitive_count);
+}
+
+
+static bool IsEqualNode(const Libdas::DasNode &_a, const Libdas::DasNode &_b) {
+    return _a.name == _b.name && _a.children_count == _b.children_count && IsEqualArray(_a.children, _b.children, _a.children_count) &&
+           _a.mesh == _b.mesh && _a.skeleton == _b.skeleton && _a.transform == _b.transform;
+}
+
+
+static bool IsEqualScene(const Libdas::DasScene &_a, const Libdas::DasScene &_b) {
+    return _a.name == _b.name && _a.node_count == _b.node_count && IsEqualArray(_a.nodes, _b.nodes, _a.node_count);
+}
+
+
+template<typename T, typename F>
+static void CheckScopes(std::vector<T> &_scopes, std::vector<T> &_baseline, F _is_equal, const std::string &_name) {
+    Check(_scopes.size() == _baseline.size(), _name + " count matches the sequential reader");
+    bool is_equal = true;
+    for(size_t i = 0; i < _scopes.size() && i < _baseline.size(); i++)
+        is_equal = is_equal && _is_equal(_scopes[i], _baseline[i]);
+    Check(is_equal, _name + " scopes match the sequential reader");
+}
+
+
+static void TestParse(Libdas::DasModel &_baseline, uint32_t _thread_count, bool _use_mapping, bool _lazy_buffers, const std::string &_file_name = OUT_FILE) {
+    std::unique_ptr<Libdas::DasParser> parser = std::make_unique<Libdas::DasParser>(_file_name, _use_mapping, _lazy_buffers);
+    parser->SetThreadCount(_thread_count);
+    parser->Parse();
+
+    const std::string mode = "(" + std::to_string(_thread_count) + " threads" + (_use_mapping ? ", mapped" : "") + (_lazy_buffers ? ", lazy" : "") + ") ";
+
+    // every scope array is carved out of the model arena
+    Libdas::DasModel &parsed = parser->GetModel();
+    bool is_arena_owned = parsed.arena != nullptr;
+    for(const Libdas::DasMeshPrimitive &prim : parsed.mesh_primitives)
+        is_arena_owned = is_arena_owned && (!prim.texture_count || !prim._free_bit);
+    for(const Libdas::DasMesh &mesh : parsed.meshes)
+        is_arena_owned = is_arena_owned && !mesh._free_bit;
+    for(const Libdas::DasNode &node : parsed.nodes)
+        is_arena_owned = is_arena_owned && (!node.children_count || !node._free_bit);
+    for(const Libdas::DasScene &scene : parsed.scenes)
+        is_arena_owned = is_arena_owned && !scene._free_bit;
+    Check(is_arena_owned, mode + "scope arrays are owned by the model arena");
+
+    // parsed scopes must outlive the parser in model copies
+    Libdas::DasModel model(parser->GetModel());
+    parser.reset();
+
+    Check(model.props.model == _baseline.props.model, mode + "properties match the sequential reader");
+    CheckScopes(model.buffers, _baseline.buffers, IsEqualBuffer, mode + "buffer");
+    CheckScopes(model.mesh_primitives, _baseline.mesh_primitives, IsEqualPrimitive, mode + "mesh primitive");
+    CheckScopes(model.meshes, _baseline.meshes, IsEqualMesh, mode + "mesh");
+    CheckScopes(model.nodes, _baseline.nodes, IsEqualNode, mode + "node");
+    CheckScopes(model.scenes, _baseline.scenes, IsEqualScene, mode + "scene");
+
+    model.DeleteBuffers();
+}
+
+
+static void TestMaskedParse(Libdas::DasModel &_baseline) {
+    Libdas::DasParser parser(OUT_FILE, true);
+    parser.SetThreadCount(0);
+    parser.Parse(false, "", LIBDAS_DAS_SCOPE_MASK(Libdas::LIBDAS_DAS_SCOPE_NODE) | LIBDAS_DAS_SCOPE_MASK(Libdas::LIBDAS_DAS_SCOPE_SCENE));
+
+    Libdas::DasModel &model = parser.GetModel();
+    Check(model.buffers.empty() && model.mesh_primitives.empty() && model.meshes.empty(), "masked out scopes are skipped");
+    CheckScopes(model.nodes, _baseline.nodes, IsEqualNode, "(masked) node");
+    CheckScopes(model.scenes, _baseline.scenes, IsEqualScene, "(masked) scene");
+}
+
+
+// overwrite the first value of given table of contents declaration and check that the file is read sequentially instead
+static void TestCorruptedTableOfContents(Libdas::DasModel &_baseline, const std::string &_value, uint32_t _corrupted) {
+    std::vector<char> data;
+    {
+        std::ifstream file(OUT_FILE, std::ios_base::binary);
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    uint64_t toc_offset = 0;
+    std::memcpy(&toc_offset, data.data() + offsetof(Libdas::DasHeader, toc_offset), sizeof(uint64_t));
+    const std::string decl = _value + ": ";
+    auto it = std::search(data.begin() + toc_offset, data.end(), decl.begin(), decl.end());
+    Check(toc_offset && it != data.end(), _value + " is written to the table of contents");
+    if(it == data.end())
+        return;
+    std::memcpy(&*(it + decl.size()), &_corrupted, sizeof(uint32_t));
+
+    {
+        std::ofstream file(CORRUPTED_FILE, std::ios_base::binary);
+        file.write(data.data(), data.size());
+    }
+
+    Libdas::DasReaderCore reader(CORRUPTED_FILE, true);
+    reader.ReadSignature();
+    Check(!reader.ReadTableOfContents(), "table of contents with invalid " + _value + " is rejected");
+
+    TestParse(_baseline, 1, true, false, CORRUPTED_FILE);
+    TestParse(_baseline, 0, true, true, CORRUPTED_FILE);
+    std::remove(CORRUPTED_FILE);
+}
+
+
+int main() {
+    std::vector<std::vector<char>> payloads;
+    WriteModel(OUT_FILE, payloads);
+    Libdas::DasModel baseline = ReadBaseline(OUT_FILE);
+    Check(baseline.buffers.size() == SCOPE_COUNT && baseline.nodes.size() == SCOPE_COUNT, "sequential reader reads all written scopes");
+
+    bool is_written = baseline.buffers.size() == payloads.size();
+    for(size_t i = 0; i < payloads.size() && is_written; i++)
+        is_written = baseline.buffers[i].data_ptrs.size() == 1 && baseline.buffers[i].data_ptrs[0].second == payloads[i].size() &&
+                     !std::memcmp(baseline.buffers[i].data_ptrs[0].first, payloads[i].data(), payloads[i].size());
+    Check(is_written, "sequential reader reads written buffer payloads");
+
+    TestParse(baseline, 1, false, false);
+    TestParse(baseline, 1, true, false);
+    TestParse(baseline, 0, true, false);
+    TestParse(baseline, 0, true, true);
+    TestMaskedParse(baseline);
+    TestCorruptedTableOfContents(baseline, "SCOPETYPECOUNT", Libdas::LIBDAS_DAS_SCOPE_END + 1);
+    TestCorruptedTableOfContents(baseline, "SCOPECOUNTS", UINT32_MAX);
+
+    baseline.DeleteBuffers();
+    std::remove(OUT_FILE);
+    return ReportChecks("DasParser");
+}
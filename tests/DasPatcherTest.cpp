@@ -0,0 +1,274 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasPatcherTest.cpp - DasPatcher and DasTranscoder patch and compaction test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <any>
+#include <atomic>
+#include <future>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "trs/Iterators.h"
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "mar/AsciiStreamReader.h"
+#include "mar/AsciiLineReader.h"
+
+#include "das/Api.h"
+#include "das/ErrorHandlers.h"
+#include "das/DasStructures.h"
+#include "das/MappedFile.h"
+#include "das/RandomAccessFile.h"
+#include "das/OutputSink.h"
+#include "das/FileWriter.h"
+#include "das/TextureReader.h"
+#include "das/DasWriterCore.h"
+#include "das/DasArena.h"
+#include "das/DasReaderCore.h"
+#include "das/DasParser.h"
+#include "das/DasBlobStore.h"
+#include "das/DasTranscoder.h"
+#include "das/DasPatcher.h"
+
+#include "TestUtils.h"
+
+#define PATCHED_FILE        "DasPatcherTest.das"
+#define COMPACTED_FILE      "DasPatcherTestCompacted.das"
+#define PAYLOAD_ALIGNMENT   64
+
+
+// expected contents of the patched file
+struct ExpectedModel {
+    std::vector<std::vector<char>> payloads;
+    std::vector<std::vector<uint32_t>> mesh_primitives;
+    std::vector<std::string> node_names;
+    std::vector<uint32_t> node_meshes;
+    std::vector<uint32_t> scene_nodes;
+};
+
+
+static std::vector<char> MakePayload(size_t _len, uint32_t _seed) {
+    std::vector<char> payload(_len);
+    for(size_t i = 0; i < _len; i++)
+        payload[i] = static_cast<char>(_seed * 131 + i * 7);
+    return payload;
+}
+
+
+static Libdas::DasBuffer MakeBuffer(std::vector<char> &_payload) {
+    Libdas::DasBuffer buffer;
+    buffer.type = LIBDAS_BUFFER_TYPE_VERTEX;
+    buffer.data_len = static_cast<uint32_t>(_payload.size());
+    buffer.data_ptrs.push_back(std::make_pair(_payload.data(), _payload.size()));
+    buffer._free_bit = false;
+    return buffer;
+}
+
+
+static Libdas::DasMesh MakeMesh(const std::vector<uint32_t> &_primitives) {
+    Libdas::DasMesh mesh;
+    mesh.primitive_count = static_cast<uint32_t>(_primitives.size());
+    mesh.primitives = new uint32_t[_primitives.size()];
+    std::copy(_primitives.begin(), _primitives.end(), mesh.primitives);
+    return mesh;
+}
+
+
+static Libdas::DasNode MakeNode(const std::string &_name, uint32_t _mesh) {
+    Libdas::DasNode node;
+    node.name = _name;
+    node.mesh = _mesh;
+    return node;
+}
+
+
+static Libdas::DasScene MakeScene(const std::vector<uint32_t> &_nodes) {
+    Libdas::DasScene scene;
+    scene.name = "scene";
+    scene.node_count = static_cast<uint32_t>(_nodes.size());
+    scene.nodes = new uint32_t[_nodes.size()];
+    std::copy(_nodes.begin(), _nodes.end(), scene.nodes);
+    return scene;
+}
+
+
+static void WriteOriginal(const std::string &_file_name, ExpectedModel &_expected) {
+    _expected.payloads = { MakePayload(256, 0), MakePayload(1000, 1), MakePayload(17, 2), MakePayload(4096, 3) };
+    _expected.mesh_primitives = { { 0 }, { 0, 1 } };
+    _expected.node_names = { "root", "left", "right" };
+    _expected.node_meshes = { UINT32_MAX, 0, 1 };
+    _expected.scene_nodes = { 0, 1, 2 };
+
+    Libdas::DasWriterCore writer(_file_name);
+    writer.InitialiseFile(Libdas::DasProperties());
+    for(size_t i = 0; i < _expected.payloads.size(); i++)
+        writer.WriteBuffer(MakeBuffer(_expected.payloads[i]), i ? 0 : PAYLOAD_ALIGNMENT);
+
+    for(uint32_t i = 0; i < 2; i++) {
+        Libdas::DasMeshPrimitive prim;
+        prim.index_buffer_id = 2;
+        prim.draw_count = 3;
+        prim.vertex_buffer_id = i;
+        writer.WriteMeshPrimitive(prim);
+    }
+
+    for(const std::vector<uint32_t> &primitives : _expected.mesh_primitives)
+        writer.WriteMesh(MakeMesh(primitives));
+    for(size_t i = 0; i < _expected.node_names.size(); i++)
+        writer.WriteNode(MakeNode(_expected.node_names[i], _expected.node_meshes[i]));
+    writer.WriteScene(MakeScene(_expected.scene_nodes));
+    writer.CloseStream();
+}
+
+
+static void Patch(const std::string &_file_name, ExpectedModel &_expected) {
+    Libdas::DasPatcher patcher(_file_name);
+
+    // aligned buffer is replaced with a larger one, that must stay aligned
+    _expected.payloads[0] = MakePayload(384, 10);
+    patcher.ReplaceBuffer(0, MakeBuffer(_expected.payloads[0]), PAYLOAD_ALIGNMENT);
+    _expected.payloads[3] = MakePayload(100, 11);
+    patcher.ReplaceBuffer(3, MakeBuffer(_expected.payloads[3]));
+
+    _expected.mesh_primitives[1] = { 1 };
+    patcher.ReplaceMesh(1, MakeMesh(_expected.mesh_primitives[1]));
+
+    // the same node is replaced twice, only the last replacement counts
+    patcher.ReplaceNode(2, MakeNode("discarded", 0));
+    _expected.node_names[2] = "patched";
+    patcher.ReplaceNode(2, MakeNode(_expected.node_names[2], 1));
+
+    _expected.node_names.push_back("appended");
+    _expected.node_meshes.push_back(0);
+    patcher.WriteNode(MakeNode(_expected.node_names.back(), _expected.node_meshes.back()));
+
+    _expected.scene_nodes = { 0, 1, 2, 3 };
+    patcher.ReplaceScene(0, MakeScene(_expected.scene_nodes));
+
+    patcher.Close();
+
+    Libdas::DasReaderCore reader(_file_name, true);
+    reader.ReadSignature();
+    Check(reader.ReadTableOfContents(), "patched file has a table of contents");
+    Check(reader.GetTableOfContents().GetScopeCount(Libdas::LIBDAS_DAS_SCOPE_NODE) == 4, "appended node is added to the table of contents");
+    Check(reader.GetTableOfContents().GetScopeCount(Libdas::LIBDAS_DAS_SCOPE_BUFFER) == 4, "replaced buffers are not counted twice");
+}
+
+
+static std::vector<char> ReadFile(const std::string &_file_name) {
+    std::ifstream file(_file_name, std::ios_base::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+
+// count scopes of given type by reading the file sequentially
+static uint32_t CountScopes(const std::string &_file_name, Libdas::DasScopeType _type) {
+    Libdas::DasReaderCore reader(_file_name, true);
+    reader.ReadSignature();
+
+    uint32_t count = 0;
+    Libdas::DasScopeType type = Libdas::LIBDAS_DAS_SCOPE_END;
+    while((type = reader.ParseScopeDeclaration()) != Libdas::LIBDAS_DAS_SCOPE_END) {
+        if(type == Libdas::LIBDAS_DAS_SCOPE_UNDEFINED) {
+            Check(false, "file contains only defined scopes");
+            break;
+        }
+
+        std::any scope = reader.ReadScopeData(type);
+        count += type == _type ? 1 : 0;
+    }
+
+    return count;
+}
+
+
+static void CheckModel(const std::string &_file_name, const ExpectedModel &_expected, bool _use_mapping, uint32_t _thread_count, const std::string &_name) {
+    Libdas::DasParser parser(_file_name, _use_mapping);
+    parser.SetThreadCount(_thread_count);
+    parser.Parse();
+    Libdas::DasModel &model = parser.GetModel();
+
+    Check(model.buffers.size() == _expected.payloads.size(), _name + " buffer count");
+    for(size_t i = 0; i < model.buffers.size() && i < _expected.payloads.size(); i++) {
+        std::vector<char> data;
+        for(size_t j = 0; j < model.buffers[i].data_ptrs.size(); j++)
+            data.insert(data.end(), model.buffers[i].GetData(j), model.buffers[i].GetData(j) + model.buffers[i].data_ptrs[j].second);
+        Check(model.buffers[i].data_len == _expected.payloads[i].size() && data == _expected.payloads[i], _name + " buffer payloads");
+    }
+
+    Check(model.mesh_primitives.size() == 2, _name + " mesh primitive count");
+    Check(model.meshes.size() == _expected.mesh_primitives.size(), _name + " mesh count");
+    for(size_t i = 0; i < model.meshes.size() && i < _expected.mesh_primitives.size(); i++) {
+        const std::vector<uint32_t> primitives(model.meshes[i].primitives, model.meshes[i].primitives + model.meshes[i].primitive_count);
+        Check(primitives == _expected.mesh_primitives[i], _name + " mesh primitives");
+    }
+
+    Check(model.nodes.size() == _expected.node_names.size(), _name + " node count");
+    for(size_t i = 0; i < model.nodes.size() && i < _expected.node_names.size(); i++)
+        Check(model.nodes[i].name == _expected.node_names[i] && model.nodes[i].mesh == _expected.node_meshes[i], _name + " node values");
+
+    Check(model.scenes.size() == 1, _name + " scene count");
+    if(model.scenes.size() == 1) {
+        const std::vector<uint32_t> nodes(model.scenes[0].nodes, model.scenes[0].nodes + model.scenes[0].node_count);
+        Check(nodes == _expected.scene_nodes, _name + " scene nodes");
+    }
+}
+
+
+static void CheckAlignment(const std::string &_file_name, const std::string &_name) {
+    Libdas::DasParser parser(_file_name, true, true);
+    parser.Parse();
+    Libdas::DasModel &model = parser.GetModel();
+    Check(!model.buffers.empty() && !model.buffers[0].data_offsets.empty() && model.buffers[0].data_offsets[0] % PAYLOAD_ALIGNMENT == 0,
+          _name + " aligned buffer payload starts at an aligned file offset");
+}
+
+
+int main() {
+    ExpectedModel expected;
+    WriteOriginal(PATCHED_FILE, expected);
+    const std::vector<char> original = ReadFile(PATCHED_FILE);
+
+    Patch(PATCHED_FILE, expected);
+    const std::vector<char> patched = ReadFile(PATCHED_FILE);
+
+    // scopes are appended, thus everything after the header is left in place
+    Check(patched.size() > original.size() && std::equal(original.begin() + sizeof(Libdas::DasHeader), original.end(), patched.begin() + sizeof(Libdas::DasHeader)),
+          "patch only appends to the original file");
+    Check(CountScopes(PATCHED_FILE, Libdas::LIBDAS_DAS_SCOPE_OVERRIDE) == 6, "every replacement is preceded by an override scope");
+    // streamed files are read sequentially and apply override scopes, mapped files are read using the table of contents
+    CheckModel(PATCHED_FILE, expected, false, 1, "patched (streamed)");
+    CheckModel(PATCHED_FILE, expected, true, 1, "patched");
+    CheckModel(PATCHED_FILE, expected, true, 0, "patched (multithreaded)");
+    CheckAlignment(PATCHED_FILE, "patched");
+
+    Libdas::DasTranscoder transcoder(PATCHED_FILE, COMPACTED_FILE);
+    transcoder.Transcode();
+
+    Check(ReadFile(COMPACTED_FILE).size() < patched.size(), "compacted file is smaller than the patched file");
+    Check(CountScopes(COMPACTED_FILE, Libdas::LIBDAS_DAS_SCOPE_OVERRIDE) == 0, "compacted file contains no override scopes");
+    Check(CountScopes(COMPACTED_FILE, Libdas::LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS) == 1, "compacted file contains a single table of contents");
+    CheckModel(COMPACTED_FILE, expected, false, 1, "compacted (streamed)");
+    CheckModel(COMPACTED_FILE, expected, true, 1, "compacted");
+    CheckModel(COMPACTED_FILE, expected, true, 0, "compacted (multithreaded)");
+    CheckAlignment(COMPACTED_FILE, "compacted");
+
+    std::remove(PATCHED_FILE);
+    std::remove(COMPACTED_FILE);
+    return ReportChecks("DasPatcher");
+}
@@ -0,0 +1,123 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasReaderBenchmark.cpp - DAS scope decoding throughput benchmark
+// author: Karl-Mihkel Ott
+
+// stl
+#include <any>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "mar/AsciiStreamReader.h"
+#include "mar/AsciiLineReader.h"
+
+#include "das/Api.h"
+#include "das/ErrorHandlers.h"
+#include "das/DasStructures.h"
+#include "das/MappedFile.h"
+#include "das/DasReaderCore.h"
+
+#define DEFAULT_ITERATIONS  100
+
+template<typename T>
+static void ReadTyped(Libdas::DasReaderCore &_reader) {
+    T scope;
+    _reader.ReadScope(scope);
+}
+
+
+// statically dispatched decoding straight into the scope structure
+static uint64_t ReadAllTyped(const std::string &_file_name) {
+    Libdas::DasReaderCore reader(_file_name, true);
+    reader.ReadSignature();
+
+    uint64_t count = 0;
+    Libdas::DasScopeType type = Libdas::LIBDAS_DAS_SCOPE_END;
+    while((type = reader.ParseScopeDeclaration()) != Libdas::LIBDAS_DAS_SCOPE_END) {
+        switch(type) {
+            case Libdas::LIBDAS_DAS_SCOPE_PROPERTIES: ReadTyped<Libdas::DasProperties>(reader); break;
+            case Libdas::LIBDAS_DAS_SCOPE_BUFFER: ReadTyped<Libdas::DasBuffer>(reader); break;
+            case Libdas::LIBDAS_DAS_SCOPE_MESH_PRIMITIVE: ReadTyped<Libdas::DasMeshPrimitive>(reader); break;
+            case Libdas::LIBDAS_DAS_SCOPE_MORPH_TARGET: ReadTyped<Libdas::DasMorphTarget>(reader); break;
+            case Libdas::LIBDAS_DAS_SCOPE_MESH: ReadTyped<Libdas::DasMesh>(reader); break;
+            case Libdas::LIBDAS_DAS_SCOPE_NODE: ReadTyped<Libdas::DasNode>(reader); break;
+            case Libdas::LIBDAS_DAS_SCOPE_SCENE: ReadTyped<Libdas::DasScene>(reader); break;
+            case Libdas::LIBDAS_DAS_SCOPE_SKELETON_JOINT: ReadTyped<Libdas::DasSkeletonJoint>(reader); break;
+            case Libdas::LIBDAS_DAS_SCOPE_SKELETON: ReadTyped<Libdas::DasSkeleton>(reader); break;
+            case Libdas::LIBDAS_DAS_SCOPE_ANIMATION: ReadTyped<Libdas::DasAnimation>(reader); break;
+            case Libdas::LIBDAS_DAS_SCOPE_ANIMATION_CHANNEL: ReadTyped<Libdas::DasAnimationChannel>(reader); break;
+            case Libdas::LIBDAS_DAS_SCOPE_BVH: ReadTyped<Libdas::DasBvh>(reader); break;
+            case Libdas::LIBDAS_DAS_SCOPE_TABLE_OF_CONTENTS: ReadTyped<Libdas::DasTableOfContents>(reader); break;
+            case Libdas::LIBDAS_DAS_SCOPE_OVERRIDE: ReadTyped<Libdas::DasScopeOverride>(reader); break;
+            default:
+                std::cerr << "Undefined scope in file " << _file_name << std::endl;
+                std::exit(-1);
+        }
+        count++;
+    }
+
+    return count;
+}
+
+
+// dynamically dispatched decoding, where each scope is returned inside std::any
+static uint64_t ReadAllAny(const std::string &_file_name) {
+    Libdas::DasReaderCore reader(_file_name, true);
+    reader.ReadSignature();
+
+    uint64_t count = 0;
+    Libdas::DasScopeType type = Libdas::LIBDAS_DAS_SCOPE_END;
+    while((type = reader.ParseScopeDeclaration()) != Libdas::LIBDAS_DAS_SCOPE_END) {
+        if(type == Libdas::LIBDAS_DAS_SCOPE_UNDEFINED) {
+            std::cerr << "Undefined scope in file " << _file_name << std::endl;
+            std::exit(-1);
+        }
+
+        std::any scope = reader.ReadScopeData(type);
+        count++;
+    }
+
+    return count;
+}
+
+
+template<typename F>
+static void Benchmark(const std::string &_name, F _read_all, const std::string &_file_name, uint32_t _iterations) {
+    uint64_t count = 0;
+    auto beg = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < _iterations; i++)
+        count += _read_all(_file_name);
+    auto end = std::chrono::steady_clock::now();
+
+    const double sec = std::chrono::duration<double>(end - beg).count();
+    std::cout << _name << ": " << count << " scopes in " << sec << " s, " <<
+                 (sec > 0.0 ? static_cast<double>(count) / sec : 0.0) << " scopes/s" << std::endl;
+}
+
+
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <file.das> [iterations]" << std::endl;
+        std::exit(-1);
+    }
+
+    const std::string file_name = argv[1];
+    const uint32_t iterations = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : DEFAULT_ITERATIONS;
+
+    Benchmark("std::any dispatch", ReadAllAny, file_name, iterations);
+    Benchmark("typed dispatch", ReadAllTyped, file_name, iterations);
+    return 0;
+}
@@ -0,0 +1,191 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasSceneGraphTest.cpp - DasSceneGraph class test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <iostream>
+
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "das/Api.h"
+#include "das/DasStructures.h"
+#include "das/DasSceneGraph.h"
+
+#include "TestUtils.h"
+
+// node that is not referenced by the scene
+#define DETACHED_NODE   9
+
+
+static TRS::Matrix4<float> MakeTransform(uint32_t _seed) {
+    const float s = 1.0f + static_cast<float>(_seed % 3) * 0.5f;
+    return TRS::Matrix4<float> {
+        { s, 0.0f, 0.0f, static_cast<float>(_seed) },
+        { 0.0f, s, 0.0f, static_cast<float>(_seed * 2) },
+        { 0.0f, 0.0f, 1.0f, -static_cast<float>(_seed) },
+        { 0.0f, 0.0f, 0.0f, 1.0f }
+    };
+}
+
+
+static void AddNode(Libdas::DasModel &_model, const std::string &_name, const std::vector<uint32_t> &_children) {
+    Libdas::DasNode &node = _model.nodes.emplace_back();
+    node.name = _name;
+    node.mesh = static_cast<uint32_t>(_model.nodes.size() - 1) % 2 ? static_cast<uint32_t>(_model.nodes.size() - 1) : UINT32_MAX;
+    node.transform = MakeTransform(static_cast<uint32_t>(_model.nodes.size()));
+    if(!_children.empty()) {
+        node.children_count = static_cast<uint32_t>(_children.size());
+        node.children = new uint32_t[_children.size()];
+        std::copy(_children.begin(), _children.end(), node.children);
+    }
+}
+
+
+//        0         7
+//       / \        |
+//      1   2       8
+//     / \  |
+//    3   4 5
+//          |
+//          6
+static void MakeModel(Libdas::DasModel &_model) {
+    AddNode(_model, "root", { 1, 2 });
+    AddNode(_model, "left", { 3, 4 });
+    AddNode(_model, "right", { 5 });
+    AddNode(_model, "leaf", {});
+    AddNode(_model, "leaf", {});
+    AddNode(_model, "", { 6 });
+    AddNode(_model, "leaf", {});
+    AddNode(_model, "root", { 8 });
+    AddNode(_model, "", {});
+    AddNode(_model, "detached", {});
+
+    // scene nodes are listed in arbitrary order
+    const std::vector<uint32_t> nodes = { 5, 0, 3, 1, 8, 7, 2, 6, 4 };
+    Libdas::DasScene &scene = _model.scenes.emplace_back();
+    scene.name = "scene";
+    scene.node_count = static_cast<uint32_t>(nodes.size());
+    scene.nodes = new uint32_t[nodes.size()];
+    std::copy(nodes.begin(), nodes.end(), scene.nodes);
+}
+
+
+// world transforms computed by walking the model hierarchy recursively
+static void WalkNodes(const Libdas::DasModel &_model, uint32_t _node_id, const TRS::Matrix4<float> &_parent_world, 
+                      std::unordered_map<uint32_t, TRS::Matrix4<float>> &_world_transforms) {
+    const Libdas::DasNode &node = _model.nodes[_node_id];
+    const TRS::Matrix4<float> world = _parent_world * node.transform;
+    _world_transforms[_node_id] = world;
+    for(uint32_t i = 0; i < node.children_count; i++)
+        WalkNodes(_model, node.children[i], world, _world_transforms);
+}
+
+
+static void CheckWorldTransforms(const Libdas::DasModel &_model, const Libdas::DasSceneGraph &_graph, const std::string &_name) {
+    const TRS::Matrix4<float> identity = {
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f, 0.0f },
+        { 0.0f, 0.0f, 0.0f, 1.0f }
+    };
+
+    std::unordered_map<uint32_t, TRS::Matrix4<float>> world_transforms;
+    WalkNodes(_model, 0, identity, world_transforms);
+    WalkNodes(_model, 7, identity, world_transforms);
+
+    bool is_equal = world_transforms.size() == _graph.GetNodeCount();
+    for(uint32_t i = 0; i < _graph.GetNodeCount() && is_equal; i++)
+        is_equal = _graph.GetWorldTransforms()[i] == world_transforms[_graph.GetNodeIds()[i]];
+    Check(is_equal, _name + " world transforms match a recursive hierarchy walk");
+}
+
+
+static void TestHierarchy(const Libdas::DasModel &_model, const Libdas::DasSceneGraph &_graph) {
+    Check(_graph.GetNodeIds() == std::vector<uint32_t>({ 0, 7, 1, 2, 8, 3, 4, 5, 6 }), "nodes are stored in breadth first order");
+    Check(_graph.GetLevelOffsets() == std::vector<uint32_t>({ 0, 2, 5, 8, 9 }), "level offsets mark the beginning of each hierarchy level");
+    Check(_graph.FindGraphNode(DETACHED_NODE) == UINT32_MAX, "nodes outside of the scene are not a part of the graph");
+
+    bool is_mapped = true;
+    for(uint32_t i = 0; i < _graph.GetNodeCount(); i++)
+        is_mapped = is_mapped && _graph.FindGraphNode(_graph.GetNodeIds()[i]) == i;
+    Check(is_mapped, "graph node lookup is the inverse of node ids");
+
+    // children linked with first child and next sibling indices must match model node children in their order
+    for(uint32_t i = 0; i < _graph.GetNodeCount(); i++) {
+        const Libdas::DasNode &node = _model.nodes[_graph.GetNodeIds()[i]];
+        std::vector<uint32_t> children;
+        for(uint32_t child = _graph.GetFirstChildren()[i]; child != UINT32_MAX; child = _graph.GetNextSiblings()[child]) {
+            Check(_graph.GetParents()[child] == i, "child links back to its parent");
+            children.push_back(_graph.GetNodeIds()[child]);
+        }
+        Check(children == std::vector<uint32_t>(node.children, node.children + node.children_count), "sibling chain lists all node children in order");
+        Check(_graph.GetMeshes()[i] == node.mesh && _graph.GetSkeletons()[i] == node.skeleton, "node mesh and skeleton are copied");
+    }
+
+    const uint32_t root_count = _graph.GetLevelOffsets()[1];
+    bool is_root_valid = true;
+    for(uint32_t i = 0; i < _graph.GetNodeCount(); i++)
+        is_root_valid = is_root_valid && (i < root_count) == (_graph.GetParents()[i] == UINT32_MAX);
+    Check(is_root_valid, "only first level nodes have no parent");
+    Check(_graph.GetNextSiblings()[0] == UINT32_MAX && _graph.GetNextSiblings()[1] == UINT32_MAX, "root nodes are not linked as siblings");
+}
+
+
+static void TestNames(const Libdas::DasModel &_model, const Libdas::DasSceneGraph &_graph) {
+    Check(_graph.GetNames().size() == 5, "equal names are interned once");
+
+    bool is_equal = true;
+    for(uint32_t i = 0; i < _graph.GetNodeCount(); i++) {
+        is_equal = is_equal && _graph.GetName(i) == _model.nodes[_graph.GetNodeIds()[i]].name;
+        for(uint32_t j = 0; j < _graph.GetNodeCount(); j++) {
+            const bool is_same_name = _model.nodes[_graph.GetNodeIds()[i]].name == _model.nodes[_graph.GetNodeIds()[j]].name;
+            is_equal = is_equal && is_same_name == (_graph.GetNameIds()[i] == _graph.GetNameIds()[j]);
+        }
+    }
+    Check(is_equal, "nodes share name ids only if their names are equal");
+}
+
+
+static void TestTransformUpdate(Libdas::DasModel &_model, Libdas::DasSceneGraph &_graph) {
+    CheckWorldTransforms(_model, _graph, "built");
+
+    // updated transform of an inner node propagates to all of its descendants
+    _model.nodes[2].transform = MakeTransform(42);
+    _graph.SetLocalTransform(_graph.FindGraphNode(2), _model.nodes[2].transform);
+    _graph.UpdateWorldTransforms();
+    CheckWorldTransforms(_model, _graph, "updated");
+
+    _model.nodes[7].transform = MakeTransform(43);
+    _graph.SetLocalTransform(_graph.FindGraphNode(7), _model.nodes[7].transform);
+    _graph.UpdateWorldTransforms();
+    CheckWorldTransforms(_model, _graph, "updated root");
+}
+
+
+int main() {
+    Libdas::DasModel model;
+    MakeModel(model);
+
+    Libdas::DasSceneGraph graph(model, 0);
+    Check(graph.GetNodeCount() == model.nodes.size() - 1, "all scene nodes are a part of the graph");
+    TestHierarchy(model, graph);
+    TestNames(model, graph);
+    TestTransformUpdate(model, graph);
+
+    // rebuilding replaces the previous graph
+    graph.Build(model, 0);
+    TestHierarchy(model, graph);
+    CheckWorldTransforms(model, graph, "rebuilt");
+
+    return ReportChecks("DasSceneGraph");
+}
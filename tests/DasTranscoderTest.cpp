@@ -0,0 +1,148 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasTranscoderTest.cpp - DasTranscoder buffer callback test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <any>
+#include <atomic>
+#include <future>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "trs/Iterators.h"
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "mar/AsciiStreamReader.h"
+#include "mar/AsciiLineReader.h"
+
+#include "das/Api.h"
+#include "das/ErrorHandlers.h"
+#include "das/DasStructures.h"
+#include "das/MappedFile.h"
+#include "das/RandomAccessFile.h"
+#include "das/OutputSink.h"
+#include "das/FileWriter.h"
+#include "das/TextureReader.h"
+#include "das/DasWriterCore.h"
+#include "das/DasArena.h"
+#include "das/DasReaderCore.h"
+#include "das/DasParser.h"
+#include "das/DasBlobStore.h"
+#include "das/DasTranscoder.h"
+
+#include "TestUtils.h"
+
+#define INPUT_FILE      "DasTranscoderTest.das"
+#define OUTPUT_FILE     "DasTranscoderTestOutput.das"
+#define BUFFER_COUNT    4
+
+
+static std::vector<char> MakePayload(size_t _len, uint32_t _seed) {
+    std::vector<char> payload(_len);
+    for(size_t i = 0; i < _len; i++)
+        payload[i] = static_cast<char>(_seed * 131 + i * 7);
+    return payload;
+}
+
+
+static void WriteInput(const std::vector<std::vector<char>> &_payloads) {
+    Libdas::DasWriterCore writer(INPUT_FILE);
+    writer.InitialiseFile(Libdas::DasProperties());
+    for(const std::vector<char> &payload : _payloads) {
+        Libdas::DasBuffer buffer;
+        buffer.type = LIBDAS_BUFFER_TYPE_VERTEX;
+        buffer.data_len = static_cast<uint32_t>(payload.size());
+        buffer.data_ptrs.push_back(std::make_pair(const_cast<char*>(payload.data()), payload.size()));
+        buffer._free_bit = false;
+        writer.WriteBuffer(buffer);
+    }
+    writer.CloseStream();
+}
+
+
+static void CheckOutput(const std::vector<std::vector<char>> &_expected) {
+    Libdas::DasParser parser(OUTPUT_FILE, true);
+    parser.Parse();
+    Libdas::DasModel &model = parser.GetModel();
+
+    Check(model.buffers.size() == _expected.size(), "transcoded buffer count");
+    for(size_t i = 0; i < model.buffers.size() && i < _expected.size(); i++) {
+        std::vector<char> data;
+        for(size_t j = 0; j < model.buffers[i].data_ptrs.size(); j++)
+            data.insert(data.end(), model.buffers[i].GetData(j), model.buffers[i].GetData(j) + model.buffers[i].data_ptrs[j].second);
+        Check(model.buffers[i].data_len == _expected[i].size() && data == _expected[i], "transcoded buffer " + std::to_string(i) + " payload");
+    }
+}
+
+
+int main() {
+    std::vector<std::vector<char>> expected;
+    for(uint32_t i = 0; i < BUFFER_COUNT; i++)
+        expected.push_back(MakePayload(100 + i * 50, i));
+    WriteInput(expected);
+
+    // replacement payloads must stay valid until the next callback, thus these are kept for the whole transcoding
+    std::vector<std::vector<char>> replacements(BUFFER_COUNT);
+    Libdas::DasTranscodeCallbacks callbacks;
+    callbacks.on_buffer = [&](Libdas::DasBuffer &_buffer, uint32_t _id) {
+        const char *data = _buffer.GetData();
+        Check(data && !std::memcmp(data, expected[_id].data(), expected[_id].size()), "lazily loaded payload matches the input");
+        Check(_buffer._loaded_payloads.size() == 1, "loaded payload is owned by the buffer");
+
+        switch(_id) {
+            // loaded payload is replaced
+            case 0:
+                replacements[_id] = MakePayload(64, 10);
+                _buffer.data_ptrs[0] = std::make_pair(replacements[_id].data(), replacements[_id].size());
+                _buffer.data_len = static_cast<uint32_t>(replacements[_id].size());
+                _buffer.data_offsets.clear();
+                expected[_id] = replacements[_id];
+                break;
+
+            // all payloads are dropped and a new one is added
+            case 1:
+                replacements[_id] = MakePayload(300, 11);
+                _buffer.data_ptrs.clear();
+                _buffer.data_offsets.clear();
+                _buffer.data_ptrs.push_back(std::make_pair(replacements[_id].data(), replacements[_id].size()));
+                _buffer.data_len = static_cast<uint32_t>(replacements[_id].size());
+                expected[_id] = replacements[_id];
+                break;
+
+            // loaded payload is modified in place and a new payload is appended
+            case 2:
+                _buffer.GetData()[0] = 42;
+                expected[_id][0] = 42;
+                replacements[_id] = MakePayload(20, 12);
+                _buffer.data_ptrs.push_back(std::make_pair(replacements[_id].data(), replacements[_id].size()));
+                _buffer.data_len += static_cast<uint32_t>(replacements[_id].size());
+                expected[_id].insert(expected[_id].end(), replacements[_id].begin(), replacements[_id].end());
+                break;
+
+            // loaded payload is left as it is
+            default:
+                break;
+        }
+    };
+
+    Libdas::DasTranscoder transcoder(INPUT_FILE, OUTPUT_FILE);
+    transcoder.Transcode(callbacks);
+    CheckOutput(expected);
+
+    std::remove(INPUT_FILE);
+    std::remove(OUTPUT_FILE);
+    return ReportChecks("DasTranscoder");
+}
@@ -0,0 +1,204 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: DasWriterBenchmark.cpp - DAS writer output throughput benchmark
+// author: Karl-Mihkel Ott
+
+// stl
+#include <any>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "trs/Iterators.h"
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "mar/AsciiStreamReader.h"
+#include "mar/AsciiLineReader.h"
+
+#include "das/Api.h"
+#include "das/ErrorHandlers.h"
+#include "das/DasStructures.h"
+#include "das/MappedFile.h"
+#include "das/RandomAccessFile.h"
+#include "das/OutputSink.h"
+#include "das/FileWriter.h"
+#include "das/TextureReader.h"
+#include "das/DasWriterCore.h"
+#include "das/DasArena.h"
+#include "das/DasReaderCore.h"
+#include "das/DasParser.h"
+
+#define DEFAULT_ITERATIONS  10
+#define OUT_FILE            "DasWriterBenchmark.das"
+
+// Reference writer, that issues a separate stream write for every value name, separator, value and newline
+class StreamWriter {
+    private:
+        std::ofstream m_stream;
+
+    private:
+        template<typename T>
+        void _WriteValue(const std::string &_name, const T *_values, uint32_t _n = 1) {
+            m_stream.write(_name.c_str(), _name.size());
+            m_stream.write(": ", 2);
+            m_stream.write(reinterpret_cast<const char*>(_values), sizeof(T) * _n);
+            m_stream.write(LIBDAS_DAS_NEWLINE, strlen(LIBDAS_DAS_NEWLINE));
+        }
+
+        void _Scope(const std::string &_name) {
+            m_stream.write(_name.c_str(), _name.size());
+            m_stream.write(LIBDAS_DAS_NEWLINE, strlen(LIBDAS_DAS_NEWLINE));
+        }
+
+        void _EndScope() {
+            m_stream.write("ENDSCOPE", 8);
+            m_stream.write(LIBDAS_DAS_NEWLINE, strlen(LIBDAS_DAS_NEWLINE));
+        }
+
+    public:
+        StreamWriter(const std::string &_file_name) : m_stream(_file_name, std::ios_base::binary) {
+            Libdas::DasHeader header;
+            m_stream.write(reinterpret_cast<const char*>(&header), sizeof(Libdas::DasHeader));
+        }
+
+        void WriteBuffer(const Libdas::DasBuffer &_buffer) {
+            _Scope("BUFFER");
+            _WriteValue("BUFFERTYPE", &_buffer.type);
+            _WriteValue("DATALEN", &_buffer.data_len);
+            m_stream.write("DATA: ", 6);
+            for(const std::pair<char*, size_t> &ptr : _buffer.data_ptrs)
+                m_stream.write(ptr.first, ptr.second);
+            m_stream.write(LIBDAS_DAS_NEWLINE, strlen(LIBDAS_DAS_NEWLINE));
+            _EndScope();
+        }
+
+        void WriteMesh(const Libdas::DasMesh &_mesh) {
+            _Scope("MESH");
+            _WriteValue("PRIMITIVECOUNT", &_mesh.primitive_count);
+            _WriteValue("PRIMITIVES", _mesh.primitives, _mesh.primitive_count);
+            _EndScope();
+        }
+
+        void WriteNode(const Libdas::DasNode &_node) {
+            _Scope("NODE");
+            if(_node.children_count) {
+                _WriteValue("CHILDRENCOUNT", &_node.children_count);
+                _WriteValue("CHILDREN", _node.children, _node.children_count);
+            }
+            if(_node.mesh != UINT32_MAX)
+                _WriteValue("MESH", &_node.mesh);
+
+            m_stream.write("TRANSFORM: ", 11);
+            for(auto it = _node.transform.BeginRowMajor(); it != _node.transform.EndRowMajor(); it++)
+                m_stream.write(reinterpret_cast<const char*>(it.GetData()), sizeof(float));
+            m_stream.write(LIBDAS_DAS_NEWLINE, strlen(LIBDAS_DAS_NEWLINE));
+            _EndScope();
+        }
+
+        void WriteScene(const Libdas::DasScene &_scene) {
+            _Scope("SCENE");
+            _WriteValue("NODECOUNT", &_scene.node_count);
+            _WriteValue("NODES", _scene.nodes, _scene.node_count);
+            _EndScope();
+        }
+};
+
+
+// buffered writer, that exposes DasWriterCore's scope writing methods and serializes scopes on a single thread
+class BufferedWriter : public Libdas::DasWriterCore {
+    public:
+        BufferedWriter(const std::string &_file_name) : Libdas::DasWriterCore(_file_name) {
+            SetThreadCount(1);
+            InitialiseFile(Libdas::DasProperties());
+        }
+};
+
+
+// buffered writer, that serializes scopes on all hardware threads
+class ParallelWriter : public Libdas::DasWriterCore {
+    public:
+        ParallelWriter(const std::string &_file_name) : Libdas::DasWriterCore(_file_name) {
+            SetThreadCount(0);
+            InitialiseFile(Libdas::DasProperties());
+        }
+};
+
+
+template<typename W>
+static void WriteModel(const Libdas::DasModel &_model) {
+    W writer(OUT_FILE);
+    for(const Libdas::DasBuffer &buffer : _model.buffers)
+        writer.WriteBuffer(buffer);
+    for(const Libdas::DasMesh &mesh : _model.meshes)
+        writer.WriteMesh(mesh);
+    for(const Libdas::DasNode &node : _model.nodes)
+        writer.WriteNode(node);
+    for(const Libdas::DasScene &scene : _model.scenes)
+        writer.WriteScene(scene);
+}
+
+
+template<>
+void WriteModel<ParallelWriter>(const Libdas::DasModel &_model) {
+    ParallelWriter writer(OUT_FILE);
+    writer.WriteBuffers(_model.buffers);
+    writer.WriteMeshes(_model.meshes);
+    writer.WriteNodes(_model.nodes);
+    writer.WriteScenes(_model.scenes);
+}
+
+
+static uint64_t GetFileSize(const std::string &_file_name) {
+    std::ifstream file(_file_name, std::ios_base::binary | std::ios_base::ate);
+    return file ? static_cast<uint64_t>(file.tellg()) : 0;
+}
+
+
+template<typename W>
+static void Benchmark(const std::string &_name, const Libdas::DasModel &_model, uint32_t _iterations) {
+    uint64_t bytes = 0;
+    auto beg = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < _iterations; i++) {
+        WriteModel<W>(_model);
+        bytes += GetFileSize(OUT_FILE);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    const double sec = std::chrono::duration<double>(end - beg).count();
+    std::cout << _name << ": " << bytes << " bytes in " << sec << " s, " <<
+                 (sec > 0.0 ? static_cast<double>(bytes) / (sec * 1024.0 * 1024.0) : 0.0) << " MB/s" << std::endl;
+}
+
+
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <file.das> [iterations]" << std::endl;
+        std::exit(-1);
+    }
+
+    const uint32_t iterations = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : DEFAULT_ITERATIONS;
+
+    Libdas::DasParser parser(argv[1], true);
+    parser.Parse();
+
+    Benchmark<StreamWriter>("per value stream writes", parser.GetModel(), iterations);
+    Benchmark<BufferedWriter>("staged DasWriterCore", parser.GetModel(), iterations);
+    Benchmark<ParallelWriter>("parallel DasWriterCore", parser.GetModel(), iterations);
+    std::remove(OUT_FILE);
+    return 0;
+}
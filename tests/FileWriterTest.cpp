@@ -0,0 +1,118 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: FileWriterTest.cpp - FileWriter class crash safety test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+
+#include "das/Api.h"
+#include "das/RandomAccessFile.h"
+#include "das/OutputSink.h"
+#include "das/FileWriter.h"
+
+#include "TestUtils.h"
+
+#define TEST_DIR        "FileWriterTest"
+#define TARGET_FILE     TEST_DIR "/target.das"
+
+
+static std::string ReadFile(const std::string &_file_name) {
+    std::ifstream file(_file_name, std::ios_base::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+
+static void WriteFile(const std::string &_file_name, const std::string &_data) {
+    std::ofstream file(_file_name, std::ios_base::binary | std::ios_base::trunc);
+    file.write(_data.data(), _data.size());
+}
+
+
+// all files in the test directory, temporary files included
+static std::vector<std::string> ListFiles() {
+    std::vector<std::string> files;
+    for(const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(TEST_DIR))
+        files.push_back(entry.path().filename().string());
+    return files;
+}
+
+
+static void TestUncommitted() {
+    const std::string original = "original contents";
+    WriteFile(TARGET_FILE, original);
+
+    {
+        Libdas::FileWriter writer(TARGET_FILE);
+        const std::string data = "partially written output";
+        Check(writer.Write(data.data(), data.size()), "uncommitted data is written");
+        Check(ListFiles().size() == 2, "output is written into a temporary file");
+        Check(ReadFile(TARGET_FILE) == original, "target is unchanged while writing");
+    }
+
+    Check(ReadFile(TARGET_FILE) == original, "uncommitted writer leaves the target unchanged");
+    Check(ListFiles() == std::vector<std::string>({ "target.das" }), "uncommitted writer removes its temporary file");
+}
+
+
+static void TestCommit() {
+    WriteFile(TARGET_FILE, "original contents, that are longer than the new output");
+
+    const std::string data = "committed output";
+    {
+        Libdas::FileWriter writer(TARGET_FILE);
+        writer.Preallocate(1 << 20);
+        Check(writer.Write(data.data(), data.size()), "committed data is written");
+        Check(writer.Commit(), "output is committed");
+        Check(ReadFile(TARGET_FILE) == data, "commit replaces the target");
+    }
+
+    Check(ReadFile(TARGET_FILE) == data, "committed output is kept after the writer is destroyed");
+    Check(std::filesystem::file_size(TARGET_FILE) == data.size(), "preallocated space is released on commit");
+    Check(ListFiles() == std::vector<std::string>({ "target.das" }), "commit leaves no temporary file behind");
+}
+
+
+static void TestAppend() {
+    const std::string original = "original contents";
+    const std::string appended = " and appended data";
+    WriteFile(TARGET_FILE, original);
+
+    {
+        Libdas::FileWriter writer(TARGET_FILE, true);
+        Check(writer.GetSize() == original.size(), "appending writer starts at the end of the existing file");
+        Check(writer.Write(appended.data(), appended.size()), "appended data is written");
+        Check(ReadFile(TARGET_FILE) == original + appended, "appending writer writes into the target directly");
+    }
+
+    Check(ReadFile(TARGET_FILE) == original, "uncommitted appending writer truncates the target back to its original size");
+
+    {
+        Libdas::FileWriter writer(TARGET_FILE, true);
+        Check(writer.Write(appended.data(), appended.size()), "appended data is written");
+        Check(writer.Commit(), "appended output is committed");
+    }
+
+    Check(ReadFile(TARGET_FILE) == original + appended, "committed appending writer keeps appended data");
+    Check(ListFiles() == std::vector<std::string>({ "target.das" }), "appending writer creates no temporary file");
+}
+
+
+int main() {
+    std::filesystem::remove_all(TEST_DIR);
+    std::filesystem::create_directory(TEST_DIR);
+
+    TestUncommitted();
+    TestCommit();
+    TestAppend();
+
+    std::filesystem::remove_all(TEST_DIR);
+    return ReportChecks("FileWriter");
+}
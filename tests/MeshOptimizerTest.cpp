@@ -0,0 +1,142 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: MeshOptimizerTest.cpp - MeshOptimizer class test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <iostream>
+
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "das/Api.h"
+#include "das/MeshOptimizer.h"
+
+#include "TestUtils.h"
+
+#define GRID_SIZE               64
+#define UNREFERENCED_VERTICES   5
+
+
+// grid triangles in shuffled order, followed by a few vertices that no triangle references
+static std::vector<uint32_t> MakeShuffledGrid(uint32_t _size) {
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for(uint32_t y = 0; y < _size; y++) {
+        for(uint32_t x = 0; x < _size; x++) {
+            const uint32_t v0 = y * (_size + 1) + x, v1 = v0 + 1, v2 = v0 + _size + 1, v3 = v2 + 1;
+            triangles.push_back({ v0, v1, v2 });
+            triangles.push_back({ v1, v3, v2 });
+        }
+    }
+
+    uint32_t state = 7;
+    for(size_t i = triangles.size() - 1; i > 0; i--) {
+        state = state * 1664525u + 1013904223u;
+        std::swap(triangles[i], triangles[state % (i + 1)]);
+    }
+
+    std::vector<uint32_t> indices;
+    for(const std::array<uint32_t, 3> &tri : triangles)
+        indices.insert(indices.end(), tri.begin(), tri.end());
+    return indices;
+}
+
+
+// triangles rotated so that the smallest index comes first, which keeps the winding order
+static std::vector<std::array<uint32_t, 3>> NormaliseTriangles(const std::vector<uint32_t> &_indices) {
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for(size_t i = 0; i + 2 < _indices.size(); i += 3) {
+        std::array<uint32_t, 3> tri = { _indices[i], _indices[i + 1], _indices[i + 2] };
+        while(tri[0] > tri[1] || tri[0] > tri[2])
+            tri = { tri[1], tri[2], tri[0] };
+        triangles.push_back(tri);
+    }
+
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+
+static void TestVertexCache(const std::vector<uint32_t> &_indices, uint32_t _vertex_count) {
+    std::vector<uint32_t> indices = _indices;
+    Libdas::MeshOptimizer optimizer(indices.data(), static_cast<uint32_t>(indices.size()), _vertex_count);
+    const Libdas::VertexCacheStatistics before = optimizer.AnalyzeVertexCache();
+    optimizer.OptimizeVertexCache();
+    const Libdas::VertexCacheStatistics after = optimizer.AnalyzeVertexCache();
+
+    Check(NormaliseTriangles(indices) == NormaliseTriangles(_indices), "reordered triangles are a permutation of input triangles with the same winding");
+    Check(after.acmr < before.acmr, "vertex cache optimization reduces the cache miss ratio");
+    Check(after.acmr >= 0.5f && after.atvr >= 1.0f, "cache statistics are inside their theoretical bounds");
+
+    // already optimized triangles stay optimized
+    std::vector<uint32_t> again = indices;
+    Libdas::MeshOptimizer reoptimizer(again.data(), static_cast<uint32_t>(again.size()), _vertex_count);
+    reoptimizer.OptimizeVertexCache();
+    Check(reoptimizer.AnalyzeVertexCache().acmr <= after.acmr + 0.01f, "optimizing twice does not degrade the cache miss ratio");
+}
+
+
+static void TestVertexFetch(const std::vector<uint32_t> &_indices, uint32_t _vertex_count) {
+    std::vector<uint32_t> indices = _indices;
+    Libdas::MeshOptimizer optimizer(indices.data(), static_cast<uint32_t>(indices.size()), _vertex_count);
+    optimizer.OptimizeVertexCache();
+    const std::vector<uint32_t> optimized = indices;
+    const std::vector<uint32_t> remap = optimizer.OptimizeVertexFetch();
+
+    Check(remap.size() == _vertex_count, "remap table has an entry for every vertex");
+    std::vector<uint32_t> sorted = remap;
+    std::sort(sorted.begin(), sorted.end());
+    bool is_permutation = true;
+    for(uint32_t i = 0; i < sorted.size(); i++)
+        is_permutation = is_permutation && sorted[i] == i;
+    Check(is_permutation, "remap table is a permutation of vertex indices");
+
+    // vertices are numbered in the order of their first use
+    uint32_t next_vertex = 0;
+    bool is_first_use_order = true;
+    for(uint32_t index : indices) {
+        if(index == next_vertex)
+            next_vertex++;
+        else is_first_use_order = is_first_use_order && index < next_vertex;
+    }
+    Check(is_first_use_order, "vertices are renumbered in the order of their first use");
+    Check(next_vertex == _vertex_count - UNREFERENCED_VERTICES, "all referenced vertices come first");
+    for(uint32_t i = _vertex_count - UNREFERENCED_VERTICES; i < _vertex_count; i++)
+        Check(remap[i] >= next_vertex, "unreferenced vertices are kept after referenced ones");
+
+    // remapped vertex data must describe the same triangles
+    std::vector<uint32_t> vertices(_vertex_count);
+    for(uint32_t i = 0; i < _vertex_count; i++)
+        vertices[i] = i * 3 + 1;
+    std::vector<uint32_t> remapped = vertices;
+    Libdas::MeshOptimizer::RemapVertices(remapped, remap);
+    std::vector<uint32_t> stream(_vertex_count);
+    Libdas::MeshOptimizer::RemapVertexStream(reinterpret_cast<char*>(stream.data()), reinterpret_cast<const char*>(vertices.data()), sizeof(uint32_t), remap);
+    Check(stream == remapped, "vertex stream and vertex vector remapping agree");
+
+    bool is_same_geometry = true;
+    for(size_t i = 0; i < indices.size(); i++)
+        is_same_geometry = is_same_geometry && remapped[indices[i]] == vertices[optimized[i]];
+    Check(is_same_geometry, "remapped vertices describe the same triangles");
+}
+
+
+int main() {
+    const std::vector<uint32_t> indices = MakeShuffledGrid(GRID_SIZE);
+    const uint32_t vertex_count = (GRID_SIZE + 1) * (GRID_SIZE + 1) + UNREFERENCED_VERTICES;
+
+    TestVertexCache(indices, vertex_count);
+    TestVertexFetch(indices, vertex_count);
+
+    return ReportChecks("MeshOptimizer");
+}
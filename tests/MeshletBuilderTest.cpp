@@ -0,0 +1,150 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: MeshletBuilderTest.cpp - MeshletBuilder class test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <iostream>
+
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "das/Api.h"
+#include "das/DasStructures.h"
+#include "das/MeshletBuilder.h"
+
+#include "TestUtils.h"
+
+// large enough to be split into several tasks
+#define GRID_SIZE   200
+#define EPSILON     1e-4f
+
+
+// flat grid in z = 0 plane, all triangles face towards +z
+static void MakeGrid(uint32_t _size, std::vector<TRS::Point3D<float>> &_positions, std::vector<uint32_t> &_indices) {
+    for(uint32_t y = 0; y <= _size; y++) {
+        for(uint32_t x = 0; x <= _size; x++)
+            _positions.push_back({ static_cast<float>(x), static_cast<float>(y), 0.0f });
+    }
+
+    for(uint32_t y = 0; y < _size; y++) {
+        for(uint32_t x = 0; x < _size; x++) {
+            const uint32_t v0 = y * (_size + 1) + x, v1 = v0 + 1, v2 = v0 + _size + 1, v3 = v2 + 1;
+            _indices.insert(_indices.end(), { v0, v1, v2, v1, v3, v2 });
+        }
+    }
+}
+
+
+static bool IsBackfacing(const Libdas::DasMeshlet &_meshlet, float _x, float _y, float _z) {
+    float dx = _meshlet.cone_apex.x - _x, dy = _meshlet.cone_apex.y - _y, dz = _meshlet.cone_apex.z - _z;
+    const float len = std::sqrt(dx * dx + dy * dy + dz * dz);
+    dx /= len, dy /= len, dz /= len;
+    return dx * _meshlet.cone_axis.x + dy * _meshlet.cone_axis.y + dz * _meshlet.cone_axis.z >= _meshlet.cone_cutoff;
+}
+
+
+// decode serialized meshlets and compare them against the source triangles
+static void CheckMeshlets(const Libdas::MeshletBuilder &_builder, const std::vector<TRS::Point3D<float>> &_positions,
+                          const std::vector<uint32_t> &_indices, uint32_t _max_vertices, uint32_t _max_triangles, bool _check_cones) {
+    std::vector<char> data(_builder.GetSerializedSize());
+    _builder.Serialize(data.data());
+    Check(data.size() % sizeof(uint32_t) == 0, "serialized size is a multiple of 4");
+
+    std::vector<uint32_t> decoded;
+    decoded.reserve(_indices.size());
+    for(uint32_t i = 0; i < _builder.GetMeshletCount(); i++) {
+        Libdas::DasMeshlet meshlet;
+        std::memcpy(&meshlet, data.data() + i * sizeof(Libdas::DasMeshlet), sizeof(Libdas::DasMeshlet));
+        Check(meshlet.vertex_count <= _max_vertices, "meshlet vertex count does not exceed the limit");
+        Check(meshlet.triangle_count && meshlet.triangle_count <= _max_triangles, "meshlet triangle count does not exceed the limit");
+        Check(meshlet.vertex_offset % sizeof(uint32_t) == 0, "meshlet vertex indices are aligned");
+        Check(meshlet.vertex_offset + meshlet.vertex_count * sizeof(uint32_t) <= data.size() &&
+              meshlet.triangle_offset + meshlet.triangle_count * 3 <= data.size(), "meshlet data is inside the serialized data");
+
+        const uint32_t *vertices = reinterpret_cast<const uint32_t*>(data.data() + meshlet.vertex_offset);
+        const uint8_t *triangles = reinterpret_cast<const uint8_t*>(data.data() + meshlet.triangle_offset);
+        for(uint32_t j = 0; j < meshlet.triangle_count * 3; j++) {
+            Check(triangles[j] < meshlet.vertex_count, "local index points to a meshlet vertex");
+            decoded.push_back(vertices[triangles[j]]);
+        }
+
+        for(uint32_t j = 0; j < meshlet.vertex_count; j++) {
+            const TRS::Point3D<float> &p = _positions[vertices[j]];
+            const float dx = p.x - meshlet.center.x, dy = p.y - meshlet.center.y, dz = p.z - meshlet.center.z;
+            Check(std::sqrt(dx * dx + dy * dy + dz * dz) <= meshlet.radius + EPSILON, "bounding sphere encloses meshlet vertices");
+        }
+
+        if(_check_cones) {
+            Check(std::fabs(meshlet.cone_axis.z - 1.0f) <= EPSILON && std::fabs(meshlet.cone_cutoff) <= EPSILON, "flat meshlet has a narrow cone along its normal");
+            Check(!IsBackfacing(meshlet, meshlet.center.x, meshlet.center.y, 10.0f), "meshlet facing the camera is not culled");
+            Check(IsBackfacing(meshlet, meshlet.center.x, meshlet.center.y, -10.0f), "meshlet facing away from the camera is culled");
+        }
+    }
+
+    Check(decoded == _indices, "meshlets contain all triangles in index order");
+}
+
+
+static void TestGrid(uint32_t _max_vertices, uint32_t _max_triangles) {
+    std::vector<TRS::Point3D<float>> positions;
+    std::vector<uint32_t> indices;
+    MakeGrid(GRID_SIZE, positions, indices);
+
+    Libdas::MeshletBuilder builder(indices.data(), static_cast<uint32_t>(indices.size()), positions.data(),
+                                   static_cast<uint32_t>(positions.size()), _max_vertices, _max_triangles);
+    builder.Build(0);
+    CheckMeshlets(builder, positions, indices, _max_vertices, _max_triangles, true);
+
+    // output must not depend on the thread count
+    Libdas::MeshletBuilder single(indices.data(), static_cast<uint32_t>(indices.size()), positions.data(),
+                                  static_cast<uint32_t>(positions.size()), _max_vertices, _max_triangles);
+    single.Build(1);
+    std::vector<char> a(builder.GetSerializedSize()), b(single.GetSerializedSize());
+    builder.Serialize(a.data());
+    single.Serialize(b.data());
+    Check(a == b, "meshlets do not depend on the thread count");
+}
+
+
+static void TestClosedMesh() {
+    // cube, whose normals spread over all directions
+    const std::vector<TRS::Point3D<float>> positions = {
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, 1.0f, 1.0f}
+    };
+    const std::vector<uint32_t> indices = {
+        0, 2, 1, 0, 3, 2,   4, 5, 6, 4, 6, 7,   0, 1, 5, 0, 5, 4,
+        1, 2, 6, 1, 6, 5,   2, 3, 7, 2, 7, 6,   3, 0, 4, 3, 4, 7
+    };
+
+    Libdas::MeshletBuilder builder(indices.data(), static_cast<uint32_t>(indices.size()), positions.data(), static_cast<uint32_t>(positions.size()));
+    builder.Build();
+    Check(builder.GetMeshletCount() == 1, "small mesh fits into a single meshlet");
+    CheckMeshlets(builder, positions, indices, LIBDAS_MESHLET_MAX_VERTICES, LIBDAS_MESHLET_MAX_TRIANGLES, false);
+
+    if(builder.GetMeshletCount()) {
+        const Libdas::DasMeshlet &meshlet = builder.GetMeshlets()[0];
+        Check(meshlet.cone_cutoff == 1.0f, "closed meshlet has a degenerate cone");
+        Check(!IsBackfacing(meshlet, 10.0f, 0.5f, 0.5f) && !IsBackfacing(meshlet, 0.5f, 0.5f, -10.0f), "closed meshlet is never culled");
+    }
+}
+
+
+int main() {
+    TestGrid(LIBDAS_MESHLET_MAX_VERTICES, LIBDAS_MESHLET_MAX_TRIANGLES);
+    TestGrid(16, 10);
+    TestGrid(256, 512);
+    TestClosedMesh();
+
+    return ReportChecks("MeshletBuilder");
+}
@@ -0,0 +1,187 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: OutputSinkTest.cpp - MemorySink and CallbackSink class test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <any>
+#include <atomic>
+#include <future>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <cstdio>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "trs/Iterators.h"
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "mar/AsciiStreamReader.h"
+#include "mar/AsciiLineReader.h"
+
+#include "das/Api.h"
+#include "das/ErrorHandlers.h"
+#include "das/DasStructures.h"
+#include "das/MappedFile.h"
+#include "das/RandomAccessFile.h"
+#include "das/OutputSink.h"
+#include "das/FileWriter.h"
+#include "das/TextureReader.h"
+#include "das/DasWriterCore.h"
+#include "das/DasArena.h"
+#include "das/DasReaderCore.h"
+#include "das/DasParser.h"
+
+#include "TestUtils.h"
+
+#define OUT_FILE            "OutputSinkTest.das"
+#define BUFFER_COUNT        5
+#define NODE_COUNT          4
+#define PAYLOAD_ALIGNMENT   32
+
+
+static std::vector<std::vector<char>> MakePayloads() {
+    std::vector<std::vector<char>> payloads;
+    for(uint32_t i = 0; i < BUFFER_COUNT; i++) {
+        std::vector<char> &payload = payloads.emplace_back(50 + i * 77);
+        for(size_t j = 0; j < payload.size(); j++)
+            payload[j] = static_cast<char>(i * 13 + j * 5);
+    }
+
+    return payloads;
+}
+
+
+static void WriteModel(Libdas::DasWriterCore &_writer, std::vector<std::vector<char>> &_payloads) {
+    Libdas::DasProperties props;
+    props.model = "OutputSinkTest";
+    _writer.InitialiseFile(props);
+
+    for(size_t i = 0; i < _payloads.size(); i++) {
+        Libdas::DasBuffer buffer;
+        buffer.type = LIBDAS_BUFFER_TYPE_VERTEX;
+        buffer.data_len = static_cast<uint32_t>(_payloads[i].size());
+        buffer.data_ptrs.push_back(std::make_pair(_payloads[i].data(), _payloads[i].size()));
+        buffer._free_bit = false;
+        _writer.WriteBuffer(buffer, i % 2 ? 0 : PAYLOAD_ALIGNMENT);
+    }
+
+    for(uint32_t i = 0; i < NODE_COUNT; i++) {
+        Libdas::DasNode node;
+        node.name = "node" + std::to_string(i);
+        node.mesh = i;
+        _writer.WriteNode(node);
+    }
+
+    Libdas::DasScene scene;
+    scene.name = "scene";
+    scene.node_count = NODE_COUNT;
+    scene.nodes = new uint32_t[NODE_COUNT];
+    for(uint32_t i = 0; i < NODE_COUNT; i++)
+        scene.nodes[i] = i;
+    _writer.WriteScene(scene);
+
+    _writer.CloseStream();
+}
+
+
+static void CheckModel(Libdas::DasModel &_model, const std::vector<std::vector<char>> &_payloads, const std::string &_name) {
+    Check(_model.props.model == "OutputSinkTest", _name + " properties");
+    Check(_model.buffers.size() == _payloads.size(), _name + " buffer count");
+    for(size_t i = 0; i < _model.buffers.size() && i < _payloads.size(); i++) {
+        std::vector<char> data;
+        for(size_t j = 0; j < _model.buffers[i].data_ptrs.size(); j++)
+            data.insert(data.end(), _model.buffers[i].GetData(j), _model.buffers[i].GetData(j) + _model.buffers[i].data_ptrs[j].second);
+        Check(_model.buffers[i].data_len == _payloads[i].size() && data == _payloads[i], _name + " buffer payloads");
+    }
+
+    Check(_model.nodes.size() == NODE_COUNT, _name + " node count");
+    for(uint32_t i = 0; i < _model.nodes.size(); i++)
+        Check(_model.nodes[i].name == "node" + std::to_string(i) && _model.nodes[i].mesh == i, _name + " node values");
+    Check(_model.scenes.size() == 1 && _model.scenes[0].node_count == NODE_COUNT, _name + " scene");
+}
+
+
+static std::vector<char> TestMemorySink(std::vector<std::vector<char>> &_payloads) {
+    std::shared_ptr<Libdas::MemorySink> sink = std::make_shared<Libdas::MemorySink>();
+    {
+        Libdas::DasWriterCore writer(sink);
+        WriteModel(writer, _payloads);
+    }
+
+    std::vector<char> image = sink->ReleaseImage();
+    Check(sink->GetImage().empty(), "released memory sink is empty");
+
+    // the same model written into a file must produce an identical image
+    {
+        Libdas::DasWriterCore writer(OUT_FILE);
+        WriteModel(writer, _payloads);
+    }
+    std::ifstream file(OUT_FILE, std::ios_base::binary);
+    const std::vector<char> file_image = std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    Check(image == file_image, "memory sink image matches the written file");
+    file.close();
+    std::remove(OUT_FILE);
+
+    std::vector<char> parsed_image = image;
+    Libdas::DasParser parser(std::move(parsed_image));
+    parser.Parse();
+    CheckModel(parser.GetModel(), _payloads, "memory image");
+    return image;
+}
+
+
+static void TestCallbackSink(std::vector<std::vector<char>> &_payloads, const std::vector<char> &_image) {
+    std::vector<char> image;
+    uint32_t patch_count = 0;
+    bool is_appended = true;
+
+    std::shared_ptr<Libdas::CallbackSink> sink;
+    sink = std::make_shared<Libdas::CallbackSink>([&](uint64_t _offset, const char *_data, size_t _len) {
+        // appends continue from the current sink size, while patches overwrite already reported bytes
+        if(_offset < sink->GetSize()) {
+            Check(_offset + _len <= sink->GetSize(), "patched data was already written");
+            Check(_offset + _len <= sizeof(Libdas::DasHeader), "only the header is patched");
+            std::memcpy(image.data() + _offset, _data, _len);
+            patch_count++;
+        } else {
+            is_appended = is_appended && _offset == image.size() && _offset == sink->GetSize();
+            image.insert(image.end(), _data, _data + _len);
+        }
+        return true;
+    });
+
+    {
+        Libdas::DasWriterCore writer(sink);
+        WriteModel(writer, _payloads);
+    }
+
+    Check(is_appended, "callback sink reports appends with increasing offsets");
+    Check(patch_count == 1, "callback sink reports the header patch once");
+    Check(sink->GetSize() == image.size(), "callback sink size matches the amount of appended bytes");
+    Check(image == _image, "callback sink output matches the memory sink image");
+
+    Libdas::DasParser parser(std::move(image));
+    parser.Parse();
+    CheckModel(parser.GetModel(), _payloads, "callback output");
+}
+
+
+int main() {
+    std::vector<std::vector<char>> payloads = MakePayloads();
+    const std::vector<char> image = TestMemorySink(payloads);
+    TestCallbackSink(payloads, image);
+    return ReportChecks("OutputSink");
+}
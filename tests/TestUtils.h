@@ -0,0 +1,44 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: TestUtils.h - check reporting helpers shared by libdas test applications
+// author: Karl-Mihkel Ott
+
+#ifndef TEST_UTILS_H
+#define TEST_UTILS_H
+
+#include <cstdint>
+#include <string>
+#include <iostream>
+
+// amount of failed checks in the current test application
+inline uint32_t g_failed_count = 0;
+
+/**
+ * Report a failed check, the test application keeps running to report all other failures as well
+ * @param _condition specifies the checked condition
+ * @param _description specifies the expected behaviour, that is printed when the condition does not hold
+ */
+inline void Check(bool _condition, const std::string &_description) {
+    if(!_condition) {
+        std::cerr << "FAILED: " << _description << std::endl;
+        g_failed_count++;
+    }
+}
+
+
+/**
+ * Print the test summary
+ * @param _name specifies the name of tested functionality
+ * @return exit code of the test application
+ */
+inline int ReportChecks(const std::string &_name) {
+    if(g_failed_count) {
+        std::cerr << g_failed_count << " " << _name << " checks failed" << std::endl;
+        return -1;
+    }
+
+    std::cout << "All " << _name << " checks passed" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,131 @@
+// libdas: DENG asset handling management library
+// licence: Apache, see LICENCE file
+// file: VertexQuantizationTest.cpp - vertex attribute quantization functions test application
+// author: Karl-Mihkel Ott
+
+// stl
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <iostream>
+
+#include "trs/Vector.h"
+#include "trs/Matrix.h"
+#include "trs/Points.h"
+#include "trs/Quaternion.h"
+
+#include "das/Api.h"
+#include "das/VertexQuantization.h"
+
+#include "TestUtils.h"
+
+#define SAMPLE_COUNT    10000
+// largest distance between a unit vector and its decoded octahedral encoding
+#define OCTAHEDRAL_MAX_ERROR    1e-4f
+
+
+static float Random(uint32_t &_state) {
+    _state = _state * 1664525u + 1013904223u;
+    return static_cast<float>(_state >> 8) / static_cast<float>(1 << 24);
+}
+
+
+static void TestUnorm16() {
+    const float min = -12.5f, max = 40.0f;
+    const float scale = Libdas::Quantization::FindScale(min, max);
+    Check(scale == max - min, "scale equals the range size");
+    Check(Libdas::Quantization::FindScale(3.0f, 3.0f) == 1.0f, "degenerate range has a scale of 1");
+
+    // rounding to the nearest step bounds the error by half a step, with some slack for float precision
+    const float max_error = scale / 65535.0f * 0.5f + std::fabs(max) * 1e-6f;
+    uint32_t state = 1;
+    for(uint32_t i = 0; i < SAMPLE_COUNT; i++) {
+        const float value = min + Random(state) * scale;
+        const float decoded = Libdas::Quantization::DecodeUnorm16(Libdas::Quantization::EncodeUnorm16(value, min, scale), min, scale);
+        Check(std::fabs(decoded - value) <= max_error, "unorm16 round trip error is at most half a quantization step");
+    }
+
+    Check(Libdas::Quantization::EncodeUnorm16(min, min, scale) == 0, "range minimum is encoded as 0");
+    Check(Libdas::Quantization::EncodeUnorm16(max, min, scale) == UINT16_MAX, "range maximum is encoded as the largest value");
+    Check(Libdas::Quantization::DecodeUnorm16(0, min, scale) == min, "0 is decoded as the range minimum");
+    Check(std::fabs(Libdas::Quantization::DecodeUnorm16(UINT16_MAX, min, scale) - max) <= max_error, "largest value is decoded as the range maximum");
+    Check(Libdas::Quantization::EncodeUnorm16(min - 1.0f, min, scale) == 0 && Libdas::Quantization::EncodeUnorm16(max + 1.0f, min, scale) == UINT16_MAX,
+          "values outside of the range are clamped");
+}
+
+
+static void CheckOctahedral(float _x, float _y, float _z) {
+    const float len = std::sqrt(_x * _x + _y * _y + _z * _z);
+    const TRS::Vector3<float> dir(_x / len, _y / len, _z / len);
+    const TRS::Vector3<float> decoded = Libdas::Quantization::DecodeOctahedral(Libdas::Quantization::EncodeOctahedral(dir));
+
+    const float decoded_len = std::sqrt(decoded.first * decoded.first + decoded.second * decoded.second + decoded.third * decoded.third);
+    Check(std::fabs(decoded_len - 1.0f) <= 1e-5f, "decoded octahedral vector is normalised");
+
+    // chord length is used instead of the angle, since acos() is imprecise for nearly parallel vectors
+    const float dx = decoded.first - dir.first, dy = decoded.second - dir.second, dz = decoded.third - dir.third;
+    Check(std::sqrt(dx * dx + dy * dy + dz * dz) <= OCTAHEDRAL_MAX_ERROR, "octahedral round trip error is bounded");
+}
+
+
+static void TestOctahedral() {
+    // axes and octahedron edges, where the lower hemisphere folding is the most sensitive
+    CheckOctahedral(1.0f, 0.0f, 0.0f);
+    CheckOctahedral(-1.0f, 0.0f, 0.0f);
+    CheckOctahedral(0.0f, 1.0f, 0.0f);
+    CheckOctahedral(0.0f, -1.0f, 0.0f);
+    CheckOctahedral(0.0f, 0.0f, 1.0f);
+    CheckOctahedral(0.0f, 0.0f, -1.0f);
+    CheckOctahedral(1.0f, 1.0f, -1.0f);
+    CheckOctahedral(-1.0f, -1.0f, -1e-3f);
+    CheckOctahedral(-1e-3f, 1.0f, -1.0f);
+
+    uint32_t state = 2;
+    for(uint32_t i = 0; i < SAMPLE_COUNT; i++) {
+        const float x = Random(state) * 2.0f - 1.0f, y = Random(state) * 2.0f - 1.0f, z = Random(state) * 2.0f - 1.0f;
+        if(x * x + y * y + z * z > 1e-6f)
+            CheckOctahedral(x, y, z);
+    }
+
+    const TRS::Vector2<int16_t> zero = Libdas::Quantization::EncodeOctahedral(TRS::Vector3<float>(0.0f, 0.0f, 0.0f));
+    Check(zero.first == 0 && zero.second == 0, "zero vector is encoded without dividing by zero");
+}
+
+
+static void TestJointWeights() {
+    uint32_t state = 3;
+    for(uint32_t i = 0; i < SAMPLE_COUNT; i++) {
+        // some weights are left empty and the sum is not normalised
+        float w[4];
+        for(uint32_t j = 0; j < 4; j++)
+            w[j] = Random(state) < 0.3f ? 0.0f : Random(state) * 2.0f;
+        if(w[0] + w[1] + w[2] + w[3] == 0.0f)
+            w[0] = 1.0f;
+
+        const TRS::Vector4<uint8_t> q = Libdas::Quantization::EncodeJointWeights(TRS::Vector4<float>(w[0], w[1], w[2], w[3]));
+        const uint8_t qw[4] = { q.first, q.second, q.third, q.fourth };
+        const float sum = w[0] + w[1] + w[2] + w[3];
+        Check(qw[0] + qw[1] + qw[2] + qw[3] == 255, "quantized joint weights sum up to 255");
+
+        for(uint32_t j = 0; j < 4; j++) {
+            // rounding error of all four weights might be corrected on a single weight
+            Check(std::fabs(qw[j] / 255.0f - w[j] / sum) <= 2.0f / 255.0f + 1e-6f, "quantized joint weight error is bounded");
+            Check(w[j] != 0.0f || qw[j] == 0, "empty joint weights stay empty");
+        }
+    }
+
+    const TRS::Vector4<uint8_t> empty = Libdas::Quantization::EncodeJointWeights(TRS::Vector4<float>(0.0f, 0.0f, 0.0f, 0.0f));
+    Check(empty.first == 255 && empty.second == 0 && empty.third == 0 && empty.fourth == 0, "empty weights are bound to the first joint");
+}
+
+
+int main() {
+    TestUnorm16();
+    TestOctahedral();
+    TestJointWeights();
+
+    return ReportChecks("vertex quantization");
+}